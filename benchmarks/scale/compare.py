@@ -0,0 +1,47 @@
+#!/usr/bin/python3
+# Compares two summary.csv files written by run-sweep.sh, point by point,
+# and exits with 1 when a point got slower (wall time per simulated second)
+# or bigger (peak RSS) by more than the threshold.
+#
+#   ./compare.py baseline/summary.csv results/summary.csv [threshold]
+import csv
+import sys
+
+
+def load(fname):
+    points = {}
+    with open(fname, "r") as fin:
+        for row in csv.DictReader(fin):
+            points[(int(row["cells"]), int(row["ues_per_cell"]))] = row
+    return points
+
+
+def main():
+    if len(sys.argv) < 3:
+        print("usage: compare.py baseline.csv current.csv [threshold]")
+        return 2
+    baseline = load(sys.argv[1])
+    current = load(sys.argv[2])
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 0.10
+
+    regressions = 0
+    print("%6s %6s %14s %14s %8s %10s" %
+          ("cells", "ues", "wall/sim base", "wall/sim now", "ratio", "rss ratio"))
+    for key in sorted(current):
+        if key not in baseline:
+            continue
+        old, new = baseline[key], current[key]
+        time_ratio = float(new["wall_per_sim_second"]) / float(old["wall_per_sim_second"])
+        rss_ratio = float(new["peak_rss_kb"]) / float(old["peak_rss_kb"])
+        flag = ""
+        if time_ratio > 1 + threshold or rss_ratio > 1 + threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%6d %6d %14.3f %14.3f %8.2f %10.2f%s" %
+              (key[0], key[1], float(old["wall_per_sim_second"]),
+               float(new["wall_per_sim_second"]), time_ratio, rss_ratio, flag))
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,33 @@
+#!/bin/bash
+# Runs ScaleTest over a sweep of cells x UEs per cell and collects the
+# BENCH summaries into CSV files. The runs are sequential, so that they do
+# not compete for the cores or the memory bandwidth.
+#
+#   ./run-sweep.sh [config] [output dir]
+#   CELLS="1 7 19 37" UES="10 50 100" ./run-sweep.sh
+
+LTESIM=${LTESIM:-../../LTE-Sim}
+CONFIG=${1:-scale-test.json}
+ODIR=${2:-results}
+CELLS=${CELLS:-"1 7 19"}
+UES=${UES:-"10 50 100"}
+
+mkdir -p ${ODIR}
+SUMMARY=${ODIR}/summary.csv
+SUBSYSTEMS=${ODIR}/subsystems.csv
+echo "cells,ues_per_cell,sim_seconds,setup_seconds,wall_seconds,wall_per_sim_second,events,events_per_second,peak_rss_kb" > ${SUMMARY}
+echo "cells,ues_per_cell,subsystem,events,seconds" > ${SUBSYSTEMS}
+
+for n in ${CELLS}; do
+    for m in ${UES}; do
+        LOG=${ODIR}/scale_${n}_${m}.log
+        if ! ${LTESIM} ScaleTest ${CONFIG} ${n} ${m} 2> ${LOG} > /dev/null; then
+            echo "ScaleTest ${n} cells x ${m} UEs failed, see ${LOG}" >&2
+            continue
+        fi
+        # BENCH cells N ues_per_cell M sim_seconds S ... : keep the values
+        grep "^BENCH " ${LOG} | awk '{ line = $3; for (i = 5; i <= NF; i += 2) line = line "," $i; print line }' >> ${SUMMARY}
+        grep "^BENCH_SUBSYSTEM " ${LOG} | awk -v n=${n} -v m=${m} '{ print n "," m "," $2 "," $3 "," $4 }' >> ${SUBSYSTEMS}
+        tail -1 ${SUMMARY}
+    done
+done
@@ -43,6 +43,7 @@
 #include "scenarios/single-cell-with-streets.h"
 #include "scenarios/multi-cell-sinrplot.h"
 #include "scenarios/single-cell-customize.h"
+#include "scenarios/scale-test.h"
 #include "TEST/scalability-test-macro-with-femto.h"
 #include "TEST/test-sinr-femto.h"
 #include "TEST/test-throughput-macro-with-femto.h"
@@ -51,9 +52,18 @@
 #include "TEST/test-throughput-building.h"
 #include "TEST/test-uplink-fme.h"
 #include "TEST/test-uplink-channel-quality.h"
+#include "TEST/test-amc-tables.h"
+#include "TEST/test-lookup-scaling.h"
+#include "TEST/test-timing-wheel.h"
 
 
 #include "utility/help.h"
+#include "device/CqiManager/cqi-trace-store.h"
+#include "componentManagers/TtiExecutor.h"
+#include "componentManagers/SnapshotManager.h"
+#include "componentManagers/RealTimeManager.h"
+#include "protocolStack/mac/packet-scheduler/scheduler-input-trace.h"
+#include "protocolStack/mac/packet-scheduler/scheduler-replay.h"
 #include <iostream>
 #include <queue>
 #include <fstream>
@@ -64,6 +74,76 @@
 main (int argc, char *argv[])
 {
 
+  /* options shared by all the scenarios, before the scenario name */
+  while (argc > 2 && strncmp(argv[1], "--", 2)==0)
+  {
+    if (strcmp(argv[1], "--tti-threads")==0)
+      TtiExecutor::Init ()->SetNbThreads (atoi(argv[2]));
+    else if (strcmp(argv[1], "--snapshot-at")==0)
+      SnapshotManager::Init ()->Enable (atof(argv[2]));
+    else if (strcmp(argv[1], "--snapshot-schedulers")==0)
+      {
+        if (!SnapshotManager::Init ()->SetSchedulers (argv[2]))
+          {
+            std::cerr << "ERROR: invalid scheduler list " << argv[2] << std::endl;
+            exit(1);
+          }
+      }
+    else if (strcmp(argv[1], "--snapshot-seeds")==0)
+      {
+        if (!SnapshotManager::Init ()->SetSeeds (argv[2]))
+          {
+            std::cerr << "ERROR: invalid seed list " << argv[2] << std::endl;
+            exit(1);
+          }
+      }
+    else if (strcmp(argv[1], "--snapshot-output")==0)
+      SnapshotManager::Init ()->SetOutputPrefix (argv[2]);
+    else if (strcmp(argv[1], "--snapshot-jobs")==0)
+      SnapshotManager::Init ()->SetNbJobs (atoi(argv[2]));
+    else if (strcmp(argv[1], "--real-time")==0)
+      {
+        if (atof(argv[2]) <= 0)
+          {
+            std::cerr << "ERROR: invalid slot duration " << argv[2] << std::endl;
+            exit(1);
+          }
+        RealTimeManager::Init ()->Enable (atof(argv[2]));
+      }
+    else if (strcmp(argv[1], "--real-time-socket")==0)
+      {
+        if (!RealTimeManager::Init ()->Listen (argv[2]))
+          {
+            std::cerr << "ERROR: unable to create the socket " << argv[2] << std::endl;
+            exit(1);
+          }
+      }
+    else if (strcmp(argv[1], "--capture-scheduler-inputs")==0)
+      {
+        if (!SchedulerInputTrace::Init ()->Open (argv[2]))
+          {
+            std::cerr << "ERROR: unable to create " << argv[2] << std::endl;
+            exit(1);
+          }
+      }
+    else
+      break;
+    argv += 2;
+    argc -= 2;
+  }
+  // the restored runs would all write to the same capture
+  if (SchedulerInputTrace::Init ()->IsRecording () && SnapshotManager::Init ()->IsEnabled ())
+  {
+    std::cerr << "ERROR: --capture-scheduler-inputs does not apply to snapshots" << std::endl;
+    exit(1);
+  }
+  // the restored runs would share the clock and the controller
+  if (RealTimeManager::Init ()->IsEnabled () && SnapshotManager::Init ()->IsEnabled ())
+  {
+    std::cerr << "ERROR: --real-time does not apply to snapshots" << std::endl;
+    exit(1);
+  }
+
   if (argc > 1)
   {
 
@@ -137,6 +217,13 @@ main (int argc, char *argv[])
         radius, sched_type, frame_struct, speed, maxDelay,
         videoBitRate, internetFlowRate, seed, config_fname);
     }
+    if (strcmp(argv[1], "ScaleTest")==0)
+    {
+      string config_fname = string(argv[2]);
+      int nbCells = (argc > 3) ? atoi(argv[3]) : -1;
+      int nbUE = (argc > 4) ? atoi(argv[4]) : -1;
+      ScaleTest (config_fname, nbCells, nbUE);
+    }
     if (strcmp(argv[1], "MultiCell")==0)
     {
       int nbCells = atoi(argv[2]);
@@ -201,6 +288,33 @@ main (int argc, char *argv[])
       SingleCellWithStreets ( radius, nbStreets, nbUE, nbFemtoUE, nbVoIP, nbVideo, nbBE, nbCBR, sched_type, frame_struct, speed, maxDelay, video_bit_rate, seed);
     }
 
+    /* Compile the SDR CQI logs into the binary trace store */
+    if (strcmp(argv[1], "CompileCqiTrace")==0)
+    {
+      string traceDir = (argc > 2) ? string(argv[2]) : path + CQI_TRACE_DIR;
+      if (traceDir.back() != '/') traceDir += "/";
+      if (!CqiTraceStore::Compile (traceDir, traceDir + CQI_TRACE_BINARY))
+        {
+          std::cerr << "ERROR: unable to compile the cqi traces in " << traceDir << std::endl;
+          return 1;
+        }
+      return 0;
+    }
+
+    /* Benchmark a DL scheduler on captured inputs */
+    if (strcmp(argv[1], "ReplaySchedulerInputs")==0)
+    {
+      if (argc < 5)
+        {
+          std::cerr << "ERROR: ReplaySchedulerInputs capture scheduler config [passes]" << std::endl;
+          return 1;
+        }
+      int passes = (argc > 5) ? atoi(argv[5]) : 2;
+      if (passes < 1)
+        passes = 1;
+      return SchedulerReplay::Run (argv[2], argv[3], argv[4], passes);
+    }
+
     /* other dedicated simulations */
     if (strcmp(argv[1], "test-amc-mapping")==0)
     {
@@ -212,6 +326,18 @@ main (int argc, char *argv[])
 
       TestAmcMapping (cells, radius, speed, bandwidth, cluster);
     }
+    if (strcmp(argv[1], "test-amc-tables")==0)
+    {
+      TestAmcTables ();
+    }
+    if (strcmp(argv[1], "test-lookup-scaling")==0)
+    {
+      TestLookupScaling ();
+    }
+    if (strcmp(argv[1], "test-timing-wheel")==0)
+    {
+      TestTimingWheel ();
+    }
     if (strcmp(argv[1], "test-mobility-model")==0)
     {
       double radius = atof(argv[2]);
@@ -50,13 +50,13 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
                                           int nbUE_buildings) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbCell = 19;
   double duration = 30.;
@@ -75,7 +75,7 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
     CartesianCoordinates center = GetCartesianCoordinatesForCell(i, radius);
     Cell* c = new Cell(i, radius / 1000., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "CELL " << c->GetIdCell() << " position "
               << c->GetCellCenterPosition()->GetCoordinateX() << " "
@@ -90,7 +90,7 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
     enb->GetPhy()->SetUlChannel(ch_ul);
     enb->SetDLScheduler(ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR);
     enb->GetPhy()->SetBandwidthManager(new BandwidthManager(5, 5, 0, 0));
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
 
     std::cout
         << "eNB " << enb->GetIDNetworkNode() << " cell "
@@ -169,7 +169,10 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
         double posY =
             henb->GetMobilityModel()->GetAbsolutePosition()->GetCoordinateY();
         double speed = 3;
-        double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+        double speedDirection =
+            (double)(CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE)
+                         .NextInt(360)) *
+            ((2 * 3.14) / 360);
 
         UserEquipment* ue = new UserEquipment(
             idUE, posX, posY, speed, speedDirection, henb->GetCell(), henb, 0,
@@ -202,7 +205,7 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
             ->GetPropagationLossModel()
             ->AddChannelRealization(c_ul);
 
-        nm->GetUserEquipmentContainer()->push_back(ue);
+        nm->AddUserEquipment(ue);
 
         std::cout << "UE " << idUE << " position " << posX << " " << posY
                   << " cell " << ue->GetCell()->GetIdCell() << " enb "
@@ -228,12 +231,13 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
 
   int macro_ue = 30;
   for (int i = 0; i < macro_ue; i++) {
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
     double r = 1. / 4. * radius;
-    double angle = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double angle = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
     double x = (r * cos(angle));
     double y = (r * sin(angle));
     double speed = 3;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment* ue = new UserEquipment(
         idUE, x, y, speed, speedDirection, nm->GetCellByID(0),
@@ -266,7 +270,7 @@ static void ScalabilityTestMacroWithFemto(double radius, int nbBuildings,
         ->GetPropagationLossModel()
         ->AddChannelRealization(c_ul);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     std::cout << "UE " << idUE << " position " << x << " " << y << " cell "
               << ue->GetCell()->GetIdCell() << " enb "
@@ -55,7 +55,7 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/CellPosition.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/frequency-reuse-helper.h"
 #include "../utility/seed.h"
 
@@ -88,7 +88,7 @@ static void TestAmcMapping(int nbCells, double radius, int speed,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", pos: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -133,7 +133,7 @@ static void TestAmcMapping(int nbCells, double radius, int speed,
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -162,7 +162,7 @@ static void TestAmcMapping(int nbCells, double radius, int speed,
   WidebandCqiEesmErrorModel *errorModel = new WidebandCqiEesmErrorModel();
   ue->GetPhy()->SetErrorModel(errorModel);
 
-  nm->GetUserEquipmentContainer()->push_back(ue);
+  nm->AddUserEquipment(ue);
 
   eNBs->at(0)->RegisterUserEquipment(ue);
 
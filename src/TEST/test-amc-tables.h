@@ -0,0 +1,161 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <limits>
+
+#include "../protocolStack/mac/AMCModule.h"
+
+/*
+ * Checks the AMC lookup tables against the linear searches they replaced,
+ * and the NR TBS computation against values worked out by hand from
+ * TS 38.214, 5.1.3.2.
+ */
+
+// the mappings as they were computed before the lookup tables
+static double amcTestSinrForCqi[15] = {-4.63, -2.6,  -0.12, 2.26,  4.73,
+                                       7.53,  8.67,  11.32, 14.24, 15.21,
+                                       18.63, 21.32, 23.47, 28.49, 34.6};
+static double amcTestEfficiencyForCqi[16] = {
+    0.15, 0.23, 0.38, 0.6,  0.88, 1.18, 1.48, 1.91,
+    2.41, 2.73, 3.32, 3.9,  4.52, 5.12, 5.55, 0};  // [15]: read past the end
+static double amcTestEfficiencyForMcs[32] = {
+    0,    0.15, 0.19, 0.23, 0.31, 0.38, 0.49, 0.6,  0.74, 0.88, 1.03,
+    1.18, 1.33, 1.48, 1.7,  1.91, 2.16, 2.41, 2.57, 2.73, 3.03, 3.32,
+    3.61, 3.9,  4.21, 4.52, 4.82, 5.12, 5.33, 5.55, 2.4,  0};
+
+static int AmcTestCqiFromSinr(double sinr) {
+  int cqi = 1;
+  while (cqi <= 14 && amcTestSinrForCqi[cqi] <= sinr) cqi++;
+  return cqi;
+}
+
+static int AmcTestCqiFromEfficiency(double e) {
+  int cqi = 1;
+  while (amcTestEfficiencyForCqi[cqi] < e && cqi <= 14) cqi++;
+  return cqi;
+}
+
+static int AmcTestMcsFromEfficiency(double e) {
+  int mcs = 1;
+  while (amcTestEfficiencyForMcs[mcs] < e && mcs < 30) mcs++;
+  return mcs;
+}
+
+static int AmcTestCheck(const char *what, double x, int got, int expected) {
+  if (got == expected) return 0;
+  std::cout << "FAIL " << what << "(" << x << "): " << got << ", expected "
+            << expected << std::endl;
+  return 1;
+}
+
+static void TestAmcTables() {
+  AMCModule amc;
+  int failures = 0;
+
+  // dense sweeps, plus every breakpoint and its neighbours
+  std::vector<double> values;
+  for (double x = -40; x <= 60; x += 0.001) values.push_back(x);
+  for (int i = 0; i < 15; i++) values.push_back(amcTestSinrForCqi[i]);
+  for (int i = 0; i < 15; i++) values.push_back(amcTestEfficiencyForCqi[i]);
+  for (int i = 0; i < 32; i++) values.push_back(amcTestEfficiencyForMcs[i]);
+  int nbBreakpoints = values.size();
+  for (int i = 0; i < nbBreakpoints; i++) {
+    values.push_back(nextafter(values[i], -1e9));
+    values.push_back(nextafter(values[i], 1e9));
+  }
+  values.push_back(std::numeric_limits<double>::infinity());
+  values.push_back(-std::numeric_limits<double>::infinity());
+  values.push_back(std::numeric_limits<double>::quiet_NaN());
+
+  for (size_t i = 0; i < values.size(); i++) {
+    double x = values[i];
+    failures += AmcTestCheck("GetCQIFromSinr", x, amc.GetCQIFromSinr(x),
+                             AmcTestCqiFromSinr(x));
+    failures += AmcTestCheck("GetCQIFromEfficiency", x,
+                             amc.GetCQIFromEfficiency(x),
+                             AmcTestCqiFromEfficiency(x));
+    failures += AmcTestCheck("GetMCSIndexFromEfficiency", x,
+                             amc.GetMCSIndexFromEfficiency(x),
+                             AmcTestMcsFromEfficiency(x));
+  }
+
+  for (int mcs = -1; mcs <= 32; mcs++) {
+    int expected = 1;
+    for (int cqi = 15; cqi >= 1; cqi--)
+      if (amc.GetMCSFromCQI(cqi) == mcs) expected = cqi;
+    failures += AmcTestCheck("GetCQIFromMCS", mcs, amc.GetCQIFromMCS(mcs),
+                             expected);
+  }
+
+  for (int cqi = 1; cqi <= 15; cqi++) {
+    int bits = amc.GetTBSizeFromMCS(amc.GetMCSFromCQI(cqi));
+    double expected = (bits / 0.001) / 180000.;
+    if (amc.GetEfficiencyFromCQI(cqi) != expected) {
+      std::cout << "FAIL GetEfficiencyFromCQI(" << cqi << ")" << std::endl;
+      failures++;
+    }
+  }
+
+  // 120 REs per PRB: 11 symbols, one of them with DMRS
+  failures += AmcTestCheck("ComputeNrTBSize", 1, AMCModule::ComputeNrTBSize(0, 1), 24);
+  failures += AmcTestCheck("ComputeNrTBSize", 20, AMCModule::ComputeNrTBSize(4, 20), 1480);
+  failures += AmcTestCheck("ComputeNrTBSize", 100, AMCModule::ComputeNrTBSize(0, 100), 2792);
+  // R <= 1/4, three code blocks
+  failures += AmcTestCheck("ComputeNrTBSize", 275, AMCModule::ComputeNrTBSize(0, 275), 7680);
+  // 22 code blocks
+  failures += AmcTestCheck("ComputeNrTBSize", 275, AMCModule::ComputeNrTBSize(28, 275), 184424);
+  // N_RE' is capped to 156
+  failures += AmcTestCheck("ComputeNrTBSize", 1,
+                           AMCModule::ComputeNrTBSize(28, 1, 14, 0, 0, 1),
+                           AMCModule::ComputeNrTBSize(28, 1, 13, 0, 0, 1));
+
+  for (int mcs = 0; mcs <= 28; mcs++) {
+    for (int prb = 1; prb <= NR_MAX_PRB; prb++) {
+      int tbs = AMCModule::ComputeNrTBSize(mcs, prb);
+      failures += AmcTestCheck("GetNrTBSize", prb, amc.GetNrTBSize(mcs, prb), tbs);
+      failures += AmcTestCheck("GetNrTBSize", prb, amc.GetNrTBSize(mcs, prb, 2), 4 * tbs);
+      if (prb > 1 && tbs < AMCModule::ComputeNrTBSize(mcs, prb - 1)) {
+        std::cout << "FAIL ComputeNrTBSize(" << mcs << ", " << prb
+                  << ") is not monotonic" << std::endl;
+        failures++;
+      }
+    }
+  }
+
+  // wide carriers: 500 RBs of 180 kHz are 250 PRBs of 30 kHz, twice per ms
+  failures += AmcTestCheck("GetTBSizeFromMCS", 500, amc.GetTBSizeFromMCS(28, 500),
+                           2 * AMCModule::ComputeNrTBSize(28, 250));
+  failures += AmcTestCheck("GetTBSizeFromMCS", 501, amc.GetTBSizeFromMCS(28, 501),
+                           2 * AMCModule::ComputeNrTBSize(28, 250) +
+                               AMCModule::ComputeNrTBSize(28, 1));
+  failures += AmcTestCheck("GetTBSizeFromMCS", 111, amc.GetTBSizeFromMCS(28, 111),
+                           AMCModule::ComputeNrTBSize(28, 111));
+
+  if (failures > 0) {
+    std::cout << "AMC tables: " << failures << " failures" << std::endl;
+    exit(1);
+  }
+  std::cout << "AMC tables: OK" << std::endl;
+}
@@ -41,7 +41,7 @@ static void TestDownlinkProportionalFair() {
   // Create devices
 
   Cell *cell = new Cell(0, 1, 0.35, 0, 0);
-  networkManager->GetCellContainer()->push_back(cell);
+  networkManager->AddCell(cell);
 
   LteChannel *dlCh = new LteChannel();
   LteChannel *ulCh = new LteChannel();
@@ -54,7 +54,7 @@ static void TestDownlinkProportionalFair() {
   enb->GetPhy()->SetUlChannel(ulCh);
   enb->GetPhy()->SetBandwidthManager(spectrum->Copy());
   ulCh->AddDevice(enb);
-  networkManager->GetENodeBContainer()->push_back(enb);
+  networkManager->AddENodeB(enb);
 
   // Create UE
   UserEquipment *ue = new UserEquipment(2, 50, 50, 0, 0, cell, enb, 0,
@@ -69,11 +69,11 @@ static void TestDownlinkProportionalFair() {
   cqiManager->SetDevice(ue);
   ue->SetCqiManager(cqiManager);
 
-  networkManager->GetUserEquipmentContainer()->push_back(ue);
+  networkManager->AddUserEquipment(ue);
 
   // Create GW
   Gateway *gw = new Gateway();
-  networkManager->GetGatewayContainer()->push_back(gw);
+  networkManager->AddGateway(gw);
 
   enb->SetDLScheduler(ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR);
   enb->RegisterUserEquipment(ue);
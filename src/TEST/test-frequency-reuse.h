@@ -50,7 +50,7 @@ static void TestFrequencyReuse() {
     Cell *c = new Cell(i, 1., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -93,7 +93,7 @@ static void TestFrequencyReuse() {
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 }
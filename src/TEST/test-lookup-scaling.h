@@ -0,0 +1,180 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "../componentManagers/NetworkManager.h"
+#include "../core/spectrum/bandwidth-manager.h"
+#include "../device/ENodeB.h"
+#include "../device/UserEquipment.h"
+#include "../networkTopology/Cell.h"
+#include "../phy/enb-lte-phy.h"
+
+/*
+ * Regression benchmark for the ID lookup tables: the lookups a TTI performs
+ * for a fixed set of scheduled UEs must cost the same with 500 and with
+ * 5,000 UEs in the network. With the former linear scans the cost grew with
+ * the number of UEs.
+ */
+
+#define LOOKUP_TEST_ACTIVE_UES 64
+#define LOOKUP_TEST_TTIS 2000
+
+static int LookupTestCheck(const char *what, int id, bool ok) {
+  if (ok) return 0;
+  std::cout << "FAIL " << what << "(" << id << ")" << std::endl;
+  return 1;
+}
+
+static void LookupTestAddUEs(int first, int last, Cell *cell, ENodeB *enb) {
+  NetworkManager *nm = NetworkManager::Init();
+  for (int id = first; id < last; id++) {
+    UserEquipment *ue = new UserEquipment(id, 10 + id % 100, 10 + id / 100, 0,
+                                          0, cell, enb, 0,
+                                          Mobility::CONSTANT_POSITION);
+    nm->AddUserEquipment(ue);
+    enb->RegisterUserEquipment(ue);
+  }
+}
+
+// nanoseconds per TTI, best of a few runs
+static double LookupTestTTICost(ENodeB *enb, int nbUEs, long &checksum) {
+  NetworkManager *nm = NetworkManager::Init();
+  std::vector<int> active;
+  for (int i = 0; i < LOOKUP_TEST_ACTIVE_UES; i++)
+    active.push_back(nbUEs - 1 - i * (nbUEs / LOOKUP_TEST_ACTIVE_UES));
+
+  double best = 0;
+  for (int run = 0; run < 5; run++) {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (int tti = 0; tti < LOOKUP_TEST_TTIS; tti++) {
+      for (size_t i = 0; i < active.size(); i++) {
+        ENodeB::UserEquipmentRecord *record =
+            enb->GetUserEquipmentRecord(active[i]);
+        UserEquipment *ue = nm->GetUserEquipmentByID(active[i]);
+        NetworkNode *node = nm->GetNetworkNodeByID(active[i]);
+        checksum += (record->GetUE() == ue) + (node == ue);
+      }
+      checksum += nm->GetENodeBByCellID(0) == enb;
+      checksum += nm->GetCellByID(0) != NULL;
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - start)
+                    .count() /
+                LOOKUP_TEST_TTIS;
+    if (run == 0 || ns < best) best = ns;
+  }
+  return best;
+}
+
+static void TestLookupScaling() {
+  NetworkManager *nm = NetworkManager::Init();
+  int failures = 0;
+
+  Cell *cell = nm->CreateCell(0, 1, 0.035, 0, 0);
+  ENodeB *enb = new ENodeB(1, cell, 0, 0);
+  ENodeB *enb2 = new ENodeB(2, cell, 100, 0);
+  BandwidthManager *spectrum = new BandwidthManager(5, 5, 0, 0);
+  enb->GetPhy()->SetBandwidthManager(spectrum);
+  enb2->GetPhy()->SetBandwidthManager(spectrum->Copy());
+  nm->AddENodeB(enb);
+  nm->AddENodeB(enb2);
+
+  long checksum = 0;
+  LookupTestAddUEs(3, 500, cell, enb);
+  double small = LookupTestTTICost(enb, 500, checksum);
+  LookupTestAddUEs(500, 5000, cell, enb);
+  double large = LookupTestTTICost(enb, 5000, checksum);
+
+  long expected = 2L * 5 * LOOKUP_TEST_TTIS * (2 * LOOKUP_TEST_ACTIVE_UES + 2);
+  failures += LookupTestCheck("lookups", 0, checksum == expected);
+
+  // every entity is found, and lookups follow registration changes
+  for (int id = 3; id < 5000; id++) {
+    UserEquipment *ue = nm->GetUserEquipmentByID(id);
+    failures += LookupTestCheck("GetUserEquipmentByID", id,
+                                ue != NULL && ue->GetIDNetworkNode() == id);
+    failures += LookupTestCheck(
+        "GetUserEquipmentRecord", id,
+        ue != NULL && enb->GetUserEquipmentRecord(id) != NULL &&
+            enb->GetUserEquipmentRecord(id)->GetUE() == ue);
+  }
+  failures += LookupTestCheck("GetNetworkNodeByID", 2,
+                              nm->GetNetworkNodeByID(2) == enb2);
+  failures += LookupTestCheck("GetENodeBByID", 1, nm->GetENodeBByID(1) == enb);
+  failures += LookupTestCheck("GetUserEquipmentByID", 5000,
+                              nm->GetUserEquipmentByID(5000) == NULL);
+
+  UserEquipment *moved = nm->GetUserEquipmentByID(42);
+  enb2->RegisterUserEquipment(moved);
+  enb->DeleteUserEquipment(moved);
+  moved->SetTargetNode(enb2);
+  failures += LookupTestCheck("DeleteUserEquipment", 42,
+                              enb->GetUserEquipmentRecord(42) == NULL);
+  failures += LookupTestCheck(
+      "RegisterUserEquipment", 42,
+      enb2->GetUserEquipmentRecord(42) != NULL &&
+          enb2->GetUserEquipmentRecord(42)->GetUE() == moved);
+  failures += LookupTestCheck("GetUserEquipmentRecord", 43,
+                              enb->GetUserEquipmentRecord(43) != NULL);
+  std::vector<UserEquipment *> *onEnb = nm->GetRegisteredUEToENodeB(1);
+  std::vector<UserEquipment *> *onEnb2 = nm->GetRegisteredUEToENodeB(2);
+  failures += LookupTestCheck("GetRegisteredUEToENodeB", 1,
+                              onEnb->size() == 4996);
+  failures += LookupTestCheck("GetRegisteredUEToENodeB", 2,
+                              onEnb2->size() == 1 && onEnb2->at(0) == moved);
+  delete onEnb;
+  delete onEnb2;
+
+  // handing 42 back keeps the registration order, removal drops 43
+  enb->RegisterUserEquipment(moved);
+  enb2->DeleteUserEquipment(moved);
+  moved->SetTargetNode(enb);
+  UserEquipment *removed = nm->GetUserEquipmentByID(43);
+  enb->DeleteUserEquipment(removed);
+  // not deleted: its channels still refer to it
+  nm->RemoveUserEquipment(removed);
+  failures += LookupTestCheck("RemoveUserEquipment", 43,
+                              nm->GetUserEquipmentByID(43) == NULL &&
+                                  nm->GetNetworkNodeByID(43) == NULL);
+  onEnb = nm->GetRegisteredUEToENodeB(1);
+  failures += LookupTestCheck(
+      "GetRegisteredUEToENodeB", 42,
+      onEnb->size() == 4996 && onEnb->at(39) == moved &&
+          onEnb->at(40)->GetIDNetworkNode() == 44);
+  delete onEnb;
+
+  std::cout << "per-TTI lookup cost: " << small << " ns with 500 UEs, "
+            << large << " ns with 5000 UEs" << std::endl;
+  // linear scans were about ten times slower with ten times the UEs
+  failures += LookupTestCheck("per-TTI cost", 5000, large < 2 * small);
+
+  if (failures > 0) {
+    std::cout << "Lookup scaling: " << failures << " failures" << std::endl;
+    exit(1);
+  }
+  std::cout << "Lookup scaling: OK" << std::endl;
+}
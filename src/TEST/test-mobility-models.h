@@ -47,7 +47,7 @@
 #include "../phy/wideband-cqi-eesm-error-model.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 /*
@@ -63,7 +63,7 @@ static void TestMobilityModels(double radius, int nbUE, int mobility_model,
   else if (mobility_model == 1)
     model = Mobility::RANDOM_WALK;
 
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   // CREATE COMPONENT MANAGER
   Simulator* simulator = Simulator::Init();
@@ -74,20 +74,21 @@ static void TestMobilityModels(double radius, int nbUE, int mobility_model,
 
   // CREATE CELL
   Cell* cell = new Cell(0, radius, 0.035, 0, 0);
-  networkManager->GetCellContainer()->push_back(cell);
+  networkManager->AddCell(cell);
 
   // Create ENodeB
   ENodeB* enb = new ENodeB(1, cell, 0, 0);
-  networkManager->GetENodeBContainer()->push_back(enb);
+  networkManager->AddENodeB(enb);
 
   // Create UEs
   int idUE = 2;
   for (int i = 0; i < nbUE; i++) {
     // ue's random position
     int maxXY = radius * 1000;               // in metres
-    double posX = GetRandomVariable(maxXY);  // rand () %maxXY;
-    double posY = GetRandomVariable(maxXY);  // rand () %maxXY;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    CounterRng& rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform(maxXY);  // rand () %maxXY;
+    double posY = rng.NextUniform(maxXY);  // rand () %maxXY;
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment* ue = new UserEquipment(idUE, posX, posY, speed,
                                           speedDirection, cell, enb, 0, model);
@@ -95,7 +96,7 @@ static void TestMobilityModels(double radius, int nbUE, int mobility_model,
     std::cout << "Created UE - id " << idUE << " position " << posX << " "
               << posY << std::endl;
 
-    networkManager->GetUserEquipmentContainer()->push_back(ue);
+    networkManager->AddUserEquipment(ue);
 
     idUE++;
   }
@@ -48,7 +48,7 @@ static void TestMultiCell() {
     Cell *c = new Cell(i, 1., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -90,7 +90,7 @@ static void TestMultiCell() {
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -117,7 +117,7 @@ static void TestMultiCell() {
   cqiManager->SetDevice(ue);
   ue->SetCqiManager(cqiManager);
 
-  nm->GetUserEquipmentContainer()->push_back(ue);
+  nm->AddUserEquipment(ue);
 
   eNBs->at(0)->RegisterUserEquipment(ue);
 
@@ -0,0 +1,290 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+#include "../channel/LteChannel.h"
+#include "../componentManagers/NetworkManager.h"
+#include "../core/spectrum/bandwidth-manager.h"
+#include "../device/ENodeB.h"
+#include "../device/IPClassifier/ClassifierParameters.h"
+#include "../device/UserEquipment.h"
+#include "../flows/QoS/QoSParameters.h"
+#include "../flows/application/InfiniteBuffer.h"
+#include "../networkTopology/Cell.h"
+#include "../phy/enb-lte-phy.h"
+#include "../protocolStack/mac/packet-scheduler/packet-scheduler.h"
+#include "../slicing/slicing.h"
+#include "../utility/counter-rng.h"
+
+/*
+ * The DL schedulers must not call the heap once they have seen their busiest
+ * TTI: the users or flows to schedule and the temporaries of the allocation
+ * come from their TTI arena. Every inter-slice solver of the transport
+ * scheduler and two per-flow schedulers (PF, M-LWDF) run a few TTIs to warm
+ * up, then PrepareSchedule and AllocateResources must make no allocation.
+ *
+ * The slicing library is also called on its own, with the buffers of the
+ * caller: rs_slicing_allocate must not call the heap from the first call.
+ *
+ * The heap calls are counted by the global operator new of the test binary
+ * (unittest/test-scheduler-allocations.cpp), which only counts while a test
+ * turns it on. The simulator itself keeps the default allocator.
+ */
+
+extern bool schedAllocCounting;
+extern long schedAllocCount;
+
+#define SCHED_ALLOC_TEST_UES 20
+#define SCHED_ALLOC_TEST_SLICES 4
+#define SCHED_ALLOC_TEST_WARMUP 10
+#define SCHED_ALLOC_TEST_TTIS 500
+
+// swallows the per-TTI logging of the scheduler
+class SchedAllocNullBuffer : public std::streambuf {
+ protected:
+  virtual int overflow(int c) { return c; }
+  virtual std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+static int SchedAllocTestCheck(const char* what, const char* solver, bool ok) {
+  if (ok) return 0;
+  std::cout << "FAIL " << what << " (" << solver << ")" << std::endl;
+  return 1;
+}
+
+static std::string SchedAllocTestConfig(void) {
+  char fname[] = "/tmp/sched-alloc-test-XXXXXX";
+  int fd = mkstemp(fname);
+  if (fd < 0) {
+    std::cerr << "ERROR: unable to create the scheduler config" << std::endl;
+    exit(1);
+  }
+  close(fd);
+  std::ofstream ofs(fname);
+  ofs << "{\"ues_per_slice\": [5, 5, 5, 5], \"slices\": ["
+         "{\"n_slices\": 2, \"weight\": 0.25, \"algo_alpha\": 0,"
+         " \"algo_beta\": 0, \"algo_epsilon\": 1, \"algo_psi\": 1},"
+         "{\"n_slices\": 2, \"weight\": 0.25, \"algo_alpha\": 1,"
+         " \"algo_beta\": 1, \"algo_epsilon\": 1, \"algo_psi\": 1}]}";
+  return fname;
+}
+
+// the slicing library with SCHED_ALLOC_TEST_UES users over 100 RBs
+static int SchedAllocTestLibrary(CounterRng* rng) {
+  const int nbRBs = 100, rbgSize = 4, nbRBGs = nbRBs / rbgSize;
+  const int nbSlices = SCHED_ALLOC_TEST_SLICES, nbUsers = SCHED_ALLOC_TEST_UES;
+  const char* names[] = {"greedy-by-row", "subopt", "maximize-cell", "vogel",
+                         "upper-bound"};
+  int failures = 0;
+
+  std::vector<rs_slicing_slice> slices(nbSlices);
+  for (int k = 0; k < nbSlices; k++) {
+    slices[k].weight = 1.0 / nbSlices;
+    slices[k].alpha = k % 2;
+    slices[k].beta = k % 2;
+    slices[k].epsilon = 1;
+    slices[k].psi = 1;
+  }
+  std::vector<rs_slicing_user> users(nbUsers);
+  std::vector<double> efficiency(nbUsers * nbRBGs);
+  std::vector<int> targets(nbSlices), quotas(nbSlices);
+  std::vector<char> workspace(rs_slicing_workspace_size(nbRBGs, nbSlices, nbUsers));
+
+  for (int algo = RS_SLICING_GREEDY_BY_ROW; algo <= RS_SLICING_UPPER_BOUND; algo++) {
+    std::vector<double> offsets(nbSlices, 0);
+    std::vector<rs_slicing_grant> grants(rs_slicing_max_grants(algo, nbRBGs, nbSlices));
+    std::vector<int> granted(nbRBGs);
+    long allocations = 0;
+    bool ok = true;
+
+    for (int call = 0; call < SCHED_ALLOC_TEST_TTIS; call++) {
+      for (int u = 0; u < nbUsers; u++) {
+        users[u].slice = u % nbSlices;
+        users[u].backlog = 1 + rng->NextInt(100000);
+        users[u].priority_backlog = rng->NextInt(2) * users[u].backlog;
+        users[u].average_rate = 1 + rng->NextUniform(1e6);
+        users[u].hol_delay = rng->NextUniform(0.1);
+        for (int i = 0; i < nbRBGs; i++) {
+          efficiency[u * nbRBGs + i] = rng->NextUniform(5.5);
+        }
+      }
+      rs_slicing_input input;
+      input.algo = algo;
+      input.nb_rbs = nbRBs;
+      input.rbg_size = rbgSize;
+      input.nb_slices = nbSlices;
+      input.nb_users = nbUsers;
+      input.slices = slices.data();
+      input.users = users.data();
+      input.spectral_efficiency = efficiency.data();
+      input.rotation[0] = rng->NextInt(nbSlices);
+      input.rotation[1] = rng->NextInt(nbSlices);
+      rs_slicing_output output;
+      output.grants = grants.data();
+      output.max_grants = grants.size();
+      output.slice_target_rbs = targets.data();
+      output.slice_quota_rbgs = quotas.data();
+
+      schedAllocCount = 0;
+      schedAllocCounting = true;
+      int status = rs_slicing_allocate(&input, offsets.data(), workspace.data(),
+                                       workspace.size(), &output);
+      schedAllocCounting = false;
+      allocations += schedAllocCount;
+
+      // every grant to a user of its slice, an RBG once but with the upper bound
+      ok = ok && status == RS_SLICING_OK && output.nb_grants > 0;
+      std::fill(granted.begin(), granted.end(), 0);
+      for (int g = 0; ok && g < output.nb_grants; g++) {
+        const rs_slicing_grant& grant = output.grants[g];
+        ok = grant.rbg >= 0 && grant.rbg < nbRBGs && grant.user >= 0 &&
+             grant.user < nbUsers && users[grant.user].slice == grant.slice &&
+             (++granted[grant.rbg] == 1 || algo == RS_SLICING_UPPER_BOUND);
+      }
+    }
+
+    std::cout << "library " << names[algo] << ": " << allocations << " heap calls in "
+              << SCHED_ALLOC_TEST_TTIS << " calls, workspace of " << workspace.size()
+              << " bytes" << std::endl;
+    failures += SchedAllocTestCheck("library grants", names[algo], ok);
+    failures += SchedAllocTestCheck("library heap calls", names[algo], allocations == 0);
+  }
+  return failures;
+}
+
+static void TestSchedulerAllocations() {
+  NetworkManager* nm = NetworkManager::Init();
+  int failures = 0;
+  std::string config = SchedAllocTestConfig();
+
+  Cell* cell = nm->CreateCell(0, 1, 0.035, 0, 0);
+  ENodeB* enb = new ENodeB(100, cell, 0, 0);
+  LteChannel* dlCh = new LteChannel();
+  enb->GetPhy()->SetDlChannel(dlCh);
+  enb->GetPhy()->SetBandwidthManager(new BandwidthManager(10, 10, 0, 0));
+  nm->AddENodeB(enb);
+  int nbRBs = enb->GetPhy()->GetBandwidthManager()->GetDlSubChannels().size();
+
+  // one UE per user ID, each with a backlogged flow
+  for (int id = 0; id < SCHED_ALLOC_TEST_UES; id++) {
+    UserEquipment* ue = new UserEquipment(id, 10 + id, 10, 0, 0, cell, enb, 0,
+                                          Mobility::CONSTANT_POSITION);
+    nm->AddUserEquipment(ue);
+    enb->RegisterUserEquipment(ue);
+
+    InfiniteBuffer* app = new InfiniteBuffer();
+    app->SetSource(enb);
+    app->SetDestination(ue);
+    app->SetApplicationID(id);
+    app->SetClassifierParameters(new ClassifierParameters(
+        enb->GetIDNetworkNode(), id, 0, 100,
+        TransportProtocol::TRANSPORT_PROTOCOL_TYPE_UDP));
+    app->SetQoSParameters(new QoSParameters());
+    app->Start();
+  }
+
+  struct {
+    const char* name;
+    ENodeB::DLSchedulerType type;
+    bool perFlow;  // schedules FlowsToSchedule, not UsersToSchedule
+  } solvers[] = {
+      {"sequential", ENodeB::DLScheduler_SEQUENTIAL, false},
+      {"subopt", ENodeB::DLScheduler_SUBOPT, false},
+      {"maxcell", ENodeB::DLScheduler_MAXCELL, false},
+      {"vogel", ENodeB::DLScheduler_VOGEL, false},
+      {"upperbound", ENodeB::DLScheduler_UpperBound, false},
+      {"pf", ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR, true},
+      {"mlwdf", ENodeB::DLScheduler_TYPE_MLWDF, true},
+  };
+
+  CounterRng rng(0, RNG_PURPOSE_CHANNEL);
+  std::vector<int> cqi(nbRBs);
+  SchedAllocNullBuffer nullBuffer;
+
+  for (size_t s = 0; s < sizeof(solvers) / sizeof(solvers[0]); s++) {
+    enb->SetDLScheduler(solvers[s].type, config);
+    PacketScheduler* scheduler = enb->GetDLScheduler();
+    long allocations = 0;
+    size_t allocatedRBs = 0;
+
+    std::streambuf* out = std::cout.rdbuf(&nullBuffer);
+    std::streambuf* err = std::cerr.rdbuf(&nullBuffer);
+    for (int tti = 0; tti < SCHED_ALLOC_TEST_WARMUP + SCHED_ALLOC_TEST_TTIS; tti++) {
+      // new channel conditions, outside of the scheduler
+      for (int id = 0; id < SCHED_ALLOC_TEST_UES; id++) {
+        for (int rb = 0; rb < nbRBs; rb++) cqi[rb] = 1 + rng.NextInt(15);
+        enb->GetUserEquipmentRecord(id)->SetCQI(cqi);
+      }
+
+      schedAllocCount = 0;
+      schedAllocCounting = true;
+      scheduler->PrepareSchedule();
+      scheduler->AllocateResources();
+      schedAllocCounting = false;
+      if (tti >= SCHED_ALLOC_TEST_WARMUP) allocations += schedAllocCount;
+
+      if (solvers[s].perFlow) {
+        PacketScheduler::FlowsToSchedule* flows = scheduler->GetFlowsToSchedule();
+        for (size_t f = 0; f < flows->size(); f++) {
+          allocatedRBs += flows->at(f)->GetListOfAllocatedRBs()->size();
+        }
+      } else {
+        PacketScheduler::UsersToSchedule* users = scheduler->GetUsersToSchedule();
+        for (size_t u = 0; u < users->size(); u++) {
+          allocatedRBs += users->at(u)->GetListOfAllocatedRBs()->size();
+        }
+      }
+    }
+    std::cout.rdbuf(out);
+    std::cerr.rdbuf(err);
+
+    std::cout << solvers[s].name << ": " << allocations << " heap calls in "
+              << SCHED_ALLOC_TEST_TTIS << " TTIs, arena of "
+              << scheduler->GetTtiArena()->GetCapacity() << " bytes"
+              << std::endl;
+    size_t scheduled = solvers[s].perFlow ? scheduler->GetFlowsToSchedule()->size()
+                                          : scheduler->GetUsersToSchedule()->size();
+    failures += SchedAllocTestCheck("users or flows to schedule", solvers[s].name,
+                                    scheduled == SCHED_ALLOC_TEST_UES);
+    failures += SchedAllocTestCheck("allocated RBs", solvers[s].name,
+                                    allocatedRBs > 0);
+    failures += SchedAllocTestCheck("arena in use", solvers[s].name,
+                                    scheduler->GetTtiArena()->GetUsed() > 0);
+    failures += SchedAllocTestCheck("heap calls", solvers[s].name,
+                                    allocations == 0);
+  }
+  unlink(config.c_str());
+  failures += SchedAllocTestLibrary(&rng);
+
+  if (failures > 0) {
+    std::cout << "Scheduler allocations: " << failures << " failures"
+              << std::endl;
+    exit(1);
+  }
+  std::cout << "Scheduler allocations: OK" << std::endl;
+}
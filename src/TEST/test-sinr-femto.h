@@ -49,12 +49,12 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void TestSinrFemto(int riuso, double activityFactor) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbBuildings = 1;
   double duration = 0.2;
@@ -76,7 +76,8 @@ static void TestSinrFemto(int riuso, double activityFactor) {
   int nbFemtoCells = nbBuildings * femtoCellsInBuilding;
 
   for (int i = 0; i < nbBuildings; i++) {
-    double rnd = (double)rand() / RAND_MAX;
+    double rnd =
+        CounterRng::Stream(idBuilding, RNG_PURPOSE_PLACEMENT_HENB).NextUniform();
     if (rnd <= activityFactor) {
       double buildingCenter_X = 0;
       double buildingCenter_Y = 0;
@@ -171,7 +172,10 @@ static void TestSinrFemto(int riuso, double activityFactor) {
       double posX = x;
       double posY = y;
       double speed = 3;
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)(CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE)
+                       .NextInt(360)) *
+          ((2 * 3.14) / 360);
 
       UserEquipment* ue = new UserEquipment(
           idUE, posX, posY, speed, speedDirection,
@@ -202,7 +206,7 @@ static void TestSinrFemto(int riuso, double activityFactor) {
           ->GetPropagationLossModel()
           ->AddChannelRealization(c_ul);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       /*
       std::cout << "UE " << idUE << " position " << posX << " " << posY
@@ -50,13 +50,13 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void TestSinrMacroWithFemto(double radius, int nbBuildings,
                                    int nbUE_macro) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbCell = 19;
   double duration = 0.5;
@@ -75,7 +75,7 @@ static void TestSinrMacroWithFemto(double radius, int nbBuildings,
     CartesianCoordinates center = GetCartesianCoordinatesForCell(i, radius);
     Cell* c = new Cell(i, radius / 1000., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "CELL " << c->GetIdCell() << " position "
               << c->GetCellCenterPosition()->GetCoordinateX() << " "
@@ -90,7 +90,7 @@ static void TestSinrMacroWithFemto(double radius, int nbBuildings,
     enb->GetPhy()->SetUlChannel(ch_ul);
     enb->SetDLScheduler(ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR);
     enb->GetPhy()->SetBandwidthManager(new BandwidthManager(5, 5, 0, 0));
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
 
     std::cout
         << "eNB " << enb->GetIDNetworkNode() << " cell "
@@ -163,12 +163,13 @@ static void TestSinrMacroWithFemto(double radius, int nbBuildings,
   // for (int j = 0; j < nbCell; j++)
   //  {
   for (int i = 0; i < nbUE_macro; i++) {
-    double posX = (double)rand() / RAND_MAX;
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform(1.);
     posX = 0.90 * (((2 * radius) * posX) - radius);
-    double posY = (double)rand() / RAND_MAX;
+    double posY = rng.NextUniform(1.);
     posY = 0.90 * (((2 * radius) * posY) - radius);
     double speed = 3;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment* ue =
         new UserEquipment(idUE, posX, posY, speed, speedDirection,
@@ -206,7 +207,7 @@ static void TestSinrMacroWithFemto(double radius, int nbBuildings,
         ->GetPropagationLossModel()
         ->AddChannelRealization(c_ul);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     std::cout << "UE " << idUE << " position " << posX << " " << posY
               << " cell " << ue->GetCell()->GetIdCell() << " enb "
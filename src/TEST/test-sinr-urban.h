@@ -50,12 +50,12 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void TestSinrUrban(int streets, int henb, int reuse) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbCell = 1;
   int radius = 1000;  // metres
@@ -74,7 +74,7 @@ static void TestSinrUrban(int streets, int henb, int reuse) {
     CartesianCoordinates center = GetCartesianCoordinatesForCell(i, radius);
     Cell* c = new Cell(i, radius / 1000., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "CELL " << c->GetIdCell() << " position "
               << c->GetCellCenterPosition()->GetCoordinateX() << " "
@@ -94,7 +94,7 @@ static void TestSinrUrban(int streets, int henb, int reuse) {
     } else {
       enb->GetPhy()->SetBandwidthManager(new BandwidthManager(15, 15, 0, 0));
     }
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
 
     std::cout
         << "eNB " << enb->GetIDNetworkNode() << " cell "
@@ -223,12 +223,13 @@ static void TestSinrUrban(int streets, int henb, int reuse) {
   //	    {
 
   for (int i = 0; i < 500; i++) {
-    double posX = (double)rand() / RAND_MAX;
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform(1.);
     posX = 0.90 * (((2 * radius) * posX) - radius);
-    double posY = (double)rand() / RAND_MAX;
+    double posY = rng.NextUniform(1.);
     posY = 0.90 * (((2 * radius) * posY) - radius);
     double speed = 3;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment* ue = new UserEquipment(
         idUE, posX, posY, speed, speedDirection, nm->GetCellContainer()->at(0),
@@ -257,7 +258,7 @@ static void TestSinrUrban(int streets, int henb, int reuse) {
         ->GetPropagationLossModel()
         ->AddChannelRealization(c_ul);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     std::cout << "UE " << idUE << " position " << posX << " " << posY
               << " cell " << ue->GetCell()->GetIdCell() << " target "
@@ -49,13 +49,13 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void TestThroughputBuilding(int riuso, double activityFactor,
                                    int nbUE_femto) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbBuildings = 1;
   double duration = 31;
@@ -101,7 +101,8 @@ static void TestThroughputBuilding(int riuso, double activityFactor,
 
     // create HeNB
     for (int j = 0; j < femtoCellsInBuilding; j++) {
-      double rnd = (double)rand() / RAND_MAX;
+      double rnd = CounterRng::Stream(idFemto + j, RNG_PURPOSE_PLACEMENT_HENB)
+                       .NextUniform();
       if (rnd <= activityFactor) {
         HeNodeB* enb = new HeNodeB(
             idFemto + j,
@@ -187,20 +188,21 @@ static void TestThroughputBuilding(int riuso, double activityFactor,
       CartesianCoordinates* henb_position =
           henb->GetMobilityModel()->GetAbsolutePosition();
 
-      double x = (double)rand() / RAND_MAX;
+      CounterRng& rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+      double x = rng.NextUniform(1.);
       x = (apartmentSide * x) + henb_position->GetCoordinateX();
-      double y = (double)rand() / RAND_MAX;
+      double y = rng.NextUniform(1.);
       y = (apartmentSide * y) + henb_position->GetCoordinateY();
 
       /*
       double r = (double) rand()/RAND_MAX; r = r * 5.;
-      double angle = (double)(rand() %360) * ((2*3.14)/360);
+      double angle = (double)(GetRandomInt(360)) * ((2*3.14)/360);
       double x = (r * cos (angle) + henb_position->GetCoordinateX ());
       double y = (r * sin (angle) + henb_position->GetCoordinateY ());
           */
 
       double speed = 3;
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
       UserEquipment* ue =
           new UserEquipment(idUE, x, y, speed, speedDirection, henb->GetCell(),
@@ -230,7 +232,7 @@ static void TestThroughputBuilding(int riuso, double activityFactor,
           ->GetPropagationLossModel()
           ->AddChannelRealization(c_ul);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       std::cout << "UE " << idUE << " position " << x << " " << y << " cell "
                 << ue->GetCell()->GetIdCell() << " henb "
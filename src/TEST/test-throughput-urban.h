@@ -50,13 +50,13 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/UsersDistribution.h"
 #include "../utility/seed.h"
 
 static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
                                 double activityFactor) {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   int nbCell = 1;
   int radius = 1000;  // metres
@@ -76,7 +76,7 @@ static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
     CartesianCoordinates center = GetCartesianCoordinatesForCell(i, radius);
     Cell* c = new Cell(i, radius / 1000., 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "CELL " << c->GetIdCell() << " position "
               << c->GetCellCenterPosition()->GetCoordinateX() << " "
@@ -96,7 +96,7 @@ static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
     } else {
       enb->GetPhy()->SetBandwidthManager(new BandwidthManager(15, 15, 0, 0));
     }
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
 
     std::cout
         << "eNB " << enb->GetIDNetworkNode() << " cell "
@@ -180,9 +180,10 @@ static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
       // CREATE HENB
       std::vector<Femtocell*>* femtocells = nm->GetFemtoCellContainer();
       for (int i = 0; i < femtocells->size(); i++) {
-        double rnd = (double)rand() / RAND_MAX;
+        int id = femtocells->at(i)->GetIdCell();
+        double rnd =
+            CounterRng::Stream(id, RNG_PURPOSE_PLACEMENT_HENB).NextUniform();
         if (rnd <= activityFactor) {
-          int id = femtocells->at(i)->GetIdCell();
           HeNodeB* enb = new HeNodeB(id, femtocells->at(i));
 
           LteChannel* ch_dl = new LteChannel();
@@ -228,12 +229,13 @@ static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
   double startTime = 0.1;
 
   for (int i = 0; i < nbUE; i++) {
-    double posX = (double)rand() / RAND_MAX;
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform(1.);
     posX = 0.90 * (((2 * radius) * posX) - radius);
-    double posY = (double)rand() / RAND_MAX;
+    double posY = rng.NextUniform(1.);
     posY = 0.90 * (((2 * radius) * posY) - radius);
     double speed = 3;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment* ue = new UserEquipment(
         idUE, posX, posY, speed, speedDirection, nm->GetCellContainer()->at(0),
@@ -262,7 +264,7 @@ static void TestThroughputUrban(int streets, int henb, int reuse, int nbUE,
         ->GetPropagationLossModel()
         ->AddChannelRealization(c_ul);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     std::cout << "UE " << idUE << " position " << posX << " " << posY
               << " cell " << ue->GetCell()->GetIdCell() << " target "
@@ -0,0 +1,125 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../core/eventScheduler/simulator.h"
+
+/*
+ * The periodic tasks of the timing wheel must run at the TTIs a calendar
+ * chain rescheduling itself would have run them, on both levels of the wheel
+ * and beyond, stop once cancelled, and run in the order they were scheduled
+ * when due in the same TTI.
+ */
+
+#define WHEEL_TEST_END 45.0
+
+class TimingWheelProbe {
+ public:
+  TimingWheelProbe(int period, int maxRuns)
+      : m_period(period), m_maxRuns(maxRuns), m_runs(0), m_late(0), m_task(-1) {}
+
+  void Start(void) {
+    m_start = Simulator::Init()->Now();
+    m_task = Simulator::Init()->SchedulePeriodic(m_period, &TimingWheelProbe::Run, this);
+  }
+
+  void Run(void) {
+    double now = Simulator::Init()->Now();
+    m_runs++;
+    if (fabs(now - (m_start + m_runs * m_period * 0.001)) > 0.0001) m_late++;
+    s_runs.push_back(std::make_pair((long)llround(now * 1000), m_task));
+    if (m_runs == m_maxRuns) Simulator::Init()->CancelPeriodic(m_task);
+  }
+
+  int m_period;
+  int m_maxRuns;  // 0: never cancelled
+  int m_runs;
+  int m_late;
+  int m_task;
+  double m_start;
+
+  // TTI and task of every run
+  static std::vector<std::pair<long, int> > s_runs;
+};
+
+std::vector<std::pair<long, int> > TimingWheelProbe::s_runs;
+
+static int WheelTestCheck(const char* what, int probe, bool ok) {
+  if (ok) return 0;
+  std::cout << "FAIL " << what << " (probe " << probe << ")" << std::endl;
+  return 1;
+}
+
+static void TestTimingWheel() {
+  Simulator* sim = Simulator::Init();
+  // period, runs before cancelling, start
+  struct {
+    int period;
+    int maxRuns;
+    double start;
+  } setups[] = {
+      {1, 0, 0},         {3, 0, 0},          {1, 50, 0},
+      {300, 0, 0.002},   {7, 0, 0.005},      {20000, 0, 0.001},
+      {256, 0, 0.010},   {16384, 0, 0.003},  {1, 0, 0.005},
+  };
+  int nbProbes = sizeof(setups) / sizeof(setups[0]);
+
+  std::vector<TimingWheelProbe*> probes;
+  for (int i = 0; i < nbProbes; i++) {
+    TimingWheelProbe* probe = new TimingWheelProbe(setups[i].period, setups[i].maxRuns);
+    probes.push_back(probe);
+    sim->Schedule(setups[i].start, &TimingWheelProbe::Start, probe);
+  }
+  sim->SetStop(WHEEL_TEST_END + 0.0005);
+  sim->Run();
+
+  int failures = 0;
+  for (int i = 0; i < nbProbes; i++) {
+    TimingWheelProbe* probe = probes[i];
+    int expected = probe->m_maxRuns > 0
+                       ? probe->m_maxRuns
+                       : (int)floor((WHEEL_TEST_END - setups[i].start) * 1000 /
+                                    probe->m_period + 1e-6);
+    std::cout << "probe " << i << ": period " << probe->m_period << ", "
+              << probe->m_runs << " runs" << std::endl;
+    failures += WheelTestCheck("runs", i, probe->m_runs == expected);
+    failures += WheelTestCheck("on time", i, probe->m_late == 0);
+  }
+  const std::vector<std::pair<long, int> >& runs = TimingWheelProbe::s_runs;
+  for (size_t r = 1; r < runs.size(); r++) {
+    failures += WheelTestCheck("order", runs[r].second,
+                               runs[r - 1].first < runs[r].first ||
+                                   (runs[r - 1].first == runs[r].first &&
+                                    runs[r - 1].second < runs[r].second));
+  }
+
+  if (failures > 0) {
+    std::cout << "Timing wheel: " << failures << " failures" << std::endl;
+    exit(1);
+  }
+  std::cout << "Timing wheel: OK" << std::endl;
+}
@@ -39,7 +39,7 @@
 #include "../protocolStack/packet/packet-burst.h"
 
 static void TestUplinkChannelQuality() {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   // CREATE COMPONENT MANAGERS
   Simulator *simulator = Simulator::Init();
@@ -61,7 +61,7 @@ static void TestUplinkChannelQuality() {
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    networkManager->GetCellContainer()->push_back(c);
+    networkManager->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -104,7 +104,7 @@ static void TestUplinkChannelQuality() {
         << enb->GetPhy()->GetUlChannel()->GetChannelId() << std::endl;
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
-    networkManager->GetENodeBContainer()->push_back(enb);
+    networkManager->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -126,7 +126,7 @@ static void TestUplinkChannelQuality() {
                                           0,  // handover false!
                                           Mobility::RANDOM_DIRECTION);
 
-    networkManager->GetUserEquipmentContainer()->push_back(ue);
+    networkManager->AddUserEquipment(ue);
     ue->SetTargetNode(enb);
     enb->RegisterUserEquipment(ue);
 
@@ -37,9 +37,10 @@
 #include "../protocolStack/mac/packet-scheduler/mt-uplink-packet-scheduler.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
+#include "../utility/counter-rng.h"
 
 static void TestUplinkFME() {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   // CREATE COMPONENT MANAGERS
   Simulator *simulator = Simulator::Init();
@@ -60,7 +61,7 @@ static void TestUplinkFME() {
   enb->GetPhy()->SetBandwidthManager(spectrum->Copy());
   enb->SetULScheduler(ENodeB::ULScheduler_TYPE_FME);
   enb->SetDLScheduler(ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR);
-  networkManager->GetENodeBContainer()->push_back(enb);
+  networkManager->AddENodeB(enb);
   ulCh->AddDevice(enb);
 
   int nbUEs = 4;
@@ -76,9 +77,10 @@ static void TestUplinkFME() {
   for (int i = 0; i < nbUEs; i++) {
     // ue's random position
     int maxXY = cell->GetRadius() * 1000;
-    double posX = (double)(rand() % 1000);  // 200;
-    double posY = (double)(rand() % 1000);  // 200;
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    CounterRng& rng = CounterRng::Stream(idUe, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = (double)(rng.NextInt(1000));  // 200;
+    double posY = (double)(rng.NextInt(1000));  // 200;
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
     double speed = 30;
 
     printf("Creating UE %d at (%lf,%lf)\n", idUe, posX, posY);
@@ -37,9 +37,10 @@
 #include "../protocolStack/mac/packet-scheduler/mt-uplink-packet-scheduler.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
+#include "../utility/counter-rng.h"
 
 static void TestUplinkMaximumThroughput() {
-  srand(time(NULL));
+  CounterRng::SetGlobalSeed(time(NULL));
 
   // CREATE COMPONENT MANAGERS
   Simulator* simulator = Simulator::Init();
@@ -60,7 +61,7 @@ static void TestUplinkMaximumThroughput() {
   enb->GetPhy()->SetBandwidthManager(spectrum->Copy());
   enb->SetULScheduler(ENodeB::ULScheduler_TYPE_MAXIMUM_THROUGHPUT);
   enb->SetDLScheduler(ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR);
-  networkManager->GetENodeBContainer()->push_back(enb);
+  networkManager->AddENodeB(enb);
   ulCh->AddDevice(enb);
 
   int nbUEs = 4;
@@ -70,9 +71,10 @@ static void TestUplinkMaximumThroughput() {
   int dstPort = 100;
 
   for (int i = 0; i < nbUEs; i++) {
-    double posX = (double)(rand() % 1000);
-    double posY = (double)(rand() % 1000);
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    CounterRng& rng = CounterRng::Stream(idUe, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = (double)(rng.NextInt(1000));
+    double posY = (double)(rng.NextInt(1000));
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
     double speed = 30;
 
     UserEquipment* ue = new UserEquipment(idUe, posX, posY, speed,
@@ -80,7 +82,7 @@ static void TestUplinkMaximumThroughput() {
                                           0,  // handover false!
                                           Mobility::RANDOM_DIRECTION);
 
-    networkManager->GetUserEquipmentContainer()->push_back(ue);
+    networkManager->AddUserEquipment(ue);
     ue->SetTargetNode(enb);
     enb->RegisterUserEquipment(ue);
 
@@ -114,8 +116,8 @@ static void TestUplinkMaximumThroughput() {
 
     ue->GetPhy()->GetDlChannel()->AddDevice(ue);
 
-    double startTime = (double)(rand() % 1);  // s
-    double stopTime = (double)(rand() % 2);   // s
+    double startTime = (double)(rng.NextInt(1));  // s
+    double stopTime = (double)(rng.NextInt(2));   // s
     QoSParameters* qos = new QoSParameters();
     Application* be = flowsManager->CreateApplication(
         applicationID, ue, enb, srcPort, dstPort,
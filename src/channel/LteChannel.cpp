@@ -28,11 +28,13 @@
 #include "../core/eventScheduler/simulator.h"
 #include "../load-parameters.h"
 #include "propagation-model/propagation-loss-model.h"
+#include "../utility/phase-profiler.h"
 
 LteChannel::LteChannel()
 {
   m_attachedDevices = new std::vector<NetworkNode*> ();
   m_propagationLossModel = new PropagationLossModel ();
+  m_traceDriven = false;
 }
 
 LteChannel::~LteChannel()
@@ -65,6 +67,7 @@ LteChannel::StartTx (PacketBurst* p, TransmittedSignal* txSignal, NetworkNode* s
 void
 LteChannel::StartRx (PacketBurst* p, TransmittedSignal* txSignal, NetworkNode* src)
 {
+  PROFILE_PHASE (PHASE_CHANNEL_RX);
 #ifdef TEST_DEVICE_ON_CHANNEL
   std::cout << "LteChannel::StartRx ch " << GetChannelId () << std::endl;
 #endif
@@ -80,7 +83,11 @@ LteChannel::StartRx (PacketBurst* p, TransmittedSignal* txSignal, NetworkNode* s
 
 	  //APPLY THE PROPAGATION LOSS MODEL
 	  TransmittedSignal* rxSignal;
-	  if (m_propagationLossModel != NULL)
+	  if (m_traceDriven)
+	    {
+		  rxSignal = NULL;
+	    }
+	  else if (m_propagationLossModel != NULL)
 	    {
 #ifdef TEST_DEVICE_ON_CHANNEL
           std::cout << "LteChannel::StartRx add propagation loss" << std::endl;
@@ -181,3 +188,15 @@ LteChannel::GetChannelId (void)
 {
   return m_channelId;
 }
+
+void
+LteChannel::SetTraceDriven (bool traceDriven)
+{
+  m_traceDriven = traceDriven;
+}
+
+bool
+LteChannel::IsTraceDriven (void) const
+{
+  return m_traceDriven;
+}
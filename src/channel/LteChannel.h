@@ -49,6 +49,14 @@ class LteChannel {
   void SetChannelId(int id);
   int GetChannelId(void);
 
+  /*
+   * A trace-driven channel delivers bursts without any propagation model:
+   * receivers get a NULL signal and take their channel quality from the
+   * SDR CQI traces instead.
+   */
+  void SetTraceDriven(bool traceDriven);
+  bool IsTraceDriven(void) const;
+
  private:
   std::vector<NetworkNode*>*
       m_attachedDevices;  // list of devices attached to the channel
@@ -56,6 +64,7 @@ class LteChannel {
   PropagationLossModel* m_propagationLossModel;
 
   int m_channelId;
+  bool m_traceDriven;
 };
 
 #endif /* LTECHANNEL_H_ */
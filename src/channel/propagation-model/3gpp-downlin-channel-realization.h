@@ -39,7 +39,7 @@ class ThreeGppDownlinChannelRealization : public ChannelRealization {
   double GetShadowing(void);
   virtual void UpdateModels(void);
 
-  virtual std::vector<double> GetLoss();
+  virtual void ComputeLoss(double* loss);
 
  private:
   double m_penetrationLoss;
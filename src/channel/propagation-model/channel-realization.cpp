@@ -24,13 +24,12 @@
 #include "../../device/UserEquipment.h"
 #include "../../device/ENodeB.h"
 #include "../../device/HeNodeB.h"
-#include "../../utility/RandomVariable.h"
 #include "shadowing-trace.h"
 #include "../../core/spectrum/bandwidth-manager.h"
 #include "../../phy/lte-phy.h"
 #include "../../core/eventScheduler/simulator.h"
 #include "../../load-parameters.h"
-#include "fast-fading-trace.h"
+#include "fast-fading-pool.h"
 
 ChannelRealization::ChannelRealization()
 {
@@ -38,7 +37,6 @@ ChannelRealization::ChannelRealization()
   m_dst = NULL;
   m_samplingPeriod = 0.5;
   m_lastUpdate = NULL;
-  m_fastFading = NULL;
 }
 
 ChannelRealization::~ChannelRealization()
@@ -49,16 +47,7 @@ ChannelRealization::~ChannelRealization()
 void
 ChannelRealization::Destroy ()
 {
-  if (m_fastFading != NULL)
-    {
-          FastFading::iterator it;
-          for (it = m_fastFading->begin (); it != m_fastFading->end (); it ++)
-                {
-                  (*it).clear();
-                }
-          m_fastFading->clear ();
-          delete m_fastFading;
-    }
+  m_fastFading.clear ();
   m_src = NULL;
   m_dst = NULL;
 }
@@ -67,6 +56,7 @@ void
 ChannelRealization::SetSourceNode (NetworkNode* src)
 {
   m_src = src;
+  KeyRandomStream ();
 }
 
 NetworkNode*
@@ -79,6 +69,7 @@ void
 ChannelRealization::SetDestinationNode (NetworkNode* dst)
 {
   m_dst = dst;
+  KeyRandomStream ();
 }
 
 NetworkNode*
@@ -87,6 +78,22 @@ ChannelRealization::GetDestinationNode (void)
   return m_dst;
 }
 
+void
+ChannelRealization::KeyRandomStream (void)
+{
+  if (m_src == NULL || m_dst == NULL)
+    return;
+  uint64_t key = ((uint64_t) m_src->GetIDNetworkNode () << 32)
+      | (uint32_t) m_dst->GetIDNetworkNode ();
+  m_rng = CounterRng (key, RNG_PURPOSE_CHANNEL);
+}
+
+CounterRng&
+ChannelRealization::GetRandomStream (void)
+{
+  return m_rng;
+}
+
 void
 ChannelRealization::SetLastUpdate (void)
 {
@@ -134,6 +141,20 @@ ChannelRealization::NeedForUpdate (void)
     }
 }
 
+std::vector<double>
+ChannelRealization::GetLoss (void)
+{
+  std::vector<double> loss (GetNbOfSubChannels ());
+  ComputeLoss (loss.data ());
+  return loss;
+}
+
+int
+ChannelRealization::GetNbOfSubChannels (void)
+{
+  return GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+}
+
 void
 ChannelRealization::SetChannelType (ChannelType t)
 {
@@ -148,29 +169,9 @@ ChannelRealization::GetChannelType (void)
 }
 
 
-ChannelRealization::FastFading*
-ChannelRealization::GetFastFading (void)
-{
-  return m_fastFading;
-}
-
-void
-ChannelRealization::SetFastFading (ChannelRealization::FastFading* ff)
-{
-  m_fastFading = ff;
-}
-
 void
 ChannelRealization::UpdateFastFading (void)
 {
-  //clear old realization
-  FastFading::iterator it;
-  for (it = m_fastFading->begin (); it != m_fastFading->end (); it ++)
-	{
-	  (*it).clear();
-	}
-  m_fastFading->clear ();
-
   int numbOfSubChannels = GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
   int samplingTime = GetSamplingPeriod () * 1000;
   double speed;
@@ -190,166 +191,37 @@ ChannelRealization::UpdateFastFading (void)
 	  speed = 0;
     }
 
+  m_fastFading.resize (numbOfSubChannels);
 
   //if (_simple_jakes_model_)
   if (GetChannelType () == ChannelRealization::CHANNEL_TYPE_JAKES)
    {
 	  // number of path = M
 	  //x = 1 -> M=6, x = 2 -> M=8, x = 3 -> M=10, x = 4 -> M=12
-	  int x = 1 + GetRandomVariable (4);
+	  int x = 1 + GetRandomStream ().NextUniform (4);
+	  if (x < 1 || x > 4)
+		{
+		  std::cout << " ERROR: Jaks's Model, incorrect M value" << std::endl;
+		  exit (1);
+		}
+	  const float* trace = FastFadingPool::GetJakesTrace (4 + 2 * x, speed);
+	  if (trace == NULL || 2000 + samplingTime > FAST_FADING_JAKES_SAMPLES)
+		{
+		  std::cout << " ERROR: no fast fading trace for speed " << speed << std::endl;
+		  exit (1);
+		}
 	  for (int i = 0; i < numbOfSubChannels; i++)
 		{
 		  //StartJakes allow us to select a window of 0.5ms into the Jakes realization lasting 3s.
-	      int startJakes = GetRandomVariable (2000);
-
-		  FastFadingForTimeDomain ff_time;
-		  if (x == 1)
-			{
-			  //SELECTED 6 MULTIPLE PATH FOR JAKES MODEL
-			  if (abs(speed) == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M6_v_0 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M6_v_3 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M6_v_30 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M6_v_120 [j + startJakes]);
-					}
-				}
-			}
-
-		  else if (x == 2)
-			{
-			  //SELECTED 8 MULTIPLE PATH FOR JAKES MODEL
-			  if (abs(speed) == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M8_v_0 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M8_v_3 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M8_v_30 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M8_v_120 [j + startJakes]);
-					}
-				}
-			}
-
-		  else if (x == 3)
-			{
-			  //SELECTED 10 MULTIPLE PATH FOR JAKES MODEL
-			  if (abs(speed) == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M10_v_0 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M10_v_3 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M10_v_30 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M10_v_120 [j + startJakes]);
-					}
-				}
-			}
-
-		  else if (x == 4)
-			{
-			  //SELECTED 12 MULTIPLE PATH FOR JAKES MODEL
-			  if (abs(speed) == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M12_v_0 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M12_v_3 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M12_v_30 [j + startJakes]);
-					}
-				}
-			  if (abs(speed) == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back(multipath_M12_v_120 [j + startJakes]);
-					}
-				}
-			}
-
-		  else
-			{
-			  std::cout << " ERROR: Jaks's Model, incorrect M value" << std::endl;
-			  exit (1);
-			}
-
-		  m_fastFading->push_back (ff_time);
+	      int startJakes = GetRandomStream ().NextUniform (2000);
+		  m_fastFading[i] = trace + startJakes;
 		}
     }
 
-
   else
     {
 	  int start_point_freq = 0;
-	  int start_point_time = GetRandomVariable (499);
+	  int start_point_time = GetRandomStream ().NextUniform (499);
 
 	#ifdef TEST_PROPAGATION_LOSS_MODEL
 	  std::cout << "UpdateFastFading, "
@@ -361,292 +233,17 @@ ChannelRealization::UpdateFastFading (void)
 			  std::endl;
 	#endif
 
-	  //CASE CHANNEL TYPE = PedA
-	  if (GetChannelType () == ChannelRealization::CHANNEL_TYPE_PED_A)
+	  const float* trace = FastFadingPool::GetZhengTrace (GetChannelType (), speed);
+	  if (trace == NULL || 499 + samplingTime > FAST_FADING_ZHENG_SAMPLES)
 		{
-		  for (int i = 0; i < numbOfSubChannels; i++)
-			{
-			  FastFadingForTimeDomain ff_time;
-			  if (speed == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_0[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_3[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_30[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_120[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 150)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_150[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 200)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_200[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 250)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_250[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 300)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_300[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 350)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedA_speed_350[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  m_fastFading->push_back (ff_time);
-			}
+		  std::cout << " ERROR: no fast fading trace for speed " << speed << std::endl;
+		  exit (1);
 		}
-
-	  //CASE CHANNEL TYPE = PedB
-	  if (GetChannelType () == ChannelRealization::CHANNEL_TYPE_PED_B)
-		{
-		  for (int i = 0; i < numbOfSubChannels; i++)
-			{
-			  FastFadingForTimeDomain ff_time;
-			  if (speed == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedB_speed_0[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedB_speed_3[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedB_speed_30[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_PedB_speed_120[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  m_fastFading->push_back (ff_time);
-			}
-		}
-
-	  //CASE CHANNEL TYPE = VehA
-	  if (GetChannelType () == ChannelRealization::CHANNEL_TYPE_VEH_A)
-		{
-		  for (int i = 0; i < numbOfSubChannels; i++)
-			{
-			  FastFadingForTimeDomain ff_time;
-			  if (speed == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_0[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_3[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_30[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_120[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 150)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_150[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 200)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_200[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 250)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_250[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 300)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_300[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 350)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehA_speed_350[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  m_fastFading->push_back (ff_time);
-			}
-		}
-
-	  //CASE CHANNEL TYPE = VehB
-	  if (GetChannelType () == ChannelRealization::CHANNEL_TYPE_VEH_B)
+	  for (int i = 0; i < numbOfSubChannels; i++)
 		{
-		  for (int i = 0; i < numbOfSubChannels; i++)
-			{
-			  FastFadingForTimeDomain ff_time;
-			  if (speed == 0)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_0[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 3)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_3[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 30)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_30[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 120)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_120[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 150)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_150[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 200)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_200[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 250)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_250[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 300)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_300[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  if (speed == 350)
-				{
-				  for (int j = 0; j < samplingTime; j++)
-					{
-					  ff_time.push_back (
-							  ff_VehB_speed_350[start_point_freq+i][start_point_time+j]);
-					}
-				}
-			  m_fastFading->push_back (ff_time);
-			}
+		  // the traces have FAST_FADING_ZHENG_RBS rows, wider bands reuse them
+		  int row = (start_point_freq + i) % FAST_FADING_ZHENG_RBS;
+		  m_fastFading[i] = trace + row * FAST_FADING_ZHENG_SAMPLES + start_point_time;
 		}
     }
 }
@@ -24,6 +24,8 @@
 
 #include <vector>
 
+#include "../../utility/counter-rng.h"
+
 class NetworkNode;
 
 class ChannelRealization {
@@ -37,6 +39,9 @@ class ChannelRealization {
   void SetDestinationNode(NetworkNode* dst);
   NetworkNode* GetDestinationNode(void);
 
+  // keyed to the (source, destination) pair once both nodes are set
+  CounterRng& GetRandomStream(void);
+
   void SetLastUpdate(void);
   double GetLastUpdate(void);
   void SetSamplingPeriod(double sp);
@@ -45,7 +50,11 @@ class ChannelRealization {
   bool NeedForUpdate(void);
   virtual void UpdateModels(void) = 0;
 
-  virtual std::vector<double> GetLoss() = 0;
+  // the loss of each sub-channel
+  std::vector<double> GetLoss();
+  // the same, written to loss, which has room for GetNbOfSubChannels ()
+  virtual void ComputeLoss(double* loss) = 0;
+  int GetNbOfSubChannels(void);
 
   enum ChannelType {
     CHANNEL_TYPE_PED_A,
@@ -58,23 +67,30 @@ class ChannelRealization {
   void SetChannelType(ChannelType t);
   ChannelType GetChannelType(void);
 
-  typedef std::vector<double> FastFadingForTimeDomain;
-  typedef std::vector<FastFadingForTimeDomain> FastFading;
-
+  /*
+   * Picks a new fast fading window for every sub-channel. The windows are
+   * views into the traces of FastFadingPool, nothing is copied.
+   */
   void UpdateFastFading(void);
-  void SetFastFading(FastFading* ff);
-  FastFading* GetFastFading(void);
+  // fast fading of a sub-channel, sample ms after the window start
+  inline double GetFastFading(int subChannel, int sample) const {
+    return m_fastFading[subChannel][sample];
+  }
 
  private:
+  void KeyRandomStream(void);
+
   NetworkNode* m_src;
   NetworkNode* m_dst;
 
+  CounterRng m_rng;
+
   double m_lastUpdate;
   double m_samplingPeriod;
 
   ChannelType m_channelType;
 
-  FastFading* m_fastFading;
+  std::vector<const float*> m_fastFading;
 };
 
 #endif /* CHANNELREALIZATION_H_ */
@@ -0,0 +1,114 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "fast-fading-pool.h"
+#include <math.h>
+// the traces are static arrays, include them in this file only
+#include "fast-fading-trace.h"
+
+const float*
+FastFadingPool::GetJakesTrace(int nbPaths, double speed)
+{
+  int v = fabs(speed);
+  if (v != fabs(speed))
+    return NULL;
+  switch (nbPaths) {
+    case 6:
+      if (v == 0) return multipath_M6_v_0;
+      if (v == 3) return multipath_M6_v_3;
+      if (v == 30) return multipath_M6_v_30;
+      if (v == 120) return multipath_M6_v_120;
+      break;
+    case 8:
+      if (v == 0) return multipath_M8_v_0;
+      if (v == 3) return multipath_M8_v_3;
+      if (v == 30) return multipath_M8_v_30;
+      if (v == 120) return multipath_M8_v_120;
+      break;
+    case 10:
+      if (v == 0) return multipath_M10_v_0;
+      if (v == 3) return multipath_M10_v_3;
+      if (v == 30) return multipath_M10_v_30;
+      if (v == 120) return multipath_M10_v_120;
+      break;
+    case 12:
+      if (v == 0) return multipath_M12_v_0;
+      if (v == 3) return multipath_M12_v_3;
+      if (v == 30) return multipath_M12_v_30;
+      if (v == 120) return multipath_M12_v_120;
+      break;
+  }
+  return NULL;
+}
+
+const float*
+FastFadingPool::GetZhengTrace(ChannelRealization::ChannelType type,
+                              double speed)
+{
+  int v = speed;
+  if (v != speed)
+    return NULL;
+  switch (type) {
+    case ChannelRealization::CHANNEL_TYPE_PED_A:
+      if (v == 0) return ff_PedA_speed_0[0];
+      if (v == 3) return ff_PedA_speed_3[0];
+      if (v == 30) return ff_PedA_speed_30[0];
+      if (v == 120) return ff_PedA_speed_120[0];
+      if (v == 150) return ff_PedA_speed_150[0];
+      if (v == 200) return ff_PedA_speed_200[0];
+      if (v == 250) return ff_PedA_speed_250[0];
+      if (v == 300) return ff_PedA_speed_300[0];
+      if (v == 350) return ff_PedA_speed_350[0];
+      break;
+    case ChannelRealization::CHANNEL_TYPE_PED_B:
+      // the faster PedB traces were never wired in
+      if (v == 0) return ff_PedB_speed_0[0];
+      if (v == 3) return ff_PedB_speed_3[0];
+      if (v == 30) return ff_PedB_speed_30[0];
+      if (v == 120) return ff_PedB_speed_120[0];
+      break;
+    case ChannelRealization::CHANNEL_TYPE_VEH_A:
+      if (v == 0) return ff_VehA_speed_0[0];
+      if (v == 3) return ff_VehA_speed_3[0];
+      if (v == 30) return ff_VehA_speed_30[0];
+      if (v == 120) return ff_VehA_speed_120[0];
+      if (v == 150) return ff_VehA_speed_150[0];
+      if (v == 200) return ff_VehA_speed_200[0];
+      if (v == 250) return ff_VehA_speed_250[0];
+      if (v == 300) return ff_VehA_speed_300[0];
+      if (v == 350) return ff_VehA_speed_350[0];
+      break;
+    case ChannelRealization::CHANNEL_TYPE_VEH_B:
+      if (v == 0) return ff_VehB_speed_0[0];
+      if (v == 3) return ff_VehB_speed_3[0];
+      if (v == 30) return ff_VehB_speed_30[0];
+      if (v == 120) return ff_VehB_speed_120[0];
+      if (v == 150) return ff_VehB_speed_150[0];
+      if (v == 200) return ff_VehB_speed_200[0];
+      if (v == 250) return ff_VehB_speed_250[0];
+      if (v == 300) return ff_VehB_speed_300[0];
+      if (v == 350) return ff_VehB_speed_350[0];
+      break;
+    default:
+      break;
+  }
+  return NULL;
+}
@@ -0,0 +1,53 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef FAST_FADING_POOL_H_
+#define FAST_FADING_POOL_H_
+
+#include "channel-realization.h"
+
+#define FAST_FADING_JAKES_SAMPLES 3000
+#define FAST_FADING_ZHENG_RBS 100
+#define FAST_FADING_ZHENG_SAMPLES 1000
+
+/*
+ * The fast fading traces shared by every channel realization. There is a
+ * single copy of each (profile, speed) trace in the process; a realization
+ * only keeps pointers into it, so the memory used for fast fading does not
+ * grow with the number of UEs.
+ */
+class FastFadingPool {
+ public:
+  /*
+   * Jakes trace with nbPaths multiple paths (6, 8, 10 or 12),
+   * FAST_FADING_JAKES_SAMPLES samples long. NULL if there is none for speed.
+   */
+  static const float* GetJakesTrace(int nbPaths, double speed);
+
+  /*
+   * Zheng trace of the given channel type, FAST_FADING_ZHENG_RBS rows of
+   * FAST_FADING_ZHENG_SAMPLES samples. NULL if there is none for speed.
+   */
+  static const float* GetZhengTrace(ChannelRealization::ChannelType type,
+                                    double speed);
+};
+
+#endif /* FAST_FADING_POOL_H_ */
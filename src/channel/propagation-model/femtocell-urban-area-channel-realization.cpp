@@ -24,7 +24,6 @@
 #include "../../device/UserEquipment.h"
 #include "../../device/ENodeB.h"
 #include "../../device/HeNodeB.h"
-#include "../../utility/RandomVariable.h"
 #include "shadowing-trace.h"
 #include "../../core/spectrum/bandwidth-manager.h"
 #include "../../phy/lte-phy.h"
@@ -39,7 +38,6 @@ FemtoCellUrbanAreaChannelRealization::FemtoCellUrbanAreaChannelRealization (Netw
   m_penetrationLoss = 0;
   m_shadowing = 0;
   m_pathLoss = 0;
-  SetFastFading (new FastFading ());
 
   SetSourceNode (src);
   SetDestinationNode (dst);
@@ -164,7 +162,7 @@ FemtoCellUrbanAreaChannelRealization::UpdateModels ()
 
   //update shadowing
   m_shadowing = 0;
-  double probability = GetRandomVariable (101) / 100.0;
+  double probability = GetRandomStream ().NextUniform (101) / 100.0;
   for (int i = 0; i < 201; i++)
     {
 	  if (probability <= shadowing_probability[i])
@@ -180,8 +178,8 @@ FemtoCellUrbanAreaChannelRealization::UpdateModels ()
 }
 
 
-std::vector<double>
-FemtoCellUrbanAreaChannelRealization::GetLoss ()
+void
+FemtoCellUrbanAreaChannelRealization::ComputeLoss (double* loss)
 {
 #ifdef TEST_PROPAGATION_LOSS_MODEL
   std::cout << "\t  --> compute loss between "
@@ -194,32 +192,31 @@ FemtoCellUrbanAreaChannelRealization::GetLoss ()
 	   UpdateModels ();
     }
 
-  std::vector<double> loss;
 
 
   int now_ms = Simulator::Init()->Now () * 1000;
   int lastUpdate_ms = GetLastUpdate () * 1000;
   int index = now_ms - lastUpdate_ms;
 
-  int nbOfSubChannels = GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+  int nbOfSubChannels = GetNbOfSubChannels ();
+  // the same for every sub-channel
+  double pathLoss = GetPathLoss ();
 
   for (int i = 0; i < nbOfSubChannels; i++)
     {
-	  //ATTENZIONE double l = GetFastFading ()->at (i).at (index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
-	  double l = - GetPathLoss ();
-	  loss.push_back (l);
+	  //ATTENZIONE double l = GetFastFading (i, index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
+	  double l = - pathLoss;
+	  loss[i] = l;
 
 #ifdef TEST_PROPAGATION_LOSS_MODEL
-       std::cout << "\t\t mlp = " << GetFastFading ()->at (i).at (index)
-		  << " pl = " << GetPathLoss ()
+       std::cout << "\t\t mlp = " << GetFastFading (i, index)
+		  << " pl = " << pathLoss
           << " pnl = " << GetPenetrationLoss()
           << " sh = " << GetShadowing()
           << " LOSS = " << l
 		  << std::endl;
 #endif
     }
-
-  return loss;
 }
 
 
@@ -24,7 +24,6 @@
 #include "../../device/UserEquipment.h"
 #include "../../device/ENodeB.h"
 #include "../../device/HeNodeB.h"
-#include "../../utility/RandomVariable.h"
 #include "shadowing-trace.h"
 #include "../../core/spectrum/bandwidth-manager.h"
 #include "../../phy/lte-phy.h"
@@ -39,7 +38,6 @@ MacroCellSubUrbanAreaChannelRealization::MacroCellSubUrbanAreaChannelRealization
   m_penetrationLoss = 10;
   m_shadowing = 0;
   m_pathLoss = 0;
-  SetFastFading (new FastFading ());
 
   SetSourceNode (src);
   SetDestinationNode (dst);
@@ -140,7 +138,7 @@ MacroCellSubUrbanAreaChannelRealization::UpdateModels ()
 
   //update shadowing
   m_shadowing = 0;
-  double probability = GetRandomVariable (101) / 100.0;
+  double probability = GetRandomStream ().NextUniform (101) / 100.0;
   for (int i = 0; i < 201; i++)
     {
 	  if (probability <= shadowing_probability[i])
@@ -156,8 +154,8 @@ MacroCellSubUrbanAreaChannelRealization::UpdateModels ()
 }
 
 
-std::vector<double>
-MacroCellSubUrbanAreaChannelRealization::GetLoss ()
+void
+MacroCellSubUrbanAreaChannelRealization::ComputeLoss (double* loss)
 {
 #ifdef TEST_PROPAGATION_LOSS_MODEL
   std::cout << "\t  --> compute loss between "
@@ -170,29 +168,30 @@ MacroCellSubUrbanAreaChannelRealization::GetLoss ()
 	   UpdateModels ();
     }
 
-  std::vector<double> loss;
 
 
   int now_ms = Simulator::Init()->Now () * 1000;
   int lastUpdate_ms = GetLastUpdate () * 1000;
   int index = now_ms - lastUpdate_ms;
 
-  int nbOfSubChannels = GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+  int nbOfSubChannels = GetNbOfSubChannels ();
+  // the same for every sub-channel
+  double pathLoss = GetPathLoss ();
+  double penetrationLoss = GetPenetrationLoss ();
+  double shadowing = GetShadowing ();
 
   for (int i = 0; i < nbOfSubChannels; i++)
     {
-	  double l = GetFastFading ()->at (i).at (index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
-	  loss.push_back (l);
+	  double l = GetFastFading (i, index) - pathLoss - penetrationLoss - shadowing;
+	  loss[i] = l;
 
 #ifdef TEST_PROPAGATION_LOSS_MODEL
-       std::cout << "\t\t mlp = " << GetFastFading ()->at (i).at (index)
-		  << " pl = " << GetPathLoss ()
-          << " pnl = " << GetPenetrationLoss()
-          << " sh = " << GetShadowing()
+       std::cout << "\t\t mlp = " << GetFastFading (i, index)
+		  << " pl = " << pathLoss
+          << " pnl = " << penetrationLoss
+          << " sh = " << shadowing
           << " LOSS = " << l
 		  << std::endl;
 #endif
     }
-
-  return loss;
 }
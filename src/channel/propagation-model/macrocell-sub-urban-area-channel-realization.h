@@ -38,7 +38,7 @@ class MacroCellSubUrbanAreaChannelRealization : public ChannelRealization {
   double GetShadowing(void);
   virtual void UpdateModels(void);
 
-  virtual std::vector<double> GetLoss();
+  virtual void ComputeLoss(double* loss);
 
  private:
   double m_penetrationLoss;
@@ -24,7 +24,6 @@
 #include "../../device/UserEquipment.h"
 #include "../../device/ENodeB.h"
 #include "../../device/HeNodeB.h"
-#include "../../utility/RandomVariable.h"
 #include "shadowing-trace.h"
 #include "../../core/spectrum/bandwidth-manager.h"
 #include "../../phy/lte-phy.h"
@@ -38,7 +37,6 @@ MacroCellUrbanAreaChannelRealization::MacroCellUrbanAreaChannelRealization(Netwo
   m_penetrationLoss = 10;
   m_shadowing = 0;
   m_pathLoss = 0;
-  SetFastFading (new FastFading ());
 
   SetSourceNode (src);
   SetDestinationNode (dst);
@@ -164,7 +162,7 @@ MacroCellUrbanAreaChannelRealization::UpdateModels ()
 
   //update shadowing
   m_shadowing = 0;
-  double probability = GetRandomVariable (101) / 100.0;
+  double probability = GetRandomStream ().NextUniform (101) / 100.0;
   for (int i = 0; i < 201; i++)
     {
 	  if (probability <= shadowing_probability[i])
@@ -184,8 +182,8 @@ MacroCellUrbanAreaChannelRealization::UpdateModels ()
 }
 
 
-std::vector<double>
-MacroCellUrbanAreaChannelRealization::GetLoss ()
+void
+MacroCellUrbanAreaChannelRealization::ComputeLoss (double* loss)
 {
 #ifdef TEST_PROPAGATION_LOSS_MODEL
   std::cout << "\t  --> compute loss between "
@@ -198,7 +196,6 @@ MacroCellUrbanAreaChannelRealization::GetLoss ()
 	//    UpdateModels ();
   //   }
 
-  std::vector<double> loss;
 
 
   int now_ms = Simulator::Init()->Now () * 1000;
@@ -206,35 +203,37 @@ MacroCellUrbanAreaChannelRealization::GetLoss ()
   //int index = now_ms - lastUpdate_ms;
   int index = now_ms % (int)(GetSamplingPeriod() * 1000); // sample period is 500ms here
 
-  int nbOfSubChannels = GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+  int nbOfSubChannels = GetNbOfSubChannels ();
+  // the same for every sub-channel
+  double pathLoss = GetPathLoss ();
+  double penetrationLoss = GetPenetrationLoss ();
+  double shadowing = GetShadowing ();
 
   for (int i = 0; i < nbOfSubChannels; i++)
     {
-	  double l = GetFastFading ()->at (i).at (index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
+	  double l = GetFastFading (i, index) - pathLoss - penetrationLoss - shadowing;
 
     #ifdef FIRST_SYNTHETIC_EXP
-    l = - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
+    l = - pathLoss - penetrationLoss - shadowing;
     #endif
 
     #ifdef SECOND_SYNTHETIC_EXP
-    l = - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
+    l = - pathLoss - penetrationLoss - shadowing;
     if (i < nbOfSubChannels / 2)
       l -= 10;
     else
       l += 10;
     #endif
       
-    loss.push_back (l);
+    loss[i] = l;
 
 #ifdef TEST_PROPAGATION_LOSS_MODEL
-       std::cout << "\t\t mlp = " << GetFastFading ()->at (i).at (index)
-		  << " pl = " << GetPathLoss ()
-          << " pnl = " << GetPenetrationLoss()
-          << " sh = " << GetShadowing()
+       std::cout << "\t\t mlp = " << GetFastFading (i, index)
+		  << " pl = " << pathLoss
+          << " pnl = " << penetrationLoss
+          << " sh = " << shadowing
           << " LOSS = " << l
 		  << std::endl;
 #endif
     }
-
-  return loss;
 }
@@ -24,7 +24,6 @@
 #include "../../device/UserEquipment.h"
 #include "../../device/ENodeB.h"
 #include "../../device/HeNodeB.h"
-#include "../../utility/RandomVariable.h"
 #include "../../utility/IndoorScenarios.h"
 #include "shadowing-trace.h"
 #include "../../core/spectrum/bandwidth-manager.h"
@@ -41,7 +40,6 @@ WinnerDownlinkChannelRealization::WinnerDownlinkChannelRealization (NetworkNode*
   m_penetrationLoss = 0;
   m_shadowing = 0;
   m_pathLoss = 0;
-  SetFastFading (new FastFading ());
 
   SetSourceNode (src);
   SetDestinationNode (dst);
@@ -171,7 +169,7 @@ WinnerDownlinkChannelRealization::UpdateModels ()
 
   //update shadowing
   m_shadowing = 0;
-  double probability = GetRandomVariable (101) / 100.0;
+  double probability = GetRandomStream ().NextUniform (101) / 100.0;
   for (int i = 0; i < 201; i++)
     {
 	  if (probability <= shadowing_probability[i])
@@ -187,8 +185,8 @@ WinnerDownlinkChannelRealization::UpdateModels ()
 }
 
 
-std::vector<double>
-WinnerDownlinkChannelRealization::GetLoss ()
+void
+WinnerDownlinkChannelRealization::ComputeLoss (double* loss)
 {
 #ifdef TEST_PROPAGATION_LOSS_MODEL
   std::cout << "\t  --> compute loss between "
@@ -201,31 +199,30 @@ WinnerDownlinkChannelRealization::GetLoss ()
 	   UpdateModels ();
     }
 
-  std::vector<double> loss;
 
 
   int now_ms = Simulator::Init()->Now () * 1000;
   int lastUpdate_ms = GetLastUpdate () * 1000;
   int index = now_ms - lastUpdate_ms;
 
-  int nbOfSubChannels = GetSourceNode ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+  int nbOfSubChannels = GetNbOfSubChannels ();
+  // the same for every sub-channel
+  double pathLoss = GetPathLoss ();
 
   for (int i = 0; i < nbOfSubChannels; i++)
     {
-	  //ATTENZIONE double l = GetFastFading ()->at (i).at (index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
-	  double l = - GetPathLoss ();
+	  //ATTENZIONE double l = GetFastFading (i, index) - GetPathLoss () - GetPenetrationLoss () - GetShadowing ();
+	  double l = - pathLoss;
 
-	  loss.push_back (l);
+	  loss[i] = l;
 
 #ifdef TEST_PROPAGATION_LOSS_MODEL
-       std::cout << "\t\t mlp = " << GetFastFading ()->at (i).at (index)
-		  << " pl = " << GetPathLoss ()
+       std::cout << "\t\t mlp = " << GetFastFading (i, index)
+		  << " pl = " << pathLoss
           << " pnl = " << GetPenetrationLoss()
           << " sh = " << GetShadowing()
           << " LOSS = " << l
 		  << std::endl;
 #endif
     }
-
-  return loss;
 }
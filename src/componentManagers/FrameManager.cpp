@@ -25,6 +25,11 @@
 #include "../load-parameters.h"
 #include "../device/ENodeB.h"
 #include "../device/HeNodeB.h"
+#include "../protocolStack/mac/packet-scheduler/packet-scheduler.h"
+#include "../utility/output-capture.h"
+#include "TtiExecutor.h"
+#include "RealTimeManager.h"
+#include "../utility/phase-profiler.h"
 
 FrameManager* FrameManager::ptr=NULL;
 
@@ -157,6 +162,14 @@ FrameManager::StopFrame (void)
 void
 FrameManager::StartSubframe (void)
 {
+  // in real time, waits for the slot of the TTI about to start
+  RealTimeManager *realTime = RealTimeManager::Init ();
+  if (realTime->IsEnabled ())
+    {
+      realTime->StartTti (GetTTICounter () + 1);
+    }
+
+  PROFILE_TTI_BOUNDARY ();
 #ifdef FRAME_MANAGER_DEBUG
   std::cout << " --------- Start SubFrame, time =  "
       << Simulator::Init()->Now() << " --------- " << std::endl;
@@ -223,6 +236,9 @@ FrameManager::UpdateUserPosition(void)
 void
 FrameManager::ResourceAllocation(void)
 {
+  PROFILE_PHASE (PHASE_FRAME_ALLOCATION);
+  m_ttiNodes.clear ();
+
   std::vector<ENodeB*> *records = GetNetworkManager ()->GetENodeBContainer ();
   std::vector<ENodeB*>::iterator iter;
   ENodeB *record;
@@ -239,7 +255,7 @@ FrameManager::ResourceAllocation(void)
 	  if (GetFrameStructure () == FrameManager::FRAME_STRUCTURE_FDD)
 		{
 		  //record->ResourceBlocksAllocation ();
-		  Simulator::Init()->Schedule(0.0, &ENodeB::ResourceBlocksAllocation,record);
+		  ScheduleAllocation (record, true, true);
 		}
 	  else
 		{
@@ -251,7 +267,7 @@ FrameManager::ResourceAllocation(void)
 				  "	SUBFRAME_FOR_DOWNLINK " << std::endl;
 #endif
 			  //record->DownlinkResourceBlokAllocation();
-			  Simulator::Init()->Schedule(0.0, &ENodeB::DownlinkResourceBlokAllocation,record);
+			  ScheduleAllocation (record, true, false);
 			}
 		  else if(GetSubFrameType (GetNbSubframes ()) == 1)
 			{
@@ -260,7 +276,7 @@ FrameManager::ResourceAllocation(void)
 				  "	SUBFRAME_FOR_UPLINK " << std::endl;
 #endif
 			  //record->UplinkResourceBlockAllocation();
-			  Simulator::Init()->Schedule(0.0, &ENodeB::UplinkResourceBlockAllocation,record);
+			  ScheduleAllocation (record, false, true);
 			}
 		  else
 			{
@@ -288,7 +304,7 @@ FrameManager::ResourceAllocation(void)
   	  if (GetFrameStructure () == FrameManager::FRAME_STRUCTURE_FDD)
   		{
   		  //record_2->ResourceBlocksAllocation ();
-  		  Simulator::Init()->Schedule(0.0, &ENodeB::ResourceBlocksAllocation,record_2);
+  		  ScheduleAllocation (record_2, true, true);
   		}
   	  else
   		{
@@ -300,7 +316,7 @@ FrameManager::ResourceAllocation(void)
   				  "	SUBFRAME_FOR_DOWNLINK " << std::endl;
   #endif
   			  //record_2->DownlinkResourceBlokAllocation();
-  			  Simulator::Init()->Schedule(0.0, &ENodeB::DownlinkResourceBlokAllocation,record_2);
+  			  ScheduleAllocation (record_2, true, false);
   			}
   		  else if(GetSubFrameType (GetNbSubframes ()) == 1)
   			{
@@ -309,7 +325,7 @@ FrameManager::ResourceAllocation(void)
   				  "	SUBFRAME_FOR_UPLINK " << std::endl;
   #endif
   			  //record_2->UplinkResourceBlockAllocation();
-  			  Simulator::Init()->Schedule(0.0, &ENodeB::UplinkResourceBlockAllocation,record_2);
+  			  ScheduleAllocation (record_2, false, true);
   			}
   		  else
   			{
@@ -320,4 +336,97 @@ FrameManager::ResourceAllocation(void)
   			}
   		}
   	}
+
+  if (!m_ttiNodes.empty ())
+    {
+      Simulator::Init()->Schedule(0.0, &FrameManager::ParallelResourceAllocation, this);
+    }
+}
+
+void
+FrameManager::ScheduleAllocation (ENodeB *node, bool downlink, bool uplink)
+{
+  if (TtiExecutor::Init ()->IsParallel ())
+    {
+      TtiNode n;
+      n.m_node = node;
+      n.m_downlink = downlink;
+      n.m_uplink = uplink;
+      n.m_phased = false;
+      m_ttiNodes.push_back (std::move (n));
+    }
+  else if (downlink && uplink)
+    {
+      Simulator::Init()->Schedule(0.0, &ENodeB::ResourceBlocksAllocation, node);
+    }
+  else if (downlink)
+    {
+      Simulator::Init()->Schedule(0.0, &ENodeB::DownlinkResourceBlokAllocation, node);
+    }
+  else
+    {
+      Simulator::Init()->Schedule(0.0, &ENodeB::UplinkResourceBlockAllocation, node);
+    }
+}
+
+/*
+ * Does the work of the per-node allocation events, in three phases. The
+ * first two (flow selection, then RB allocation) run the downlink schedulers
+ * of all the cells concurrently; what they print is captured per cell. The
+ * third one replays that output and transmits, node by node in the order of
+ * the events it replaces, together with the schedulers that are not split in
+ * phases and the uplink ones. A run thus prints and draws the same as the
+ * sequential one.
+ */
+void
+FrameManager::ParallelResourceAllocation (void)
+{
+  PROFILE_PHASE (PHASE_FRAME_ALLOCATION);
+  for (size_t i = 0; i < m_ttiNodes.size (); i++)
+    {
+      TtiNode &n = m_ttiNodes.at (i);
+      PacketScheduler *scheduler = n.m_node->GetDLScheduler ();
+      n.m_phased = n.m_downlink && scheduler != NULL
+          && n.m_node->GetNbOfUserEquipmentRecords () > 0
+          && scheduler->SupportsPhases ();
+      OutputCapture::Reset (&n.m_out, OutputCapture::STDOUT);
+      OutputCapture::Reset (&n.m_err, OutputCapture::STDERR);
+    }
+
+  RunSchedulingPhase (&PacketScheduler::PrepareSchedule);
+  RunSchedulingPhase (&PacketScheduler::AllocateResources);
+
+  for (size_t i = 0; i < m_ttiNodes.size (); i++)
+    {
+      TtiNode &n = m_ttiNodes.at (i);
+      std::cout << n.m_out.str ();
+      std::cerr << n.m_err.str ();
+      if (n.m_phased)
+        {
+          n.m_node->GetDLScheduler ()->StopSchedule ();
+        }
+      else if (n.m_downlink)
+        {
+          n.m_node->DownlinkResourceBlokAllocation ();
+        }
+      if (n.m_uplink)
+        {
+          n.m_node->UplinkResourceBlockAllocation ();
+        }
+    }
+  m_ttiNodes.clear ();
+}
+
+void
+FrameManager::RunSchedulingPhase (void (PacketScheduler::*phase) (void))
+{
+  TtiExecutor::Init ()->ParallelFor (m_ttiNodes.size (), [this, phase] (int i)
+    {
+      TtiNode &n = m_ttiNodes.at (i);
+      if (!n.m_phased)
+        return;
+      OutputCapture::Start (&n.m_out, &n.m_err);
+      (n.m_node->GetDLScheduler ()->*phase) ();
+      OutputCapture::Stop ();
+    });
 }
@@ -23,6 +23,8 @@
 #define FRAMEMANAGER_H_
 
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 #include "../core/eventScheduler/simulator.h"
 #include "NetworkManager.h"
@@ -37,6 +39,9 @@
  *    ...
  */
 
+class ENodeB;
+class PacketScheduler;
+
 class FrameManager {
  public:
   enum FrameStructure { FRAME_STRUCTURE_FDD, FRAME_STRUCTURE_TDD };
@@ -53,6 +58,20 @@ class FrameManager {
   FrameManager();
   static FrameManager* ptr;
 
+  // a node to schedule in the current TTI, when the TTI runs in parallel
+  struct TtiNode {
+    ENodeB* m_node;
+    bool m_downlink;
+    bool m_uplink;
+    bool m_phased;  // the DL scheduler runs split in phases
+    std::ostringstream m_out;  // captured during the parallel phases
+    std::ostringstream m_err;
+  };
+  std::vector<TtiNode> m_ttiNodes;
+
+  void ScheduleAllocation(ENodeB* node, bool downlink, bool uplink);
+  void RunSchedulingPhase(void (PacketScheduler::*phase)(void));
+
  public:
   // FrameManager();
   virtual ~FrameManager();
@@ -90,6 +109,7 @@ class FrameManager {
 
   void UpdateUserPosition(void);
   void ResourceAllocation(void);
+  void ParallelResourceAllocation(void);
 };
 
 #endif /* FRAMEMANAGER_H_ */
@@ -0,0 +1,197 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "MobilityManager.h"
+#include <math.h>
+#include "NetworkManager.h"
+#include "../core/eventScheduler/simulator.h"
+#include "../device/UserEquipment.h"
+#include "../mobility/RandomDirection.h"
+#include "../protocolStack/protocol-stack.h"
+#include "../protocolStack/rrc/rrc-entity.h"
+#include "../protocolStack/rrc/ho/handover-entity.h"
+#include "../protocolStack/rrc/ho/ho-manager.h"
+
+MobilityManager* MobilityManager::ptr = NULL;
+
+MobilityManager::MobilityManager()
+{
+  m_updatePeriod = 0.001;
+  m_scheduled = false;
+}
+
+MobilityManager::~MobilityManager()
+{
+}
+
+void
+MobilityManager::SetUpdatePeriod(double period)
+{
+  m_updatePeriod = period;
+}
+
+double
+MobilityManager::GetUpdatePeriod(void) const
+{
+  return m_updatePeriod;
+}
+
+void
+MobilityManager::Register(UserEquipment* ue)
+{
+  Mobility* m = ue->GetMobilityModel();
+  if (m->m_slot >= 0)
+    return;
+  m->m_slot = m_users.size();
+  m_users.push_back(ue);
+  m_models.push_back(m);
+  m_modelType.push_back(m->GetMobilityModel());
+  m_x.push_back(0);
+  m_y.push_back(0);
+  m_speed.push_back(0);
+  m_cos.push_back(1);
+  m_sin.push_back(0);
+  m_lastUpdate.push_back(0);
+  m_moved.push_back(true);
+  m_nextX.push_back(0);
+  m_nextY.push_back(0);
+  Sync(m);
+
+  if (!m_scheduled) {
+    m_scheduled = true;
+    Simulator::Init()->Schedule(m_updatePeriod,
+                                &MobilityManager::UpdatePositions,
+                                this,
+                                Simulator::Init()->Now());
+  }
+}
+
+void
+MobilityManager::Unregister(UserEquipment* ue)
+{
+  Mobility* m = ue->GetMobilityModel();
+  if (m == NULL || m->m_slot < 0)
+    return;
+  // keep the registration order, it fixes the order of the random draws
+  int slot = m->m_slot;
+  m_users.erase(m_users.begin() + slot);
+  m_models.erase(m_models.begin() + slot);
+  m_modelType.erase(m_modelType.begin() + slot);
+  m_x.erase(m_x.begin() + slot);
+  m_y.erase(m_y.begin() + slot);
+  m_speed.erase(m_speed.begin() + slot);
+  m_cos.erase(m_cos.begin() + slot);
+  m_sin.erase(m_sin.begin() + slot);
+  m_lastUpdate.erase(m_lastUpdate.begin() + slot);
+  m_moved.erase(m_moved.begin() + slot);
+  m_nextX.pop_back();
+  m_nextY.pop_back();
+  for (size_t i = slot; i < m_models.size(); i++)
+    m_models[i]->m_slot = i;
+  m->m_slot = -1;
+}
+
+int
+MobilityManager::GetNbUsers(void) const
+{
+  return m_users.size();
+}
+
+void
+MobilityManager::Sync(Mobility* m)
+{
+  int i = m->m_slot;
+  if (m->m_AbsolutePosition != NULL) {
+    m_x[i] = m->m_AbsolutePosition->GetCoordinateX();
+    m_y[i] = m->m_AbsolutePosition->GetCoordinateY();
+  }
+  // same expressions as the per-UE models, for bit-identical positions
+  m_speed[i] = m->m_speed * (1000.0 / 3600.0);
+  m_cos[i] = cos(m->m_speedDirection);
+  m_sin[i] = sin(m->m_speedDirection);
+  m_lastUpdate[i] = m->m_positionLastUpdate;
+  m_moved[i] = true;
+}
+
+void
+MobilityManager::UpdatePositions(double time)
+{
+  int nbUsers = m_users.size();
+
+  // random direction kinematics for every slot, no side effects
+  const double* x = m_x.data();
+  const double* y = m_y.data();
+  const double* speed = m_speed.data();
+  const double* c = m_cos.data();
+  const double* s = m_sin.data();
+  const double* last = m_lastUpdate.data();
+  double* nextX = m_nextX.data();
+  double* nextY = m_nextY.data();
+  for (int i = 0; i < nbUsers; i++) {
+    double shift = (time - last[i]) * speed[i];
+    nextX[i] = x[i] + shift * c[i];
+    nextY[i] = y[i] + shift * s[i];
+  }
+
+  NetworkManager* nm = NetworkManager::Init();
+  for (int i = 0; i < nbUsers; i++) {
+    UserEquipment* ue = m_users[i];
+    Mobility* m = m_models[i];
+
+    if (m_modelType[i] == Mobility::RANDOM_DIRECTION) {
+      if (m->m_speed != 0) {
+        CartesianCoordinates position(m_nextX[i], m_nextY[i]);
+        ((RandomDirection*)m)->KeepInsideCell(&position);
+        m->m_AbsolutePosition->SetCoordinates(position.GetCoordinateX(),
+                                              position.GetCoordinateY());
+        m->m_positionLastUpdate = time;
+        m_x[i] = position.GetCoordinateX();
+        m_y[i] = position.GetCoordinateY();
+        m_lastUpdate[i] = time;
+        m_moved[i] = true;
+      }
+    } else {
+      // the setters of the model resync the slot
+      m->UpdatePosition(time);
+    }
+
+    if (!m_moved[i])
+      continue;
+    m_moved[i] = false;
+
+    ue->SetIndoorFlag(nm->CheckIndoorUsers(ue));
+
+    if (m->GetHandover()) {
+      NetworkNode* targetNode = ue->GetTargetNode();
+      HandoverEntity* ho = targetNode->GetProtocolStack()->GetRrcEntity()->
+          GetHandoverEntity();
+      if (ho->CheckHandoverNeed(ue)) {
+        NetworkNode* newTargetNode = ho->GetHoManager()->m_target;
+        nm->HandoverProcedure(time, ue, targetNode, newTargetNode);
+      }
+    }
+  }
+
+  Simulator::Init()->Schedule(m_updatePeriod,
+                              &MobilityManager::UpdatePositions,
+                              this,
+                              Simulator::Init()->Now());
+}
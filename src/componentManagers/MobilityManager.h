@@ -0,0 +1,93 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef MOBILITYMANAGER_H_
+#define MOBILITYMANAGER_H_
+
+#include <vector>
+
+#include "../mobility/Mobility.h"
+
+class UserEquipment;
+
+/*
+ * Moves every user equipment from a single periodic event, instead of one
+ * position-update event per UE.
+ *
+ * The kinematic state of the registered UEs is kept in parallel arrays, in
+ * registration order. Each update advances all the random direction users in
+ * one branch-free pass, then walks the UEs in order to apply the cell
+ * boundaries (which may draw a new direction) and to run the other mobility
+ * models, so the sequence of random draws is the same as with per-UE events.
+ * The indoor flag and the handover check are only evaluated for UEs that
+ * moved since the previous update.
+ *
+ * The Mobility objects stay authoritative for the rest of the simulator:
+ * positions are written back after each update, and the Mobility setters
+ * call Sync() so that external changes reach the arrays.
+ */
+class MobilityManager {
+ private:
+  MobilityManager();
+  static MobilityManager* ptr;
+
+  double m_updatePeriod;  // s
+  bool m_scheduled;
+
+  std::vector<UserEquipment*> m_users;
+  std::vector<Mobility*> m_models;
+  std::vector<int> m_modelType;
+  std::vector<double> m_x;           // m
+  std::vector<double> m_y;           // m
+  std::vector<double> m_speed;       // m/s
+  std::vector<double> m_cos;         // of the speed direction
+  std::vector<double> m_sin;
+  std::vector<double> m_lastUpdate;  // s
+  std::vector<char> m_moved;
+
+  // positions proposed by the batched pass
+  std::vector<double> m_nextX;
+  std::vector<double> m_nextY;
+
+ public:
+  virtual ~MobilityManager();
+
+  static MobilityManager* Init(void) {
+    if (ptr == NULL) {
+      ptr = new MobilityManager;
+    }
+    return ptr;
+  }
+
+  void SetUpdatePeriod(double period);
+  double GetUpdatePeriod(void) const;
+
+  void Register(UserEquipment* ue);
+  void Unregister(UserEquipment* ue);
+  int GetNbUsers(void) const;
+
+  // reloads the slot of m from the Mobility object
+  void Sync(Mobility* m);
+
+  void UpdatePositions(double time);
+};
+
+#endif /* MOBILITYMANAGER_H_ */
@@ -21,6 +21,8 @@
 
 
 
+#include <algorithm>
+
 #include "NetworkManager.h"
 #include "../core/eventScheduler/simulator.h"
 #include "../device/Gateway.h"
@@ -58,6 +60,10 @@ NetworkManager::NetworkManager()
   m_userEquipmentContainer = new std::vector<UserEquipment*>;
   m_gatewayContainer = new std::vector<Gateway*>;
   m_buildingContainer = new std::vector<Building*>;
+  m_cellGridValid = false;
+  m_buildingGridValid = false;
+  m_maxCellRadius = 0;
+  m_nextUserEquipmentOrder = 0;
 }
 
 NetworkManager::~NetworkManager()
@@ -101,7 +107,7 @@ NetworkManager::CreateCell (int idCell, double radius, double minDistance, doubl
 {
   Cell *cell = new Cell (idCell, radius, minDistance, X, Y);
 
-  GetCellContainer()->push_back (cell);
+  AddCell (cell);
 
   return cell;
 }
@@ -119,7 +125,7 @@ NetworkManager::CreateEnodeb (int id,
   enb->GetPhy ()->SetBandwidthManager (bm);
   ulCh->AddDevice (enb);
 
-  GetENodeBContainer ()->push_back (enb);
+  AddENodeB (enb);
 
   return enb;
 }
@@ -129,7 +135,7 @@ NetworkManager::CreateGateway (void)
 {
   Gateway *gw = new Gateway ();
 
-  GetGatewayContainer ()->push_back (gw);
+  AddGateway (gw);
 
   return gw;
 }
@@ -161,7 +167,7 @@ NetworkManager::CreateUserEquipment (int id,
   MacroCellUrbanAreaChannelRealization* c_ul = new MacroCellUrbanAreaChannelRealization (ue, enb);
   enb->GetPhy()->GetUlChannel ()->GetPropagationLossModel ()->AddChannelRealization (c_ul);
 
-  GetUserEquipmentContainer ()->push_back (ue);
+  AddUserEquipment (ue);
 
   return ue;
 }
@@ -256,6 +262,7 @@ NetworkManager::CreateBuildingForFemtocells (int idBuilding,
 	}
 
 	GetBuildingContainer()->push_back(building);
+	m_buildingGridValid = false;
 
 }
 
@@ -319,22 +326,176 @@ NetworkManager::GetBuildingContainer (void)
 }
 
 
-Cell*
-NetworkManager::GetCellByID (int idCell)
+template <class T>
+static int
+GetNodeID (T* node)
 {
-  std::vector<Cell*>* cellContainer = GetCellContainer ();
-  std::vector<Cell*>::iterator iter;
-  Cell *cell;
-  for (iter = cellContainer->begin ();
-      iter !=cellContainer->end (); iter++)
+  return node->GetIDNetworkNode ();
+}
+
+static int
+GetCellID (Cell* cell)
+{
+  return cell->GetIdCell ();
+}
+
+static int
+GetENodeBCellID (ENodeB* eNodeB)
+{
+  return eNodeB->GetCell () != NULL ? eNodeB->GetCell ()->GetIdCell () : -1;
+}
+
+template <class T>
+static void
+AddToIDTable (std::vector<T*>& table, int id, T* element)
+{
+  if (id < 0)
     {
-    cell = *iter;
-    if (cell->GetIdCell() == idCell)
-      return cell;
+      return;
+    }
+  if (id >= (int) table.size ())
+    {
+      table.resize (id + 1, NULL);
+    }
+  // the first element with a given ID wins, as with a linear scan
+  if (table[id] == NULL)
+    {
+      table[id] = element;
+    }
+}
+
+template <class T>
+static void
+RemoveFromIDTable (std::vector<T*>* container, std::vector<T*>& table,
+                   int (*getID)(T*), T* element)
+{
+  int id = getID (element);
+  if (id < 0 || id >= (int) table.size () || table[id] != element)
+    {
+      return;
+    }
+  // fall back to the next element registered with the same ID
+  table[id] = NULL;
+  for (size_t i = 0; i < container->size () && table[id] == NULL; i++)
+    {
+      if (container->at (i) != element && getID (container->at (i)) == id)
+        {
+          table[id] = container->at (i);
+        }
+    }
+}
+
+template <class T>
+static T*
+LookupID (std::vector<T*>* container, std::vector<T*>& table, int (*getID)(T*), int id)
+{
+  if (id >= 0)
+    {
+      return id < (int) table.size () ? table[id] : NULL;
+    }
+  // negative IDs (e.g. the gateway) are not indexed
+  for (size_t i = 0; i < container->size (); i++)
+    {
+      if (getID (container->at (i)) == id)
+        {
+          return container->at (i);
+        }
     }
   return NULL;
 }
 
+void
+NetworkManager::AddCell (Cell* cell)
+{
+  m_cellContainer->push_back (cell);
+  AddToIDTable (m_cellByID, GetCellID (cell), cell);
+  m_cellGridValid = false;
+}
+
+void
+NetworkManager::AddENodeB (ENodeB* eNodeB)
+{
+  m_eNodeBContainer->push_back (eNodeB);
+  AddToIDTable (m_eNodeBByID, GetNodeID (eNodeB), eNodeB);
+  AddToIDTable (m_eNodeBByCellID, GetENodeBCellID (eNodeB), eNodeB);
+}
+
+void
+NetworkManager::AddUserEquipment (UserEquipment* ue)
+{
+  m_userEquipmentContainer->push_back (ue);
+  AddToIDTable (m_userEquipmentByID, GetNodeID (ue), ue);
+  m_userEquipmentOrder[ue] = m_nextUserEquipmentOrder++;
+  AddToTarget (ue, ue->GetTargetNode ());
+}
+
+void
+NetworkManager::AddGateway (Gateway* gw)
+{
+  m_gatewayContainer->push_back (gw);
+  AddToIDTable (m_gatewayByID, GetNodeID (gw), gw);
+}
+
+void
+NetworkManager::RemoveUserEquipment (UserEquipment* ue)
+{
+  std::vector<UserEquipment*>::iterator it =
+      std::find (m_userEquipmentContainer->begin (), m_userEquipmentContainer->end (), ue);
+  if (it == m_userEquipmentContainer->end ())
+    {
+      return;
+    }
+  RemoveFromTarget (ue, ue->GetTargetNode ());
+  m_userEquipmentOrder.erase (ue);
+  m_userEquipmentContainer->erase (it);
+  RemoveFromIDTable (m_userEquipmentContainer, m_userEquipmentByID, GetNodeID<UserEquipment>, ue);
+}
+
+void
+NetworkManager::AddToTarget (UserEquipment* ue, NetworkNode* target)
+{
+  int idTarget = target != NULL ? target->GetIDNetworkNode () : -1;
+  if (idTarget < 0)
+    {
+      return;
+    }
+  if (idTarget >= (int) m_userEquipmentByTargetID.size ())
+    {
+      m_userEquipmentByTargetID.resize (idTarget + 1);
+    }
+  // keep the list in registration order
+  std::vector<UserEquipment*>& list = m_userEquipmentByTargetID[idTarget];
+  uint64_t order = m_userEquipmentOrder[ue];
+  std::vector<UserEquipment*>::iterator it = list.end ();
+  while (it != list.begin () && m_userEquipmentOrder[*(it - 1)] > order)
+    {
+      it--;
+    }
+  list.insert (it, ue);
+}
+
+void
+NetworkManager::RemoveFromTarget (UserEquipment* ue, NetworkNode* target)
+{
+  int idTarget = target != NULL ? target->GetIDNetworkNode () : -1;
+  if (idTarget < 0 || idTarget >= (int) m_userEquipmentByTargetID.size ())
+    {
+      return;
+    }
+  std::vector<UserEquipment*>& list = m_userEquipmentByTargetID[idTarget];
+  std::vector<UserEquipment*>::iterator it = std::find (list.begin (), list.end (), ue);
+  if (it != list.end ())
+    {
+      list.erase (it);
+    }
+}
+
+Cell*
+NetworkManager::GetCellByID (int idCell)
+{
+  return LookupID (m_cellContainer, m_cellByID, GetCellID, idCell);
+}
+
 Femtocell*
 NetworkManager::GetFemtoCellByID (int idFemtoCell)
 {
@@ -354,74 +515,25 @@ NetworkManager::GetFemtoCellByID (int idFemtoCell)
 ENodeB*
 NetworkManager::GetENodeBByID (int idENodeB)
 {
-  std::vector<ENodeB*>* eNodeBContainer = GetENodeBContainer ();
-  std::vector<ENodeB*>::iterator iter2;
-  ENodeB *eNodeB;
-  for (iter2 = eNodeBContainer->begin ();
-      iter2 !=eNodeBContainer->end (); iter2++)
-    {
-    eNodeB = *iter2;
-    if (eNodeB->GetIDNetworkNode() == idENodeB)
-      {
-      return eNodeB;
-      }
-    }
-  return NULL;
+  return LookupID (m_eNodeBContainer, m_eNodeBByID, GetNodeID<ENodeB>, idENodeB);
 }
 
 ENodeB*
 NetworkManager::GetENodeBByCellID (int idCell)
 {
-  std::vector<ENodeB*>* eNodeBContainer = GetENodeBContainer ();
-  std::vector<ENodeB*>::iterator iter2;
-  ENodeB *eNodeB;
-  for (iter2 = eNodeBContainer->begin ();
-      iter2 !=eNodeBContainer->end (); iter2++)
-    {
-    eNodeB = *iter2;
-    if (eNodeB->GetCell ()->GetIdCell ()== idCell)
-      {
-      return eNodeB;
-      }
-    }
-  return NULL;
+  return LookupID (m_eNodeBContainer, m_eNodeBByCellID, GetENodeBCellID, idCell);
 }
 
 UserEquipment*
 NetworkManager::GetUserEquipmentByID (int idUE)
 {
-  std::vector<UserEquipment*>* userEquipmentContainer = GetUserEquipmentContainer ();
-  std::vector<UserEquipment*>::iterator iter3;
-  UserEquipment *userEquipment;
-  for (iter3 = userEquipmentContainer->begin ();
-      iter3 !=userEquipmentContainer->end (); iter3++)
-    {
-    userEquipment = *iter3;
-    if (userEquipment->GetIDNetworkNode() == idUE)
-      {
-      return userEquipment;
-      }
-    }
-  return NULL;
+  return LookupID (m_userEquipmentContainer, m_userEquipmentByID, GetNodeID<UserEquipment>, idUE);
 }
 
 Gateway*
 NetworkManager::GetGatewayByID (int idGW)
 {
-  std::vector<Gateway*>* gatewayContainer = GetGatewayContainer ();
-  std::vector<Gateway*>::iterator iter;
-  Gateway *gateway;
-
-  for (iter = gatewayContainer->begin ();
-      iter !=gatewayContainer->end (); iter++)
-    {
-    gateway = *iter;
-    if (gateway->GetIDNetworkNode() == idGW)
-      {
-      return gateway;
-      }
-    }
-  return NULL;
+  return LookupID (m_gatewayContainer, m_gatewayByID, GetNodeID<Gateway>, idGW);
 }
 
 Building*
@@ -465,84 +577,123 @@ NetworkManager::GetBuildingByFemtoCellID (int idFemtoCell)
 NetworkNode*
 NetworkManager::GetNetworkNodeByID (int id)
 {
-  std::vector<ENodeB*>* eNodeBContainer = GetENodeBContainer ();
-  std::vector<ENodeB*>::iterator iter2;
-  ENodeB *eNodeB;
-  for (iter2 = eNodeBContainer->begin ();
-      iter2 !=eNodeBContainer->end (); iter2++)
+  NetworkNode *node = LookupID (m_eNodeBContainer, m_eNodeBByID, GetNodeID<ENodeB>, id);
+  if (node == NULL)
     {
-    eNodeB = *iter2;
-    if (eNodeB->GetIDNetworkNode() == id)
-      {
-      return eNodeB;
-      }
+      node = LookupID (m_userEquipmentContainer, m_userEquipmentByID, GetNodeID<UserEquipment>, id);
     }
-
-  std::vector<UserEquipment*>* userEquipmentContainer = GetUserEquipmentContainer ();
-  std::vector<UserEquipment*>::iterator iter3;
-  UserEquipment *userEquipment;
-  for (iter3 = userEquipmentContainer->begin ();
-      iter3 !=userEquipmentContainer->end (); iter3++)
+  if (node == NULL)
     {
-    userEquipment = *iter3;
-    if (userEquipment->GetIDNetworkNode() == id)
-      {
-      return userEquipment;
-      }
-    }
-
-  std::vector<Gateway*>* gatewayContainer = GetGatewayContainer ();
-  std::vector<Gateway*>::iterator iter;
-  Gateway *gateway;
-
-  for (iter = gatewayContainer->begin ();
-      iter !=gatewayContainer->end (); iter++)
-    {
-    gateway = *iter;
-    if (gateway->GetIDNetworkNode() == id)
-      {
-      return gateway;
-      }
+      node = LookupID (m_gatewayContainer, m_gatewayByID, GetNodeID<Gateway>, id);
     }
-  return NULL;
+  return node;
 }
 
 std::vector<UserEquipment*>*
 NetworkManager::GetRegisteredUEToENodeB (int idENB)
 {
   std::vector<UserEquipment*>* UElist = new std::vector<UserEquipment*>;
-
-  std::vector<UserEquipment*>* userEquipmentContainer = GetUserEquipmentContainer ();
-  std::vector<UserEquipment*>::iterator iter;
-  UserEquipment *userEquipment;
-  for (iter = userEquipmentContainer->begin ();
-      iter !=userEquipmentContainer->end (); iter++)
+  if (idENB >= 0 && idENB < (int) m_userEquipmentByTargetID.size ())
     {
-    userEquipment = *iter;
-    if (userEquipment->GetTargetNode ()->GetIDNetworkNode() == idENB)
-      {
-      UElist->push_back(userEquipment);
-      }
+      *UElist = m_userEquipmentByTargetID[idENB];
     }
   return UElist;
 }
 
+void
+NetworkManager::NotifyTargetNodeChanged (UserEquipment* ue, NetworkNode* oldTarget)
+{
+  // UEs not registered yet are placed by AddUserEquipment
+  if (m_userEquipmentOrder.count (ue) == 0)
+    {
+      return;
+    }
+  RemoveFromTarget (ue, oldTarget);
+  AddToTarget (ue, ue->GetTargetNode ());
+}
+
+
+void
+NetworkManager::UpdateSpatialIndex (void)
+{
+  if (!m_cellGridValid)
+    {
+      double minX = 0, minY = 0, maxX = 0, maxY = 0;
+      m_maxCellRadius = 0;
+      for (size_t i = 0; i < m_cellContainer->size (); i++)
+        {
+          CartesianCoordinates *center = m_cellContainer->at (i)->GetCellCenterPosition ();
+          double x = center->GetCoordinateX ();
+          double y = center->GetCoordinateY ();
+          minX = (i == 0 || x < minX) ? x : minX;
+          minY = (i == 0 || y < minY) ? y : minY;
+          maxX = (i == 0 || x > maxX) ? x : maxX;
+          maxY = (i == 0 || y > maxY) ? y : maxY;
+          m_maxCellRadius = std::max (m_maxCellRadius, m_cellContainer->at (i)->GetRadius ());
+        }
+      // about one cell per bucket
+      double side = std::max (maxX - minX, maxY - minY);
+      double bucketSide = side / ceil (sqrt ((double) m_cellContainer->size ()));
+      m_cellGrid.Reset (minX, minY, maxX, maxY, bucketSide > 0 ? bucketSide : 1);
+      for (size_t i = 0; i < m_cellContainer->size (); i++)
+        {
+          CartesianCoordinates *center = m_cellContainer->at (i)->GetCellCenterPosition ();
+          m_cellGrid.Insert (i, center->GetCoordinateX (), center->GetCoordinateY (),
+                             center->GetCoordinateX (), center->GetCoordinateY ());
+        }
+      m_cellGridValid = true;
+    }
+
+  if (!m_buildingGridValid)
+    {
+      // footprints are padded by 1 m, the containment test below truncates
+      double minX = 0, minY = 0, maxX = 0, maxY = 0, bucketSide = 1;
+      for (size_t i = 0; i < m_buildingContainer->size (); i++)
+        {
+          Building *building = m_buildingContainer->at (i);
+          double halfX = building->GetSide ()[0] / 2 + 1;
+          double halfY = building->GetSide ()[1] / 2 + 1;
+          double x = building->GetCenterPosition ()->GetCoordinateX ();
+          double y = building->GetCenterPosition ()->GetCoordinateY ();
+          minX = (i == 0 || x - halfX < minX) ? x - halfX : minX;
+          minY = (i == 0 || y - halfY < minY) ? y - halfY : minY;
+          maxX = (i == 0 || x + halfX > maxX) ? x + halfX : maxX;
+          maxY = (i == 0 || y + halfY > maxY) ? y + halfY : maxY;
+          bucketSide = std::max (bucketSide, 2 * std::max (halfX, halfY));
+        }
+      m_buildingGrid.Reset (minX, minY, maxX, maxY, bucketSide);
+      for (size_t i = 0; i < m_buildingContainer->size (); i++)
+        {
+          Building *building = m_buildingContainer->at (i);
+          double halfX = building->GetSide ()[0] / 2 + 1;
+          double halfY = building->GetSide ()[1] / 2 + 1;
+          double x = building->GetCenterPosition ()->GetCoordinateX ();
+          double y = building->GetCenterPosition ()->GetCoordinateY ();
+          m_buildingGrid.Insert (i, x - halfX, y - halfY, x + halfX, y + halfY);
+        }
+      m_buildingGridValid = true;
+    }
+}
 
 std::vector<int>
 NetworkManager::GetCellIDFromPosition (CartesianCoordinates *position)
 {
   std::vector<int> CellsID;
 
+  UpdateSpatialIndex ();
+
   std::vector<Cell*>* cellContainer = GetCellContainer ();
-  std::vector<Cell*>::iterator iter;
   Cell *cell;
   double distance;
-  for (iter = cellContainer->begin ();
-      iter !=cellContainer->end (); iter++)
+  double posX = position->GetCoordinateX ();
+  double posY = position->GetCoordinateY ();
+  double r = m_maxCellRadius;
+  m_cellGrid.Query (posX - r, posY - r, posX + r, posY + r, m_gridCandidates);
+  for (size_t i = 0; i < m_gridCandidates.size (); i++)
     {
-    cell = *iter;
-    distance =  sqrt (pow ((cell->GetCellCenterPosition()->GetCoordinateX() - position->GetCoordinateX()),2)
-                      + pow ((cell->GetCellCenterPosition()->GetCoordinateY() - position->GetCoordinateY()),2));
+    cell = cellContainer->at (m_gridCandidates[i]);
+    distance =  sqrt (pow ((cell->GetCellCenterPosition()->GetCoordinateX() - posX),2)
+                      + pow ((cell->GetCellCenterPosition()->GetCoordinateY() - posY),2));
 
     if (distance <= cell->GetRadius())
       {
@@ -557,24 +708,42 @@ int
 NetworkManager::GetCellIDFromPosition (double posX,
                                        double posY)
 {
+  UpdateSpatialIndex ();
+
   std::vector<Cell*>* cellContainer = GetCellContainer ();
-  std::vector<Cell*>::iterator iter;
   Cell *cell;
-  double target_distance = 10000.0;
+  double target_distance;
   double distance;
-  int cellID;
-
-  for (iter = cellContainer->begin ();
-      iter !=cellContainer->end (); iter++)
+  int cellID = -1;
+
+  /*
+   * Grow a square around the position until the nearest candidate is closer
+   * than the half side: every cell outside the square is then farther away.
+   * Candidates are visited in container order, so ties still go to the
+   * first cell, as with the full scan.
+   */
+  double r = m_cellGrid.GetBucketSide ();
+  while (true)
     {
-    cell = *iter;
-    distance = cell->GetCellCenterPosition()->GetDistance(posX, posY);
-
-    if (distance < target_distance)
-      {
-        cellID = cell->GetIdCell ();
-        target_distance = distance;
-      }
+      m_cellGrid.Query (posX - r, posY - r, posX + r, posY + r, m_gridCandidates);
+      target_distance = 10000.0;
+      for (size_t i = 0; i < m_gridCandidates.size (); i++)
+        {
+        cell = cellContainer->at (m_gridCandidates[i]);
+        distance = cell->GetCellCenterPosition()->GetDistance(posX, posY);
+
+        if (distance < target_distance)
+          {
+            cellID = cell->GetIdCell ();
+            target_distance = distance;
+          }
+        }
+      if (target_distance <= r || r >= 10000.0
+          || m_cellGrid.Covers (posX - r, posY - r, posX + r, posY + r))
+        {
+          break;
+        }
+      r *= 2;
     }
   return cellID;
 }
@@ -663,68 +832,64 @@ NetworkManager::CheckHandoverPermissions (NetworkNode* target, UserEquipment* us
 	return false;
 }
 
-bool
-NetworkManager::CheckIndoorUsers (UserEquipment *ue)
+Building*
+NetworkManager::GetBuildingFromPosition (double posX, double posY)
 {
+	UpdateSpatialIndex ();
+
 	std::vector<Building*>* buildingContainer = GetBuildingContainer ();
-	std::vector<Building*>::iterator iter;
+	const std::vector<int>& candidates = m_buildingGrid.Query (posX, posY);
 	Building *building;
 
-	if (buildingContainer->size()>0)
+	for (size_t i = 0; i < candidates.size (); i++)
 	{
-		for (iter = buildingContainer->begin ();
-				iter !=buildingContainer->end (); iter++)
-		{
-			building = *iter;
+		building = buildingContainer->at (candidates[i]);
 
-			if ( ( abs( building->GetCenterPosition()->GetCoordinateX()
-					- ue->GetMobilityModel()->GetAbsolutePosition()->GetCoordinateX() ) < building->GetSide()[0]/2 ) &&
-					( abs( building->GetCenterPosition()->GetCoordinateY()
-							- ue->GetMobilityModel()->GetAbsolutePosition()->GetCoordinateY() ) < building->GetSide()[1]/2 ) )
-			{
-				return true;
-			}
+		if ( ( abs( building->GetCenterPosition()->GetCoordinateX()
+				- posX ) < building->GetSide()[0]/2 ) &&
+				( abs( building->GetCenterPosition()->GetCoordinateY()
+						- posY ) < building->GetSide()[1]/2 ) )
+		{
+			return building;
 		}
 	}
-	return false;
+	return NULL;
+}
+
+bool
+NetworkManager::CheckIndoorUsers (UserEquipment *ue)
+{
+	if (GetBuildingContainer ()->empty ())
+	{
+		return false;
+	}
+	CartesianCoordinates *ue_pos = ue->GetMobilityModel()->GetAbsolutePosition();
+	return GetBuildingFromPosition (ue_pos->GetCoordinateX(), ue_pos->GetCoordinateY()) != NULL;
 }
 
 int
 NetworkManager::GetBuildingIDForUE (UserEquipment *ue)
 {
-	std::vector<Building*>* buildingContainer = GetBuildingContainer ();
-	std::vector<Building*>::iterator iter;
-	Building *building;
-
-	if (buildingContainer->size()>0)
+	if (GetBuildingContainer ()->empty ())
 	{
-		for (iter = buildingContainer->begin ();
-				iter !=buildingContainer->end (); iter++)
-		{
-			building = *iter;
-
-			if ( ( abs( building->GetCenterPosition()->GetCoordinateX()
-					- ue->GetMobilityModel()->GetAbsolutePosition()->GetCoordinateX() ) < building->GetSide()[0]/2 ) &&
-					( abs( building->GetCenterPosition()->GetCoordinateY()
-							- ue->GetMobilityModel()->GetAbsolutePosition()->GetCoordinateY() ) < building->GetSide()[1]/2 ) )
-			{
-				return building->GetIdBuilding();
-			}
-		}
+		return -1;
 	}
-	return -1;
+	CartesianCoordinates *ue_pos = ue->GetMobilityModel()->GetAbsolutePosition();
+	Building *building = GetBuildingFromPosition (ue_pos->GetCoordinateX(), ue_pos->GetCoordinateY());
+	return building != NULL ? building->GetIdBuilding() : -1;
 }
 
 Cell*
 NetworkManager::GetBelongingCellFromPosition(UserEquipment* ue)
 {
 	CartesianCoordinates* ue_pos = ue->GetMobilityModel()->GetAbsolutePosition();
-	int buildingID = GetBuildingIDForUE(ue);
+	Building *building = GetBuildingContainer ()->empty () ? NULL :
+			GetBuildingFromPosition (ue_pos->GetCoordinateX(), ue_pos->GetCoordinateY());
 
-	if ( buildingID != -1 )
+	if ( building != NULL )
 	{
 		//user is indoor and it will be attached to a femtocell
-		std::vector<Femtocell*>* femtocellContainer = GetBuildingByID(buildingID)->GetFemtoCellsInBuilding();
+		std::vector<Femtocell*>* femtocellContainer = building->GetFemtoCellsInBuilding();
 		std::vector<Femtocell*>::iterator iter;
 		Femtocell *cell;
 		double distance = 9999999;
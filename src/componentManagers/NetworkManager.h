@@ -24,9 +24,11 @@
 
 #include <stdint.h>
 
+#include <unordered_map>
 #include <vector>
 
 #include "../networkTopology/Cell.h"
+#include "../utility/spatial-grid.h"
 
 class NetworkNode;
 class Cell;
@@ -52,6 +54,33 @@ class NetworkManager {
   std::vector<Gateway*>* m_gatewayContainer;
   std::vector<Building*>* m_buildingContainer;
 
+  // spatial indexes over the cell centers and the building footprints,
+  // rebuilt lazily after AddCell / CreateBuildingForFemtocells
+  SpatialGrid m_cellGrid;
+  SpatialGrid m_buildingGrid;
+  bool m_cellGridValid;
+  bool m_buildingGridValid;
+  double m_maxCellRadius;
+  std::vector<int> m_gridCandidates;
+
+  void UpdateSpatialIndex(void);
+  Building* GetBuildingFromPosition(double posX, double posY);
+
+  // dense ID -> element tables, kept up to date by the Add / Remove calls
+  std::vector<Cell*> m_cellByID;
+  std::vector<ENodeB*> m_eNodeBByID;
+  std::vector<ENodeB*> m_eNodeBByCellID;
+  std::vector<UserEquipment*> m_userEquipmentByID;
+  std::vector<Gateway*> m_gatewayByID;
+
+  // UEs grouped by the ID of their target node, in registration order
+  std::vector<std::vector<UserEquipment*> > m_userEquipmentByTargetID;
+  std::unordered_map<UserEquipment*, uint64_t> m_userEquipmentOrder;
+  uint64_t m_nextUserEquipmentOrder;
+
+  void AddToTarget(UserEquipment* ue, NetworkNode* target);
+  void RemoveFromTarget(UserEquipment* ue, NetworkNode* target);
+
   NetworkManager();
   static NetworkManager* ptr;
 
@@ -76,6 +105,17 @@ class NetworkManager {
   std::vector<Gateway*>* GetGatewayContainer(void);
   std::vector<Building*>* GetBuildingContainer(void);
 
+  /*
+   * Register network elements. The ID lookup tables follow these calls:
+   * elements must not be pushed into the containers directly.
+   */
+  void AddCell(Cell* cell);
+  void AddENodeB(ENodeB* eNodeB);
+  void AddUserEquipment(UserEquipment* ue);
+  void AddGateway(Gateway* gw);
+  // takes the UE out of the network, the caller deletes it
+  void RemoveUserEquipment(UserEquipment* ue);
+
   int GetNbCell(void);
 
   /*
@@ -91,6 +131,8 @@ class NetworkManager {
   Building* GetBuildingByFemtoCellID(int idFemtoCell);
 
   std::vector<UserEquipment*>* GetRegisteredUEToENodeB(int idENB);
+  // called by UserEquipment::SetTargetNode
+  void NotifyTargetNodeChanged(UserEquipment* ue, NetworkNode* oldTarget);
 
   NetworkNode* GetNetworkNodeByID(int id);
 
@@ -0,0 +1,350 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "RealTimeManager.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <jsoncpp/json/json.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "../core/eventScheduler/simulator.h"
+#include "../device/ENodeB.h"
+#include "../device/HeNodeB.h"
+#include "../device/UserEquipment.h"
+#include "../protocolStack/mac/packet-scheduler/packet-scheduler.h"
+#include "../slicing/slicing.h"
+#include "NetworkManager.h"
+#include "SnapshotManager.h"
+
+// queued for the controller; beyond, the CQI lines are dropped
+#define REAL_TIME_MAX_PENDING (8 << 20)
+// a line of the controller cannot be longer
+#define REAL_TIME_MAX_LINE (1 << 20)
+
+RealTimeManager* RealTimeManager::ptr = NULL;
+
+// the eNBs and the home eNBs, in the order FrameManager schedules them
+static void GetCells(std::vector<ENodeB*>* cells) {
+  NetworkManager* nm = NetworkManager::Init();
+  cells->assign(nm->GetENodeBContainer()->begin(), nm->GetENodeBContainer()->end());
+  cells->insert(cells->end(), nm->GetHomeENodeBContainer()->begin(),
+                nm->GetHomeENodeBContainer()->end());
+}
+
+RealTimeManager::RealTimeManager()
+    : m_enabled(false),
+      m_slot(std::chrono::milliseconds(1)),
+      m_nbSlots(0),
+      m_nbMisses(0),
+      m_maxOverrun(0),
+      m_listenFd(-1),
+      m_clientFd(-1),
+      m_nbSent(0),
+      m_nbDropped(0),
+      m_nbApplied(0),
+      m_nbRejected(0) {}
+
+RealTimeManager::~RealTimeManager() {
+  Disconnect();
+  if (m_listenFd >= 0) {
+    close(m_listenFd);
+    unlink(m_socketPath.c_str());
+    m_listenFd = -1;
+  }
+}
+
+void RealTimeManager::Enable(double slotMicroseconds) {
+  m_slot = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::micro>(slotMicroseconds));
+  if (!m_enabled) atexit(ReportAtExit);
+  m_enabled = true;
+}
+
+bool RealTimeManager::Listen(const std::string& path) {
+  struct sockaddr_un addr;
+  if (m_listenFd >= 0 || path.empty() || path.size() >= sizeof(addr.sun_path)) {
+    return false;
+  }
+  // a socket left by a previous run, but never another file
+  struct stat st;
+  if (lstat(path.c_str(), &st) == 0) {
+    if (!S_ISSOCK(st.st_mode)) return false;
+    unlink(path.c_str());
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return false;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  memcpy(addr.sun_path, path.c_str(), path.size());
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 1) != 0 ||
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0) {
+    close(fd);
+    return false;
+  }
+  m_listenFd = fd;
+  m_socketPath = path;
+  if (!m_enabled) Enable(1000);
+  return true;
+}
+
+void RealTimeManager::StartTti(unsigned long tti) {
+  Clock::time_point now = Clock::now();
+  if (m_nbSlots == 0) {
+    m_anchor = now;
+  } else {
+    EndTti(now);
+    ExportCqi(tti - 1);
+  }
+  if (m_listenFd >= 0) {
+    Accept();
+    Receive(tti);
+    Flush();
+  }
+  // nothing to wait for when the run is late
+  std::this_thread::sleep_until(m_anchor + m_slot * (long)m_nbSlots);
+  m_ttiStart = Clock::now();
+  m_nbSlots++;
+}
+
+void RealTimeManager::EndTti(Clock::time_point now) {
+  m_processing.push_back(std::chrono::duration<double>(now - m_ttiStart).count());
+  Clock::time_point deadline = m_anchor + m_slot * (long)m_nbSlots;
+  if (now > deadline) {
+    m_nbMisses++;
+    m_maxOverrun =
+        std::max(m_maxOverrun, std::chrono::duration<double>(now - deadline).count());
+  }
+}
+
+void RealTimeManager::ExportCqi(unsigned long tti) {
+  if (m_clientFd < 0) return;
+  if (m_out.size() > REAL_TIME_MAX_PENDING) {
+    m_nbDropped++;
+    return;
+  }
+  std::vector<ENodeB*> cells;
+  GetCells(&cells);
+  char number[64];
+  snprintf(number, sizeof(number), "{\"tti\": %lu, \"time\": %.3f, \"cells\": [", tti,
+           Simulator::Init()->Now());
+  m_out += number;
+  for (size_t c = 0; c < cells.size(); c++) {
+    ENodeB* enb = cells[c];
+    PacketScheduler* scheduler = enb->GetDLScheduler();
+    snprintf(number, sizeof(number), "%s{\"cell\": %d, \"ues\": [", c ? ", " : "",
+             enb->GetIDNetworkNode());
+    m_out += number;
+    ENodeB::UserEquipmentRecords* records = enb->GetUserEquipmentRecords();
+    for (size_t u = 0; u < records->size(); u++) {
+      int ue = records->at(u)->GetUE()->GetIDNetworkNode();
+      snprintf(number, sizeof(number), "%s{\"ue\": %d, \"slice\": %d, \"cqi\": [",
+               u ? ", " : "", ue, scheduler ? scheduler->GetSliceOfUser(ue) : -1);
+      m_out += number;
+      const std::vector<int>& cqi = records->at(u)->GetCQI();
+      for (size_t rb = 0; rb < cqi.size(); rb++) {
+        snprintf(number, sizeof(number), rb ? ", %d" : "%d", cqi[rb]);
+        m_out += number;
+      }
+      m_out += "]}";
+    }
+    m_out += "]}";
+  }
+  m_out += "]}\n";
+  m_nbSent++;
+}
+
+void RealTimeManager::Accept(void) {
+  if (m_clientFd >= 0) return;
+  int fd = accept(m_listenFd, NULL, NULL);
+  if (fd < 0) return;
+  m_clientFd = fd;
+  m_in.clear();
+  m_out.clear();
+}
+
+void RealTimeManager::Receive(unsigned long tti) {
+  char buffer[4096];
+  while (m_clientFd >= 0) {
+    ssize_t n = recv(m_clientFd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) {
+      m_in.append(buffer, n);
+      continue;
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      Disconnect();
+    }
+    break;
+  }
+
+  size_t end;
+  while (m_clientFd >= 0 && (end = m_in.find('\n')) != std::string::npos) {
+    std::string error = ApplyUpdate(m_in.substr(0, end));
+    m_in.erase(0, end + 1);
+    char reply[64];
+    snprintf(reply, sizeof(reply), "{\"tti\": %lu, \"ok\": %s", tti,
+             error.empty() ? "true}\n" : "false, \"error\": \"");
+    m_out += reply;
+    if (error.empty()) {
+      m_nbApplied++;
+    } else {
+      m_out += error + "\"}\n";
+      m_nbRejected++;
+    }
+  }
+  if (m_in.size() > REAL_TIME_MAX_LINE) Disconnect();
+}
+
+void RealTimeManager::Flush(void) {
+  while (m_clientFd >= 0 && !m_out.empty()) {
+    ssize_t n = send(m_clientFd, m_out.data(), m_out.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (n > 0) {
+      m_out.erase(0, n);
+      continue;
+    }
+    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      Disconnect();
+    }
+    break;
+  }
+}
+
+void RealTimeManager::Disconnect(void) {
+  if (m_clientFd < 0) return;
+  close(m_clientFd);
+  m_clientFd = -1;
+  m_in.clear();
+  m_out.clear();
+}
+
+std::string RealTimeManager::ApplyUpdate(const std::string& line) {
+  Json::Reader reader;
+  Json::Value obj;
+  if (!reader.parse(line, obj) || !obj.isObject()) return "not a JSON object";
+
+  bool hasParam = obj.isMember("alpha") || obj.isMember("beta") ||
+                  obj.isMember("epsilon") || obj.isMember("psi");
+  if (!obj.isMember("inter_slice") && !obj.isMember("weight") && !hasParam) {
+    return "nothing to update";
+  }
+  if ((obj.isMember("weight") || hasParam) && !obj["slice"].isInt()) {
+    return "no slice";
+  }
+  if (hasParam && !(obj["alpha"].isInt() && obj["beta"].isInt() &&
+                    obj["epsilon"].isInt() && obj["psi"].isInt())) {
+    return "alpha, beta, epsilon and psi go together";
+  }
+  int algo = -1;
+  if (obj.isMember("inter_slice")) {
+    ENodeB::DLSchedulerType type;
+    if (!obj["inter_slice"].isString() ||
+        !SnapshotManager::ParseDLSchedulerType(obj["inter_slice"].asString(), &type)) {
+      return "unknown inter-slice algorithm";
+    }
+    switch (type) {
+      case ENodeB::DLScheduler_SEQUENTIAL: algo = RS_SLICING_GREEDY_BY_ROW; break;
+      case ENodeB::DLScheduler_SUBOPT: algo = RS_SLICING_SUBOPT; break;
+      case ENodeB::DLScheduler_MAXCELL: algo = RS_SLICING_MAXIMIZE_CELL; break;
+      case ENodeB::DLScheduler_VOGEL: algo = RS_SLICING_VOGEL; break;
+      case ENodeB::DLScheduler_UpperBound: algo = RS_SLICING_UPPER_BOUND; break;
+      default: return "unknown inter-slice algorithm";
+    }
+  }
+  if (obj.isMember("cell") && !obj["cell"].isInt()) return "the cell is not an ID";
+  int cell = obj.get("cell", -1).asInt();
+
+  int slice = obj["slice"].isInt() ? obj["slice"].asInt() : -1;
+  Json::Value weightValue = obj.get("weight", -1);
+  double weight = weightValue.isNumeric() ? weightValue.asDouble() : -1;
+  SchedulerAlgoParam param(obj.get("alpha", 0).asInt(), obj.get("beta", 0).asInt(),
+                           obj.get("epsilon", 0).asInt(), obj.get("psi", 0).asInt());
+
+  // every target cell is checked before any is changed, so that an update
+  // is applied to all of them or to none
+  std::vector<ENodeB*> cells;
+  GetCells(&cells);
+  std::vector<PacketScheduler*> schedulers;
+  for (size_t c = 0; c < cells.size(); c++) {
+    if (cell != -1 && cells[c]->GetIDNetworkNode() != cell) continue;
+    PacketScheduler* scheduler = cells[c]->GetDLScheduler();
+    if (scheduler == NULL) return "a cell has no DL scheduler";
+    if (algo != -1 && !scheduler->HasInterSliceAlgo()) {
+      return "the scheduler has no inter-slice algorithm";
+    }
+    bool hasSlice = slice >= 0 && slice < scheduler->GetNbSlices();
+    if (obj.isMember("weight") && (!hasSlice || weight < 0 || weight > 1)) {
+      return "invalid slice or weight";
+    }
+    if (hasParam && !hasSlice) return "invalid slice";
+    schedulers.push_back(scheduler);
+  }
+  if (schedulers.empty()) return "no such cell";
+
+  for (size_t c = 0; c < schedulers.size(); c++) {
+    if (algo != -1) schedulers[c]->SetInterSliceAlgo(algo);
+    if (obj.isMember("weight")) schedulers[c]->SetSliceWeight(slice, weight);
+    if (hasParam) schedulers[c]->SetSliceAlgoParam(slice, param);
+  }
+  return "";
+}
+
+void RealTimeManager::Report(std::ostream& os) {
+  if (!m_enabled || m_nbSlots == 0) return;
+  std::vector<double> sorted(m_processing);
+  std::sort(sorted.begin(), sorted.end());
+  double p50 = 0, p99 = 0, max = 0;
+  if (!sorted.empty()) {
+    p50 = sorted[std::min(sorted.size() - 1, (size_t)(0.50 * sorted.size()))];
+    p99 = sorted[std::min(sorted.size() - 1, (size_t)(0.99 * sorted.size()))];
+    max = sorted.back();
+  }
+  char line[256];
+  snprintf(line, sizeof(line),
+           "REALTIME slot_us %.0f ttis %zu misses %lu (%.2f%%) processing_us p50 %.1f"
+           " p99 %.1f max %.1f max_overrun_us %.1f\n",
+           std::chrono::duration<double, std::micro>(m_slot).count(), sorted.size(),
+           m_nbMisses, sorted.empty() ? 0.0 : 100.0 * m_nbMisses / sorted.size(),
+           p50 * 1e6, p99 * 1e6, max * 1e6, m_maxOverrun * 1e6);
+  os << line;
+  if (m_listenFd >= 0) {
+    snprintf(line, sizeof(line),
+             "REALTIME socket %s cqi_lines %lu dropped %lu updates %lu rejected %lu\n",
+             m_socketPath.c_str(), m_nbSent, m_nbDropped, m_nbApplied, m_nbRejected);
+    os << line;
+  }
+}
+
+void RealTimeManager::ReportAtExit(void) {
+  if (ptr == NULL) return;
+  ptr->Flush();
+  ptr->Report(std::cerr);
+  delete ptr;
+  ptr = NULL;
+}
@@ -0,0 +1,117 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef REALTIMEMANAGER_H_
+#define REALTIMEMANAGER_H_
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * Real-time mode: FrameManager starts TTI n at n slots of wall clock after
+ * the first one instead of as soon as the previous one is over. A TTI,
+ * everything the simulator does in it and the DL/UL scheduling first, must
+ * be over by the end of its slot; when it is not, that is a deadline miss.
+ * A late TTI does not move the following slots, which start right away
+ * until the run has caught up.
+ *
+ * With a socket, a controller can follow and steer the run from the same
+ * machine. The socket is a Unix domain stream socket created at the given
+ * path; one controller is connected at a time. Everything is exchanged
+ * between two TTIs, from the simulation thread, and never blocks it:
+ *  - after every TTI, one JSON line with the CQIs the cells hold for their
+ *    UEs, {"tti": n, "time": s, "cells": [{"cell": id, "ues": [{"ue": id,
+ *    "slice": k, "cqi": [...]}]}]}; when the controller does not keep up,
+ *    the lines are dropped and counted;
+ *  - before every TTI, the JSON lines the controller sent, each one change
+ *    of policy applied to one cell ("cell": id) or to all of them:
+ *      {"slice": k, "weight": w}
+ *      {"slice": k, "alpha": a, "beta": b, "epsilon": e, "psi": p}
+ *      {"inter_slice": "sequential|subopt|maxcell|vogel|upperbound"}
+ *    each answered by {"tti": n, "ok": true} or {"tti": n, "ok": false,
+ *    "error": "..."}.
+ *
+ * At exit the deadline misses, the processing time of the TTIs and the
+ * traffic of the socket are printed on stderr, in "REALTIME " lines.
+ */
+class RealTimeManager {
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  RealTimeManager();
+  static RealTimeManager* ptr;
+
+  bool m_enabled;
+  Clock::duration m_slot;
+  Clock::time_point m_anchor;     // start of the first slot
+  Clock::time_point m_ttiStart;   // of the running TTI
+  unsigned long m_nbSlots;        // TTIs started
+
+  // the TTIs that are over
+  std::vector<double> m_processing;  // s
+  unsigned long m_nbMisses;
+  double m_maxOverrun;               // s past the end of the slot
+
+  std::string m_socketPath;
+  int m_listenFd;
+  int m_clientFd;
+  std::string m_in;
+  std::string m_out;
+  unsigned long m_nbSent;
+  unsigned long m_nbDropped;
+  unsigned long m_nbApplied;
+  unsigned long m_nbRejected;
+
+  void EndTti(Clock::time_point now);
+  void ExportCqi(unsigned long tti);
+  void Accept(void);
+  void Receive(unsigned long tti);
+  void Flush(void);
+  void Disconnect(void);
+  // the error, empty when applied
+  std::string ApplyUpdate(const std::string& line);
+  static void ReportAtExit(void);
+
+ public:
+  virtual ~RealTimeManager();
+
+  static RealTimeManager* Init(void) {
+    if (ptr == NULL) {
+      ptr = new RealTimeManager;
+    }
+    return ptr;
+  }
+
+  // paces the run, one TTI per slot of that many microseconds
+  void Enable(double slotMicroseconds);
+  bool IsEnabled(void) const { return m_enabled; }
+  // serves the controller socket at path; false when it cannot be created
+  bool Listen(const std::string& path);
+
+  // from FrameManager, before TTI tti (from 1) starts
+  void StartTti(unsigned long tti);
+
+  void Report(std::ostream& os);
+};
+
+#endif /* REALTIMEMANAGER_H_ */
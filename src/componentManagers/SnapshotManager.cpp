@@ -0,0 +1,400 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "SnapshotManager.h"
+#include "NetworkManager.h"
+#include "TtiExecutor.h"
+#include "../core/eventScheduler/simulator.h"
+#include "../device/HeNodeB.h"
+#include "../protocolStack/mac/packet-scheduler/packet-scheduler.h"
+#include "../protocolStack/protocol-stack.h"
+#include "../protocolStack/rrc/rrc-entity.h"
+#include "../flows/radio-bearer.h"
+#include "../utility/counter-rng.h"
+#include "../utility/seed.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <map>
+#include <sstream>
+
+SnapshotManager* SnapshotManager::ptr = NULL;
+
+static const struct {
+  const char* m_name;
+  ENodeB::DLSchedulerType m_type;
+} dlSchedulerNames[] = {
+  {"pf", ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR},
+  {"mlwdf", ENodeB::DLScheduler_TYPE_MLWDF},
+  {"exp", ENodeB::DLScheduler_TYPE_EXP},
+  {"fls", ENodeB::DLScheduler_TYPE_FLS},
+  {"log-rule", ENodeB::DLScheduler_LOG_RULE},
+  {"exp-rule", ENodeB::DLScheduler_EXP_RULE},
+  {"nvs", ENodeB::DLScheduler_NVS},
+  {"nvs-nongreedy", ENodeB::DLScheduler_NVS_NONGREEDY},
+  {"sequential", ENodeB::DLScheduler_SEQUENTIAL},
+  {"subopt", ENodeB::DLScheduler_SUBOPT},
+  {"maxcell", ENodeB::DLScheduler_MAXCELL},
+  {"vogel", ENodeB::DLScheduler_VOGEL},
+  {"upperbound", ENodeB::DLScheduler_UpperBound},
+};
+
+SnapshotManager::SnapshotManager()
+{
+  m_time = -1;
+  m_prefix = "snapshot";
+  m_restored = false;
+  m_variant = -1;
+  m_summaryFd = -1;
+  m_restoreEvents = 0;
+  m_nbJobs = sysconf(_SC_NPROCESSORS_ONLN);
+  if (m_nbJobs < 1)
+    m_nbJobs = 1;
+}
+
+SnapshotManager::~SnapshotManager()
+{}
+
+bool
+SnapshotManager::ParseDLSchedulerType(const std::string& name, ENodeB::DLSchedulerType* type)
+{
+  for (size_t i = 0; i < sizeof(dlSchedulerNames) / sizeof(dlSchedulerNames[0]); i++) {
+    if (name == dlSchedulerNames[i].m_name) {
+      *type = dlSchedulerNames[i].m_type;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+SnapshotManager::SetSchedulers(const std::string& names)
+{
+  m_schedulers.clear();
+  std::stringstream ss(names);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    Variant v;
+    v.m_name = name;
+    v.m_setScheduler = true;
+    v.m_seed = -1;
+    if (!ParseDLSchedulerType(name, &v.m_type))
+      return false;
+    m_schedulers.push_back(v);
+  }
+  return !m_schedulers.empty();
+}
+
+bool
+SnapshotManager::SetSeeds(const std::string& seeds)
+{
+  m_seeds.clear();
+  std::stringstream ss(seeds);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    int first, last;
+    char dash;
+    std::stringstream is(item);
+    if (!(is >> first) || first < 0)
+      return false;
+    last = first;
+    if (is >> dash && (dash != '-' || !(is >> last) || last < first))
+      return false;
+    for (int seed = first; seed <= last; seed++) {
+      m_seeds.push_back(seed);
+    }
+  }
+  return !m_seeds.empty();
+}
+
+void
+SnapshotManager::SetOutputPrefix(const std::string& prefix)
+{
+  m_prefix = prefix;
+}
+
+void
+SnapshotManager::SetNbJobs(int nbJobs)
+{
+  m_nbJobs = nbJobs < 1 ? 1 : nbJobs;
+}
+
+void
+SnapshotManager::Enable(double time)
+{
+  m_time = time;
+  Simulator::Init()->Schedule(time, &SnapshotManager::TakeSnapshot, this);
+}
+
+bool
+SnapshotManager::IsEnabled(void) const
+{
+  return m_time >= 0;
+}
+
+bool
+SnapshotManager::IsRestored(void) const
+{
+  return m_restored;
+}
+
+void
+SnapshotManager::AddTemporaryFile(const std::string& fname)
+{
+  m_temporaryFiles.push_back(fname);
+}
+
+void
+SnapshotManager::RemoveTemporaryFiles(void)
+{
+  if (m_restored)
+    return;
+  for (size_t i = 0; i < m_temporaryFiles.size(); i++) {
+    unlink(m_temporaryFiles[i].c_str());
+  }
+  m_temporaryFiles.clear();
+}
+
+// every scheduler with every seed
+void
+SnapshotManager::CreateVariants(void)
+{
+  std::vector<Variant> schedulers = m_schedulers;
+  if (schedulers.empty()) {
+    Variant v;
+    v.m_name = "current";
+    v.m_setScheduler = false;
+    v.m_seed = -1;
+    schedulers.push_back(v);
+  }
+  m_variants.clear();
+  for (size_t i = 0; i < schedulers.size(); i++) {
+    if (m_seeds.empty()) {
+      m_variants.push_back(schedulers[i]);
+    }
+    for (size_t j = 0; j < m_seeds.size(); j++) {
+      Variant v = schedulers[i];
+      v.m_seed = m_seeds[j];
+      v.m_name += "-seed" + std::to_string(v.m_seed);
+      m_variants.push_back(v);
+    }
+  }
+}
+
+void
+SnapshotManager::TakeSnapshot(void)
+{
+  if (m_schedulers.empty() && m_seeds.empty()) {
+    std::cerr << "ERROR: --snapshot-at needs --snapshot-schedulers or --snapshot-seeds"
+              << std::endl;
+    exit(1);
+  }
+  CreateVariants();
+  std::cerr << "snapshot at " << Simulator::Init()->Now() << ", restoring "
+            << m_variants.size() << " runs" << std::endl;
+
+  // the workers do not survive fork (), the children start their own
+  TtiExecutor* executor = TtiExecutor::Init();
+  int nbThreads = executor->GetNbThreads();
+  executor->SetNbThreads(1);
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+
+  /*
+   * The summaries are small enough to be written at once, and are read as
+   * the children end: a child never blocks on a full pipe for long.
+   */
+  int fds[2];
+  if (pipe(fds) != 0 || fcntl(fds[0], F_SETFL, O_NONBLOCK) != 0) {
+    std::cerr << "ERROR: unable to create the pipe of the restored runs" << std::endl;
+    exit(1);
+  }
+  std::vector<RunSummary> summaries(m_variants.size());
+  std::vector<bool> received(m_variants.size(), false);
+  std::map<pid_t, int> children;
+  std::vector<int> statuses(m_variants.size(), 0);
+
+  size_t next = 0;
+  int failed = 0;
+  while (next < m_variants.size() || !children.empty()) {
+    if (next < m_variants.size() && (int)children.size() < m_nbJobs) {
+      pid_t pid = fork();
+      if (pid < 0) {
+        std::cerr << "ERROR: unable to fork the run of " << m_variants[next].m_name
+                  << std::endl;
+        exit(1);
+      }
+      if (pid == 0) {
+        close(fds[0]);
+        m_summaryFd = fds[1];
+        m_restored = true;
+        executor->SetNbThreads(nbThreads);
+        Restore(next);
+        return;
+      }
+      children[pid] = next++;
+      continue;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0 && errno == EINTR)
+      continue;
+    if (pid < 0)
+      break;
+    statuses[children[pid]] = status;
+    children.erase(pid);
+
+    RunSummary summary;
+    while (read(fds[0], &summary, sizeof(summary)) == sizeof(summary)) {
+      if (summary.m_variant >= 0 && summary.m_variant < (int)m_variants.size()) {
+        summaries[summary.m_variant] = summary;
+        received[summary.m_variant] = true;
+      }
+    }
+  }
+  close(fds[0]);
+  close(fds[1]);
+
+  for (size_t i = 0; i < m_variants.size(); i++) {
+    bool ok = received[i] && WIFEXITED(statuses[i]) && WEXITSTATUS(statuses[i]) == 0;
+    if (!ok)
+      failed++;
+    PrintSummary(m_variants[i], received[i] ? &summaries[i] : NULL, ok ? 0 : 1);
+  }
+  RemoveTemporaryFiles();
+  std::cerr << "snapshot: " << m_variants.size() - failed << " of " << m_variants.size()
+            << " restored runs completed" << std::endl;
+  exit(failed > 0 ? 1 : 0);
+}
+
+void
+SnapshotManager::PrintSummary(const Variant& variant, const RunSummary* summary, int status)
+{
+  std::cerr << "RUN " << variant.m_name << " status " << (status == 0 ? "ok" : "failed");
+  if (summary != NULL) {
+    std::cerr << " sim_seconds " << summary->m_simulatedTime
+              << " wall_seconds " << summary->m_wallSeconds
+              << " events " << summary->m_events
+              << " scheduled_bytes " << summary->m_scheduledBytes
+              << " peak_rss_kb " << summary->m_peakRssKb;
+  }
+  std::cerr << std::endl;
+}
+
+uint64_t
+SnapshotManager::GetScheduledBytes(void)
+{
+  uint64_t bytes = 0;
+  NetworkManager* nm = NetworkManager::Init();
+  std::vector<ENodeB*> enbs = *nm->GetENodeBContainer();
+  enbs.insert(enbs.end(), nm->GetHomeENodeBContainer()->begin(),
+              nm->GetHomeENodeBContainer()->end());
+  for (size_t i = 0; i < enbs.size(); i++) {
+    RrcEntity::RadioBearersContainer* bearers =
+        enbs[i]->GetProtocolStack()->GetRrcEntity()->GetRadioBearerContainer();
+    for (size_t j = 0; j < bearers->size(); j++) {
+      bytes += bearers->at(j)->GetCumulateBytes();
+    }
+  }
+  return bytes;
+}
+
+void
+SnapshotManager::RunStopped(void)
+{
+  if (!m_restored || m_summaryFd < 0)
+    return;
+  Simulator* simulator = Simulator::Init();
+  RunSummary summary;
+  summary.m_variant = m_variant;
+  summary.m_reserved = 0;
+  summary.m_simulatedTime = simulator->Now() - m_time;
+  summary.m_wallSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - m_restoreTime).count();
+  summary.m_events = simulator->GetNbProcessedEvents() - m_restoreEvents;
+  summary.m_scheduledBytes = GetScheduledBytes();
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  summary.m_peakRssKb = usage.ru_maxrss;
+  if (write(m_summaryFd, &summary, sizeof(summary)) != sizeof(summary))
+    std::cerr << "ERROR: unable to send the summary of the run" << std::endl;
+  close(m_summaryFd);
+  m_summaryFd = -1;
+}
+
+// the replaced scheduler is left as it is, the process ends with the run
+void
+SnapshotManager::ReplaceScheduler(ENodeB* enb, ENodeB::DLSchedulerType type)
+{
+  if (enb->GetDLSchedulerType() == type)
+    return;
+  unsigned long ts = enb->GetDLScheduler()->GetTimeStamp();
+  enb->SetDLScheduler(type, enb->GetDLSchedulerConfig());
+  enb->GetDLScheduler()->SetTimeStamp(ts);
+}
+
+void
+SnapshotManager::Restore(int index)
+{
+  const Variant& variant = m_variants[index];
+  m_variant = index;
+  m_restoreTime = std::chrono::steady_clock::now();
+  m_restoreEvents = Simulator::Init()->GetNbProcessedEvents();
+
+  std::string base = m_prefix + "-" + variant.m_name;
+  std::string outName = m_prefix == "-" ? "/dev/null" : base + ".out";
+  std::string errName = m_prefix == "-" ? "/dev/null" : base + ".err";
+  int out = open(outName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  int err = open(errName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (out < 0 || err < 0 || dup2(out, STDOUT_FILENO) < 0 || dup2(err, STDERR_FILENO) < 0) {
+    std::cerr << "ERROR: unable to open " << base << ".out/.err" << std::endl;
+    _exit(1);
+  }
+  close(out);
+  close(err);
+
+  if (variant.m_setScheduler) {
+    NetworkManager* nm = NetworkManager::Init();
+    std::vector<ENodeB*>* enbs = nm->GetENodeBContainer();
+    for (size_t i = 0; i < enbs->size(); i++) {
+      ReplaceScheduler(enbs->at(i), variant.m_type);
+    }
+    std::vector<HeNodeB*>* henbs = nm->GetHomeENodeBContainer();
+    for (size_t i = 0; i < henbs->size(); i++) {
+      ReplaceScheduler(henbs->at(i), variant.m_type);
+    }
+  }
+  if (variant.m_seed >= 0) {
+    CounterRng::SetGlobalSeed(variant.m_seed < 9 ? GetCommonSeed(variant.m_seed)
+                                                 : variant.m_seed);
+  }
+  std::cerr << "restored snapshot at " << Simulator::Init()->Now()
+            << " as " << variant.m_name << std::endl;
+}
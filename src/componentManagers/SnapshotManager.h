@@ -0,0 +1,147 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef SNAPSHOTMANAGER_H_
+#define SNAPSHOTMANAGER_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../device/ENodeB.h"
+
+/*
+ * Snapshot of the simulation at time T, restored once per downlink
+ * scheduler and seed, so that a sweep simulates the common part once.
+ *
+ * The snapshot is the state of the process itself: at T the simulator
+ * stops dispatching and forks one child per (scheduler, seed). Each child
+ * shares the whole state copy-on-write (calendar, queues, bearers and their
+ * average rates, channel realizations, RNG streams), installs its scheduler
+ * on every eNB, rekeys the RNG streams with its seed and runs to the end.
+ * What a child prints from T on goes to PREFIX-NAME.out and PREFIX-NAME.err
+ * (NAME: the scheduler name, then -seedN), or nowhere with the prefix "-".
+ * When the simulation stops it sends a RunSummary to the parent through a
+ * pipe. The parent
+ * waits for its children, prints one RUN line per child on stderr and exits
+ * without running past T.
+ *
+ * With T = 0 the snapshot is taken right after the setup of the scenario,
+ * before the first event: a launcher of independent runs that share the
+ * topology, the parsed configs and the loaded traces.
+ *
+ * A run restored with the warm-up scheduler is identical to the run that
+ * never stopped. Another scheduler starts with a fresh state of its own
+ * (e.g. the per-slice EWMAs of NVS) but the TTI count; the per-bearer state
+ * it reads is warm. A seed changes what is drawn from T on, not the setup.
+ */
+class SnapshotManager {
+ public:
+  struct Variant {
+    std::string m_name;
+    bool m_setScheduler;  // false: keep the scheduler of the scenario
+    ENodeB::DLSchedulerType m_type;
+    int m_seed;  // -1: keep the streams of the scenario
+  };
+
+  // what a restored run reports to the parent, written at once to the pipe
+  struct RunSummary {
+    int32_t m_variant;
+    int32_t m_reserved;
+    double m_simulatedTime;  // simulated seconds from T
+    double m_wallSeconds;
+    uint64_t m_events;
+    uint64_t m_scheduledBytes;  // by all the DL schedulers, from the start
+    int64_t m_peakRssKb;
+  };
+
+ private:
+  SnapshotManager();
+  static SnapshotManager* ptr;
+
+  double m_time;
+  std::string m_prefix;
+  int m_nbJobs;
+  std::vector<Variant> m_schedulers;
+  std::vector<int> m_seeds;
+  std::vector<Variant> m_variants;
+  std::vector<std::string> m_temporaryFiles;
+  bool m_restored;
+
+  // in a restored run
+  int m_variant;
+  int m_summaryFd;
+  std::chrono::steady_clock::time_point m_restoreTime;
+  uint64_t m_restoreEvents;
+
+  void CreateVariants(void);
+  void TakeSnapshot(void);
+  void Restore(int variant);
+  void ReplaceScheduler(ENodeB* enb, ENodeB::DLSchedulerType type);
+  void PrintSummary(const Variant& variant, const RunSummary* summary, int status);
+  static uint64_t GetScheduledBytes(void);
+
+ public:
+  virtual ~SnapshotManager();
+
+  static SnapshotManager* Init(void) {
+    if (ptr == NULL) {
+      ptr = new SnapshotManager;
+    }
+    return ptr;
+  }
+
+  // pf, mlwdf, exp, fls, log-rule, exp-rule, nvs, nvs-nongreedy,
+  // sequential, subopt, maxcell, vogel, upperbound
+  static bool ParseDLSchedulerType(const std::string& name, ENodeB::DLSchedulerType* type);
+
+  // comma-separated scheduler names; false on an unknown name
+  bool SetSchedulers(const std::string& names);
+  /*
+   * Comma-separated seeds or ranges (1-8); false on a syntax error. Seeds
+   * 0-8 are the common seeds of the scenarios, the others are used as is.
+   */
+  bool SetSeeds(const std::string& seeds);
+  void SetOutputPrefix(const std::string& prefix);
+  // restored runs executed at once, the number of processors by default
+  void SetNbJobs(int nbJobs);
+
+  // schedules the snapshot at time, to be called before the simulation runs
+  void Enable(double time);
+  bool IsEnabled(void) const;
+  // true in the restored runs
+  bool IsRestored(void) const;
+
+  /*
+   * Files the restored runs still read (scheduler configs written by the
+   * scenario), removed by RemoveTemporaryFiles once no run needs them.
+   * A restored run never removes them, the next ones may not be forked yet.
+   */
+  void AddTemporaryFile(const std::string& fname);
+  void RemoveTemporaryFiles(void);
+
+  // called by the Simulator when the run stops; sends the RunSummary
+  void RunStopped(void);
+};
+
+#endif /* SNAPSHOTMANAGER_H_ */
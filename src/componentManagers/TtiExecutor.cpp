@@ -0,0 +1,138 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "TtiExecutor.h"
+
+TtiExecutor* TtiExecutor::ptr = NULL;
+
+TtiExecutor::TtiExecutor()
+{
+  m_nbThreads = 1;
+  m_generation = 0;
+  m_stop = false;
+  m_job = NULL;
+  m_nbJobs = 0;
+  m_nextJob = 0;
+  m_busyWorkers = 0;
+}
+
+TtiExecutor::~TtiExecutor()
+{
+  StopWorkers();
+}
+
+void
+TtiExecutor::SetNbThreads(int nbThreads)
+{
+  if (nbThreads < 1)
+    nbThreads = 1;
+  StopWorkers();
+  m_nbThreads = nbThreads;
+  if (m_nbThreads > 1) {
+    m_stop = false;
+    for (int i = 1; i < m_nbThreads; i++) {
+      m_workers.push_back(std::thread(&TtiExecutor::WorkerLoop, this));
+    }
+  }
+}
+
+int
+TtiExecutor::GetNbThreads(void) const
+{
+  return m_nbThreads;
+}
+
+bool
+TtiExecutor::IsParallel(void) const
+{
+  return m_nbThreads > 1;
+}
+
+void
+TtiExecutor::StopWorkers(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_all();
+  for (size_t i = 0; i < m_workers.size(); i++) {
+    m_workers[i].join();
+  }
+  m_workers.clear();
+}
+
+void
+TtiExecutor::RunJobs(void)
+{
+  int i;
+  while ((i = m_nextJob.fetch_add(1)) < m_nbJobs) {
+    (*m_job)(i);
+  }
+}
+
+void
+TtiExecutor::WorkerLoop(void)
+{
+  unsigned long seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wakeUp.wait(lock, [&] { return m_stop || m_generation != seen; });
+      if (m_stop)
+        return;
+      seen = m_generation;
+    }
+    RunJobs();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_busyWorkers == 0)
+        m_finished.notify_one();
+    }
+  }
+}
+
+void
+TtiExecutor::ParallelFor(int nbJobs, const std::function<void(int)>& job)
+{
+  if (m_workers.empty() || nbJobs < 2) {
+    for (int i = 0; i < nbJobs; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_job = &job;
+    m_nbJobs = nbJobs;
+    m_nextJob = 0;
+    m_busyWorkers = m_workers.size();
+    m_generation++;
+  }
+  m_wakeUp.notify_all();
+  RunJobs();
+
+  // every worker has to leave RunJobs before the next phase reuses m_job
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [&] { return m_busyWorkers == 0; });
+  m_job = NULL;
+}
@@ -0,0 +1,82 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef TTIEXECUTOR_H_
+#define TTIEXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Worker pool of the parallel TTI (see FrameManager::ParallelResourceAllocation).
+ *
+ * ParallelFor hands out the jobs of one phase to the workers and to the
+ * calling thread, and returns once all of them have completed, which is the
+ * barrier between two phases. With one thread (the default) nothing is
+ * started and the simulator keeps its sequential event flow.
+ */
+class TtiExecutor {
+ private:
+  TtiExecutor();
+  static TtiExecutor* ptr;
+
+  int m_nbThreads;
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wakeUp;
+  std::condition_variable m_finished;
+  unsigned long m_generation;  // one per ParallelFor
+  bool m_stop;
+
+  const std::function<void(int)>* m_job;
+  int m_nbJobs;
+  std::atomic<int> m_nextJob;
+  int m_busyWorkers;
+
+  void WorkerLoop(void);
+  void RunJobs(void);
+  void StopWorkers(void);
+
+ public:
+  virtual ~TtiExecutor();
+
+  static TtiExecutor* Init(void) {
+    if (ptr == NULL) {
+      ptr = new TtiExecutor;
+    }
+    return ptr;
+  }
+
+  // threads used per TTI, the calling one included
+  void SetNbThreads(int nbThreads);
+  int GetNbThreads(void) const;
+  bool IsParallel(void) const;
+
+  // runs job (0) ... job (nbJobs - 1) and waits for all of them
+  void ParallelFor(int nbJobs, const std::function<void(int)>& job);
+};
+
+#endif /* TTIEXECUTOR_H_ */
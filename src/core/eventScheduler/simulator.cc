@@ -24,8 +24,12 @@
 #include "simulator.h"
 #include "make-event.h"
 #include "../../componentManagers/FrameManager.h"
+#include "../../componentManagers/SnapshotManager.h"
 
+#include <cxxabi.h>
 #include <math.h>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <list>
 #include <vector>
@@ -42,7 +46,10 @@ Simulator::Simulator ()
   m_currentTs = 0;
   m_unscheduledEvents = 0;
   m_calendar = new Calendar;
+  m_timingWheel = new TimingWheel;
   m_uid = 0;
+  m_nbProcessedEvents = 0;
+  m_profileEvents = false;
 }
 
 Simulator::~Simulator ()
@@ -52,6 +59,7 @@ Simulator::~Simulator ()
 	  m_calendar->RemoveEvent ();
     }
   delete m_calendar;
+  delete m_timingWheel;
 }
 
 double
@@ -84,8 +92,21 @@ Simulator::ProcessOneEvent(void)
   --m_unscheduledEvents;
   m_currentTs = next->GetTimeStamp();
   m_currentUid = next->GetUID();
+  ++m_nbProcessedEvents;
 
-  next->RunEvent();
+  if (m_profileEvents)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+      next->RunEvent();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+      EventProfile &profile = m_eventProfiles[std::type_index (typeid (*next))];
+      profile.m_count++;
+      profile.m_seconds += elapsed.count ();
+    }
+  else
+    {
+      next->RunEvent();
+    }
 
   m_calendar->RemoveEvent();
 }
@@ -97,12 +118,75 @@ Simulator::GetUID (void)
   return (m_uid-1);
 }
 
+uint64_t
+Simulator::GetNbProcessedEvents (void) const
+{
+  return m_nbProcessedEvents;
+}
+
+void
+Simulator::SetEventProfiling (bool enabled)
+{
+  m_profileEvents = enabled;
+}
+
+/*
+ * The events are local classes of the MakeEvent templates, so the demangled
+ * type reads "MakeEvent<void (ENodeB::*)(), ENodeB*>(...)::EventMemberImpl0":
+ * the class of the object is the one before "::*".
+ */
+static std::string
+GetEventClass (const std::type_index& type)
+{
+  int status;
+  char *demangled = abi::__cxa_demangle (type.name (), NULL, NULL, &status);
+  if (status != 0)
+    {
+      return type.name ();
+    }
+  std::string name (demangled);
+  free (demangled);
+
+  size_t end = name.find ("::*");
+  if (end == std::string::npos)
+    {
+      return "function";
+    }
+  size_t begin = name.rfind ('(', end);
+  return name.substr (begin + 1, end - begin - 1);
+}
+
+void
+Simulator::PrintEventProfile (std::ostream& out, const std::string& prefix)
+{
+  // several event types run on the same class
+  std::unordered_map<std::string, EventProfile> classes;
+  for (auto it = m_eventProfiles.begin (); it != m_eventProfiles.end (); ++it)
+    {
+      EventProfile &profile = classes[GetEventClass (it->first)];
+      profile.m_count += it->second.m_count;
+      profile.m_seconds += it->second.m_seconds;
+    }
+
+  std::vector<std::pair<std::string, EventProfile> > sorted (classes.begin (), classes.end ());
+  std::sort (sorted.begin (), sorted.end (),
+             [] (const std::pair<std::string, EventProfile>& a,
+                 const std::pair<std::string, EventProfile>& b)
+             { return a.second.m_seconds > b.second.m_seconds; });
+  for (size_t i = 0; i < sorted.size (); i++)
+    {
+      out << prefix << sorted[i].first << " " << sorted[i].second.m_count
+          << " " << sorted[i].second.m_seconds << std::endl;
+    }
+}
+
 void 
 Simulator::Stop (void)
 {
   std::cout << " SIMULATOR_DEBUG: Stop ()"
       << std::endl;
   m_stop = true;
+  SnapshotManager::Init ()->RunStopped ();
 }
 
 void 
@@ -125,6 +209,12 @@ Simulator::DoSchedule (double time,
   m_calendar->InsertEvent(event);
 }
 
+void
+Simulator::CancelPeriodic (int taskId)
+{
+  m_timingWheel->Cancel (taskId);
+}
+
 void
 Simulator::PrintMemoryUsage (void)
 {
@@ -26,10 +26,13 @@
 
 #include <iostream>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 
 #include "calendar.h"
 #include "event.h"
 #include "make-event.h"
+#include "timing-wheel.h"
 
 /*
  * Simulator
@@ -42,6 +45,7 @@ class Simulator {
   static Simulator *ptr;
 
   Calendar *m_calendar;
+  TimingWheel *m_timingWheel;
   bool m_stop;
   int m_currentUid;
   double m_currentTs;
@@ -49,6 +53,16 @@ class Simulator {
 
   int m_uid;
 
+  uint64_t m_nbProcessedEvents;
+
+  // wall time spent in the events, per event type
+  struct EventProfile {
+    uint64_t m_count;
+    double m_seconds;
+  };
+  bool m_profileEvents;
+  std::unordered_map<std::type_index, EventProfile> m_eventProfiles;
+
   void ProcessOneEvent(void);
 
  public:
@@ -69,6 +83,17 @@ class Simulator {
 
   int GetUID(void);
 
+  uint64_t GetNbProcessedEvents(void) const;
+
+  /*
+   * Times every event and accounts it to the class of the object it runs
+   * on (FrameManager, ENodeB, VoIP, ...), i.e. to the subsystem. Costs two
+   * clock reads per event, so it is off by default.
+   */
+  void SetEventProfiling(bool enabled);
+  // one line per class: name, events, seconds; the most expensive first
+  void PrintEventProfile(std::ostream& out, const std::string& prefix);
+
   void DoSchedule(double time, Event *event);
 
   /*
@@ -95,6 +120,16 @@ class Simulator {
   template <typename U1, typename T1>
   void Schedule(double time, void (*f)(U1), T1 a1);
 
+  /*
+   * Periodic tasks, run every period TTIs from period TTIs from now until
+   * cancelled, by the timing wheel instead of the calendar: use them for
+   * what reschedules itself every TTI (or every few TTIs). Tasks due in the
+   * same TTI run back to back, in the order they were scheduled.
+   */
+  template <typename MEM, typename OBJ>
+  int SchedulePeriodic(int period, MEM mem_ptr, OBJ obj);
+  void CancelPeriodic(int taskId);
+
   void PrintMemoryUsage(void);
 };
 
@@ -119,6 +154,11 @@ void Simulator::Schedule(double time, MEM mem_ptr, OBJ obj, T1 a1, T2 a2,
   DoSchedule(time, MakeEvent(mem_ptr, obj, a1, a2, a3));
 }
 
+template <typename MEM, typename OBJ>
+int Simulator::SchedulePeriodic(int period, MEM mem_ptr, OBJ obj) {
+  return m_timingWheel->Register(period, MakeEvent(mem_ptr, obj));
+}
+
 /*
 void
 Simulator::Schedule (double time, void (*f) (void))
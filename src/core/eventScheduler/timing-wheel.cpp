@@ -0,0 +1,159 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "timing-wheel.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include "event.h"
+#include "make-event.h"
+#include "simulator.h"
+
+#define LEVEL0_BITS 8
+#define LEVEL0_SLOTS (1 << LEVEL0_BITS)
+#define LEVEL1_SLOTS 64
+#define LEVEL1_SPAN (LEVEL0_SLOTS * LEVEL1_SLOTS)
+
+TimingWheel::TimingWheel()
+    : m_nbTasks(0), m_nbStored(0), m_slot(0), m_scheduled(false), m_nextTick(0) {}
+
+TimingWheel::~TimingWheel() {
+  for (size_t i = 0; i < m_tasks.size(); i++) {
+    if (m_tasks[i] != NULL) {
+      delete m_tasks[i]->m_event;
+      delete m_tasks[i];
+    }
+  }
+}
+
+int TimingWheel::Register(int period, Event* task) {
+  if (period < 1) {
+    std::cerr << "ERROR: periodic task with a period of " << period
+              << " TTIs" << std::endl;
+    exit(1);
+  }
+  Task* t = new Task;
+  t->m_id = m_tasks.size();
+  t->m_period = period;
+  t->m_due = CurrentSlot() + period;
+  t->m_event = task;
+  t->m_cancelled = false;
+  m_tasks.push_back(t);
+  m_nbTasks++;
+  m_nbStored++;
+  Insert(t);
+
+  if (!m_scheduled) {
+    ScheduleTick();
+  }
+  return t->m_id;
+}
+
+void TimingWheel::Cancel(int id) {
+  Task* t = m_tasks.at(id);
+  if (t == NULL || t->m_cancelled) return;
+  // deleted when the wheel gets to its slot
+  t->m_cancelled = true;
+  m_nbTasks--;
+}
+
+int64_t TimingWheel::CurrentSlot(void) const {
+  // the tick of the next slot may be due now, not run yet
+  if (m_scheduled &&
+      Simulator::Init()->Now() > m_nextTick - TIMING_WHEEL_TTI / 2) {
+    return m_slot + 1;
+  }
+  return m_slot;
+}
+
+void TimingWheel::Insert(Task* task) {
+  int64_t delta = task->m_due - m_slot;
+  if (delta < LEVEL0_SLOTS) {
+    m_level0[task->m_due & (LEVEL0_SLOTS - 1)].push_back(task);
+  } else if (delta < LEVEL1_SPAN) {
+    m_level1[(task->m_due >> LEVEL0_BITS) % LEVEL1_SLOTS].push_back(task);
+  } else {
+    m_overflow.push_back(task);
+  }
+}
+
+void TimingWheel::Cascade(void) {
+  // at the first slot of a round of the first level
+  if ((m_slot & (LEVEL0_SLOTS - 1)) != 0) return;
+
+  if ((m_slot % LEVEL1_SPAN) == 0 && !m_overflow.empty()) {
+    m_batch.swap(m_overflow);
+    for (size_t i = 0; i < m_batch.size(); i++) Insert(m_batch[i]);
+    m_batch.clear();
+  }
+  std::vector<Task*>& slot = m_level1[(m_slot >> LEVEL0_BITS) % LEVEL1_SLOTS];
+  if (!slot.empty()) {
+    m_batch.swap(slot);
+    for (size_t i = 0; i < m_batch.size(); i++) Insert(m_batch[i]);
+    m_batch.clear();
+  }
+}
+
+void TimingWheel::ScheduleTick(void) {
+  m_scheduled = true;
+  m_nextTick = Simulator::Init()->Now() + TIMING_WHEEL_TTI;
+  Simulator::Init()->Schedule(TIMING_WHEEL_TTI, &TimingWheel::Tick, this);
+}
+
+void TimingWheel::Tick(void) {
+  m_slot++;
+  Cascade();
+
+  // the tasks registered while the batch runs count from this slot
+  m_nextTick = Simulator::Init()->Now() + TIMING_WHEEL_TTI;
+
+  m_batch.swap(m_level0[m_slot & (LEVEL0_SLOTS - 1)]);
+  // tasks of different periods reach the slot from different places
+  auto registered = [](const Task* a, const Task* b) { return a->m_id < b->m_id; };
+  if (!std::is_sorted(m_batch.begin(), m_batch.end(), registered)) {
+    std::sort(m_batch.begin(), m_batch.end(), registered);
+  }
+  for (size_t i = 0; i < m_batch.size(); i++) {
+    Task* t = m_batch[i];
+    if (!t->m_cancelled) {
+      t->m_event->RunEvent();
+    }
+    if (t->m_cancelled) {
+      m_tasks[t->m_id] = NULL;
+      delete t->m_event;
+      delete t;
+      m_nbStored--;
+    } else {
+      t->m_due += t->m_period;
+      Insert(t);
+    }
+  }
+  m_batch.clear();
+
+  if (m_nbStored > 0) {
+    ScheduleTick();
+  } else {
+    m_scheduled = false;
+  }
+}
@@ -0,0 +1,92 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef TIMING_WHEEL_H_
+#define TIMING_WHEEL_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+class Event;
+
+#define TIMING_WHEEL_TTI 0.001
+
+/*
+ * Periodic tasks with a period of whole TTIs. A task registers once and is
+ * run every period until it is cancelled, instead of rescheduling itself in
+ * the calendar each time.
+ *
+ * The wheel has one slot per TTI (256 of them), a second level of 64 slots
+ * of 256 TTIs each for the tasks due later, and an overflow list beyond
+ * that; the far tasks move down a level when the wheel gets to their slot.
+ * While it holds tasks, the wheel puts a single event per TTI in the
+ * calendar, which runs all the tasks due in that TTI back to back, in the
+ * order they were registered.
+ *
+ * The tick is rescheduled 1 ms after the previous one, as the tasks did
+ * themselves, so a task registered at the same time as a chain it replaces
+ * runs at the same timestamps.
+ */
+class TimingWheel {
+ public:
+  TimingWheel();
+  virtual ~TimingWheel();
+
+  // runs task every period TTIs, the first time period TTIs from now; the
+  // wheel owns the event. Returns the id of the task.
+  int Register(int period, Event* task);
+  // the task is not run anymore, also when called from the task itself
+  void Cancel(int id);
+
+  int GetNbTasks(void) const { return m_nbTasks; }
+
+ private:
+  struct Task {
+    int m_id;
+    int m_period;
+    int64_t m_due;  // slot
+    Event* m_event;
+    bool m_cancelled;
+  };
+
+  void Tick(void);
+  // the slot a task registered now counts from
+  int64_t CurrentSlot(void) const;
+  void Insert(Task* task);
+  void Cascade(void);
+  void ScheduleTick(void);
+
+  std::vector<Task*> m_level0[256];
+  std::vector<Task*> m_level1[64];
+  std::vector<Task*> m_overflow;
+  std::vector<Task*> m_batch;  // the slot being fired, or cascaded
+
+  std::vector<Task*> m_tasks;  // by id, NULL once deleted
+  int m_nbTasks;               // not cancelled
+  int m_nbStored;              // in the slots, cancelled or not
+
+  int64_t m_slot;     // the last slot fired
+  bool m_scheduled;   // a tick is in the calendar
+  double m_nextTick;  // its timestamp
+};
+
+#endif /* TIMING_WHEEL_H_ */
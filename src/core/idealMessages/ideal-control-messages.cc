@@ -22,6 +22,7 @@
 
 #include "ideal-control-messages.h"
 #include "../../device/NetworkNode.h"
+#include "../../device/ENodeB.h"
 
 
 IdealControlMessage::IdealControlMessage (void)
@@ -85,6 +86,8 @@ IdealControlMessage::GetMessageType (void)
 PdcchMapIdealControlMessage::PdcchMapIdealControlMessage (void)
 {
   m_idealPdcchMessage =  new IdealPdcchMessage ();
+  m_grantRecords = NULL;
+  m_grants = NULL;
   SetMessageType (IdealControlMessage::ALLOCATION_MAP);
 }
 
@@ -116,6 +119,70 @@ PdcchMapIdealControlMessage::GetMessage (void)
 }
 
 
+void
+PdcchMapIdealControlMessage::IndexGrants (ENodeB *enb, std::vector<Grant> *grants,
+                                          IdealPdcchMessage *grantRecords)
+{
+  grants->assign (enb->GetNbOfUserEquipmentRecords (), Grant {0, 0});
+
+  //count the records of each UE
+  for (IdealPdcchMessage::iterator it = m_idealPdcchMessage->begin ();
+       it != m_idealPdcchMessage->end (); it++)
+    {
+      ENodeB::UserEquipmentRecord *ue = enb->GetUserEquipmentRecord ((*it).m_ue->GetIDNetworkNode ());
+      if (ue != NULL)
+        {
+          grants->at (ue->GetIndex ()).m_nbRecords++;
+        }
+    }
+
+  //give each UE a range of grantRecords
+  int first = 0;
+  for (std::vector<Grant>::iterator it = grants->begin (); it != grants->end (); it++)
+    {
+      (*it).m_firstRecord = first;
+      first += (*it).m_nbRecords;
+      (*it).m_nbRecords = 0;
+    }
+
+  //copy the records into the ranges, keeping their order
+  grantRecords->resize (first);
+  for (IdealPdcchMessage::iterator it = m_idealPdcchMessage->begin ();
+       it != m_idealPdcchMessage->end (); it++)
+    {
+      ENodeB::UserEquipmentRecord *ue = enb->GetUserEquipmentRecord ((*it).m_ue->GetIDNetworkNode ());
+      if (ue != NULL)
+        {
+          Grant &grant = grants->at (ue->GetIndex ());
+          grantRecords->at (grant.m_firstRecord + grant.m_nbRecords) = *it;
+          grant.m_nbRecords++;
+        }
+    }
+
+  m_grants = grants;
+  m_grantRecords = grantRecords;
+}
+
+
+const PdcchMapIdealControlMessage::Grant*
+PdcchMapIdealControlMessage::GetGrant (int ueIndex) const
+{
+  if (m_grants == NULL || ueIndex < 0 || ueIndex >= (int) m_grants->size ()
+      || m_grants->at (ueIndex).m_nbRecords == 0)
+    {
+      return NULL;
+    }
+  return &m_grants->at (ueIndex);
+}
+
+
+const PdcchMapIdealControlMessage::IdealPdcchMessage&
+PdcchMapIdealControlMessage::GetGrantRecords (void) const
+{
+  return *m_grantRecords;
+}
+
+
 
 // ----------------------------------------------------------------------------------------------------------
 
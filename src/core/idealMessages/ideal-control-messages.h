@@ -65,9 +65,10 @@ class IdealControlMessage {
 #ifndef PDCCH_MAP_IDEAL_CONTROL_MESSAGES_H
 #define PDCCH_MAP_IDEAL_CONTROL_MESSAGES_H
 
-#include <list>
+#include <vector>
 
 class NetworkNode;
+class ENodeB;
 
 /*
  * The PdcchMapIdealControlMessage defines an ideal allocation map
@@ -83,6 +84,12 @@ class NetworkNode;
  * When the IdealPdcchMessage is sent under an ideal control channel,
  * all UE stores into a proper variables the informations about
  * the resource mapping.
+ *
+ * Before sending, the eNodeB indexes the records by the position of each
+ * UE in its UE records (IndexGrants): each UE then finds its own records
+ * with one lookup instead of scanning the records of all the UEs of the
+ * cell. The index lives in storage the eNodeB reuses from one TTI to the
+ * next, and stays valid while the message is delivered.
  */
 class PdcchMapIdealControlMessage : public IdealControlMessage {
  public:
@@ -98,15 +105,32 @@ class PdcchMapIdealControlMessage : public IdealControlMessage {
     double m_mcsIndex;
   };
 
-  typedef std::list<struct IdealPdcchRecord> IdealPdcchMessage;
+  typedef std::vector<struct IdealPdcchRecord> IdealPdcchMessage;
+
+  // the records of a UE: m_nbRecords from m_firstRecord in GetGrantRecords
+  struct Grant {
+    int m_firstRecord;
+    int m_nbRecords;
+  };
 
   void AddNewRecord(Direction direction, int subChannel, NetworkNode* ue,
                     double mcs);
 
   IdealPdcchMessage* GetMessage(void);
 
+  // to be called once all the records are added, with the storage of enb
+  void IndexGrants(ENodeB* enb, std::vector<Grant>* grants,
+                   IdealPdcchMessage* grantRecords);
+  // by the index of the UE record in the eNodeB; NULL if the UE has no record
+  const Grant* GetGrant(int ueIndex) const;
+  // the records grouped by UE, in the order they were added for each UE
+  const IdealPdcchMessage& GetGrantRecords(void) const;
+
  private:
   IdealPdcchMessage* m_idealPdcchMessage;
+
+  const IdealPdcchMessage* m_grantRecords;
+  const std::vector<Grant>* m_grants;
 };
 
 #endif /* PDCCH_MAP_IDEAL_CONTROL_MESSAGES_H */
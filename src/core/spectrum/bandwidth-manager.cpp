@@ -306,7 +306,7 @@ BandwidthManager::SetDlSubChannels (std::vector<double> s)
   m_dlSubChannels = s;
 }
 
-std::vector<double>
+const std::vector<double>&
 BandwidthManager::GetDlSubChannels (void)
 {
   return m_dlSubChannels;
@@ -318,7 +318,7 @@ BandwidthManager::SetUlSubChannels (std::vector<double> s)
   m_ulSubChannels = s;
 }
 
-std::vector<double>
+const std::vector<double>&
 BandwidthManager::GetUlSubChannels (void)
 {
   return m_ulSubChannels;
@@ -38,10 +38,10 @@ class BandwidthManager {
   virtual ~BandwidthManager();
 
   void SetDlSubChannels(std::vector<double> s);
-  std::vector<double> GetDlSubChannels(void);
+  const std::vector<double>& GetDlSubChannels(void);
 
   void SetUlSubChannels(std::vector<double> s);
-  std::vector<double> GetUlSubChannels(void);
+  const std::vector<double>& GetUlSubChannels(void);
 
   void SetOperativeSubBand(int s);
   int GetOperativeSubBand(void);
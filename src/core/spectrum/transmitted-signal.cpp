@@ -31,13 +31,13 @@ TransmittedSignal::~TransmittedSignal()
 {}
 
 void
-TransmittedSignal::SetValues (std::vector<double> values)
+TransmittedSignal::SetValues (const std::vector<double>& values)
 {
   m_values = values;
 }
 
-std::vector<double>
-TransmittedSignal::Getvalues (void)
+const std::vector<double>&
+TransmittedSignal::Getvalues (void) const
 {
   return m_values;
 }
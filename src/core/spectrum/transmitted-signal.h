@@ -30,8 +30,8 @@ class TransmittedSignal {
   TransmittedSignal();
   virtual ~TransmittedSignal();
 
-  void SetValues(std::vector<double> values);
-  std::vector<double> Getvalues(void);
+  void SetValues(const std::vector<double>& values);
+  const std::vector<double>& Getvalues(void) const;
 
   TransmittedSignal* Copy(void);
 
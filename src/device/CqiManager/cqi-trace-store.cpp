@@ -0,0 +1,321 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "cqi-trace-store.h"
+#include "../../load-parameters.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#define CQI_TRACE_MAGIC 0x49514352  // "RCQI"
+#define CQI_TRACE_VERSION 2
+
+CqiTraceStore* CqiTraceStore::ptr = NULL;
+
+CqiTraceStore::CqiTraceStore()
+{
+  m_fd = -1;
+  m_size = 0;
+  m_data = NULL;
+  m_header = NULL;
+  m_index = NULL;
+}
+
+CqiTraceStore::~CqiTraceStore()
+{
+  Close();
+}
+
+CqiTraceStore*
+CqiTraceStore::Init(void)
+{
+  if (ptr == NULL) {
+    ptr = new CqiTraceStore;
+    std::string dir = path + CQI_TRACE_DIR;
+    std::string fname = dir + CQI_TRACE_BINARY;
+    if (access(fname.c_str(), R_OK) != 0 || !ptr->Open(fname) ||
+        !ptr->IsUpToDate(dir)) {
+      ptr->Close();
+      std::cerr << "compiling cqi traces into " << fname << std::endl;
+      if (!Compile(dir, fname)) {
+        std::cerr << "ERROR: unable to compile the cqi traces in "
+          << dir << std::endl;
+        exit(1);
+      }
+    }
+    if ((ptr->m_data == NULL && !ptr->Open(fname)) ||
+        !ptr->LoadUserMapping(dir + "mapping.config")) {
+      std::cerr << "ERROR: unable to load the cqi traces in "
+        << dir << std::endl;
+      exit(1);
+    }
+  }
+  return ptr;
+}
+
+// parse one report line, return the number of values read
+static int
+ParseReportLine(const std::string& line, std::vector<uint8_t>& cqi)
+{
+  cqi.clear();
+  const char* p = line.c_str();
+  char* end;
+  while (true) {
+    long v = strtol(p, &end, 10);
+    if (end == p)
+      break;
+    if (v < 0) v = 0;
+    if (v > 15) v = 15;
+    cqi.push_back((uint8_t)v);
+    p = end;
+  }
+  return cqi.size();
+}
+
+static std::string
+GetLogName(const std::string& traceDir, int traceId)
+{
+  return traceDir + "ue" + std::to_string(traceId) + ".log";
+}
+
+// the size and the modification time (ns) of a log, -1 when there is none
+static void
+GetSourceStamp(const std::string& fname, int64_t* size, int64_t* mtime)
+{
+  struct stat st;
+  if (stat(fname.c_str(), &st) != 0) {
+    *size = -1;
+    *mtime = -1;
+    return;
+  }
+  *size = st.st_size;
+  *mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+bool
+CqiTraceStore::Compile(const std::string& traceDir,
+                       const std::string& binaryFile,
+                       int maxReports)
+{
+  std::vector<std::vector<std::vector<uint8_t>>> traces(CQI_TRACE_MAX_UE);
+  int nb_rbs = 0;
+  for (int t = 0; t < CQI_TRACE_MAX_UE; ++t) {
+    std::ifstream ifs(GetLogName(traceDir, t), std::ifstream::in);
+    if (!ifs.is_open())
+      continue;
+    std::string line;
+    std::vector<uint8_t> report;
+    while ((int)traces[t].size() < maxReports && std::getline(ifs, line)) {
+      if (ParseReportLine(line, report) == 0)
+        continue;
+      if (nb_rbs == 0)
+        nb_rbs = report.size();
+      traces[t].push_back(report);
+    }
+  }
+  if (nb_rbs == 0)
+    return false;
+
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.m_magic = CQI_TRACE_MAGIC;
+  header.m_version = CQI_TRACE_VERSION;
+  header.m_nbTraces = CQI_TRACE_MAX_UE;
+  header.m_nbRbs = nb_rbs;
+  header.m_rowBytes = (nb_rbs + 1) / 2;
+
+  std::vector<IndexEntry> index(CQI_TRACE_MAX_UE);
+  uint64_t offset = sizeof(FileHeader) + sizeof(IndexEntry) * index.size();
+  for (int t = 0; t < CQI_TRACE_MAX_UE; ++t) {
+    memset(&index[t], 0, sizeof(IndexEntry));
+    index[t].m_offset = offset;
+    index[t].m_nbReports = traces[t].size();
+    GetSourceStamp(GetLogName(traceDir, t), &index[t].m_sourceSize,
+                   &index[t].m_sourceMtime);
+    offset += (uint64_t)header.m_rowBytes * traces[t].size();
+  }
+
+  // write to a private file first, concurrent runs may compile at once
+  std::string tmp = binaryFile + ".tmp." + std::to_string(getpid());
+  FILE* fp = fopen(tmp.c_str(), "wb");
+  if (fp == NULL)
+    return false;
+  bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+  ok = ok && fwrite(index.data(), sizeof(IndexEntry), index.size(), fp) == index.size();
+  std::vector<uint8_t> row(header.m_rowBytes);
+  for (int t = 0; ok && t < CQI_TRACE_MAX_UE; ++t) {
+    for (auto& report : traces[t]) {
+      std::fill(row.begin(), row.end(), 0);
+      for (int rb = 0; rb < nb_rbs; ++rb) {
+        // a short line repeats its last value, as the text parser did
+        uint8_t v = rb < (int)report.size() ? report[rb] : report.back();
+        row[rb >> 1] |= v << ((rb & 1) << 2);
+      }
+      ok = ok && fwrite(row.data(), 1, row.size(), fp) == row.size();
+    }
+  }
+  ok = (fclose(fp) == 0) && ok;
+  if (!ok || rename(tmp.c_str(), binaryFile.c_str()) != 0) {
+    unlink(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool
+CqiTraceStore::Open(const std::string& binaryFile)
+{
+  Close();
+  m_fd = open(binaryFile.c_str(), O_RDONLY);
+  if (m_fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(m_fd, &st) != 0 || (size_t)st.st_size < sizeof(FileHeader)) {
+    Close();
+    return false;
+  }
+  m_size = st.st_size;
+  void* addr = mmap(NULL, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+  if (addr == MAP_FAILED) {
+    m_size = 0;
+    Close();
+    return false;
+  }
+  m_data = (const uint8_t*)addr;
+  m_header = (const FileHeader*)m_data;
+  m_index = (const IndexEntry*)(m_data + sizeof(FileHeader));
+  if (m_header->m_magic != CQI_TRACE_MAGIC ||
+      m_header->m_version != CQI_TRACE_VERSION ||
+      sizeof(FileHeader) + sizeof(IndexEntry) * m_header->m_nbTraces > m_size) {
+    Close();
+    return false;
+  }
+  for (uint32_t t = 0; t < m_header->m_nbTraces; ++t) {
+    if (m_index[t].m_offset +
+        (uint64_t)m_index[t].m_nbReports * m_header->m_rowBytes > m_size) {
+      Close();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+CqiTraceStore::IsUpToDate(const std::string& traceDir) const
+{
+  for (uint32_t t = 0; t < m_header->m_nbTraces; ++t) {
+    int64_t size, mtime;
+    GetSourceStamp(GetLogName(traceDir, t), &size, &mtime);
+    if (size != m_index[t].m_sourceSize || mtime != m_index[t].m_sourceMtime)
+      return false;
+  }
+  return true;
+}
+
+void
+CqiTraceStore::Close(void)
+{
+  if (m_data != NULL)
+    munmap((void*)m_data, m_size);
+  if (m_fd >= 0)
+    close(m_fd);
+  m_fd = -1;
+  m_size = 0;
+  m_data = NULL;
+  m_header = NULL;
+  m_index = NULL;
+}
+
+bool
+CqiTraceStore::LoadUserMapping(const std::string& mappingFile)
+{
+  std::ifstream ifs(mappingFile, std::ifstream::in);
+  if (!ifs.is_open())
+    return false;
+  m_userMapping.clear();
+  int uid, tid;
+  while (ifs >> uid >> tid) {
+    m_userMapping.push_back(tid);
+  }
+  return m_userMapping.size() > 0;
+}
+
+int
+CqiTraceStore::GetNbTraces(void) const
+{
+  return m_header->m_nbTraces;
+}
+
+int
+CqiTraceStore::GetNbRbs(void) const
+{
+  return m_header->m_nbRbs;
+}
+
+int
+CqiTraceStore::GetNbReports(int traceId) const
+{
+  return m_index[traceId].m_nbReports;
+}
+
+int
+CqiTraceStore::GetTraceIdForUser(int userId)
+{
+  int trace_id = m_userMapping[userId % m_userMapping.size()];
+  if (userId >= (int)m_announcedUsers.size())
+    m_announcedUsers.resize(userId + 1, false);
+  if (!m_announcedUsers[userId]) {
+    m_announcedUsers[userId] = true;
+    std::cerr << "user " << userId << " uses trace " << trace_id << std::endl;
+  }
+  if (trace_id < 0 || trace_id >= GetNbTraces() || GetNbReports(trace_id) == 0) {
+    std::cerr << "ERROR: missing cqi trace " << trace_id << std::endl;
+    exit(1);
+  }
+  return trace_id;
+}
+
+void
+CqiTraceStore::GetReport(int traceId, int report, int nbRbs,
+                         std::vector<int>& cqi) const
+{
+  report %= m_index[traceId].m_nbReports;
+  int width = m_header->m_nbRbs;
+  cqi.resize(nbRbs);
+  for (int rb = 0; rb < nbRbs; ++rb) {
+    cqi[rb] = GetCQI(traceId, report, rb < width ? rb : width - 1);
+  }
+}
+
+void
+CqiTraceStore::GetReportForUser(int userId, double now, int nbRbs,
+                                std::vector<int>& cqi)
+{
+  int trace_id = GetTraceIdForUser(userId);
+  int time_stamp = now * 1000 / CQI_TRACE_INTERVAL;
+  GetReport(trace_id, time_stamp, nbRbs, cqi);
+}
@@ -0,0 +1,131 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef CQI_TRACE_STORE_H_
+#define CQI_TRACE_STORE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#define CQI_TRACE_DIR "cqi-traces-noise0/"
+#define CQI_TRACE_BINARY "cqi-traces.bin"
+#define CQI_TRACE_MAX_UE 158
+#define CQI_TRACE_MAX_REPORTS 475
+#define CQI_TRACE_INTERVAL 40  // TTIs between two reports of a trace
+
+/*
+ * Read-only store of the SDR CQI traces.
+ *
+ * The text logs (cqi-traces-noise0/ueN.log, one report per line, one CQI
+ * per RB) are compiled once into a packed binary file: a fixed header, an
+ * index with one entry per trace id, and the reports packed 4 bits per RB.
+ * The binary file is mmap'ed read-only, so every eNB of a run and every run
+ * of a sweep share the same physical pages. The index records the size and
+ * the modification time of every log, and the file is compiled again when
+ * a log no longer matches them.
+ */
+class CqiTraceStore {
+ public:
+  struct FileHeader {
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_nbTraces;
+    uint32_t m_nbRbs;
+    uint32_t m_rowBytes;  // bytes per packed report
+    uint32_t m_reserved;
+  };
+
+  struct IndexEntry {
+    uint64_t m_offset;  // from the beginning of the file
+    uint32_t m_nbReports;
+    uint32_t m_reserved;
+    // of the text log, -1 when there is none
+    int64_t m_sourceSize;
+    int64_t m_sourceMtime;  // ns
+  };
+
+ private:
+  CqiTraceStore();
+  static CqiTraceStore* ptr;
+
+  int m_fd;
+  size_t m_size;
+  const uint8_t* m_data;
+  const FileHeader* m_header;
+  const IndexEntry* m_index;
+
+  std::vector<int> m_userMapping;
+  std::vector<bool> m_announcedUsers;
+
+ public:
+  virtual ~CqiTraceStore();
+
+  /*
+   * Maps path + CQI_TRACE_DIR + CQI_TRACE_BINARY, compiling it from the
+   * text logs first when it does not exist yet or is older than them.
+   */
+  static CqiTraceStore* Init(void);
+
+  /*
+   * Converts the text logs found in traceDir into the binary format.
+   * The file is written under a temporary name and renamed, so concurrent
+   * runs never observe a partially written store.
+   */
+  static bool Compile(const std::string& traceDir,
+                      const std::string& binaryFile,
+                      int maxReports = CQI_TRACE_MAX_REPORTS);
+
+  bool Open(const std::string& binaryFile);
+  void Close(void);
+  // whether the logs in traceDir are the ones the open file was compiled from
+  bool IsUpToDate(const std::string& traceDir) const;
+  bool LoadUserMapping(const std::string& mappingFile);
+
+  int GetNbTraces(void) const;
+  int GetNbRbs(void) const;
+  int GetNbReports(int traceId) const;
+  int GetTraceIdForUser(int userId);
+
+  inline int GetCQI(int traceId, int report, int rb) const {
+    const uint8_t* row = m_data + m_index[traceId].m_offset +
+                         (size_t)report * m_header->m_rowBytes;
+    return (row[rb >> 1] >> ((rb & 1) << 2)) & 0x0F;
+  }
+
+  /*
+   * Fills cqi with nbRbs values of the given report. Reports wrap around
+   * the end of the trace; RBs beyond the trace width repeat the last one.
+   */
+  void GetReport(int traceId, int report, int nbRbs,
+                 std::vector<int>& cqi) const;
+
+  /*
+   * The report a user sees at time now (in seconds), i.e. the last one
+   * collected at or before now.
+   */
+  void GetReportForUser(int userId, double now, int nbRbs,
+                        std::vector<int>& cqi);
+};
+
+#endif /* CQI_TRACE_STORE_H_ */
@@ -0,0 +1,62 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "trace-cqi-manager.h"
+#include "cqi-trace-store.h"
+#include "../NetworkNode.h"
+#include "../UserEquipment.h"
+#include "../../core/idealMessages/ideal-control-messages.h"
+#include "../../core/eventScheduler/simulator.h"
+#include "../../core/spectrum/bandwidth-manager.h"
+#include "../../phy/lte-phy.h"
+
+TraceCqiManager::TraceCqiManager()
+{}
+
+TraceCqiManager::~TraceCqiManager()
+{}
+
+void
+TraceCqiManager::CreateCqiFeedbacks (std::vector<double> sinr)
+{
+  UserEquipment* thisNode = (UserEquipment*) GetDevice ();
+  NetworkNode* targetNode = thisNode->GetTargetNode ();
+
+  std::vector<double> dlSubChannels = thisNode->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ();
+  std::vector<int> cqi;
+  CqiTraceStore::Init ()->GetReportForUser (
+      thisNode->GetIDNetworkNode (), Simulator::Init ()->Now (),
+      dlSubChannels.size (), cqi);
+
+  CqiIdealControlMessage *msg = new CqiIdealControlMessage ();
+  msg->SetSourceDevice (thisNode);
+  msg->SetDestinationDevice (targetNode);
+
+  int nbSubChannels = cqi.size ();
+  for (int i = 0; i < nbSubChannels; i++)
+    {
+      msg->AddNewRecord (dlSubChannels.at (i), cqi.at (i));
+    }
+
+  SetLastSent ();
+
+  thisNode->GetPhy ()->SendIdealControlMessage (msg);
+}
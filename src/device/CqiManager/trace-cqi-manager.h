@@ -0,0 +1,40 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef TRACECQIMANAGER_H_
+#define TRACECQIMANAGER_H_
+
+#include "cqi-manager.h"
+
+/*
+ * CQI manager of the trace-driven channel model: the feedback is read from
+ * the SDR CQI traces (see CqiTraceStore) at every reporting instant and the
+ * measured SINR is ignored.
+ */
+class TraceCqiManager : public CqiManager {
+ public:
+  TraceCqiManager();
+  virtual ~TraceCqiManager();
+
+  virtual void CreateCqiFeedbacks(std::vector<double> sinr);
+};
+
+#endif /* TRACECQIMANAGER_H_ */
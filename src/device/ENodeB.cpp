@@ -37,6 +37,7 @@
 #include "../protocolStack/mac/packet-scheduler/downlink-nvs-scheduler.h"
 #include "../protocolStack/mac/packet-scheduler/downlink-transport-scheduler.h"
 #include "../phy/enb-lte-phy.h"
+#include "../phy/ue-lte-phy.h"
 #include "../core/spectrum/bandwidth-manager.h"
 #include "../protocolStack/packet/packet-burst.h"
 
@@ -111,7 +112,28 @@ void
 ENodeB::RegisterUserEquipment (UserEquipment *UE)
 {
   UserEquipmentRecord *record = new UserEquipmentRecord (UE);
+  record->m_index = GetUserEquipmentRecords ()->size ();
   GetUserEquipmentRecords ()->push_back(record);
+
+  int idUE = UE->GetIDNetworkNode ();
+  if (idUE >= 0)
+    {
+      if (idUE >= (int) m_recordByUEID.size ())
+        {
+          m_recordByUEID.resize (idUE + 1, NULL);
+        }
+      // a UE registered twice is found by its first record, as before
+      if (m_recordByUEID[idUE] == NULL)
+        {
+          m_recordByUEID[idUE] = record;
+        }
+    }
+
+  // a UE handed over keeps sending its reference symbols
+  if (((UeLtePhy*) UE->GetPhy ())->SendsReferenceSymbols ())
+    {
+      ((EnbLtePhy*) GetPhy ())->StartReferenceSymbolsReception ();
+    }
 }
 
 void
@@ -130,6 +152,7 @@ ENodeB::DeleteUserEquipment (UserEquipment *UE)
 	    {
           //records->erase(iter);
           //break;
+		  record->m_index = new_records->size ();
 		  new_records->push_back (record);
 	    }
 	  else
@@ -141,6 +164,12 @@ ENodeB::DeleteUserEquipment (UserEquipment *UE)
   m_userEquipmentRecords->clear ();
   delete m_userEquipmentRecords;
   m_userEquipmentRecords = new_records;
+
+  int idUE = UE->GetIDNetworkNode ();
+  if (idUE >= 0 && idUE < (int) m_recordByUEID.size ())
+    {
+      m_recordByUEID[idUE] = NULL;
+    }
 }
 
 int
@@ -153,6 +182,7 @@ void
 ENodeB::CreateUserEquipmentRecords (void)
 {
   m_userEquipmentRecords = new UserEquipmentRecords ();
+  m_recordByUEID.clear ();
 }
 
 void
@@ -160,6 +190,7 @@ ENodeB::DeleteUserEquipmentRecords (void)
 {
   m_userEquipmentRecords->clear ();
   delete m_userEquipmentRecords;
+  m_recordByUEID.clear ();
 }
 
 ENodeB::UserEquipmentRecords*
@@ -171,6 +202,11 @@ ENodeB::GetUserEquipmentRecords (void)
 ENodeB::UserEquipmentRecord*
 ENodeB::GetUserEquipmentRecord (int idUE)
 {
+  if (idUE >= 0)
+    {
+      return idUE < (int) m_recordByUEID.size () ? m_recordByUEID[idUE] : NULL;
+    }
+
   UserEquipmentRecords *records = GetUserEquipmentRecords ();
   UserEquipmentRecord *record;
   UserEquipmentRecords::iterator iter;
@@ -191,6 +227,7 @@ ENodeB::GetUserEquipmentRecord (int idUE)
 ENodeB::UserEquipmentRecord::UserEquipmentRecord ()
 {
   m_UE = NULL;
+  m_index = -1;
   //Create initial CQI values:
   m_cqiFeedback.clear ();
   m_uplinkChannelStatusIndicator.clear ();
@@ -207,6 +244,7 @@ ENodeB::UserEquipmentRecord::~UserEquipmentRecord ()
 ENodeB::UserEquipmentRecord::UserEquipmentRecord (UserEquipment *UE)
 {
   m_UE = UE;
+  m_index = -1;
   BandwidthManager *s = m_UE->GetPhy ()->GetBandwidthManager ();
 
   int nbRbs = s->GetDlSubChannels ().size ();
@@ -239,13 +277,19 @@ ENodeB::UserEquipmentRecord::GetUE (void) const
   return m_UE;
 }
 
+int
+ENodeB::UserEquipmentRecord::GetIndex (void) const
+{
+  return m_index;
+}
+
 void
 ENodeB::UserEquipmentRecord::SetCQI (std::vector<int> cqi)
 {
   m_cqiFeedback = cqi;
 }
 
-std::vector<int>
+const std::vector<int>&
 ENodeB::UserEquipmentRecord::GetCQI (void) const
 {
  return m_cqiFeedback;
@@ -288,12 +332,12 @@ ENodeB::UserEquipmentRecord::GetUlMcs (void)
 }
 
 void
-ENodeB::UserEquipmentRecord::SetUplinkChannelStatusIndicator (std::vector<double> vet)
+ENodeB::UserEquipmentRecord::SetUplinkChannelStatusIndicator (const double* values, int nbOfSubChannels)
 {
-  m_uplinkChannelStatusIndicator = vet;
+  m_uplinkChannelStatusIndicator.assign (values, values + nbOfSubChannels);
 }
 
-std::vector<double>
+const std::vector<double>&
 ENodeB::UserEquipmentRecord::GetUplinkChannelStatusIndicator (void) const
 {
  return m_uplinkChannelStatusIndicator;
@@ -304,6 +348,8 @@ ENodeB::SetDLScheduler (ENodeB::DLSchedulerType type, string config_fname)
 {
   EnbMacEntity *mac = (EnbMacEntity*) GetProtocolStack ()->GetMacEntity ();
   PacketScheduler *scheduler;
+  m_dlSchedulerType = type;
+  m_dlSchedulerConfig = config_fname;
   switch (type)
     {
       case ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR:
@@ -397,6 +443,18 @@ ENodeB::GetDLScheduler (void) const
   return mac->GetDownlinkPacketScheduler ();
 }
 
+ENodeB::DLSchedulerType
+ENodeB::GetDLSchedulerType (void) const
+{
+  return m_dlSchedulerType;
+}
+
+const string&
+ENodeB::GetDLSchedulerConfig (void) const
+{
+  return m_dlSchedulerConfig;
+}
+
 void
 ENodeB::SetULScheduler (ULSchedulerType type)
 {
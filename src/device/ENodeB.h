@@ -40,9 +40,12 @@ class ENodeB : public NetworkNode {
     void SetUE(UserEquipment *UE);
     UserEquipment *GetUE(void) const;
 
+    int m_index;  // position in the records of the eNodeB
+    int GetIndex(void) const;
+
     std::vector<int> m_cqiFeedback;
     void SetCQI(std::vector<int> cqi);
-    std::vector<int> GetCQI(void) const;
+    const std::vector<int>& GetCQI(void) const;
 
     int m_schedulingRequest;  // in bytes
     void SetSchedulingRequest(int r);
@@ -57,8 +60,8 @@ class ENodeB : public NetworkNode {
     int GetUlMcs(void);
 
     std::vector<double> m_uplinkChannelStatusIndicator;
-    void SetUplinkChannelStatusIndicator(std::vector<double> vet);
-    std::vector<double> GetUplinkChannelStatusIndicator(void) const;
+    void SetUplinkChannelStatusIndicator(const double* values, int nbOfSubChannels);
+    const std::vector<double>& GetUplinkChannelStatusIndicator(void) const;
   };
 
   typedef std::vector<UserEquipmentRecord *> UserEquipmentRecords;
@@ -101,6 +104,9 @@ class ENodeB : public NetworkNode {
 
   void SetDLScheduler(DLSchedulerType type, string config_fname = "");
   PacketScheduler *GetDLScheduler(void) const;
+  // the type and config file the DL scheduler was created with
+  DLSchedulerType GetDLSchedulerType(void) const;
+  const string &GetDLSchedulerConfig(void) const;
   void SetULScheduler(ULSchedulerType type);
   PacketScheduler *GetULScheduler(void) const;
 
@@ -113,6 +119,11 @@ class ENodeB : public NetworkNode {
 
  private:
   UserEquipmentRecords *m_userEquipmentRecords;
+  // records indexed by UE id, kept in step with m_userEquipmentRecords
+  // by RegisterUserEquipment and DeleteUserEquipment
+  UserEquipmentRecords m_recordByUEID;
+  DLSchedulerType m_dlSchedulerType;
+  string m_dlSchedulerConfig;
 };
 
 #endif /* ENODEB_H_ */
@@ -29,6 +29,7 @@
 #include "CqiManager/cqi-manager.h"
 #include "../core/eventScheduler/simulator.h"
 #include "../componentManagers/NetworkManager.h"
+#include "../componentManagers/MobilityManager.h"
 #include "../protocolStack/rrc/ho/handover-entity.h"
 #include "../protocolStack/rrc/ho/ho-manager.h"
 
@@ -89,13 +90,10 @@ UserEquipment::UserEquipment (int idElement,
   m->SetHandover (handover);
   m->SetAbsolutePosition (position);
   m->SetNodeID (idElement);
+  m->SetDevice (this);
   SetMobilityModel (m);
 
-  m_timePositionUpdate = 0.001;
-  Simulator::Init()->Schedule(m_timePositionUpdate,
-		  &UserEquipment::UpdateUserPosition,
-		  this,
-		  Simulator::Init ()->Now());
+  MobilityManager::Init ()->Register (this);
 
   delete position;
 
@@ -162,15 +160,12 @@ UserEquipment::UserEquipment (int idElement,
   m->SetHandover(handover);
   m->SetAbsolutePosition(position);
   m->SetNodeID(idElement);
+  m->SetDevice(this);
   m->SetSpeed(speed);
   m->SetSpeedDirection(speedDirection);
   SetMobilityModel (m);
 
-  m_timePositionUpdate = 0.001;
-  Simulator::Init()->Schedule(m_timePositionUpdate,
-		  &UserEquipment::UpdateUserPosition,
-		  this,
-		  Simulator::Init ()->Now());
+  MobilityManager::Init ()->Register (this);
 
   delete position;
 
@@ -187,6 +182,7 @@ UserEquipment::UserEquipment (int idElement,
 
 UserEquipment::~UserEquipment()
 {
+  MobilityManager::Init ()->Unregister (this);
   m_targetNode = NULL;
   delete m_cqiManager;
   Destroy ();
@@ -195,8 +191,10 @@ UserEquipment::~UserEquipment()
 void
 UserEquipment::SetTargetNode (NetworkNode* n)
 {
+  NetworkNode *oldTarget = m_targetNode;
   m_targetNode = n;
   SetCell (n->GetCell ());
+  NetworkManager::Init ()->NotifyTargetNodeChanged (this, oldTarget);
 }
 
 NetworkNode*
@@ -226,13 +224,6 @@ UserEquipment::UpdateUserPosition (double time)
            NetworkManager::Init()->HandoverProcedure(time, this, targetNode, newTagertNode);
           }
       }
-
-
-    //schedule the new update after m_timePositionUpdate
-    Simulator::Init()->Schedule(m_timePositionUpdate,
-                                                           &UserEquipment::UpdateUserPosition,
-                                                           this,
-                                                           Simulator::Init ()->Now());
 }
 
 
@@ -43,6 +43,7 @@ class UserEquipment : public NetworkNode {
   void SetTargetNode(NetworkNode* n);
   NetworkNode* GetTargetNode(void);
 
+  // single update of this UE; the periodic one is run by MobilityManager
   void UpdateUserPosition(double time);
 
   void SetCqiManager(CqiManager* cm);
@@ -59,8 +60,6 @@ class UserEquipment : public NetworkNode {
   CqiManager* m_cqiManager;
 
   bool m_isIndoor;
-
-  double m_timePositionUpdate;
 };
 
 #endif /* USEREQUIPMENT_H_ */
@@ -211,6 +211,7 @@ void
 Application::SetApplicationID (int id)
 {
   m_applicationID = id;
+  m_rng = CounterRng (id, RNG_PURPOSE_TRAFFIC);
 }
 
 int
@@ -219,6 +220,12 @@ Application::GetApplicationID (void)
   return m_applicationID;
 }
 
+CounterRng&
+Application::GetRandomStream (void)
+{
+  return m_rng;
+}
+
 
 void
 Application::SetApplicationType (ApplicationType applicationType)
@@ -32,6 +32,7 @@
 #include "../../protocolStack/packet/Packet.h"
 #include "../../protocolStack/packet/PacketTAGs.h"
 #include "../../protocolStack/protocols/TransportProtocol.h"
+#include "../../utility/counter-rng.h"
 
 class NetworkNode;
 class ClassifierParameters;
@@ -87,8 +88,10 @@ class Application {
   virtual void DoStart(void) = 0;
   virtual void DoStop(void) = 0;
 
+  // also keys the random stream of the application to its ID
   void SetApplicationID(int id);
   int GetApplicationID(void);
+  CounterRng& GetRandomStream(void);
 
   RadioBearer* GetRadioBearer(void);
   void Trace(Packet* packet);
@@ -120,6 +123,8 @@ class Application {
 
   int m_applicationID;
   int m_priority;
+
+  CounterRng m_rng;
 };
 
 #endif /* APPLICATION_H_ */
@@ -24,6 +24,7 @@
 #include "../../componentManagers/NetworkManager.h"
 #include "../radio-bearer.h"
 #include <cmath>
+#include <stdexcept>
 
 // 1460.000000,0.500000
 // 2920.000000,0.600000
@@ -142,7 +143,6 @@ InternetFlow::SetAvgRate(double rate)
   // Bytes / Mbps => *8 (us) /1000000 (s)
   m_interval = InternetFlow::m_avg_flowsize / rate * 8 / 1000000;
   m_lambda = 1 / m_interval;
-  m_distribute = std::exponential_distribution<double>(m_lambda);
   // std::cerr << "IPFlow rate: " << rate
   //     << " mbps; lambda: " << m_lambda
   //     << " ; flow size: " << InternetFlow::m_avg_flowsize << std::endl;
@@ -152,14 +152,15 @@ double
 InternetFlow::GetInterval(void)
 {
   // return m_interval;
-  double interval = m_distribute(m_generator);
+  // exponential inter-arrival times, by inversion
+  double interval = -std::log(1. - GetRandomStream().NextUniform()) / m_lambda;
   return std::ceil(interval * 1000) / 1000.0;
 }
 
 int
-InternetFlow::GetSize(void) const
+InternetFlow::GetSize(void)
 {
-  double cdf = (double) rand() / RAND_MAX;
+  double cdf = GetRandomStream().NextUniform();
   for (int i = 0; i < InternetFlow::m_typeflow; i++) {
     if (InternetFlow::m_flowcdf[i] >= cdf) {
       return InternetFlow::m_flowsize[i];
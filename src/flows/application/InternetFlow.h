@@ -22,7 +22,6 @@
 #ifndef INTERNETFLOW_H_
 #define INTERNETFLOW_H_
 
-#include <random>
 
 #include "Application.h"
 
@@ -46,13 +45,11 @@ class InternetFlow : public Application {
 
  private:
   double GetInterval(void);
-  int GetSize(void) const;
+  int GetSize(void);
   double m_interval;
   int m_flowCounter;
 
   double m_lambda;
-  std::default_random_engine m_generator;
-  std::exponential_distribution<double> m_distribute;
 };
 
 #endif /* CBR_H_ */
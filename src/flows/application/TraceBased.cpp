@@ -21,7 +21,6 @@
 
 
 #include "TraceBased.h"
-#include "Trace/default-trace.h"
 #include <cstring>
 #include "../../componentManagers/NetworkManager.h"
 #include "../radio-bearer.h"
@@ -31,7 +30,7 @@
 TraceBased::TraceBased()
 {
   m_sent = 0;
-  m_entries = new std::vector<TraceEntry> ();
+  m_randomStartOffset = false;
   LoadDefaultTrace ();
   m_frameCounter = 0;
   SetApplicationType (Application::APPLICATION_TYPE_TRACE_BASED);
@@ -39,14 +38,16 @@ TraceBased::TraceBased()
 
 TraceBased::~TraceBased()
 {
-  m_entries->clear ();
-  delete m_entries;
   Destroy ();
 }
 
 void
 TraceBased::DoStart (void)
 {
+  if (m_randomStartOffset)
+    {
+      m_cursor = GetRandomStream ().NextInt (m_entries->size ());
+    }
   Simulator::Init()->Schedule(0.0, &TraceBased::Send, this);
 }
 
@@ -69,74 +70,26 @@ TraceBased::SetTraceFile(std::string traceFile)
 void
 TraceBased::LoadTrace (std::string traceFile)
 {
-  if (m_entries->size() > 0)
-    {
-      m_entries->clear ();
-    }
-
-  uint32_t time, index, prevTime = 0;
-  uint16_t size;
-  char frameType;
-  TraceEntry entry;
-  std::ifstream ifTraceFile;
-  ifTraceFile.open (traceFile.c_str (), std::ifstream::in);
-
-  if (!ifTraceFile.good ())
+  m_entries = VideoTraceCache::Init ()->GetTrace (traceFile);
+  if (m_entries == NULL)
     {
 	  std::cout << " TRACE_BASED_APPLICATION ERROR BAD FILE"<< std::endl;
       LoadDefaultTrace ();
     }
-  while (ifTraceFile.good ())
-    {
-      ifTraceFile >> index >> frameType >> time >> size;
-      if (frameType == 'B' || frameType == 'PB')
-        {
-          entry.TimeToSend = 0;
-        }
-      else
-        {
-          entry.TimeToSend = time - prevTime;
-          prevTime = time;
-        }
-      entry.PacketSize = size;
-      entry.FrameIndex = index;
-      entry.FrameType = frameType;
-      m_entries->push_back (entry);
-    }
-  ifTraceFile.close ();
-  iter = m_entries->begin ();
+  m_cursor = 0;
 }
 
 void
 TraceBased::LoadDefaultTrace (void)
 {
-  uint32_t time, index, prevTime = 0;
-  uint16_t size;
-  char frameType;
-  TraceEntry entry;
-  for (int i = 0; i < NB_FRAME; i++)
-    {
-      index = i + 1;
-      frameType = frameType_Tab[i];
-      time = time_Tab[i];
-      size = size_Tab[i];
-
-      if (frameType == 'B')
-        {
-          entry.TimeToSend = 0;
-        }
-      else
-        {
-          entry.TimeToSend = time - prevTime;
-          prevTime = time;
-        }
-      entry.PacketSize = size;
-      entry.FrameIndex = index;
-      entry.FrameType = frameType;
-      m_entries->push_back (entry);
-    }
-  iter = m_entries->begin ();
+  m_entries = VideoTraceCache::Init ()->GetDefaultTrace ();
+  m_cursor = 0;
+}
 
+void
+TraceBased::SetRandomStartOffset (bool random)
+{
+  m_randomStartOffset = random;
 }
 
 void
@@ -156,7 +109,8 @@ TraceBased::Send (void)
 
   while (true)
     {
-      for (int i = 0; i < (iter->PacketSize) / MAXMTUSIZE; i++)
+      const VideoTraceEntry *entry = &(*m_entries)[m_cursor];
+      for (int i = 0; i < (entry->PacketSize) / MAXMTUSIZE; i++)
 		{
     	  //CREATE A NEW PACKET (ADDING UDP, IP and PDCP HEADERS)
     	  Packet *packet = new Packet ();
@@ -192,7 +146,7 @@ TraceBased::Send (void)
     	  GetRadioBearer()->Enqueue (packet);
 		}
 
-      uint16_t sizetosend = (iter->PacketSize) % MAXMTUSIZE;
+      uint16_t sizetosend = (entry->PacketSize) % MAXMTUSIZE;
 
       if (sizetosend > 0)
         {
@@ -230,18 +184,19 @@ TraceBased::Send (void)
 	      GetRadioBearer()->Enqueue (packet);
         }
 
-      iter++;
+      m_cursor++;
 	  m_frameCounter++;
 	  dataOfFrameAlreadySent = 0;
 
-	  if (iter == m_entries->end ())
+	  if (m_cursor == m_entries->size ())
 		{
-		  iter = m_entries->begin ();
+		  m_cursor = 0;
 		}
 
-	  if (iter->TimeToSend != 0)
+	  entry = &(*m_entries)[m_cursor];
+	  if (entry->TimeToSend != 0)
 		{
-		  ScheduleTransmit ((iter->TimeToSend)*0.001);
+		  ScheduleTransmit ((entry->TimeToSend)*0.001);
 		  break;
 		}
     }
@@ -263,7 +218,7 @@ void
 TraceBased::PrintTrace(void)
 {
   std::cout << "Print Trace "<< std::endl;
-  std::vector<TraceEntry>::iterator it;
+  VideoTrace::const_iterator it;
 
   int n=0;
   for (it = m_entries->begin(); it != m_entries->end(); it++)
@@ -27,6 +27,7 @@
 #include <iostream>
 
 #include "Application.h"
+#include "VideoTraceCache.h"
 
 /*
  * This application sends udp packets based on a trace file could be downloaded
@@ -39,6 +40,9 @@
  * - the fourth one indicates the frame size in byte
  * if no valid trace trace file is provided to the application the trace from
  * default-trace.h will be loaded.
+ *
+ * The traces are parsed once and shared through the VideoTraceCache, the
+ * application only keeps its position in its trace.
  */
 
 class TraceBased : public Application {
@@ -53,6 +57,9 @@ class TraceBased : public Application {
   void SetTraceFile(std::string traceFile);
   void LoadTrace(std::string traceFile);
   void LoadDefaultTrace(void);
+  // start from a random frame of the trace, drawn from the stream of the
+  // application when it starts, instead of the first one
+  void SetRandomStartOffset(bool random);
 
   virtual void DoStart(void);
   virtual void DoStop(void);
@@ -71,15 +78,9 @@ class TraceBased : public Application {
   uint32_t m_size;
   uint32_t m_sent;
 
-  typedef struct {
-    uint32_t TimeToSend;
-    uint16_t PacketSize;
-    uint32_t FrameIndex;
-    char FrameType;
-  } TraceEntry;
-
-  std::vector<TraceEntry> *m_entries;
-  std::vector<TraceEntry>::iterator iter;
+  const VideoTrace *m_entries;
+  uint32_t m_cursor;  // the next frame to send
+  bool m_randomStartOffset;
 
   int m_frameCounter;
 };
@@ -0,0 +1,82 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "VideoTraceCache.h"
+
+#include <fstream>
+
+#include "Trace/default-trace.h"
+
+VideoTraceCache* VideoTraceCache::ptr = NULL;
+
+VideoTraceCache::VideoTraceCache() {
+  uint32_t prevTime = 0;
+  VideoTraceEntry entry;
+  for (int i = 0; i < NB_FRAME; i++) {
+    if (frameType_Tab[i] == 'B') {
+      entry.TimeToSend = 0;
+    } else {
+      entry.TimeToSend = time_Tab[i] - prevTime;
+      prevTime = time_Tab[i];
+    }
+    entry.PacketSize = size_Tab[i];
+    entry.FrameIndex = i + 1;
+    entry.FrameType = frameType_Tab[i];
+    m_defaultTrace.push_back(entry);
+  }
+}
+
+VideoTraceCache::~VideoTraceCache() {}
+
+const VideoTrace* VideoTraceCache::GetTrace(const std::string& traceFile) {
+  std::map<std::string, VideoTrace>::iterator it = m_traces.find(traceFile);
+  if (it == m_traces.end()) {
+    it = m_traces.insert(std::make_pair(traceFile, VideoTrace())).first;
+    VideoTrace& trace = it->second;
+
+    std::ifstream ifTraceFile(traceFile.c_str(), std::ifstream::in);
+    uint32_t time, index, prevTime = 0;
+    uint16_t size;
+    char frameType;
+    VideoTraceEntry entry;
+    // as the per-application parser did, the last frame is read twice, the
+    // second time with no delay
+    while (ifTraceFile.good()) {
+      ifTraceFile >> index >> frameType >> time >> size;
+      if (frameType == 'B') {
+        entry.TimeToSend = 0;
+      } else {
+        entry.TimeToSend = time - prevTime;
+        prevTime = time;
+      }
+      entry.PacketSize = size;
+      entry.FrameIndex = index;
+      entry.FrameType = frameType;
+      trace.push_back(entry);
+    }
+    trace.shrink_to_fit();
+  }
+  return it->second.empty() ? NULL : &it->second;
+}
+
+const VideoTrace* VideoTraceCache::GetDefaultTrace(void) const {
+  return &m_defaultTrace;
+}
@@ -0,0 +1,73 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef VIDEOTRACECACHE_H_
+#define VIDEOTRACECACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct VideoTraceEntry {
+  uint32_t TimeToSend;  // ms after the previous frame, 0 for a B frame
+  uint32_t FrameIndex;
+  uint16_t PacketSize;
+  char FrameType;
+};
+
+typedef std::vector<VideoTraceEntry> VideoTrace;
+
+/*
+ * The video traces of the TraceBased applications, parsed once per file
+ * and shared by all the applications that play them: an application keeps
+ * a pointer to the trace and its position in it. The traces are never
+ * modified once loaded, and live until the end of the process.
+ *
+ * Not thread-safe: the traces are loaded by the scenario setup.
+ */
+class VideoTraceCache {
+ private:
+  VideoTraceCache();
+  static VideoTraceCache* ptr;
+
+  std::map<std::string, VideoTrace> m_traces;  // empty: the file is unreadable
+  VideoTrace m_defaultTrace;
+
+ public:
+  virtual ~VideoTraceCache();
+
+  static VideoTraceCache* Init(void) {
+    if (ptr == NULL) {
+      ptr = new VideoTraceCache;
+    }
+    return ptr;
+  }
+
+  // the trace of the file, NULL if it cannot be read
+  const VideoTrace* GetTrace(const std::string& traceFile);
+  // the trace of default-trace.h
+  const VideoTrace* GetDefaultTrace(void) const;
+};
+
+#endif /* VIDEOTRACECACHE_H_ */
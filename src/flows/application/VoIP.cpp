@@ -68,7 +68,7 @@ VoIP::Send (void)
 	{
 	  m_stateON = true;
 	  //start state ON
-	  double random = rand() %10000;
+	  double random = GetRandomStream ().NextInt (10000);
 	  m_stateDuration = -3*log(1-((double)random/10000));
 	  m_endState = Simulator::Init()->Now () + m_stateDuration;
 #ifdef APPLICATION_DEBUG
@@ -117,7 +117,7 @@ VoIP::Send (void)
     {
 	  //schedule OFF Period
       m_stateON = false;
-	  double random = rand() %10000;
+	  double random = GetRandomStream ().NextInt (10000);
 	  m_stateDuration = -2.23*log(1-((double)random/10000));
 	  if (m_stateDuration > 6.9)
 	    {
@@ -27,11 +27,10 @@
 
 
 int arrival;
-Random Ran;
 //-----------------------------------------------------------------------------------------------------------------
 //	constructor and destructor for the random class
 //-----------------------------------------------------------------------------------------------------------------
-Random::Random() {		ReInit();	}
+Random::Random(CounterRng& rng) : m_rng (rng) {	}
 
 Random::~Random() {	}
 
@@ -41,7 +40,7 @@ Random::~Random() {	}
 //----------------------------------------------------------------------------------------------------------------
 int Random::Uniform(int a, int b) {
 
-	return a + (rand() % (b-a+1));
+	return a + m_rng.NextInt(b-a+1);
 
 }// end of Uniform()
 
@@ -52,23 +51,13 @@ int Random::Uniform(int a, int b) {
 double Random::Uniform(double a, double b) {
 	double f;
 
-	f = (double ) rand()/RAND_MAX;
+	f = m_rng.NextUniform();
 
 	return a + f *(b-a);
 
 }// end of Uniform()
 
 
-//--------------------------------------------------------------------------------------------------------------
-//	change the seed of random number generation
-//--------------------------------------------------------------------------------------------------------------
-void Random::ReInit() {
-
-	srand((unsigned int)time((time_t *)NULL));
-
-}// end of ReInit()
-
-
 //-------------------------------------------------------------------------------------------------------------
 // generate random variants in binomial distribution
 //-------------------------------------------------------------------------------------------------------------
@@ -77,7 +66,7 @@ int Random::Binomial(int n, double p) {
 	int b=0,i;
 
 	for (i=0; i <= n-1; i++ ) {
-		f = (double ) rand()/RAND_MAX;
+		f = m_rng.NextUniform();
 		if (f < p) {
 			b++;
 		}
@@ -94,7 +83,7 @@ int Random::Binomial(int n, double p) {
 double Random::Exponential(double lamda) {
 	double f;
 
-	f = (double ) rand()/RAND_MAX;
+	f = m_rng.NextUniform();
 
 	return -log(1- f)/lamda;
 
@@ -107,7 +96,7 @@ double Random::Exponential(double lamda) {
 int Random::Geometric(double p) {
 	double f;
 
-	f = (double ) rand()/RAND_MAX;
+	f = m_rng.NextUniform();
 
 	return (int)ceil(log(f)/log(1-p));
 
@@ -120,7 +109,7 @@ int Random::Geometric(double p) {
 double Random::Pareto(double a, double k) {
 	double f;
 
-	f=(double)rand()/RAND_MAX;
+	f=m_rng.NextUniform();
 	f=pow( f, 1/a);
 	f = k/f;
 
@@ -136,10 +125,10 @@ double Random::Normal(int n, double Mu, double Theta){
 	double u, t;
 	int i;
 
-	u = (double)rand()/RAND_MAX;
+	u = m_rng.NextUniform();
 
 	for (i=1; i<n; i++) {
-		u = u + (double)rand()/RAND_MAX;
+		u = u + m_rng.NextUniform();
 	}
 
 	double rr=n/12;
@@ -158,14 +147,12 @@ int Random::Poisson(double lamda){
 	int c;
 
 	R = 1/exp(lamda);
-	n1 = rand();
-
-	n1 = n1 / RAND_MAX;
+	n1 = m_rng.NextUniform();
 	c = 1;
 
 	do {
 		n0 = n1;
-		n1 = n0 * rand()/RAND_MAX;
+		n1 = n0 * m_rng.NextUniform();
 
 		if ((n1<=R)&&(R<n0)) {
 			break;
@@ -184,11 +171,7 @@ WEB::WEB()
    * G729 codec generates during the ON period a packet with
    * a fixed size (20 bytes). We must add the RTP header (12 bytes)
    */
-  m_size = Ran.Pareto(1.1,81.5);
-        if (m_size > 66666)
-        {
-         m_size = 66666;
-        }
+  m_size = 0;
   m_stateON = false;
   SetApplicationType (Application::APPLICATION_TYPE_WEB);
 }
@@ -201,6 +184,13 @@ WEB::~WEB()
 void
 WEB::DoStart (void)
 {
+  // drawn here, the random stream is keyed once the application has its ID
+  Random ran (GetRandomStream ());
+  m_size = ran.Pareto(1.1,81.5);
+        if (m_size > 66666)
+        {
+         m_size = 66666;
+        }
   Simulator::Init()->Schedule(0.0, &WEB::Send, this);
 }
 
@@ -225,8 +215,9 @@ WEB::Send (void)
 	  m_stateON = true;
 	  //start state ON
 
-          int n_packet = Ran.Geometric(300);
-          arrival = Ran.Geometric(0.4);
+          Random ran (GetRandomStream ());
+          int n_packet = ran.Geometric(300);
+          arrival = ran.Geometric(0.4);
 	 // double random = rand() %10000;
 	  m_stateDuration = n_packet * arrival;
 	  m_endState = Simulator::Init()->Now () + m_stateDuration;
@@ -277,7 +268,7 @@ WEB::Send (void)
 	  //schedule OFF Period
          m_stateON = false;
 	  //double random = rand() %10000;
-	  m_stateDuration  = Ran.Geometric(2);;
+	  m_stateDuration  = Random (GetRandomStream ()).Geometric(2);
 
 #ifdef APPLICATION_DEBUG
 	  std::cout << " WEB_DEBUG - Start OFF Period, "
@@ -45,9 +45,10 @@ class WEB : public Application {
   double m_endState;
 };
 
+// draws from the random stream of the application it is built on
 class Random {
  public:
-  Random();
+  Random(CounterRng& rng);
   ~Random();
 
   int Uniform(
@@ -58,8 +59,6 @@ class Random {
       double a,
       double b);  // Generate double random variants with Uniform distribution
 
-  void ReInit();  // Change the seed of random number generation
-
   int Binomial(int n,
                double p);  // Generate random variants in Binomial distribution
 
@@ -78,6 +77,9 @@ class Random {
 
   int Poisson(
       double lamda);  // Generate random variants with Poisson distribution
+
+ private:
+  CounterRng& m_rng;
 };
 
 #endif /* WEB_H_ */
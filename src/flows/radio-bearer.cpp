@@ -290,7 +290,7 @@ RadioBearer::GetHeadOfLinePacketDelay (void)
 	  AmRlcEntity* amRlc = (AmRlcEntity*) GetRlcEntity ();
 	  if (amRlc->GetSentAMDs()->size() > 0)
 	    {
-		  HOL = now - amRlc->GetSentAMDs()->at (0)->m_packet->GetTimeStamp ();
+		  HOL = now - amRlc->GetSentAMDs()->front ()->m_packet->GetTimeStamp ();
 	    }
 	  else
 	    {
@@ -397,12 +397,12 @@ RadioBearer::GetByte (int byte)
 	if (GetRlcEntity ()->GetRlcModel () == RlcEntity::AM_RLC_MODE)
 	  {
 		AmRlcEntity* amRlc = (AmRlcEntity*) GetRlcEntity ();
-		std::vector<AmdRecord*>* am_segments = amRlc->GetSentAMDs ();
+		AmdWindow* am_segments = amRlc->GetSentAMDs ();
 		if (am_segments->size() > 0)
 		  {
-			for (int i=0; i < am_segments->size(); i++)
+			for (AmdWindow::iterator it = am_segments->begin (); it != am_segments->end (); ++it)
 			  {
-				maxData =+ am_segments->at (i)->m_packet->GetSize () + 6;
+				maxData =+ (*it)->m_packet->GetSize () + 6;
 				if (maxData >= byte) continue;
 			  }
 		  }
@@ -67,7 +67,7 @@ Manhattan::UpdatePosition (double timestamp)
   double timeInterval = timestamp - GetPositionLastUpdate ();
   double speedDirection;
 
-  UserEquipment *thisNode = NetworkManager::Init ()->GetUserEquipmentByID (GetNodeID ());
+  UserEquipment *thisNode = (UserEquipment*) GetDevice ();
   Cell *thisCell = thisNode->GetCell ();
 
 
@@ -119,36 +119,35 @@ Manhattan::UpdatePosition (double timestamp)
 
 	double shift = timeInterval * (GetSpeed()*(1000.0/3600.0));
 
-	CartesianCoordinates *newPosition = new CartesianCoordinates(GetAbsolutePosition()->GetCoordinateX(), GetAbsolutePosition()->GetCoordinateY());
+	CartesianCoordinates newPosition (GetAbsolutePosition()->GetCoordinateX(), GetAbsolutePosition()->GetCoordinateY());
 	CartesianCoordinates *ENodeBPosition = targetNode->GetMobilityModel ()->GetAbsolutePosition ();
 
 // Init Manhattan grid position
   if(fmod(GetAbsolutePosition()->GetCoordinateY(),100)!=0 && fmod(GetAbsolutePosition()->GetCoordinateX(),100)!=0){
-	CartesianCoordinates *Correction = new CartesianCoordinates();
-	double distfromEnB = newPosition->GetDistance (ENodeBPosition);
-	double azim = newPosition->GetPolarAzimut (ENodeBPosition);
+	CartesianCoordinates Correction;
+	double distfromEnB = newPosition.GetDistance (ENodeBPosition);
+	double azim = newPosition.GetPolarAzimut (ENodeBPosition);
 
 	//if it was randomly put outside the cell -> shift it inside
 	if(distfromEnB > (thisCell->GetRadius()*1000)) {
-	  Correction->SetCoordinates((newPosition->GetDistance (ENodeBPosition) - (thisCell->GetRadius()*1000)) * cos(azim),
-			  (newPosition->GetDistance (ENodeBPosition) - (thisCell->GetRadius()*1000)) * sin(azim));
-	  newPosition->SetCoordinates(newPosition->GetCoordinateX() - Correction->GetCoordinateX(),
-			  newPosition->GetCoordinateY() - Correction->GetCoordinateY());
+	  Correction.SetCoordinates((newPosition.GetDistance (ENodeBPosition) - (thisCell->GetRadius()*1000)) * cos(azim),
+			  (newPosition.GetDistance (ENodeBPosition) - (thisCell->GetRadius()*1000)) * sin(azim));
+	  newPosition.SetCoordinates(newPosition.GetCoordinateX() - Correction.GetCoordinateX(),
+			  newPosition.GetCoordinateY() - Correction.GetCoordinateY());
 	}
-	delete Correction;
 
 
 	if(GetSpeedDirection()==0 || GetSpeedDirection()==3.14) {
-			  if(newPosition->GetCoordinateY() < 0)
-				  newPosition->SetCoordinateY( ceil( (double)(newPosition->GetCoordinateY() / 100) ) * 100);
+			  if(newPosition.GetCoordinateY() < 0)
+				  newPosition.SetCoordinateY( ceil( (double)(newPosition.GetCoordinateY() / 100) ) * 100);
 			  else
-				  newPosition->SetCoordinateY( floor( (double)(newPosition->GetCoordinateY() / 100) ) * 100);
+				  newPosition.SetCoordinateY( floor( (double)(newPosition.GetCoordinateY() / 100) ) * 100);
 		  }
 	else {
-			  if(newPosition->GetCoordinateX() < 0)
-				  newPosition->SetCoordinateX( ceil( (double)(newPosition->GetCoordinateX() / 100)) * 100);
+			  if(newPosition.GetCoordinateX() < 0)
+				  newPosition.SetCoordinateX( ceil( (double)(newPosition.GetCoordinateX() / 100)) * 100);
 			  else
-				  newPosition->SetCoordinateX( floor( (double)(newPosition->GetCoordinateX() / 100) ) * 100);
+				  newPosition.SetCoordinateX( floor( (double)(newPosition.GetCoordinateX() / 100) ) * 100);
 	}
   }
 
@@ -156,17 +155,17 @@ Manhattan::UpdatePosition (double timestamp)
   double shift_x = shift * cos(GetSpeedDirection());
   double shift_y = shift * sin(GetSpeedDirection());
   if(GetSpeedDirection()==0 || GetSpeedDirection()==3.14) {
-	  newPosition->SetCoordinateX(newPosition->GetCoordinateX()+shift_x);
+	  newPosition.SetCoordinateX(newPosition.GetCoordinateX()+shift_x);
   }
   else {
-	  newPosition->SetCoordinateY(newPosition->GetCoordinateY()+shift_y);
+	  newPosition.SetCoordinateY(newPosition.GetCoordinateY()+shift_y);
   }
 
 // if a node reaches a crossing, choose new speedDirection
   double old_x = abs( ((int)( GetAbsolutePosition()->GetCoordinateX() *1000))/1000.0 ); //cut after 3 decimal places
-  double new_x = abs( ((int)( newPosition->GetCoordinateX() *1000))/1000.0 );
+  double new_x = abs( ((int)( newPosition.GetCoordinateX() *1000))/1000.0 );
   double old_y = abs( ((int)( GetAbsolutePosition()->GetCoordinateY() *1000))/1000.0 );
-  double new_y = abs( ((int)( newPosition->GetCoordinateY() *1000))/1000.0 );
+  double new_y = abs( ((int)( newPosition.GetCoordinateY() *1000))/1000.0 );
   double rounded_x = abs( round(old_x/100)*100 );
   double rounded_y = abs( round(old_y/100)*100 );
 
@@ -176,23 +175,23 @@ Manhattan::UpdatePosition (double timestamp)
 		  (rounded_y==0 && old_y<rounded_y && rounded_y<=new_y) || (rounded_y==0 && old_y>rounded_y && rounded_y>=new_y) )
   {
 	  //srand ( time(NULL) );
-	  double prob_turn = (rand()%100)*0.01;
+	  double prob_turn = (GetRandomStream ().NextInt (100))*0.01;
 	  if(prob_turn<=0.25) {
 		  speedDirection = GetSpeedDirection() + 1.57; //turn left;
-		  newPosition->SetCoordinates(round(newPosition->GetCoordinateX()),round(newPosition->GetCoordinateY()));
+		  newPosition.SetCoordinates(round(newPosition.GetCoordinateX()),round(newPosition.GetCoordinateY()));
 #ifdef MOBILITY_DEBUG_TAB
 		  cout << "TURN LEFT: " << speedDirection << " -> ";
 #endif
 	  }
 	  if(prob_turn>0.25 && prob_turn<0.75) {
-		  newPosition->SetCoordinates(round(newPosition->GetCoordinateX()),round(newPosition->GetCoordinateY()) );
+		  newPosition.SetCoordinates(round(newPosition.GetCoordinateX()),round(newPosition.GetCoordinateY()) );
 		  speedDirection = GetSpeedDirection();
 #ifdef MOBILITY_DEBUG_TAB
 		  cout << "no TURN: straight -> ";
 #endif
 	  }
 	  if(prob_turn>=0.75) {
-		  newPosition->SetCoordinates(round(newPosition->GetCoordinateX()),round(newPosition->GetCoordinateY()) );
+		  newPosition.SetCoordinates(round(newPosition.GetCoordinateX()),round(newPosition.GetCoordinateY()) );
 		  speedDirection = GetSpeedDirection() - 1.57;
 #ifdef MOBILITY_DEBUG_TAB
 		  cout << "TURN RIGHT: " << speedDirection << " -> ";
@@ -208,15 +207,15 @@ Manhattan::UpdatePosition (double timestamp)
 
 
 //If node moves beyond the cell edge
-  double azimut = newPosition->GetPolarAzimut (ENodeBPosition);
-  double newDistanceFromTheENodeB = newPosition->GetDistance (ENodeBPosition);
+  double azimut = newPosition.GetPolarAzimut (ENodeBPosition);
+  double newDistanceFromTheENodeB = newPosition.GetDistance (ENodeBPosition);
 
   if (newDistanceFromTheENodeB >= (thisCell->GetRadius()*1000))
     {
 	  if (GetHandover()== false)
 		{
-		  newPosition->SetCoordinateX(GetAbsolutePosition()->GetCoordinateX());
-		  newPosition->SetCoordinateY(GetAbsolutePosition()->GetCoordinateY());
+		  newPosition.SetCoordinateX(GetAbsolutePosition()->GetCoordinateX());
+		  newPosition.SetCoordinateY(GetAbsolutePosition()->GetCoordinateY());
 
 		  speedDirection = GetSpeedDirection() - pi;
 #ifdef MOBILITY_DEBUG_TAB
@@ -225,10 +224,10 @@ Manhattan::UpdatePosition (double timestamp)
 		  if(speedDirection<0) speedDirection = speedDirection + 2*pi;
 		  SetSpeedDirection(speedDirection);
 		}
-	  else if (newPosition->GetDistance(0.0, 0.0) >= GetTopologyBorder ())
+	  else if (newPosition.GetDistance(0.0, 0.0) >= GetTopologyBorder ())
 	      {
-		  newPosition->SetCoordinateX(GetAbsolutePosition()->GetCoordinateX());
-		  newPosition->SetCoordinateY(GetAbsolutePosition()->GetCoordinateY());
+		  newPosition.SetCoordinateX(GetAbsolutePosition()->GetCoordinateX());
+		  newPosition.SetCoordinateY(GetAbsolutePosition()->GetCoordinateY());
 
 		  speedDirection = GetSpeedDirection() - 1.57;
 #ifdef MOBILITY_DEBUG_TAB
@@ -239,7 +238,7 @@ Manhattan::UpdatePosition (double timestamp)
 	      }
     }
 
-  SetAbsolutePosition(newPosition);
+  SetAbsolutePosition(&newPosition);
   SetPositionLastUpdate (timestamp);
 
 #ifdef MOBILITY_DEBUG
@@ -252,6 +251,5 @@ Manhattan::UpdatePosition (double timestamp)
 			<< GetAbsolutePosition()->GetCoordinateY() << " " << GetSpeedDirection()
 			<< endl;
 #endif
-  delete newPosition;
 }
 
@@ -22,12 +22,20 @@
 
 #include "Mobility.h"
 #include "../componentManagers/NetworkManager.h"
+#include "../componentManagers/MobilityManager.h"
 #include "../networkTopology/Cell.h"
 #include "../load-parameters.h"
 
 Mobility::Mobility()
 {
+  m_device = NULL;
+  m_slot = -1;
   m_AbsolutePosition = NULL;
+  m_speed = 0;
+  m_speedDirection = 0.0;
+  m_positionLastUpdate = 0.0;
+  m_handover = false;
+  m_handoverLastRun = 0.0;
 }
 
 Mobility::~Mobility()
@@ -39,6 +47,13 @@ void
 Mobility::SetNodeID (int id)
 {
   m_nodeID = id;
+  m_rng = CounterRng (id, RNG_PURPOSE_MOBILITY);
+}
+
+CounterRng&
+Mobility::GetRandomStream (void)
+{
+  return m_rng;
 }
 
 int
@@ -47,6 +62,18 @@ Mobility::GetNodeID (void) const
   return m_nodeID;
 }
 
+void
+Mobility::SetDevice (NetworkNode* device)
+{
+  m_device = device;
+}
+
+NetworkNode*
+Mobility::GetDevice (void) const
+{
+  return m_device;
+}
+
 void
 Mobility::SetMobilityModel(MobilityModel model)
 {
@@ -75,6 +102,10 @@ Mobility::SetAbsolutePosition (CartesianCoordinates *position)
 
   m_AbsolutePosition->SetCoordinateX (position->GetCoordinateX ());
   m_AbsolutePosition->SetCoordinateY (position->GetCoordinateY ());
+  if (m_slot >= 0)
+    {
+      MobilityManager::Init ()->Sync (this);
+    }
 }
 
 CartesianCoordinates*
@@ -93,6 +124,10 @@ void
 Mobility::SetSpeed (int speed)
 {
   m_speed = speed;
+  if (m_slot >= 0)
+    {
+      MobilityManager::Init ()->Sync (this);
+    }
 }
 
 int
@@ -105,6 +140,10 @@ void
 Mobility::SetSpeedDirection (double speedDirection)
 {
   m_speedDirection = speedDirection;
+  if (m_slot >= 0)
+    {
+      MobilityManager::Init ()->Sync (this);
+    }
 }
 
 double
@@ -117,6 +156,10 @@ void
 Mobility::SetPositionLastUpdate (double time)
 {
   m_positionLastUpdate = time;
+  if (m_slot >= 0)
+    {
+      MobilityManager::Init ()->Sync (this);
+    }
 }
 
 double
@@ -26,6 +26,9 @@
 #include <stdlib.h>
 
 #include "../core/cartesianCoodrdinates/CartesianCoordinates.h"
+#include "../utility/counter-rng.h"
+
+class NetworkNode;
 
 class Mobility {
  public:
@@ -40,8 +43,13 @@ class Mobility {
     MANHATTAN
   };
 
+  // also keys the random stream of the model to the node
   void SetNodeID(int id);
   int GetNodeID(void) const;
+  CounterRng& GetRandomStream(void);
+
+  void SetDevice(NetworkNode* device);
+  NetworkNode* GetDevice(void) const;
 
   void SetMobilityModel(MobilityModel model);
   Mobility::MobilityModel GetMobilityModel(void) const;
@@ -68,7 +76,12 @@ class Mobility {
   double GetTopologyBorder(void);
 
  private:
+  friend class MobilityManager;
+
   int m_nodeID;
+  CounterRng m_rng;
+  NetworkNode* m_device;
+  int m_slot;  // index in the MobilityManager arrays, -1 if not registered
 
   MobilityModel m_mobilityModel;
 
@@ -61,12 +61,6 @@ RandomDirection::UpdatePosition (double time)
 
   double timeInterval = time - GetPositionLastUpdate ();
 
-  UserEquipment *thisNode = NetworkManager::Init ()->GetUserEquipmentByID (GetNodeID ());
-  Cell *thisCell = thisNode->GetCell ();
-
-
-  NetworkNode *targetNode = thisNode->GetTargetNode ();
-
 #ifdef MOBILITY_DEBUG
 	std::cout << "MOBILITY_DEBUG: User ID: " << GetNodeID ()
 	    << "\n\t Cell ID " <<
@@ -98,10 +92,32 @@ RandomDirection::UpdatePosition (double time)
   double shift_x =
       shift * cos (GetSpeedDirection());
 
-  CartesianCoordinates *newPosition =
-      new CartesianCoordinates(GetAbsolutePosition()->GetCoordinateX()+shift_x,
-		  					   GetAbsolutePosition()->GetCoordinateY()+shift_y);
+  CartesianCoordinates newPosition (GetAbsolutePosition()->GetCoordinateX()+shift_x,
+                                    GetAbsolutePosition()->GetCoordinateY()+shift_y);
+
+  KeepInsideCell (&newPosition);
+
+  SetAbsolutePosition(&newPosition);
+  SetPositionLastUpdate (time);
+
+#ifdef MOBILITY_DEBUG
+  std::cout << "\n\t Final Position (X): " << GetAbsolutePosition()->GetCoordinateX()
+			<< "\n\t Final Position (Y): " << GetAbsolutePosition()->GetCoordinateY()
+			<< std::endl;
+#endif
+#ifdef MOBILITY_DEBUG_TAB
+  std::cout << GetAbsolutePosition()->GetCoordinateX() << " "
+			<< GetAbsolutePosition()->GetCoordinateY()
+			<< std::endl;
+#endif
+}
 
+void
+RandomDirection::KeepInsideCell (CartesianCoordinates *newPosition)
+{
+  UserEquipment *thisNode = (UserEquipment*) GetDevice ();
+  Cell *thisCell = thisNode->GetCell ();
+  NetworkNode *targetNode = thisNode->GetTargetNode ();
 
   CartesianCoordinates *ENodeBPosition = targetNode->GetMobilityModel ()->GetAbsolutePosition ();
 
@@ -113,20 +129,18 @@ RandomDirection::UpdatePosition (double time)
   if (newDistanceFromTheENodeB <= (thisCell->GetMinDistance() * 1000))
 	{
           /*
-	  CartesianCoordinates *Correction =
-	  new CartesianCoordinates (((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * cos(azimut),
+	  CartesianCoordinates Correction (((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * cos(azimut),
 		  					    ((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * sin(azimut));
 
-	  newPosition->SetCoordinateX(newPosition->GetCoordinateX() + Correction->GetCoordinateX());
-	  newPosition->SetCoordinateY(newPosition->GetCoordinateY() + Correction->GetCoordinateY());
+	  newPosition->SetCoordinateX(newPosition->GetCoordinateX() + Correction.GetCoordinateX());
+	  newPosition->SetCoordinateY(newPosition->GetCoordinateY() + Correction.GetCoordinateY());
 
 	  if ((azimut > GetSpeedDirection ()-pi/2) && (azimut < GetSpeedDirection ()+pi/2))
 		{
-		  double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+		  double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 		  SetSpeedDirection(speedDirection);
 		}
 
-	  delete Correction;
 	  */
 	}
   else if (newDistanceFromTheENodeB > (thisCell->GetRadius()*1000))
@@ -134,47 +148,25 @@ RandomDirection::UpdatePosition (double time)
 	  if (GetHandover()== false)
 		{
 		  //the UE must remain into the same cell
-		  CartesianCoordinates *Correction =
-		      new CartesianCoordinates ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
+		  CartesianCoordinates Correction ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
 		    		                    (newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * sin(azimut));
 
-		  newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction->GetCoordinateX());
-		  newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction->GetCoordinateY());
+		  newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction.GetCoordinateX());
+		  newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction.GetCoordinateY());
 
-		  double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+		  double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 		  SetSpeedDirection(speedDirection);
-
-		  delete Correction;
 		}
 	  else if (newPosition->GetDistance(0.0, 0.0) >= GetTopologyBorder ())
 	      {
-	  	    CartesianCoordinates *Correction =
-	  	        new CartesianCoordinates ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
+	  	    CartesianCoordinates Correction ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
 	   		 			                  (newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * sin(azimut));
 
-	  	    newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction->GetCoordinateX());
-	  	    newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction->GetCoordinateY());
+	  	    newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction.GetCoordinateX());
+	  	    newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction.GetCoordinateY());
 
-	  	  	double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+	  	  	double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 	  	  	SetSpeedDirection(speedDirection);
-
-	  	    delete Correction;
 	      }
     }
-
-  SetAbsolutePosition(newPosition);
-  SetPositionLastUpdate (time);
-
-#ifdef MOBILITY_DEBUG
-  std::cout << "\n\t Final Position (X): " << GetAbsolutePosition()->GetCoordinateX()
-			<< "\n\t Final Position (Y): " << GetAbsolutePosition()->GetCoordinateY()
-			<< std::endl;
-#endif
-#ifdef MOBILITY_DEBUG_TAB
-  std::cout << GetAbsolutePosition()->GetCoordinateX() << " "
-			<< GetAbsolutePosition()->GetCoordinateY()
-			<< std::endl;
-#endif
-
-  delete newPosition;
 }
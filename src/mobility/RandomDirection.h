@@ -30,6 +30,13 @@ class RandomDirection : public Mobility {
   virtual ~RandomDirection();
 
   void UpdatePosition(double time);
+
+  /*
+   * Pulls a position computed for this UE back inside its cell, drawing a
+   * new direction when it hits the border. Used by UpdatePosition and by
+   * the batched update of the MobilityManager.
+   */
+  void KeepInsideCell(CartesianCoordinates* newPosition);
 };
 
 #endif /* LINEARTRAJECTORY_H_ */
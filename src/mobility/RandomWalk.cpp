@@ -64,7 +64,7 @@ RandomWalk::UpdatePosition(double time)
 
   double timeInterval = time - GetPositionLastUpdate ();
 
-  UserEquipment *thisNode = NetworkManager::Init ()->GetUserEquipmentByID (GetNodeID ());
+  UserEquipment *thisNode = (UserEquipment*) GetDevice ();
   Cell *thisCell = thisNode->GetCell ();
   NetworkNode *targetNode = thisNode->GetTargetNode ();
 
@@ -99,67 +99,58 @@ RandomWalk::UpdatePosition(double time)
   double shift_x =
       shift * cos (GetSpeedDirection());
 
-  CartesianCoordinates *newPosition =
-      new CartesianCoordinates(GetAbsolutePosition()->GetCoordinateX()+shift_x,
+  CartesianCoordinates newPosition (GetAbsolutePosition()->GetCoordinateX()+shift_x,
 		  					   GetAbsolutePosition()->GetCoordinateY()+shift_y);
 
   CartesianCoordinates *ENodeBPosition = targetNode->GetMobilityModel ()->GetAbsolutePosition ();
 
   const double pi = 3.1415926;
-  double azimut = newPosition->GetPolarAzimut (ENodeBPosition);
-  double newDistanceFromTheENodeB = newPosition->GetDistance (ENodeBPosition);
+  double azimut = newPosition.GetPolarAzimut (ENodeBPosition);
+  double newDistanceFromTheENodeB = newPosition.GetDistance (ENodeBPosition);
 
   if (newDistanceFromTheENodeB <= (thisCell->GetMinDistance() * 1000))
 	{
-	  CartesianCoordinates *Correction =
-	  new CartesianCoordinates (((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * cos(azimut),
+	  CartesianCoordinates Correction (((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * cos(azimut),
 		  					    ((thisCell->GetMinDistance()*1000) - newDistanceFromTheENodeB) * sin(azimut));
 
-	  newPosition->SetCoordinateX(newPosition->GetCoordinateX() + Correction->GetCoordinateX());
-	  newPosition->SetCoordinateY(newPosition->GetCoordinateY() + Correction->GetCoordinateY());
+	  newPosition.SetCoordinateX(newPosition.GetCoordinateX() + Correction.GetCoordinateX());
+	  newPosition.SetCoordinateY(newPosition.GetCoordinateY() + Correction.GetCoordinateY());
 
 	  if ((azimut > GetSpeedDirection ()-pi/2) && (azimut < GetSpeedDirection ()+pi/2))
 		{
-		  double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+		  double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 		  SetSpeedDirection(speedDirection);
 		}
 
-	  delete Correction;
 	}
   else if (newDistanceFromTheENodeB > (thisCell->GetRadius()*1000))
     {
 	  if (GetHandover()== false)
 		{
 		  //the UE must remain into the same cell
-		  CartesianCoordinates *Correction =
-		      new CartesianCoordinates ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
+		  CartesianCoordinates Correction ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
 		    		                    (newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * sin(azimut));
 
-		  newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction->GetCoordinateX());
-		  newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction->GetCoordinateY());
+		  newPosition.SetCoordinateX(newPosition.GetCoordinateX() - Correction.GetCoordinateX());
+		  newPosition.SetCoordinateY(newPosition.GetCoordinateY() - Correction.GetCoordinateY());
 
-		  double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+		  double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 		  SetSpeedDirection(speedDirection);
-
-		  delete Correction;
 		}
-	  else if (newPosition->GetDistance(0.0, 0.0) >= GetTopologyBorder ())
+	  else if (newPosition.GetDistance(0.0, 0.0) >= GetTopologyBorder ())
 	      {
-	  	    CartesianCoordinates *Correction =
-	  	        new CartesianCoordinates ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
+	  	    CartesianCoordinates Correction ((newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * cos(azimut),
 	   		 			                  (newDistanceFromTheENodeB - (thisCell->GetRadius()*1000)) * sin(azimut));
 
-	  	    newPosition->SetCoordinateX(newPosition->GetCoordinateX() - Correction->GetCoordinateX());
-	  	    newPosition->SetCoordinateY(newPosition->GetCoordinateY() - Correction->GetCoordinateY());
+	  	    newPosition.SetCoordinateX(newPosition.GetCoordinateX() - Correction.GetCoordinateX());
+	  	    newPosition.SetCoordinateY(newPosition.GetCoordinateY() - Correction.GetCoordinateY());
 
-			double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+			double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 			SetSpeedDirection(speedDirection);
-
-	  	    delete Correction;
 	      }
     }
 
-  SetAbsolutePosition(newPosition);
+  SetAbsolutePosition(&newPosition);
   SetPositionLastUpdate (time);
 
 #ifdef MOBILITY_DEBUG
@@ -173,11 +164,10 @@ RandomWalk::UpdatePosition(double time)
 			<< std::endl;
 #endif
 
-  delete newPosition;
 
   if (time - m_lastTimeDirectionChange >= m_interval)
     {
-	  double speedDirection = (double)(rand() %360) * ((2*3.14)/360);
+	  double speedDirection = (double)(GetRandomStream ().NextInt (360)) * ((2*3.14)/360);
 	  SetSpeedDirection(speedDirection);
 
 	  double averageDistance;
@@ -204,7 +194,7 @@ RandomWalk::UpdatePosition(double time)
 	  a = averageDistance - 100;
 	  b = averageDistance + 100;
 
-	  double distance = (double) (rand() %1001);
+	  double distance = (double) (GetRandomStream ().NextInt (1001));
 	  distance = distance/1000;
 	  distance = a + (distance * (b-a)); //m
 
@@ -224,45 +224,42 @@ static double SINR_15_CQI_AWGN[15][43] = {
 
 };
 
+/*
+ * The SINR breakpoints of every curve are uniformly spaced (0.25 dB), so
+ * the segment holding SINR is found by indexing instead of scanning the
+ * whole curve. The interpolation is the same as before, bit for bit.
+ */
 static double GetBLER_AWGN(double SINR, int MCS) {
-  int index = -1;
-  double BLER = 0.0;
   int CQI = MCS;
-  double R = 0.0;
+  const double *sinr = SINR_15_CQI_AWGN[CQI - 1];
+  const double *bler = BLER_15_CQI_AWGN[CQI - 1];
 
-  if (SINR <= SINR_15_CQI_AWGN[CQI - 1][0]) {
-    BLER = 1.0;
-  } else if (SINR >= SINR_15_CQI_AWGN[CQI - 1][42]) {
-    BLER = 0.0;
-  } else {
-    for (int i = 0; i < 42; i++) {
-      if (SINR >= SINR_15_CQI_AWGN[CQI - 1][i] &&
-          SINR < SINR_15_CQI_AWGN[CQI - 1][i + 1]) {
-        index = i;
-        // std::cout << SINR_15_CQI_AWGN [CQI] [i] << " - " << SINR_15_CQI_AWGN
-        // [CQI] [i+1] << std::endl;
-      }
-    }
+  if (SINR <= sinr[0]) {
+    return 1.0;
+  } else if (SINR >= sinr[42] || SINR != SINR) {
+    return 0.0;
   }
 
-  if (index != -1) {
-    R = (SINR - SINR_15_CQI_AWGN[CQI - 1][index]) /
-        (SINR_15_CQI_AWGN[CQI - 1][index + 1] -
-         SINR_15_CQI_AWGN[CQI - 1][index]);
-
-    BLER = BLER_15_CQI_AWGN[CQI - 1][index] +
-           R * (BLER_15_CQI_AWGN[CQI - 1][index + 1] -
-                BLER_15_CQI_AWGN[CQI - 1][index]);
+  int index = (int)((SINR - sinr[0]) / (sinr[1] - sinr[0]));
+  if (index > 41) index = 41;
+  // guard against rounding right at a breakpoint
+  if (SINR < sinr[index]) {
+    index--;
+  } else if (SINR >= sinr[index + 1]) {
+    index++;
   }
 
+  double R = (SINR - sinr[index]) / (sinr[index + 1] - sinr[index]);
+  double BLER = bler[index] + R * (bler[index + 1] - bler[index]);
+
 #ifdef BLER_DEBUG
   if (BLER >= 0.1) {
     std::cout << "SINR " << SINR << " "
               << "CQI " << CQI << " "
-              << "SINRprec " << SINR_15_CQI_AWGN[CQI][index] << " "
-              << "SINRsucc " << SINR_15_CQI_AWGN[CQI][index + 1] << " "
-              << "BLERprec " << BLER_15_CQI_AWGN[CQI][index] << " "
-              << "BLERsucc " << BLER_15_CQI_AWGN[CQI][index + 1] << " "
+              << "SINRprec " << sinr[index] << " "
+              << "SINRsucc " << sinr[index + 1] << " "
+              << "BLERprec " << bler[index] << " "
+              << "BLERsucc " << bler[index + 1] << " "
               << "R " << R << " "
               << "BLER " << BLER << " " << std::endl;
   }
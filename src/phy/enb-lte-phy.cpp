@@ -32,9 +32,14 @@
 #include "interference.h"
 #include "error-model.h"
 #include "../channel/propagation-model/propagation-loss-model.h"
+#include "../channel/propagation-model/channel-realization.h"
 #include "../protocolStack/mac/AMCModule.h"
 #include "../utility/eesm-effective-sinr.h"
 #include "../componentManagers/FrameManager.h"
+#include "../core/eventScheduler/simulator.h"
+#include "ue-lte-phy.h"
+
+#include <algorithm>
 
 
 /*
@@ -58,10 +63,15 @@ EnbLtePhy::EnbLtePhy()
   SetErrorModel (NULL);
   SetInterference (NULL);
   SetTxPower(43); //dBm
+  m_referenceSymbolsTask = -1;
 }
 
 EnbLtePhy::~EnbLtePhy()
 {
+  if (m_referenceSymbolsTask >= 0)
+    {
+      Simulator::Init ()->CancelPeriodic (m_referenceSymbolsTask);
+    }
   Destroy ();
 }
 
@@ -112,7 +122,10 @@ EnbLtePhy::StartRx (PacketBurst* p, TransmittedSignal* txSignal)
   std::vector<int> channelsForRx;
   std::vector<double> rxSignalValues;
   std::vector<double>::iterator it;
-  rxSignalValues = txSignal->Getvalues();
+  if (txSignal != NULL) //NULL on a trace-driven channel
+    {
+      rxSignalValues = txSignal->Getvalues();
+    }
 
   double interference = 0;
   double noise_interference = 10. * log10 (pow(10., NOISE/10) + interference); // dB
@@ -171,6 +184,9 @@ EnbLtePhy::SendIdealControlMessage (IdealControlMessage *msg)
   if (msg->GetMessageType () == IdealControlMessage::ALLOCATION_MAP)
 	{
 	  ENodeB *enb = (ENodeB*) GetDevice ();
+	  msg->SetSourceDevice (enb);
+	  ((PdcchMapIdealControlMessage*) msg)->IndexGrants (enb, &m_grants, &m_grantRecords);
+
 	  ENodeB::UserEquipmentRecords* registeredUe = enb->GetUserEquipmentRecords ();
 	  ENodeB::UserEquipmentRecords::iterator it;
 
@@ -206,53 +222,119 @@ EnbLtePhy::ReceiveIdealControlMessage (IdealControlMessage *msg)
 }
 
 void
-EnbLtePhy::ReceiveReferenceSymbols (NetworkNode* n, TransmittedSignal* s)
+EnbLtePhy::ReceiveReferenceSymbols (UserEquipment* ue)
 {
-  ENodeB::UserEquipmentRecord* user = ((ENodeB*) GetDevice ())->
-		  GetUserEquipmentRecord (n->GetIDNetworkNode ());
-  TransmittedSignal* rxSignal;
-  if (GetUlChannel ()->GetPropagationLossModel () != NULL)
-	{
-	  rxSignal = GetUlChannel ()->GetPropagationLossModel ()->
-			  AddLossModel (n, GetDevice (), s);
-	}
-  else
-	{
-	  rxSignal = s->Copy ();
-	}
-  AMCModule* amc = GetDevice ()->GetProtocolStack ()->GetMacEntity ()->GetAmcModule ();
-  std::vector<double> ulQuality;
-  std::vector<double> rxSignalValues = rxSignal->Getvalues ();
-  double noise_interference = 10. * log10 (pow(10., NOISE/10)); // dB
-  for (std::vector<double>::iterator it = rxSignalValues.begin(); it != rxSignalValues.end(); it++)
+  m_soundingUes.clear ();
+  m_soundingUes.push_back (ue);
+  MeasureReferenceSymbols ();
+  StartReferenceSymbolsReception ();
+}
+
+void
+EnbLtePhy::StartReferenceSymbolsReception (void)
+{
+  if (m_referenceSymbolsTask < 0)
     {
-      double power;
-      if ((*it) != 0.)
+      m_referenceSymbolsTask = Simulator::Init ()->SchedulePeriodic (1, &EnbLtePhy::ReceiveAllReferenceSymbols, this);
+    }
+}
+
+void
+EnbLtePhy::ReceiveAllReferenceSymbols (void)
+{
+  ENodeB* enb = (ENodeB*) GetDevice ();
+  ENodeB::UserEquipmentRecords* records = enb->GetUserEquipmentRecords ();
+  m_soundingUes.clear ();
+  for (ENodeB::UserEquipmentRecords::iterator it = records->begin (); it != records->end (); it++)
+    {
+      UserEquipment* ue = (*it)->GetUE ();
+      if (ue->GetTargetNode () == enb
+          && ((UeLtePhy*) ue->GetPhy ())->SendsReferenceSymbols ())
         {
-          power = (*it);
+          m_soundingUes.push_back (ue);
         }
-      else
+    }
+  if (!m_soundingUes.empty ())
+    {
+      MeasureReferenceSymbols ();
+    }
+}
+
+void
+EnbLtePhy::MeasureReferenceSymbols (void)
+{
+  int nbOfUes = m_soundingUes.size ();
+  PropagationLossModel* lossModel = GetUlChannel ()->GetPropagationLossModel ();
+
+  // the rows are as wide as the widest PSD, the padding is measured too
+  size_t subChannels = 0;
+  for (int u = 0; u < nbOfUes; u++)
+    {
+      UeLtePhy* uePhy = (UeLtePhy*) m_soundingUes[u]->GetPhy ();
+      subChannels = std::max (subChannels, uePhy->GetTxSignalForReferenceSymbols ()->Getvalues ().size ());
+    }
+  m_ulPsd.assign (nbOfUes * subChannels, 0.);
+  m_ulLoss.assign (nbOfUes * subChannels, 0.);
+
+  for (int u = 0; u < nbOfUes; u++)
+    {
+      UserEquipment* ue = m_soundingUes[u];
+      const std::vector<double>& txPsd =
+          ((UeLtePhy*) ue->GetPhy ())->GetTxSignalForReferenceSymbols ()->Getvalues ();
+      std::copy (txPsd.begin (), txPsd.end (), m_ulPsd.begin () + u * subChannels);
+
+      if (lossModel != NULL)
         {
-          power = 0.;
+          ChannelRealization* c = lossModel->GetChannelRealization (ue, GetDevice ());
+          if ((size_t) c->GetNbOfSubChannels () < txPsd.size ())
+            {
+              std::cerr << "ERROR: UE " << ue->GetIDNetworkNode ()
+                        << " sends reference symbols on more sub-channels than its channel has"
+                        << std::endl;
+              exit (1);
+            }
+          if ((size_t) c->GetNbOfSubChannels () <= subChannels)
+            {
+              c->ComputeLoss (&m_ulLoss[u * subChannels]);
+            }
+          else
+            {
+              std::vector<double> loss = c->GetLoss ();
+              std::copy (loss.begin (), loss.begin () + txPsd.size (), m_ulLoss.begin () + u * subChannels);
+            }
         }
-      ulQuality.push_back (power - noise_interference - UL_INTERFERENCE);
     }
 
+  double noise_interference = 10. * log10 (pow(10., NOISE/10)); // dB
+  double* psd = m_ulPsd.data ();
+  const double* loss = m_ulLoss.data ();
+  size_t size = m_ulPsd.size ();
+  for (size_t i = 0; i < size; i++)
+    {
+      double power = psd[i] + loss[i];
+      psd[i] = power - noise_interference - UL_INTERFERENCE;
+    }
+
+  ENodeB* enb = (ENodeB*) GetDevice ();
+  for (int u = 0; u < nbOfUes; u++)
+    {
+      UserEquipment* ue = m_soundingUes[u];
+      int nbOfSubChannels = ((UeLtePhy*) ue->GetPhy ())->GetTxSignalForReferenceSymbols ()->Getvalues ().size ();
+      const double* ulQuality = psd + u * subChannels;
 
 #ifdef TEST_UL_SINR
-  double effectiveSinr = GetEesmEffectiveSinr (ulQuality);
-  if (effectiveSinr > 40) effectiveSinr = 40;
-  int mcs = amc->GetMCSFromCQI (amc->GetCQIFromSinr(effectiveSinr));
-  std::cout << "UL_SINR " << n->GetIDNetworkNode () << " "
-		  << n->GetMobilityModel ()->GetAbsolutePosition()->GetCoordinateX () << " "
-		  << n->GetMobilityModel ()->GetAbsolutePosition()->GetCoordinateY () << " "
-		  << effectiveSinr << " " << mcs << std::endl;
+      AMCModule* amc = GetDevice ()->GetProtocolStack ()->GetMacEntity ()->GetAmcModule ();
+      double effectiveSinr = GetEesmEffectiveSinr (std::vector<double> (ulQuality, ulQuality + nbOfSubChannels));
+      if (effectiveSinr > 40) effectiveSinr = 40;
+      int mcs = amc->GetMCSFromCQI (amc->GetCQIFromSinr(effectiveSinr));
+      std::cout << "UL_SINR " << ue->GetIDNetworkNode () << " "
+    		  << ue->GetMobilityModel ()->GetAbsolutePosition()->GetCoordinateX () << " "
+    		  << ue->GetMobilityModel ()->GetAbsolutePosition()->GetCoordinateY () << " "
+    		  << effectiveSinr << " " << mcs << std::endl;
 #endif
 
-
-  user->SetUplinkChannelStatusIndicator (ulQuality);
-  if (rxSignal) {
-    delete rxSignal;
-  }
+      enb->GetUserEquipmentRecord (ue->GetIDNetworkNode ())->
+          SetUplinkChannelStatusIndicator (ulQuality, nbOfSubChannels);
+    }
 }
 
@@ -22,9 +22,12 @@
 #ifndef ENB_LTE_PHY_H_
 #define ENB_LTE_PHY_H_
 
+#include <vector>
+
+#include "../core/idealMessages/ideal-control-messages.h"
 #include "lte-phy.h"
 
-class IdealControlMessage;
+class UserEquipment;
 
 class EnbLtePhy : public LtePhy {
  public:
@@ -39,7 +42,31 @@ class EnbLtePhy : public LtePhy {
   virtual void SendIdealControlMessage(IdealControlMessage* msg);
   virtual void ReceiveIdealControlMessage(IdealControlMessage* msg);
 
-  void ReceiveReferenceSymbols(NetworkNode* n, TransmittedSignal* s);
+  // the first reference symbols of a UE, measured on their own
+  void ReceiveReferenceSymbols(UserEquipment* ue);
+  /*
+   * Every TTI, the reference symbols of all the UEs of the eNB that send
+   * them: their transmit PSDs go into one matrix, a row per UE, the loss of
+   * each UL channel into another, and the UL SINR of all the UEs is computed
+   * in one pass over the matrices, straight into the UE records.
+   */
+  void ReceiveAllReferenceSymbols(void);
+  // from now on, every TTI; started by the first UE
+  void StartReferenceSymbolsReception(void);
+
+ private:
+  // the UL SINR of the m_soundingUes
+  void MeasureReferenceSymbols(void);
+
+  int m_referenceSymbolsTask;  // -1 before the first UE
+  std::vector<UserEquipment*> m_soundingUes;
+  // one row per UE, as wide as the widest PSD
+  std::vector<double> m_ulPsd;   // transmitted, then the UL SINR
+  std::vector<double> m_ulLoss;  // propagation loss
+
+  // the PDCCH map index of the TTI, by UE record
+  std::vector<PdcchMapIdealControlMessage::Grant> m_grants;
+  PdcchMapIdealControlMessage::IdealPdcchMessage m_grantRecords;
 };
 
 #endif /* ENB_LTE_PHY_H_ */
@@ -22,10 +22,21 @@
 #include "error-model.h"
 #include "BLERTrace/BLERvsSINR_15CQI_AWGN.h"
 #include "BLERTrace/BLERvsSINR_15CQI_TU.h"
-#include "../utility/RandomVariable.h"
 
 ErrorModel::ErrorModel()
 {}
 
 ErrorModel::~ErrorModel()
 {}
+
+CounterRng&
+ErrorModel::GetRandomStream (void)
+{
+  return m_rng;
+}
+
+void
+ErrorModel::SetDevice (int idDevice)
+{
+  m_rng = CounterRng (idDevice, RNG_PURPOSE_ERROR_MODEL);
+}
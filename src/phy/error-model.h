@@ -24,6 +24,8 @@
 
 #include <vector>
 
+#include "../utility/counter-rng.h"
+
 class ErrorModel {
  public:
   ErrorModel();
@@ -32,6 +34,13 @@ class ErrorModel {
   virtual bool CheckForPhysicalError(std::vector<int> channels,
                                      std::vector<int> mcs,
                                      std::vector<double> m_sinr) = 0;
+
+  // one stream per error model, keyed by the ID of the device that owns it
+  CounterRng& GetRandomStream(void);
+  void SetDevice(int idDevice);
+
+ private:
+  CounterRng m_rng;
 };
 
 #endif /* ERRORMODEL_H_ */
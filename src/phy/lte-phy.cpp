@@ -28,6 +28,7 @@
 #include "../core/spectrum/transmitted-signal.h"
 #include "interference.h"
 #include "error-model.h"
+#include <math.h>
 
 LtePhy::LtePhy()
 {
@@ -35,6 +36,7 @@ LtePhy::LtePhy()
   m_dlChannel = NULL;
   m_ulChannel = NULL;
   m_bandwidthManager = NULL;
+  m_txPowerPerSubChannelValid = false;
   m_txSignal = NULL;
 }
 
@@ -100,6 +102,7 @@ void
 LtePhy::SetBandwidthManager (BandwidthManager* s)
 {
   m_bandwidthManager = s;
+  m_txPowerPerSubChannelValid = false;
   if (s != NULL)
     DoSetBandwidthManager ();
 }
@@ -114,6 +117,7 @@ void
 LtePhy::SetTxPower (double p)
 {
   m_txPower = p;
+  m_txPowerPerSubChannelValid = false;
 }
 
 double
@@ -122,6 +126,20 @@ LtePhy::GetTxPower (void)
   return m_txPower;
 }
 
+double
+LtePhy::GetTxPowerPerSubChannel (void)
+{
+  if (!m_txPowerPerSubChannelValid)
+    {
+      m_txPowerPerSubChannel = 10 * log10 (
+          pow (10., (m_txPower - 30)/10)
+          /
+          m_bandwidthManager->GetDlSubChannels ().size ());
+      m_txPowerPerSubChannelValid = true;
+    }
+  return m_txPowerPerSubChannel;
+}
+
 void
 LtePhy::SetTxSignal (TransmittedSignal* txSignal)
 {
@@ -145,6 +163,10 @@ void
 LtePhy::SetErrorModel (ErrorModel* e)
 {
   m_errorModel = e;
+  if (e != NULL && m_device != NULL)
+    {
+      e->SetDevice (m_device->GetIDNetworkNode ());
+    }
 }
 
 
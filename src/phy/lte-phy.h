@@ -55,6 +55,9 @@ class LtePhy {
 
   void SetTxPower(double p);
   double GetTxPower(void);
+  // dBm on each downlink sub-channel, kept until the power or the
+  // bandwidth manager changes
+  double GetTxPowerPerSubChannel(void);
 
   void SetTxSignal(TransmittedSignal* txSignal);
   TransmittedSignal* GetTxSignal(void);
@@ -77,6 +80,8 @@ class LtePhy {
                                          // available BandwidthManager
 
   double m_txPower;
+  double m_txPowerPerSubChannel;
+  bool m_txPowerPerSubChannelValid;
   TransmittedSignal* m_txSignal;
 
   Interference* m_interference;
@@ -22,7 +22,6 @@
 #include "simple-error-model.h"
 #include "BLERTrace/BLERvsSINR_15CQI_AWGN.h"
 #include "BLERTrace/BLERvsSINR_15CQI_TU.h"
-#include "../utility/RandomVariable.h"
 
 SimpleErrorModel::SimpleErrorModel()
 {}
@@ -69,7 +68,7 @@ SimpleErrorModel::CheckForPhysicalError (std::vector<int> channels, std::vector<
 #endif
 
 
-  double randomNumber = (rand () %100 ) / 100.;
+  double randomNumber = GetRandomStream ().NextInt (100) / 100.;
 
   for (int i = 0; i < channels.size (); i++)
     {
@@ -34,12 +34,14 @@
 #include "interference.h"
 #include "error-model.h"
 #include "../device/CqiManager/cqi-manager.h"
+#include "../device/CqiManager/cqi-trace-store.h"
 #include "../load-parameters.h"
 #include "../core/eventScheduler/simulator.h"
 #include "../protocolStack/mac/ue-mac-entity.h"
 #include "../utility/eesm-effective-sinr.h"
 #include "enb-lte-phy.h"
 #include "../utility/ComputePathLoss.h"
+#include "../utility/phase-profiler.h"
 
 /*
  * Noise is computed as follows:
@@ -66,6 +68,7 @@ UeLtePhy::UeLtePhy()
   Interference *interference = new Interference ();
   SetInterference (interference);
   SetTxPower (23); //dBm
+  m_sendsReferenceSymbols = false;
 
   Simulator::Init()->Schedule(0.001, &UeLtePhy::SetTxSignalForReferenceSymbols, this);
 }
@@ -118,47 +121,24 @@ UeLtePhy::StartTx (PacketBurst* p)
 void
 UeLtePhy::StartRx (PacketBurst* p, TransmittedSignal* txSignal)
 {
+  PROFILE_PHASE (PHASE_UE_PHY_RX);
 #ifdef TEST_DEVICE_ON_CHANNEL
   std::cout << "Node " << GetDevice()->GetIDNetworkNode () << " starts phy rx" << std::endl;
 #endif
 
   m_measuredSinr.clear();
 
-  //COMPUTE THE SINR
-  std::vector<double> rxSignalValues;
-  std::vector<double>::iterator it;
-
-  rxSignalValues = txSignal->Getvalues();
-
-  //compute noise + interference
-  double interference;
-  if (GetInterference () != NULL)
+  if (txSignal == NULL)
     {
-      interference = GetInterference ()->ComputeInterference ((UserEquipment*) GetDevice ());
+      //TRACE-DRIVEN CHANNEL: THE SINR IS THE ONE OF THE TRACE CQI
+      if (GetErrorModel() != NULL && m_channelsForRx.size () > 0)
+        {
+          ComputeSinrFromTrace ();
+        }
     }
   else
     {
-	  interference = 0;
-    }
-
-  double noise_interference = 10. * log10 (pow(10., NOISE/10) + interference); // dB
-
-
-  for (it = rxSignalValues.begin(); it != rxSignalValues.end(); it++)
-    {
-      double power; // power transmission for the current sub channel [dB]
-      if ((*it) != 0.)
-        {
-          power = (*it);
-        }
-      else
-        {
-          power = 0.;
-        }
-      m_measuredSinr.push_back (power - noise_interference);
-      #ifdef TEST_PROPAGATION_LOSS_MODEL
-      std::cout << "rxPower= " << power << " noise_interference= " << noise_interference << " sinr= " << m_measuredSinr.back() << std::endl;
-      #endif
+      ComputeSinr (txSignal);
     }
 
   //CHECK FOR PHY ERROR
@@ -223,9 +203,67 @@ UeLtePhy::StartRx (PacketBurst* p, TransmittedSignal* txSignal)
   delete p;
 }
 
+void
+UeLtePhy::ComputeSinr (TransmittedSignal* txSignal)
+{
+  PROFILE_PHASE (PHASE_UE_PHY_SINR);
+  //COMPUTE THE SINR
+  std::vector<double> rxSignalValues;
+  std::vector<double>::iterator it;
+
+  rxSignalValues = txSignal->Getvalues();
+
+  //compute noise + interference
+  double interference;
+  if (GetInterference () != NULL)
+    {
+      interference = GetInterference ()->ComputeInterference ((UserEquipment*) GetDevice ());
+    }
+  else
+    {
+	  interference = 0;
+    }
+
+  double noise_interference = 10. * log10 (pow(10., NOISE/10) + interference); // dB
+
+
+  for (it = rxSignalValues.begin(); it != rxSignalValues.end(); it++)
+    {
+      double power; // power transmission for the current sub channel [dB]
+      if ((*it) != 0.)
+        {
+          power = (*it);
+        }
+      else
+        {
+          power = 0.;
+        }
+      m_measuredSinr.push_back (power - noise_interference);
+      #ifdef TEST_PROPAGATION_LOSS_MODEL
+      std::cout << "rxPower= " << power << " noise_interference= " << noise_interference << " sinr= " << m_measuredSinr.back() << std::endl;
+      #endif
+    }
+}
+
+void
+UeLtePhy::ComputeSinrFromTrace (void)
+{
+  PROFILE_PHASE (PHASE_UE_PHY_SINR);
+  AMCModule *amc = GetDevice ()->GetProtocolStack ()->GetMacEntity ()->GetAmcModule ();
+  std::vector<int> cqi;
+  CqiTraceStore::Init ()->GetReportForUser (
+      GetDevice ()->GetIDNetworkNode (), Simulator::Init ()->Now (),
+      GetBandwidthManager ()->GetDlSubChannels ().size (), cqi);
+  for (size_t i = 0; i < cqi.size (); i++)
+    {
+      m_measuredSinr.push_back (amc->GetSinrFromCQI (cqi[i]));
+    }
+}
+
 void
 UeLtePhy::CreateCqiFeedbacks (std::vector<double> sinr)
 {
+  PROFILE_PHASE (PHASE_UE_PHY_CQI);
   UserEquipment* thisNode = (UserEquipment*) GetDevice ();
   if (thisNode->GetCqiManager ()->NeedToSendFeedbacks ())
     {
@@ -261,30 +299,28 @@ UeLtePhy::ReceiveIdealControlMessage (IdealControlMessage *msg)
 	  m_mcsIndexForTx.clear ();
 
 	  PdcchMapIdealControlMessage *map = (PdcchMapIdealControlMessage*) msg;
-      PdcchMapIdealControlMessage::IdealPdcchMessage *map2 = map->GetMessage ();
-      PdcchMapIdealControlMessage::IdealPdcchMessage::iterator it;
-
-      int node = GetDevice ()->GetIDNetworkNode ();
+      ENodeB::UserEquipmentRecord *ue =
+          ((ENodeB*) map->GetSourceDevice ())->GetUserEquipmentRecord (GetDevice ()->GetIDNetworkNode ());
+      const PdcchMapIdealControlMessage::Grant *grant = ue != NULL ? map->GetGrant (ue->GetIndex ()) : NULL;
+      const PdcchMapIdealControlMessage::IdealPdcchMessage &records = map->GetGrantRecords ();
 
-      for (it = map2->begin(); it != map2->end (); it++)
+      for (int i = 0; grant != NULL && i < grant->m_nbRecords; i++)
         {
-    	  if ((*it).m_ue->GetIDNetworkNode () == node)
-    	    {
-              if ((*it).m_direction == PdcchMapIdealControlMessage::DOWNLINK)
-                {
-            	  //std::cout << "\t channel " << (*it).m_idSubChannel
-                	//		  << " mcs "<< (*it).m_mcsIndex << std::endl;
-
-            	  m_channelsForRx.push_back ((*it).m_idSubChannel);
-            	  m_mcsIndexForRx.push_back((*it).m_mcsIndex);
-                }
-              else if ((*it).m_direction == PdcchMapIdealControlMessage::UPLINK)
-                {
-            	  m_channelsForTx.push_back ((*it).m_idSubChannel);
-            	  m_mcsIndexForTx.push_back((*it).m_mcsIndex);
-                }
-    	    }
-	    }
+          const PdcchMapIdealControlMessage::IdealPdcchRecord &record = records[grant->m_firstRecord + i];
+          if (record.m_direction == PdcchMapIdealControlMessage::DOWNLINK)
+            {
+              //std::cout << "\t channel " << record.m_idSubChannel
+              //		  << " mcs "<< record.m_mcsIndex << std::endl;
+
+              m_channelsForRx.push_back (record.m_idSubChannel);
+              m_mcsIndexForRx.push_back (record.m_mcsIndex);
+            }
+          else if (record.m_direction == PdcchMapIdealControlMessage::UPLINK)
+            {
+              m_channelsForTx.push_back (record.m_idSubChannel);
+              m_mcsIndexForTx.push_back (record.m_mcsIndex);
+            }
+        }
 
       if (m_channelsForTx.size () > 0)
         {
@@ -326,11 +362,23 @@ UeLtePhy::GetTxSignalForReferenceSymbols (void)
 void
 UeLtePhy::SendReferenceSymbols (void)
 {
+  if (GetUlChannel ()->IsTraceDriven ())
+    {
+      //no uplink channel to sound
+      return;
+    }
   UserEquipment* ue = (UserEquipment*) GetDevice ();
   ENodeB* target = (ENodeB*) ue->GetTargetNode ();
   EnbLtePhy* enbPhy = (EnbLtePhy*) target->GetPhy ();
-  enbPhy->ReceiveReferenceSymbols (ue, GetTxSignalForReferenceSymbols ());
-  Simulator::Init()->Schedule(0.001, &UeLtePhy::SendReferenceSymbols, this);
+  enbPhy->ReceiveReferenceSymbols (ue);
+  // then every TTI, with the other UEs of the eNB
+  m_sendsReferenceSymbols = true;
+}
+
+bool
+UeLtePhy::SendsReferenceSymbols (void) const
+{
+  return m_sendsReferenceSymbols;
 }
 
 
@@ -38,6 +38,8 @@ class UeLtePhy : public LtePhy {
   virtual void StartTx(PacketBurst* p);
   virtual void StartRx(PacketBurst* p, TransmittedSignal* txSignal);
 
+  void ComputeSinr(TransmittedSignal* txSignal);
+  void ComputeSinrFromTrace(void);
   void CreateCqiFeedbacks(std::vector<double> sinr);
 
   virtual void SendIdealControlMessage(IdealControlMessage* msg);
@@ -46,10 +48,13 @@ class UeLtePhy : public LtePhy {
   void SendReferenceSymbols(void);
   void SetTxSignalForReferenceSymbols(void);
   TransmittedSignal* GetTxSignalForReferenceSymbols(void);
+  // measured by the target eNB every TTI
+  bool SendsReferenceSymbols(void) const;
 
  private:
   std::vector<double> m_measuredSinr;
   TransmittedSignal* m_txSignalForRerferenceSymbols;
+  bool m_sendsReferenceSymbols;
 
   std::vector<int> m_channelsForTx;
   std::vector<int> m_mcsIndexForTx;
@@ -22,7 +22,6 @@
 #include "wideband-cqi-eesm-error-model.h"
 #include "BLERTrace/BLERvsSINR_15CQI_AWGN.h"
 #include "BLERTrace/BLERvsSINR_15CQI_TU.h"
-#include "../utility/RandomVariable.h"
 #include "../utility/eesm-effective-sinr.h"
 #include "../load-parameters.h"
 
@@ -66,39 +65,26 @@ WidebandCqiEesmErrorModel::CheckForPhysicalError (std::vector<int> channels, std
 
 
   double effective_sinr = GetEesmEffectiveSinr (new_sinr);
-  double randomNumber = (rand () %100 ) / 100.;
-  int mcs_ = mcs.at (0);
   double bler;
-
-  if (_channel_AWGN_)
-    {
-	  bler = GetBLER_AWGN (effective_sinr, mcs_);
-    }
-  else if (_channel_TU_)
+  if (_channel_TU_ && !_channel_AWGN_)
     {
-	  bler = GetBLER_TU (effective_sinr, mcs_);
+      bler = GetBLER_TU (effective_sinr, mcs.at (0));
     }
   else
     {
-	  bler = GetBLER_AWGN (effective_sinr, mcs_);
+      bler = GetBLER_AWGN (effective_sinr, mcs.at (0));
     }
+  double randomNumber = GetRandomStream ().NextUniform ();
 
 #ifdef BLER_DEBUG
-	  std::cout <<"CheckForPhysicalError: , effective SINR:" << effective_sinr
-			  << ", selected CQI: " << mcs_
-			  << ", random " << randomNumber
-			  << ", BLER: " << bler << std::endl;
+  std::cout <<"CheckForPhysicalError: , effective SINR:" << effective_sinr
+		  << ", selected CQI: " << mcs.at (0)
+		  << ", random " << randomNumber
+		  << ", BLER: " << bler << std::endl;
 #endif
 
-  if (randomNumber < bler)
-	{
-	  error = true;
-	  if (_TEST_BLER_) std::cout << "BLER PDF " << effective_sinr << " 1" << std::endl;
-	}
-  else
-	{
-	  if (_TEST_BLER_) std::cout << "BLER PDF " << effective_sinr << " 0" << std::endl;
-	}
+  error = randomNumber < bler;
+  if (_TEST_BLER_) std::cout << "BLER PDF " << effective_sinr << (error ? " 1" : " 0") << std::endl;
 
   return error;
 }
@@ -24,6 +24,8 @@
 #include "AMCModule.h"
 #include "../../load-parameters.h"
 #include <math.h>
+#include <stdlib.h>
+#include <limits>
 #include "iostream"
 
 int CQIIndex[15] = {
@@ -232,8 +234,164 @@ int TransportBlockSizeTable [110][27] = {
 
 
 
+// 3GPP TS 38.214 - Table 5.1.3.1-1: MCS index table 1 for PDSCH
+// MCS Index -> modulation order
+int NrModulationForMCSIndex[29] = {
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  4, 4, 4, 4, 4, 4, 4,
+  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6
+};
+
+// MCS Index -> target code rate x 1024
+int NrCodeRateForMCSIndex[29] = {
+  120, 157, 193, 251, 308, 379, 449, 526, 602, 679,
+  340, 378, 434, 490, 553, 616, 658,
+  438, 466, 517, 567, 616, 666, 719, 772, 822, 873, 910, 948
+};
+
+// 3GPP TS 38.214 - Table 5.1.3.2-1: TBS for Ninfo <= 3824
+int NrTransportBlockSizeTable[93] = {
+  24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120, 128, 136, 144,
+  152, 160, 168, 176, 184, 192, 208, 224, 240, 256, 272, 288, 304, 320,
+  336, 352, 368, 384, 408, 432, 456, 480, 504, 528, 552, 576, 608, 640,
+  672, 704, 736, 768, 808, 848, 888, 928, 984, 1032, 1064, 1128, 1160,
+  1192, 1224, 1256, 1288, 1320, 1352, 1416, 1480, 1544, 1608, 1672, 1736,
+  1800, 1864, 1928, 2024, 2088, 2152, 2216, 2280, 2408, 2472, 2536, 2600,
+  2664, 2728, 2792, 2856, 2976, 3104, 3240, 3368, 3496, 3624, 3752, 3824
+};
+
+
+/*
+ * Counts in O(1) how many of a increasing list of thresholds a value has
+ * passed. The value is first quantized to a bucket narrower than a quarter
+ * of the smallest gap between two thresholds, so the count stored for the
+ * bucket is off by at most one, which two comparisons fix.
+ */
+struct ThresholdIndex
+{
+  void Build (const double* thresholds, int nbThresholds, bool inclusive);
+  inline int Count (double x) const;
+
+  bool m_inclusive;  // count thresholds <= x, otherwise < x
+  double m_lo;
+  double m_invStep;
+  int m_lastBucket;
+  std::vector<int> m_base;
+  std::vector<double> m_up;    // m_up[c]: the (c+1)-th threshold
+  std::vector<double> m_down;  // m_down[c]: the c-th threshold
+};
+
+void
+ThresholdIndex::Build (const double* thresholds, int nbThresholds, bool inclusive)
+{
+  double gap = std::numeric_limits<double>::max ();
+  for (int i = 1; i < nbThresholds; i++)
+    {
+      if (thresholds[i] - thresholds[i-1] < gap)
+        gap = thresholds[i] - thresholds[i-1];
+    }
+  if (!(gap > 0))
+    {
+      std::cerr << "ERROR: AMC thresholds must be increasing" << std::endl;
+      exit (1);
+    }
+  double step = gap / 4;
+  m_inclusive = inclusive;
+  m_lo = thresholds[0] - step;
+  m_invStep = 1 / step;
+  m_lastBucket = (thresholds[nbThresholds-1] - m_lo) * m_invStep + 1;
+
+  // NaN never compares true, so the ends are never corrected past
+  m_up.assign (nbThresholds + 1, std::numeric_limits<double>::quiet_NaN ());
+  m_down.assign (nbThresholds + 1, std::numeric_limits<double>::quiet_NaN ());
+  for (int i = 0; i < nbThresholds; i++)
+    {
+      m_up[i] = thresholds[i];
+      m_down[i+1] = thresholds[i];
+    }
+  m_base.resize (m_lastBucket + 1);
+  for (int b = 0; b <= m_lastBucket; b++)
+    {
+      double x = m_lo + b / m_invStep;
+      int count = 0;
+      while (count < nbThresholds
+             && (inclusive ? thresholds[count] <= x : thresholds[count] < x))
+        {
+          count++;
+        }
+      m_base[b] = count;
+    }
+}
+
+inline int
+ThresholdIndex::Count (double x) const
+{
+  double f = (x - m_lo) * m_invStep;
+  f = f >= 0 ? f : 0;  // also takes NaN to the first bucket
+  f = f <= m_lastBucket ? f : m_lastBucket;
+  int c = m_base[(int) f];
+  if (m_inclusive)
+    return c + (m_up[c] <= x) - (m_down[c] > x);
+  return c + (m_up[c] < x) - (m_down[c] >= x);
+}
+
+struct AmcTables
+{
+  AmcTables ();
+
+  ThresholdIndex m_cqiFromSinr;
+  ThresholdIndex m_cqiFromEfficiency;
+  ThresholdIndex m_mcsFromEfficiency;
+  int m_cqiFromMcs[32];
+  double m_efficiencyForCqi[15];
+  int m_nrTbs[29][NR_MAX_PRB];
+};
+
+AmcTables::AmcTables ()
+{
+  // the loops these replace never look at the first threshold
+  m_cqiFromSinr.Build (SINRForCQIIndex + 1, 14, true);
+  m_cqiFromEfficiency.Build (EfficiencyForCQIIndex + 1, 14, false);
+  m_mcsFromEfficiency.Build (EfficiencyForMCSIndex + 1, 29, false);
+
+  for (int mcs = 0; mcs < 32; mcs++)
+    {
+      m_cqiFromMcs[mcs] = 1;
+      for (int i = 14; i >= 0; i--)
+        {
+          if (mcs == MapCQIToMCS[i])
+            m_cqiFromMcs[mcs] = i + 1;
+        }
+    }
+
+  for (int i = 0; i < 15; i++)
+    {
+      int bits = TransportBlockSizeTable[0][McsToItbs[MapCQIToMCS[i]]];
+      //eff = rate / bandwidth
+      m_efficiencyForCqi[i] = (bits/0.001)/180000.;
+    }
+
+  for (int mcs = 0; mcs < 29; mcs++)
+    {
+      for (int prb = 1; prb <= NR_MAX_PRB; prb++)
+        {
+          m_nrTbs[mcs][prb-1] = AMCModule::ComputeNrTBSize (mcs, prb);
+        }
+    }
+}
+
+static const AmcTables*
+GetAmcTables (void)
+{
+  static AmcTables tables;
+  return &tables;
+}
+
+
 AMCModule::AMCModule()
-{}
+{
+  m_tables = GetAmcTables ();
+}
 
 AMCModule::~AMCModule()
 {}
@@ -241,23 +399,13 @@ AMCModule::~AMCModule()
 int
 AMCModule::GetCQIFromEfficiency (double Efficiency)
 {
-  int cqi = 1; // == CQIIndex[0]
-  while (EfficiencyForCQIIndex[cqi] < Efficiency && cqi <= 14)
-    {
-	  cqi++;
-    }
-  return cqi;
+  return 1 + m_tables->m_cqiFromEfficiency.Count (Efficiency);
 }
 
 int
 AMCModule::GetCQIFromSinr (double sinr)
 {
-  int cqi = 1; // == CQIIndex[0]
-  while (cqi <= 14 && SINRForCQIIndex[cqi] <= sinr)
-  {
-	  cqi++;
-  }
-  return cqi;
+  return 1 + m_tables->m_cqiFromSinr.Count (sinr);
 }
 
 double
@@ -276,23 +424,15 @@ AMCModule::GetMCSFromCQI (int cqi)
 int
 AMCModule::GetCQIFromMCS (int mcs)
 {
-  for (int i=0; i<15; i++)
-  {
-	  if (mcs == MapCQIToMCS[i])
-		  return (i+1);
-  }
-  return 1;
+  if (mcs < 0 || mcs > 31)
+    return 1;
+  return m_tables->m_cqiFromMcs[mcs];
 }
 
 int
 AMCModule::GetMCSIndexFromEfficiency(double efficiency)
 {
-  int mcs = 1;
-  while (EfficiencyForMCSIndex[mcs] < efficiency && mcs < 30)
-	{
-	  mcs++;
-	}
-  return mcs;
+  return 1 + m_tables->m_mcsFromEfficiency.Count (efficiency);
 }
 
 int
@@ -305,25 +445,88 @@ AMCModule::GetTBSizeFromMCS (int mcs)
 int
 AMCModule::GetTBSizeFromMCS (int mcs, int nbRBs)
 {
-  int itbs = McsToItbs[mcs];
-  if (nbRBs <= 110) {
-    return (TransportBlockSizeTable[nbRBs - 1][itbs]);
-  }
-  else {
-    int subRBs = nbRBs / 5;
-    int restRBs = nbRBs % 5;
-    return 5 * TransportBlockSizeTable[subRBs-1][itbs] + TransportBlockSizeTable[restRBs-1][itbs];
-  }
+  if (nbRBs <= 110)
+    {
+      return TransportBlockSizeTable[nbRBs - 1][McsToItbs[mcs]];
+    }
+  // beyond the LTE table, a 1 ms TTI over nbRBs 180 kHz RBs is carried by
+  // the NR numerology with the fewest PRBs that fit in one carrier
+  int numerology = 0;
+  while ((nbRBs >> numerology) > NR_MAX_PRB && numerology < NR_MAX_NUMEROLOGY)
+    {
+      numerology++;
+    }
+  int nbPRBs = nbRBs >> numerology;
+  int restRBs = nbRBs - (nbPRBs << numerology);
+  return GetNrTBSize (mcs, nbPRBs, numerology) + GetNrTBSize (mcs, restRBs, 0);
 }
 
 double
 AMCModule::GetEfficiencyFromCQI (int cqi)
 {
-  int mcs = GetMCSFromCQI (cqi);
-  int bits = GetTBSizeFromMCS (mcs);
-  //eff = rate / bandwidth
-  double eff = (bits/0.001)/180000.;
-  return eff;
+  return m_tables->m_efficiencyForCqi[cqi-1];
+}
+
+int
+AMCModule::GetNrTBSize (int mcs, int nbPRBs, int numerology)
+{
+  if (nbPRBs <= 0)
+    return 0;
+  if (nbPRBs > NR_MAX_PRB)
+    nbPRBs = NR_MAX_PRB;
+  return m_tables->m_nrTbs[mcs][nbPRBs - 1] << numerology;
+}
+
+int
+AMCModule::ComputeNrTBSize (int mcs, int nbPRBs, int nbSymbols, int nbDmrsRe,
+                            int nbOverheadRe, int nbLayers)
+{
+  // step 1: number of REs
+  int nbRePerPrb = 12 * nbSymbols - nbDmrsRe - nbOverheadRe;
+  if (nbRePerPrb > 156)
+    nbRePerPrb = 156;
+  double R = NrCodeRateForMCSIndex[mcs] / 1024.;
+  int Qm = NrModulationForMCSIndex[mcs];
+
+  // step 2: intermediate number of information bits
+  double Ninfo = (double) nbRePerPrb * nbPRBs * R * Qm * nbLayers;
+
+  if (Ninfo <= 3824)
+    {
+      // step 3
+      int n = (int) floor (log2 (Ninfo)) - 6;
+      if (n < 3)
+        n = 3;
+      double Ninfo_ = ldexp (floor (ldexp (Ninfo, -n)), n);
+      if (Ninfo_ < 24)
+        Ninfo_ = 24;
+      for (int i = 0; i < 93; i++)
+        {
+          if (NrTransportBlockSizeTable[i] >= Ninfo_)
+            return NrTransportBlockSizeTable[i];
+        }
+      return NrTransportBlockSizeTable[92];
+    }
+
+  // step 4
+  int n = (int) floor (log2 (Ninfo - 24)) - 5;
+  double Ninfo_ = ldexp (round (ldexp (Ninfo - 24, -n)), n);
+  if (Ninfo_ < 3840)
+    Ninfo_ = 3840;
+  int C;
+  if (R <= 0.25)
+    {
+      C = (int) ceil ((Ninfo_ + 24) / 3816);
+    }
+  else if (Ninfo_ > 8424)
+    {
+      C = (int) ceil ((Ninfo_ + 24) / 8424);
+    }
+  else
+    {
+      C = 1;
+    }
+  return 8 * C * (int) ceil ((Ninfo_ + 24) / (8 * C)) - 24;
 }
 
 std::vector<int>
@@ -23,8 +23,20 @@
 #define AMCModule_H_
 
 #include <vector>
+
+#define NR_MAX_PRB 275         // TS 38.214, 5.1.2.2
+#define NR_MAX_NUMEROLOGY 3
+#define NR_PDSCH_SYMBOLS 11    // 14 minus 3 control symbols, as LTE
+#define NR_DMRS_RE_PER_PRB 12  // one DMRS symbol
+#define NR_OVERHEAD_RE 0
+
+struct AmcTables;
+
 /*
  *  Adaptive Modulation And Coding Scheme
+ *
+ *  All the mappings are table lookups; the tables are built once, when
+ *  the first AMCModule is created.
  */
 
 class AMCModule {
@@ -42,7 +54,22 @@ class AMCModule {
   int GetCQIFromSinr(double sinr);
   double GetSinrFromCQI(int cqi);
 
+  /*
+   * Bits carried in one ms by nbPRBs PRBs of the given numerology, i.e.
+   * 2^numerology slots, with the default PDSCH configuration above.
+   * mcs indexes TS 38.214 Table 5.1.3.1-1 (64QAM).
+   */
+  int GetNrTBSize(int mcs, int nbPRBs, int numerology = 0);
+
+  // TS 38.214, 5.1.3.2: TBS of one slot
+  static int ComputeNrTBSize(int mcs, int nbPRBs, int nbSymbols = NR_PDSCH_SYMBOLS,
+                             int nbDmrsRe = NR_DMRS_RE_PER_PRB,
+                             int nbOverheadRe = NR_OVERHEAD_RE, int nbLayers = 1);
+
   std::vector<int> CreateCqiFeedbacks(std::vector<double>& sinr);
+
+ private:
+  const AmcTables* m_tables;
 };
 
 #endif /* AMCModule_H_ */
@@ -32,12 +32,8 @@
 #include "../../device/ENodeB.h"
 #include "../../load-parameters.h"
 #include "../../core/eventScheduler/simulator.h"
-#include <fstream>
+#include "../../device/CqiManager/cqi-trace-store.h"
 #include <cassert>
-#include <sstream>
-#define CQI_INTERVAL 40
-#define MAX_UE_TRACE 158
-#define MAX_TTI_TRACE 475
 
 EnbMacEntity::EnbMacEntity ()
 {
@@ -46,12 +42,7 @@ EnbMacEntity::EnbMacEntity ()
   m_downlinkScheduler = NULL;
   m_uplinkScheduler = NULL;
   #ifdef USE_REAL_TRACE
-  std::string fname = path + "cqi-traces-noise0/mapping.config";
-  std::ifstream ifs(fname, std::ifstream::in);
-  int uid, tid;
-  while (ifs >> uid >> tid) {
-    m_userMapping.push_back(tid);
-  }
+  CqiTraceStore::Init ();
   #endif
 }
 
@@ -166,29 +157,10 @@ EnbMacEntity::ReceiveCqiIdealControlMessage  (CqiIdealControlMessage* msg)
     ENodeB* enb = (ENodeB*) GetDevice ();
     ENodeB::UserEquipmentRecord* record = enb->GetUserEquipmentRecord(user_id);
 
-    if (m_userCQITrace.find(user_id) == m_userCQITrace.end()) {
-      int trace_id = m_userMapping[user_id % m_userMapping.size()];
-      std::cerr << "user " << user_id << " uses trace " << trace_id << std::endl;
-      std::string fname = path + "cqi-traces-noise0/ue" + std::to_string(trace_id) + ".log";
-      std::ifstream ifs(fname, std::ifstream::in);
-      int cqi = 0;
-      for (int i = 0; i < MAX_TTI_TRACE; ++i) {
-        std::string line;
-        std::getline(ifs, line);
-        std::istringstream iss(line);
-        std::vector<int> cqi_one_tti;
-        for (int j = 0; j < nb_rbs; ++j) {
-          iss >> cqi;
-          cqi_one_tti.push_back(cqi);
-        }
-        m_userCQITrace[user_id].push_back(cqi_one_tti);
-      }
-      ifs.close();
-    }
-
-    auto& cqi_traces = m_userCQITrace.at(user_id);
-    int time_stamp = Simulator::Init ()->Now ()*1000 / CQI_INTERVAL;
-    record->SetCQI( cqi_traces[time_stamp % cqi_traces.size() ] );
+    std::vector<int> cqiFeedback;
+    CqiTraceStore::Init ()->GetReportForUser (
+        user_id, Simulator::Init ()->Now (), nb_rbs, cqiFeedback);
+    record->SetCQI (cqiFeedback);
 
     #endif
 }
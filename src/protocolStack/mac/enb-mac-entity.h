@@ -23,7 +23,6 @@
 #define ENB_MAC_ENTITY_H
 
 #include <list>
-#include <unordered_map>
 #include <vector>
 
 #include "mac-entity.h"
@@ -54,9 +53,6 @@ class EnbMacEntity : public MacEntity {
       SchedulingRequestIdealControlMessage* msg);
 
  private:
-  std::unordered_map<int, vector<vector<int>>> m_userCQITrace;
-  std::vector<int> m_userMapping;
-
   PacketScheduler* m_uplinkScheduler;
   PacketScheduler* m_downlinkScheduler;
 };
@@ -34,6 +34,7 @@
 #include "../../../core/idealMessages/ideal-control-messages.h"
 #include "../../../flows/QoS/QoSParameters.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/output-capture.h"
 
 DelayEddRuleDownlinkPacketScheduler::DelayEddRuleDownlinkPacketScheduler()
 {
@@ -61,7 +62,7 @@ DelayEddRuleDownlinkPacketScheduler::ComputeSchedulingMetric (RadioBearer *beare
 				bearer->GetAverageTransmissionRate();
 
 #ifdef SCHEDULER_DEBUG
-	  std::cout << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
+	  OutputCapture::Out () << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
 			 << " " << spectralEfficiency
 			 << " " << bearer->GetAverageTransmissionRate ()
 			 << " --> " << metric
@@ -34,6 +34,8 @@
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../flows/QoS/QoSForEXP.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 
 DL_EXP_PacketScheduler::DL_EXP_PacketScheduler()
 {
@@ -47,10 +49,11 @@ DL_EXP_PacketScheduler::~DL_EXP_PacketScheduler()
 }
 
 void
-DL_EXP_PacketScheduler::DoSchedule ()
+DL_EXP_PacketScheduler::PrepareSchedule ()
 {
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start DL packet scheduler for node "
+	OutputCapture::Out () << "Start DL packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
@@ -58,15 +61,6 @@ DL_EXP_PacketScheduler::DoSchedule ()
   CheckForDLDropPackets ();
   SelectFlowsToSchedule ();
   ComputeAW ();
-
-  if (GetFlowsToSchedule ()->size() == 0)
-	{}
-  else
-	{
-	  RBsAllocation ();
-	}
-
-  StopSchedule ();
 }
 
 double
@@ -128,7 +122,7 @@ DL_EXP_PacketScheduler::ComputeAW ()
   FlowToSchedule *flow;
 
 #ifdef SCHEDULER_DEBUG
-  std::cout << "ComputeAW" << std::endl;
+  OutputCapture::Out () << "ComputeAW" << std::endl;
 #endif
 
   m_aW = 0;
@@ -29,7 +29,7 @@ class DL_EXP_PacketScheduler : public DownlinkPacketScheduler {
   DL_EXP_PacketScheduler();
   virtual ~DL_EXP_PacketScheduler();
 
-  virtual void DoSchedule(void);
+  virtual void PrepareSchedule(void);
 
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
                                          double spectralEfficiency,
@@ -64,6 +64,13 @@ DL_FLS_PacketScheduler::GetLowerLevelSchedulerType (void) const
   return m_lowerLevelSchedulerType;
 }
 
+bool
+DL_FLS_PacketScheduler::SupportsPhases (void)
+{
+  // the control law and the two-level allocation are not split in phases
+  return false;
+}
+
 void
 DL_FLS_PacketScheduler::DoSchedule ()
 {
@@ -338,20 +345,12 @@ DL_FLS_PacketScheduler::Select_RT_FlowsToSchedule ()
 		  //data to transmit
 		  int dataToTransmit = qos->GetDataToTransmit ();
 
-		  //compute spectral efficiency
+		  //the CQI of the user, the spectral efficiency follows from it
 		  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
 		  ENodeB::UserEquipmentRecord *ueRecord = enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ());
-		  std::vector<double> spectralEfficiency;
-		  std::vector<int> cqiFeedbacks = ueRecord->GetCQI ();
-		  int numberOfCqi = cqiFeedbacks.size ();
-		  for (int i = 0; i < numberOfCqi; i++)
-			{
-			  double sEff = GetMacEntity ()->GetAmcModule ()->GetEfficiencyFromCQI (cqiFeedbacks.at (i));
-			  spectralEfficiency.push_back (sEff);
-			}
 
 		  //create flow to schedule record
-		  InsertFlowToSchedule(bearer, dataToTransmit, spectralEfficiency, cqiFeedbacks);
+		  InsertFlowToSchedule(bearer, dataToTransmit, ueRecord->GetCQI ());
 		}
 	  else
 	    {}
@@ -397,20 +396,12 @@ DL_FLS_PacketScheduler::Select_NRT_FlowsToSchedule ()
 			  dataToTransmit = bearer->GetQueueSize ();
 		    }
 
-		  //compute spectral efficiency
+		  //the CQI of the user, the spectral efficiency follows from it
 		  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
 		  ENodeB::UserEquipmentRecord *ueRecord = enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ());
-		  std::vector<double> spectralEfficiency;
-		  std::vector<int> cqiFeedbacks = ueRecord->GetCQI ();
-		  int numberOfCqi = cqiFeedbacks.size ();
-		  for (int i = 0; i < numberOfCqi; i++)
-			{
-			  double sEff = GetMacEntity ()->GetAmcModule ()->GetEfficiencyFromCQI (cqiFeedbacks.at (i));
-			  spectralEfficiency.push_back (sEff);
-			}
 
 		  //create flow to schedule record
-		  InsertFlowToSchedule(bearer, dataToTransmit, spectralEfficiency, cqiFeedbacks);
+		  InsertFlowToSchedule(bearer, dataToTransmit, ueRecord->GetCQI ());
 		}
 	  else
 	    {}
@@ -35,6 +35,7 @@ class DL_FLS_PacketScheduler : public DownlinkPacketScheduler {
   LowerLevelSchedulerType GetLowerLevelSchedulerType(void) const;
   virtual void DoSchedule(void);
   virtual void DoStopSchedule(void);
+  virtual bool SupportsPhases(void);
   void RunControlLaw();
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
                                          double spectralEfficiency,
@@ -34,6 +34,8 @@
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../flows/QoS/QoSForM_LWDF.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 
 DL_MLWDF_PacketScheduler::DL_MLWDF_PacketScheduler()
 {
@@ -48,25 +50,17 @@ DL_MLWDF_PacketScheduler::~DL_MLWDF_PacketScheduler()
 
 
 void
-DL_MLWDF_PacketScheduler::DoSchedule ()
+DL_MLWDF_PacketScheduler::PrepareSchedule ()
 {
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start DL packet scheduler for node "
+	OutputCapture::Out () << "Start DL packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
   UpdateAverageTransmissionRate ();
   CheckForDLDropPackets ();
   SelectFlowsToSchedule ();
-
-  if (GetFlowsToSchedule ()->size() == 0)
-	{}
-  else
-	{
-	  RBsAllocation ();
-	}
-
-  StopSchedule ();
 }
 
 double
@@ -91,7 +85,7 @@ DL_MLWDF_PacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double s
 	    	    bearer->GetAverageTransmissionRate();
 
 #ifdef SCHEDULER_DEBUG
-	  std::cout << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
+	  OutputCapture::Out () << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
 			 << " " << spectralEfficiency
 			 << " " << bearer->GetAverageTransmissionRate ()
 			 << " --> " << metric
@@ -114,7 +108,7 @@ DL_MLWDF_PacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double s
 			 bearer->GetAverageTransmissionRate ());
 
 #ifdef SCHEDULER_DEBUG
-	 std::cout << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
+	 OutputCapture::Out () << "METRIC: " << bearer->GetApplication ()->GetApplicationID ()
 			 << " " << a
 			 << " " << Simulator::Init()->Now()
 			 << " " << bearer->GetMacQueue()->Peek().GetTimeStamp()
@@ -29,7 +29,7 @@ class DL_MLWDF_PacketScheduler : public DownlinkPacketScheduler {
   DL_MLWDF_PacketScheduler();
   virtual ~DL_MLWDF_PacketScheduler();
 
-  virtual void DoSchedule(void);
+  virtual void PrepareSchedule(void);
 
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
                                          double spectralEfficiency,
@@ -32,6 +32,7 @@
 #include "../../../phy/lte-phy.h"
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../core/idealMessages/ideal-control-messages.h"
+#include "../../../utility/output-capture.h"
 #include <jsoncpp/json/json.h>
 #include <fstream>
 #include <sstream>
@@ -64,8 +65,10 @@ DL_PF_PacketScheduler::~DL_PF_PacketScheduler()
 void
 DL_PF_PacketScheduler::DoStopSchedule (void)
 {
+  SendPdcchMap ();
+
 #ifdef SCHEDULER_DEBUG
-  std::cout << "\t Creating Packet Burst" << std::endl;
+  OutputCapture::Out () << "\t Creating Packet Burst" << std::endl;
 #endif
 
   PacketBurst* pb = new PacketBurst ();
@@ -86,7 +89,7 @@ DL_PF_PacketScheduler::DoStopSchedule (void)
       int app_id = flow->GetBearer()->GetApplication()->GetApplicationID();
       int user_id = flow->GetBearer()->GetUserID();
 
-      std::cerr << GetTimeStamp()
+      OutputCapture::Err () << GetTimeStamp()
           << " app: " << app_id
           << " cumu_bytes: " << flow->GetBearer()->GetCumulateBytes()
           << " cumu_rbs: " << flow->GetBearer()->GetCumulateRBs()
@@ -119,7 +122,7 @@ DL_PF_PacketScheduler::DoStopSchedule (void)
 
 #ifdef SCHEDULER_DEBUG
   if (pb->GetNPackets () == 0)
-    std::cout << "\t Send only reference symbols" << std::endl;
+    OutputCapture::Out () << "\t Send only reference symbols" << std::endl;
 #endif
 
   GetMacEntity ()->GetDevice ()->SendPacketBurst (pb);
@@ -34,6 +34,8 @@
 #include "../../../flows/MacQueue.h"
 #include "../../../utility/eesm-effective-sinr.h"
 #include "../../../load-parameters.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 #include <jsoncpp/json/json.h>
 #include <cstdio>
 #include <limits>
@@ -91,30 +93,15 @@ DownlinkNVSScheduler::~DownlinkNVSScheduler()
   Destroy ();
 }
 
-int DownlinkNVSScheduler::SelectSliceToServe()
+int DownlinkNVSScheduler::SelectSliceToServe(const BearerInputs& inputs)
 {
   int slice_id = 0;
   double max_score = 0;
 
-  RrcEntity *rrc = GetMacEntity ()->GetDevice ()->GetProtocolStack ()->GetRrcEntity ();
-  RrcEntity::RadioBearersContainer* bearers = rrc->GetRadioBearerContainer ();
   std::vector<bool> slice_with_queue(num_slices_, false);
-  for (auto it = bearers->begin(); it != bearers->end(); it++) {
-    RadioBearer *bearer = (*it);
-    int user_id = bearer->GetUserID();
-
-    if (bearer->HasPackets () && bearer->GetDestination ()->GetNodeState () == NetworkNode::STATE_ACTIVE)
-		{
-		  int dataToTransmit;
-		  if (bearer->GetApplication ()->GetApplicationType () == Application::APPLICATION_TYPE_INFINITE_BUFFER) {
-			  dataToTransmit = 100000000;
-			}
-		  else {
-			  dataToTransmit = bearer->GetQueueSize ();
-			}
-      if (dataToTransmit > 0) {
-        slice_with_queue[user_to_slice_[user_id]] = true;
-      }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i].m_dataToTransmit > 0) {
+      slice_with_queue[user_to_slice_[inputs[i].m_userID]] = true;
     }
   }
   for (int i = 0; i < num_slices_; ++i) {
@@ -141,80 +128,74 @@ int DownlinkNVSScheduler::SelectSliceToServe()
   return slice_id;
 }
 
-void DownlinkNVSScheduler::SelectFlowsToSchedule (int slice_serve)
+void DownlinkNVSScheduler::SelectFlowsToSchedule (int slice_serve, const BearerInputs& inputs)
 {
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t Select Flows to schedule" << std::endl;
+	OutputCapture::Out() << "\t Select Flows to schedule" << std::endl;
 #endif
 
   ClearUsersToSchedule();
-  RrcEntity *rrc = GetMacEntity ()->GetDevice ()->GetProtocolStack ()->GetRrcEntity ();
-  RrcEntity::RadioBearersContainer* bearers = rrc->GetRadioBearerContainer ();
 
   std::fill(slice_priority_.begin(), slice_priority_.end(), 0);
-  for (std::vector<RadioBearer* >::iterator it = bearers->begin (); it != bearers->end (); it++)
+  for (size_t i = 0; i < inputs.size(); i++)
 	{
 	  //SELECT FLOWS TO SCHEDULE
-	  RadioBearer *bearer = (*it);
-    int user_id = bearer->GetUserID();
+	  const BearerInput& input = inputs[i];
 
-    if (user_to_slice_[user_id] != slice_serve)
+    if (user_to_slice_[input.m_userID] != slice_serve)
       continue;
 
-	  if (bearer->HasPackets() && bearer->GetDestination ()->GetNodeState () == NetworkNode::STATE_ACTIVE) {
-		  //compute data to transmit
-		  int dataToTransmit;
-		  if (bearer->GetApplication ()->GetApplicationType () == Application::APPLICATION_TYPE_INFINITE_BUFFER) {
-			  dataToTransmit = 100000000;
-			}
-		  else {
-			  dataToTransmit = bearer->GetQueueSize ();
-			}
-
-		  //compute spectral efficiency
-		  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
-		  ENodeB::UserEquipmentRecord *ueRecord = 
-        enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ());
-		  std::vector<double> spectralEfficiency;
-		  std::vector<int> cqiFeedbacks = ueRecord->GetCQI ();
-		  int numberOfCqi = cqiFeedbacks.size ();
-      AMCModule *amc = GetMacEntity()->GetAmcModule();
-		  for (int i = 0; i < numberOfCqi; i++) {
-        spectralEfficiency.push_back(amc->GetEfficiencyFromCQI(cqiFeedbacks.at(i)));
-			}
-
-		  //create flow to scheduler record
-      int slice_id = user_to_slice_[user_id];
-      if (bearer->GetPriority() > slice_priority_[slice_id]) {
-        slice_priority_[slice_id] = bearer->GetPriority();
-      }
-      InsertFlowToUser(bearer, dataToTransmit, spectralEfficiency, cqiFeedbacks);
+	  //create flow to scheduler record
+    int slice_id = user_to_slice_[input.m_userID];
+    if (input.m_priority > slice_priority_[slice_id]) {
+      slice_priority_[slice_id] = input.m_priority;
     }
+    InsertFlowToUser(input);
 	}
 }
 
 void
 DownlinkNVSScheduler::DoSchedule (void)
 {
+  PrepareSchedule ();
+  AllocateResources ();
+  StopSchedule ();
+}
+
+bool
+DownlinkNVSScheduler::SupportsPhases (void)
+{
+  return true;
+}
+
+void
+DownlinkNVSScheduler::PrepareSchedule (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\nStart DL packet scheduler for node "
+	OutputCapture::Out() << "\nStart DL packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()
       << " ts: " << GetTimeStamp() << std::endl;
 #endif
 
+  // the rates are updated first, the slice selection does not read them
+  UpdateAverageTransmissionRate ();
+  const BearerInputs& inputs = ReadBearerInputs ();
   // some logic to determine the slice to serve
-  int slice_serve = SelectSliceToServe();
-  UpdateAverageTransmissionRate (slice_serve);
-  SelectFlowsToSchedule (slice_serve);
+  int slice_serve = SelectSliceToServe (inputs);
+  SelectFlowsToSchedule (slice_serve, inputs);
+}
 
+void
+DownlinkNVSScheduler::AllocateResources (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_ALLOCATE);
   if (GetUsersToSchedule()->size() != 0) {
     if (is_nongreedy_)
       RBsAllocationNonGreedyPF();
     else
       RBsAllocation();
   }
-
-  StopSchedule ();
 }
 
 void
@@ -241,7 +222,7 @@ DownlinkNVSScheduler::DoStopSchedule(void)
         user->m_bearers[i]->UpdateCumulateRBs(
             user->GetListOfAllocatedRBs()->size()
             );
-        std::cerr << GetTimeStamp()
+        OutputCapture::Err() << GetTimeStamp()
           << " app: " << user->m_bearers[i]->GetApplication()->GetApplicationID()
           << " cumu_bytes: " << user->m_bearers[i]->GetCumulateBytes()
           << " cumu_rbs: " << user->m_bearers[i]->GetCumulateRBs()
@@ -297,7 +278,7 @@ DownlinkNVSScheduler::RBsAllocation()
       UserToSchedule* user = users->at(j);
       // allocate the rbg if the user has highest metric and data to transmit
       if (metrics[i][j] > targetMetric &&
-          user->GetListOfAllocatedRBs()->size() < user->m_requiredRBs ) {
+          (int)user->GetListOfAllocatedRBs()->size() < user->m_requiredRBs ) {
         targetMetric = metrics[i][j];
         scheduledUE = user;
       }
@@ -311,17 +292,17 @@ DownlinkNVSScheduler::RBsAllocation()
   }
   AMCModule *amc = GetMacEntity()->GetAmcModule();
   PdcchMapIdealControlMessage *pdcchMsg = new PdcchMapIdealControlMessage();
-  std::cout << GetTimeStamp() << std::endl;
+  OutputCapture::Out() << GetTimeStamp() << std::endl;
   for (auto it = users->begin(); it != users->end(); it++) {
     UserToSchedule *ue = *it;
     if (ue->GetListOfAllocatedRBs()->size() > 0) {
       std::vector<double> estimatedSinrValues;
 
-      std::cout << "User(" << ue->GetUserID() << ") allocated RBGS:";
+      OutputCapture::Out() << "User(" << ue->GetUserID() << ") allocated RBGS:";
       for (size_t i = 0; i < ue->GetListOfAllocatedRBs()->size (); i++ ) {
         int rbid = ue->GetListOfAllocatedRBs()->at(i);
         if (rbid % rbg_size == 0)
-          std::cout << " " << rbid / rbg_size << "(" << ue->GetCqiFeedbacks().at(rbid) << ")";
+          OutputCapture::Out() << " " << rbid / rbg_size << "(" << ue->GetCqiFeedbacks().at(rbid) << ")";
         
         double sinr = amc->GetSinrFromCQI(
           ue->GetCqiFeedbacks().at(
@@ -329,7 +310,7 @@ DownlinkNVSScheduler::RBsAllocation()
         estimatedSinrValues.push_back (sinr);
       }
       double effectiveSinr = GetEesmEffectiveSinr(estimatedSinrValues);
-      std::cout << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
+      OutputCapture::Out() << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
       int mcs = amc->GetMCSFromCQI(amc->GetCQIFromSinr(effectiveSinr));
       int transportBlockSize = amc->GetTBSizeFromMCS(mcs, ue->GetListOfAllocatedRBs()->size());
 
@@ -361,13 +342,8 @@ double
 DownlinkNVSScheduler::ComputeSchedulingMetric(UserToSchedule* user, double spectralEfficiency)
 {
   double metric = 0;
-  double averageRate = 1;
+  double averageRate = user->GetAverageTransmissionRate();
   int slice_id = user_to_slice_[user->GetUserID()];
-  for (int i = 0; i < MAX_BEARERS; ++i) {
-    if (user->m_bearers[i]) {
-      averageRate += user->m_bearers[i]->GetAverageTransmissionRate();
-    }
-  }
   spectralEfficiency = spectralEfficiency * 180000 / 1000; // set the unit to kbps
   averageRate /= 1000.0; // set the unit of both params to kbps
   SchedulerAlgoParam param = slice_algo_params_[slice_id];
@@ -380,8 +356,7 @@ DownlinkNVSScheduler::ComputeSchedulingMetric(UserToSchedule* user, double spect
       metric = 0;
     }
     else {
-      RadioBearer* bearer = user->m_bearers[slice_priority_[slice_id]];
-      double HoL = bearer->GetHeadOfLinePacketDelay();
+      double HoL = user->GetHeadOfLinePacketDelay(slice_priority_[slice_id]);
       metric = HoL * pow(spectralEfficiency, param.epsilon)
           / pow(averageRate, param.psi);
     }
@@ -389,8 +364,40 @@ DownlinkNVSScheduler::ComputeSchedulingMetric(UserToSchedule* user, double spect
   return metric;
 }
 
+int
+DownlinkNVSScheduler::GetSliceOfUser (int userID)
+{
+  if (userID < 0 || userID >= (int)user_to_slice_.size())
+    return -1;
+  return user_to_slice_[userID];
+}
+
+int
+DownlinkNVSScheduler::GetNbSlices (void)
+{
+  return slice_weights_.size();
+}
+
+bool
+DownlinkNVSScheduler::SetSliceWeight (int slice, double weight)
+{
+  if (slice < 0 || slice >= (int)slice_weights_.size() || weight < 0 || weight > 1)
+    return false;
+  slice_weights_[slice] = weight;
+  return true;
+}
+
+bool
+DownlinkNVSScheduler::SetSliceAlgoParam (int slice, const SchedulerAlgoParam& param)
+{
+  if (slice < 0 || slice >= (int)slice_algo_params_.size())
+    return false;
+  slice_algo_params_[slice] = param;
+  return true;
+}
+
 void
-DownlinkNVSScheduler::UpdateAverageTransmissionRate (int slice_serve)
+DownlinkNVSScheduler::UpdateAverageTransmissionRate (void)
 {
   RrcEntity *rrc = GetMacEntity ()->GetDevice ()->GetProtocolStack ()->GetRrcEntity ();
   RrcEntity::RadioBearersContainer* bearers = rrc->GetRadioBearerContainer ();
@@ -433,7 +440,7 @@ DownlinkNVSScheduler::RBsAllocationNonGreedyPF() {
     // std::cout << "MCS(highest_cqi): ";
     for (size_t i = 0; i < user_highest_cqi.size(); i++) {
       assigned_mcs.push_back(
-        max( user_highest_cqi[i] - rand() % cqi_search_range, 1 )
+        max( user_highest_cqi[i] - GetRandomStream().NextInt(cqi_search_range), 1 )
       );
       // std::cout << assigned_mcs.back() << "(" << user_highest_cqi[i] << ") ";
     }
@@ -456,24 +463,24 @@ DownlinkNVSScheduler::RBsAllocationNonGreedyPF() {
   AMCModule *amc = GetMacEntity()->GetAmcModule();
   PdcchMapIdealControlMessage *pdcchMsg = new PdcchMapIdealControlMessage();
 
-  std::cout << GetTimeStamp() << std::endl;
+  OutputCapture::Out() << GetTimeStamp() << std::endl;
   for (auto it = users->begin(); it != users->end(); it++) {
     UserToSchedule* ue = *it;
     if (ue->GetListOfAllocatedRBs()->size() > 0) {
       std::vector<double> estimatedSinrValues;
-      std::cout << "User(" << ue->GetUserID() << ") allocated RBGS:";
+      OutputCapture::Out() << "User(" << ue->GetUserID() << ") allocated RBGS:";
 
       for (size_t i = 0; i < ue->GetListOfAllocatedRBs()->size (); i++ ) {
         int rbid = ue->GetListOfAllocatedRBs()->at(i);
         if (rbid % rbg_size == 0)
-          std::cout << " " << rbid / rbg_size <<
+          OutputCapture::Out() << " " << rbid / rbg_size <<
             "(" << ue->GetCqiFeedbacks().at(rbid) << ")";
         double sinr = amc->GetSinrFromCQI ( ue->GetCqiFeedbacks().at (rbid) );
         estimatedSinrValues.push_back (sinr);
       }
       double effectiveSinr = GetEesmEffectiveSinr(estimatedSinrValues);
 
-      std::cout << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
+      OutputCapture::Out() << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
 
       int mcs = amc->GetMCSFromCQI(amc->GetCQIFromSinr(effectiveSinr));
       int transportBlockSize = amc->GetTBSizeFromMCS(mcs, ue->GetListOfAllocatedRBs()->size());
@@ -46,16 +46,24 @@ class DownlinkNVSScheduler : public PacketScheduler {
                        bool is_nongreedy = false);
   virtual ~DownlinkNVSScheduler();
 
-  int SelectSliceToServe();
-  void SelectFlowsToSchedule(int);
+  int SelectSliceToServe(const BearerInputs& inputs);
+  void SelectFlowsToSchedule(int slice_serve, const BearerInputs& inputs);
 
   virtual void DoSchedule(void);
   virtual void DoStopSchedule(void);
 
+  virtual bool SupportsPhases(void);
+  virtual void PrepareSchedule(void);
+  virtual void AllocateResources(void);
+
   virtual void RBsAllocation();
   virtual double ComputeSchedulingMetric(UserToSchedule* user,
                                          double spectralEfficiency);
-  void UpdateAverageTransmissionRate(int);
+  virtual int GetSliceOfUser(int userID);
+  virtual int GetNbSlices(void);
+  virtual bool SetSliceWeight(int slice, double weight);
+  virtual bool SetSliceAlgoParam(int slice, const SchedulerAlgoParam& param);
+  void UpdateAverageTransmissionRate(void);
 
   void RBsAllocationNonGreedyPF();
   double AssignRBsGivenMCS(std::vector<int>& assigned_mcs,
@@ -35,6 +35,8 @@
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../flows/MacQueue.h"
 #include "../../../utility/eesm-effective-sinr.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 #include <cstdio>
 
 DownlinkPacketScheduler::DownlinkPacketScheduler()
@@ -48,7 +50,7 @@ DownlinkPacketScheduler::~DownlinkPacketScheduler()
 void DownlinkPacketScheduler::SelectFlowsToSchedule ()
 {
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t Select Flows to schedule" << std::endl;
+	OutputCapture::Out () << "\t Select Flows to schedule" << std::endl;
 #endif
 
   ClearFlowsToSchedule ();
@@ -73,20 +75,12 @@ void DownlinkPacketScheduler::SelectFlowsToSchedule ()
 			  dataToTransmit = bearer->GetQueueSize ();
 			}
 
-		  //compute spectral efficiency
+		  //the CQI of the user, the spectral efficiency follows from it
 		  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
 		  ENodeB::UserEquipmentRecord *ueRecord = enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ());
-		  std::vector<double> spectralEfficiency;
-		  std::vector<int> cqiFeedbacks = ueRecord->GetCQI ();
-		  int numberOfCqi = cqiFeedbacks.size ();
-		  for (int i = 0; i < numberOfCqi; i++)
-			{
-			  double sEff = GetMacEntity ()->GetAmcModule ()->GetEfficiencyFromCQI (cqiFeedbacks.at (i));
-			  spectralEfficiency.push_back (sEff);
-			}
 
 		  //create flow to scheduler record
-		  InsertFlowToSchedule(bearer, dataToTransmit, spectralEfficiency, cqiFeedbacks);
+		  InsertFlowToSchedule(bearer, dataToTransmit, ueRecord->GetCQI ());
 		}
 	  else
 	    {}
@@ -96,29 +90,59 @@ void DownlinkPacketScheduler::SelectFlowsToSchedule ()
 void
 DownlinkPacketScheduler::DoSchedule (void)
 {
+  PrepareSchedule ();
+  AllocateResources ();
+  StopSchedule ();
+}
+
+bool
+DownlinkPacketScheduler::SupportsPhases (void)
+{
+  return true;
+}
+
+void
+DownlinkPacketScheduler::PrepareSchedule (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start DL packet scheduler for node "
+	OutputCapture::Out () << "Start DL packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
   UpdateAverageTransmissionRate ();
   SelectFlowsToSchedule ();
+}
 
+void
+DownlinkPacketScheduler::AllocateResources (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_ALLOCATE);
+  m_pdcchMap.GetMessage ()->clear ();
   if (GetFlowsToSchedule ()->size() == 0)
 	{}
   else
 	{
 	  RBsAllocation ();
 	}
+}
 
-  StopSchedule ();
+void
+DownlinkPacketScheduler::SendPdcchMap (void)
+{
+  if (m_pdcchMap.GetMessage ()->size () > 0)
+    {
+      GetMacEntity ()->GetDevice ()->GetPhy ()->SendIdealControlMessage (&m_pdcchMap);
+    }
 }
 
 void
 DownlinkPacketScheduler::DoStopSchedule (void)
 {
+  SendPdcchMap ();
+
 #ifdef SCHEDULER_DEBUG
-  std::cout << "\t Creating Packet Burst" << std::endl;
+  OutputCapture::Out () << "\t Creating Packet Burst" << std::endl;
 #endif
 
   PacketBurst* pb = new PacketBurst ();
@@ -137,13 +161,13 @@ DownlinkPacketScheduler::DoStopSchedule (void)
 		  flow->GetBearer()->UpdateTransmittedBytes (availableBytes);
       flow->GetBearer()->UpdateCumulateRBs (flow->GetListOfAllocatedRBs()->size());
 
-      std::cerr << GetTimeStamp()
+      OutputCapture::Err () << GetTimeStamp()
           << " flow: " << flow->GetBearer()->GetApplication()->GetApplicationID()
           << " cumu_bytes: " << flow->GetBearer()->GetCumulateBytes()
           << " cumu_rbs: " << flow->GetBearer()->GetCumulateRBs()
           << " hol_delay: " << flow->GetBearer()->GetHeadOfLinePacketDelay()
           << std::endl;
-	    std::cout << "\nTransmit packets for flow "
+	    OutputCapture::Out () << "\nTransmit packets for flow "
 	    		<< flow->GetBearer ()->GetApplication ()->GetApplicationID () << std::endl;
 
 	      RlcEntity *rlc = flow->GetBearer ()->GetRlcEntity ();
@@ -170,7 +194,7 @@ DownlinkPacketScheduler::DoStopSchedule (void)
 
 #ifdef SCHEDULER_DEBUG
   if (pb->GetNPackets () == 0)
-    std::cout << "\t Send only reference symbols" << std::endl;
+    OutputCapture::Out () << "\t Send only reference symbols" << std::endl;
 #endif
 
   GetMacEntity ()->GetDevice ()->SendPacketBurst (pb);
@@ -181,7 +205,7 @@ DownlinkPacketScheduler::RBsAllocation ()
 {
 
 #ifdef SCHEDULER_DEBUG
-	std::cout << " ---- DownlinkPacketScheduler::RBsAllocation";
+	OutputCapture::Out () << " ---- DownlinkPacketScheduler::RBsAllocation";
 #endif
 
   FlowsToSchedule* flows = GetFlowsToSchedule ();
@@ -189,11 +213,13 @@ DownlinkPacketScheduler::RBsAllocation ()
   int rbg_size = get_rbg_size(nb_rbs);
   int nb_rbgs = (nb_rbs + rbg_size - 1) / rbg_size;
 
-  // create a matrix of flow metrics
-  double metrics[nb_rbgs][flows->size ()];
+  // create a matrix of flow metrics, flow j of RBG i at i * nb_flows + j
+  TtiArena* arena = GetTtiArena ();
+  size_t nb_flows = flows->size ();
+  double* metrics = arena->NewArray<double> (nb_rbgs * nb_flows);
   for (int i = 0; i < nb_rbgs; i++) {
 	  for (size_t j = 0; j < flows->size (); j++) {
-		  metrics[i][j] = ComputeSchedulingMetric (
+		  metrics[i * nb_flows + j] = ComputeSchedulingMetric (
         flows->at (j)->GetBearer (),
         flows->at (j)->GetSpectralEfficiency ().at (i * rbg_size),
         i);
@@ -204,24 +230,28 @@ DownlinkPacketScheduler::RBsAllocation ()
   //std::cout << ", available RBGs " << nbOfGroups << ", flows " << flows->size () << std::endl;
   for (int ii = 0; ii < flows->size (); ii++)
     {
-	  std::cout << "\t metrics for flow "
+	  OutputCapture::Out () << "\t metrics for flow "
 			  << flows->at (ii)->GetBearer ()->GetApplication ()->GetApplicationID () << ":";
 	  for (int jj = 0; jj < nbOfGroups; jj++)
 	    {
         fprintf(stdout, " (%d, %.3f, %d)",
-            jj, metrics[jj][ii], 
+            jj, metrics[jj * nb_flows + ii], 
             flows->at(ii)->GetCqiFeedbacks().at(jj * rbg_size));
 	    }
-	  std::cout << std::endl;
+	  OutputCapture::Out () << std::endl;
     }
 #endif
 
   AMCModule *amc = GetMacEntity ()->GetAmcModule ();
-  bool * l_bFlowScheduled = new bool[flows->size ()];
+  bool * l_bFlowScheduled = arena->NewArray<bool> (nb_flows);
   int l_iScheduledFlows = 0;
-  std::vector<double> * l_bFlowScheduledSINR = new std::vector<double>[flows->size ()];
+  TtiVector<double> * l_bFlowScheduledSINR = arena->NewArray<TtiVector<double> > (nb_flows);
   for (size_t k = 0; k < flows->size (); k++)
+    {
       l_bFlowScheduled[k] = false;
+      new (&l_bFlowScheduledSINR[k]) TtiVector<double> (arena);
+      l_bFlowScheduledSINR[k].reserve (nb_rbs);
+    }
 
   //RBs allocation
   for (int s = 0; s < nb_rbgs; s++)
@@ -236,9 +266,9 @@ DownlinkPacketScheduler::RBsAllocation ()
 
       for (size_t k = 0; k < flows->size (); k++)
         {
-          if (metrics[s][k] > targetMetric && !l_bFlowScheduled[k])
+          if (metrics[s * nb_flows + k] > targetMetric && !l_bFlowScheduled[k])
             {
-              targetMetric = metrics[s][k];
+              targetMetric = metrics[s * nb_flows + k];
               SubbandAllocated = true;
               scheduledFlow = flows->at (k);
               l_iScheduledFlowIndex = k;
@@ -270,11 +300,8 @@ DownlinkPacketScheduler::RBsAllocation ()
         }
     }
 
-  delete [] l_bFlowScheduled;
-  delete [] l_bFlowScheduledSINR;
-
   //Finalize the allocation
-  PdcchMapIdealControlMessage *pdcchMsg = new PdcchMapIdealControlMessage ();
+  PdcchMapIdealControlMessage *pdcchMsg = &m_pdcchMap;
 
   for (FlowsToSchedule::iterator it = flows->begin (); it != flows->end (); it++)
     {
@@ -283,7 +310,8 @@ DownlinkPacketScheduler::RBsAllocation ()
       if (flow->GetListOfAllocatedRBs ()->size () > 0)
         {
           //this flow has been scheduled
-          std::vector<double> estimatedSinrValues;
+          TtiVector<double> estimatedSinrValues (arena);
+          estimatedSinrValues.reserve (flow->GetListOfAllocatedRBs ()->size ());
           for (size_t rb = 0; rb < flow->GetListOfAllocatedRBs ()->size (); rb++ ) {
               double sinr = amc->GetSinrFromCQI (
                       flow->GetCqiFeedbacks ().at (flow->GetListOfAllocatedRBs ()->at (rb)));
@@ -302,7 +330,7 @@ DownlinkPacketScheduler::RBsAllocation ()
           flow->UpdateAllocatedBits (transportBlockSize);
 
 #ifdef SCHEDULER_DEBUG
-		  std::cout << "\t\t --> flow "	<< flow->GetBearer ()->GetApplication ()->GetApplicationID ()
+		  OutputCapture::Out () << "\t\t --> flow "	<< flow->GetBearer ()->GetApplication ()->GetApplicationID ()
 				  << " has been scheduled: " <<
 				  "\n\t\t\t nb of RBs " << flow->GetListOfAllocatedRBs ()->size () <<
 				  "\n\t\t\t effectiveSinr " << effectiveSinr <<
@@ -322,12 +350,6 @@ DownlinkPacketScheduler::RBsAllocation ()
 		    }
 	    }
     }
-
-  if (pdcchMsg->GetMessage()->size () > 0)
-    {
-      GetMacEntity ()->GetDevice ()->GetPhy ()->SendIdealControlMessage (pdcchMsg);
-    }
-  delete pdcchMsg;
 }
 
 // void
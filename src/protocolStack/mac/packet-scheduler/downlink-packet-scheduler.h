@@ -34,12 +34,24 @@ class DownlinkPacketScheduler : public PacketScheduler {
   virtual void DoSchedule(void);
   virtual void DoStopSchedule(void);
 
+  virtual bool SupportsPhases(void);
+  virtual void PrepareSchedule(void);
+  virtual void AllocateResources(void);
+
   virtual void RBsAllocation();
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
                                          double spectralEfficiency,
                                          int subChannel) = 0;
 
   void UpdateAverageTransmissionRate(void);
+
+ protected:
+  // sends the map RBsAllocation built, at the start of DoStopSchedule
+  void SendPdcchMap(void);
+
+ private:
+  // built by RBsAllocation, sent to the UEs by DoStopSchedule
+  PdcchMapIdealControlMessage m_pdcchMap;
 };
 
 #endif /* DOWNLINKPACKETSCHEDULER_H_ */
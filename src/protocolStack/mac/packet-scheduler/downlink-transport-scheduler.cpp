@@ -34,6 +34,8 @@
 #include "../../../flows/MacQueue.h"
 #include "../../../utility/eesm-effective-sinr.h"
 #include "../../../load-parameters.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 #include <jsoncpp/json/json.h>
 #include <cstdio>
 #include <utility>
@@ -41,16 +43,10 @@
 #include <sstream>
 #include <cassert>
 #include <algorithm>
-#include <unordered_map>
-#include <limits>
 #include <cstring>
 #include <cmath>
 
 using std::vector;
-using std::unordered_map;
-
-using coord_t = std::pair<int, int>;
-using coord_cqi_t = std::pair<coord_t, double>;
 
 DownlinkTransportScheduler::DownlinkTransportScheduler(std::string config_fname, int interslice_algo)
 {
@@ -75,15 +71,13 @@ DownlinkTransportScheduler::DownlinkTransportScheduler(std::string config_fname,
   for (int i = 0; i < slice_schemes.size(); i++) {
     int n_slices = slice_schemes[i]["n_slices"].asInt();
     for (int j = 0; j < n_slices; j++) {
-      slice_weights_.push_back(
-        slice_schemes[i]["weight"].asDouble()
-      );
-      slice_algo_params_.emplace_back(
-        slice_schemes[i]["algo_alpha"].asInt(),
-        slice_schemes[i]["algo_beta"].asInt(),
-        slice_schemes[i]["algo_epsilon"].asInt(),
-        slice_schemes[i]["algo_psi"].asInt()
-      );
+      rs_slicing_slice slice;
+      slice.weight = slice_schemes[i]["weight"].asDouble();
+      slice.alpha = slice_schemes[i]["algo_alpha"].asInt();
+      slice.beta = slice_schemes[i]["algo_beta"].asInt();
+      slice.epsilon = slice_schemes[i]["algo_epsilon"].asInt();
+      slice.psi = slice_schemes[i]["algo_psi"].asInt();
+      slices_.push_back(slice);
     }
   }
   slice_priority_.resize(num_slices_);
@@ -105,71 +99,70 @@ DownlinkTransportScheduler::~DownlinkTransportScheduler()
 void DownlinkTransportScheduler::SelectFlowsToSchedule ()
 {
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t Select Flows to schedule" << std::endl;
+	OutputCapture::Out() << "\t Select Flows to schedule" << std::endl;
 #endif
 
   ClearUsersToSchedule();
-  RrcEntity *rrc = GetMacEntity ()->GetDevice ()->GetProtocolStack ()->GetRrcEntity ();
-  RrcEntity::RadioBearersContainer* bearers = rrc->GetRadioBearerContainer ();
+  const BearerInputs& inputs = ReadBearerInputs();
 
   std::fill(slice_priority_.begin(), slice_priority_.end(), 0);
-  for (std::vector<RadioBearer* >::iterator it = bearers->begin (); it != bearers->end (); it++) {
+  for (size_t i = 0; i < inputs.size(); i++) {
 	  //SELECT FLOWS TO SCHEDULE
-	  RadioBearer *bearer = (*it);
-
-	  if (bearer->HasPackets() && bearer->GetDestination ()->GetNodeState () == NetworkNode::STATE_ACTIVE) {
-		  //compute data to transmit
-		  int dataToTransmit;
-		  if (bearer->GetApplication ()->GetApplicationType () == Application::APPLICATION_TYPE_INFINITE_BUFFER) {
-			  dataToTransmit = 100000000;
-			}
-		  else {
-			  dataToTransmit = bearer->GetQueueSize ();
-			}
-
-		  //compute spectral efficiency
-		  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
-		  ENodeB::UserEquipmentRecord *ueRecord =
-        enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ());
-		  std::vector<double> spectralEfficiency;
-		  std::vector<int> cqiFeedbacks = ueRecord->GetCQI ();
-		  int numberOfCqi = cqiFeedbacks.size ();
-      AMCModule *amc = GetMacEntity()->GetAmcModule();
-		  for (int i = 0; i < numberOfCqi; i++) {
-        spectralEfficiency.push_back(amc->GetEfficiencyFromCQI(cqiFeedbacks.at(i)));
-			}
-      
-		  //create flow to scheduler record
-      int slice_id = user_to_slice_[bearer->GetUserID()];
-      if (bearer->GetPriority() > slice_priority_[slice_id]) {
-        slice_priority_[slice_id] = bearer->GetPriority();
-      }
-      InsertFlowToUser(bearer, dataToTransmit, spectralEfficiency, cqiFeedbacks);
-		}
+	  const BearerInput& input = inputs[i];
+
+	  //create flow to scheduler record
+    int slice_id = user_to_slice_[input.m_userID];
+    if (input.m_priority > slice_priority_[slice_id]) {
+      slice_priority_[slice_id] = input.m_priority;
+    }
+    InsertFlowToUser(input);
 	}
 }
 
 void
 DownlinkTransportScheduler::DoSchedule (void)
 {
+  PrepareSchedule ();
+  AllocateResources ();
+  StopSchedule ();
+}
+
+bool
+DownlinkTransportScheduler::SupportsPhases (void)
+{
+  return true;
+}
+
+void
+DownlinkTransportScheduler::PrepareSchedule (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start DL packet scheduler for node "
+	OutputCapture::Out() << "Start DL packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
   UpdateAverageTransmissionRate ();
   SelectFlowsToSchedule ();
+}
 
+void
+DownlinkTransportScheduler::AllocateResources (void)
+{
+  PROFILE_PHASE (PHASE_SCHED_ALLOCATE);
+  pdcch_map_.GetMessage()->clear();
   if (GetUsersToSchedule()->size() != 0) {
     RBsAllocation ();
   }
-
-  StopSchedule ();
 }
 
 void
 DownlinkTransportScheduler::DoStopSchedule(void)
 {
+  if (pdcch_map_.GetMessage()->size() > 0) {
+    GetMacEntity()->GetDevice()->GetPhy()->SendIdealControlMessage(&pdcch_map_);
+  }
+
   PacketBurst* pb = new PacketBurst();
   UsersToSchedule *uesToSchedule = GetUsersToSchedule();
   for (auto it = uesToSchedule->begin(); it != uesToSchedule->end(); it++) {
@@ -189,7 +182,7 @@ DownlinkTransportScheduler::DoStopSchedule(void)
         user->m_bearers[i]->UpdateCumulateRBs(
             user->GetListOfAllocatedRBs()->size()
             );
-        std::cerr << GetTimeStamp()
+        OutputCapture::Err() << GetTimeStamp()
           << " app: " << user->m_bearers[i]->GetApplication()->GetApplicationID()
           << " cumu_bytes: " << user->m_bearers[i]->GetCumulateBytes()
           << " cumu_rbs: " << user->m_bearers[i]->GetCumulateRBs()
@@ -220,234 +213,12 @@ DownlinkTransportScheduler::DoStopSchedule(void)
   GetMacEntity ()->GetDevice ()->SendPacketBurst (pb);
 }
 
-static unordered_map<int, vector<int>> UpperBound(double** flow_spectraleff, vector<int>& slice_quota_rbgs, int nb_rbgs, int nb_slices)
-{
-  double sum_bits = 0;
-  unordered_map<int, vector<int>> slice_rbgs;
-  for (int j = 0; j < nb_slices; ++j) {
-    if (slice_quota_rbgs[j] <= 0)
-      continue;
-    vector<std::pair<int, double>> sorted_cqi;
-    for (int i = 0; i < nb_rbgs; ++i) {
-      sorted_cqi.emplace_back(i, flow_spectraleff[i][j]);
-    }
-    std::sort(sorted_cqi.begin(), sorted_cqi.end(),
-      [](std::pair<int, double> a, std::pair<int, double> b) {
-        return a.second > b.second;
-        }
-      );
-    for (int k = 0; k < slice_quota_rbgs[j]; ++k) {
-      slice_rbgs[j].push_back(sorted_cqi[k].first);
-      sum_bits += sorted_cqi[k].second;
-    }
-  }
-  fprintf(stderr, "all_bytes: %.0f\n", sum_bits * 180 / 8 * 4); // 4 for rbg_size
-  return slice_rbgs;
-}
-
-// return rb id to slice id mapping vector
-static vector<int> GreedyByRow(double** flow_spectraleff, vector<int>& slice_quota_rbgs, int nb_rbgs, int nb_slices)
-{
-  vector<int> slice_rbgs(nb_slices, 0);
-  vector<int> rbg_to_slice(nb_rbgs, -1);
-  for (int i = 0; i < nb_rbgs; ++i) {
-    double max_eff = -1;
-    int assigned_slice = -1;
-    for (int j = 0; j < nb_slices; ++j) {
-      if (flow_spectraleff[i][j] > max_eff && slice_rbgs[j] < slice_quota_rbgs[j]) {
-        max_eff = flow_spectraleff[i][j];
-        assigned_slice = j;
-      }
-    }
-    assert(assigned_slice != -1);
-    rbg_to_slice[i] = assigned_slice;
-    slice_rbgs[assigned_slice] += 1;
-  }
-  double sum_bits = 0;
-  for (int i = 0; i < nb_rbgs; ++i) {
-    sum_bits += flow_spectraleff[i][rbg_to_slice[i]];
-  }
-  fprintf(stderr, "all_bytes: %.0f\n", sum_bits * 180 / 8 * 4); // 4 for rbg_size
-  return rbg_to_slice;
-}
-
-static vector<int> SubOpt(double** flow_spectraleff, vector<int>& slice_quota_rbgs, int nb_rbgs, int nb_slices)
+// through OutputCapture rather than stderr, so that the parallel TTI captures it
+static void PrintAllBytes(double bytes)
 {
-  vector<int> slice_rbgs(nb_slices, 0);
-  vector<int> rbg_to_slice(nb_rbgs, -1);
-  // set negative to 0 first
-  for (size_t i = 0; i < slice_quota_rbgs.size(); ++i) {
-    if (slice_quota_rbgs[i] < 0)
-      slice_quota_rbgs[i] = 0;
-  }
-  for (int i = 0; i < nb_rbgs; ++i) {
-    double max_eff = -1;
-    int assigned_slice = -1;
-    for (int j = 0; j < nb_slices; ++j) {
-      if (flow_spectraleff[i][j] > max_eff) {
-        max_eff = flow_spectraleff[i][j];
-        assigned_slice = j;
-      }
-    }
-    assert(assigned_slice != -1);
-    rbg_to_slice[i] = assigned_slice;
-    slice_rbgs[assigned_slice] += 1;
-  }
-  // do the reallocation
-  unordered_map<int, int> slice_more;
-  unordered_map<int, int> slice_fewer;
-  for(int i = 0; i < nb_slices; ++i) {
-    if (slice_rbgs[i] > slice_quota_rbgs[i]) {
-      slice_more[i] = slice_rbgs[i] - slice_quota_rbgs[i];
-    }
-    else if (slice_rbgs[i] < slice_quota_rbgs[i]) {
-      slice_fewer[i] = slice_quota_rbgs[i] - slice_rbgs[i];
-    }
-  }
-  while (slice_more.size() > 0 && slice_fewer.size() > 0) {
-    // one reallocation
-    //std::cout << slice_more.size() << "*" << slice_fewer.size() << std::endl;
-    int from_slice = -1, to_slice, rbg_id;
-    double min_tbs_reduce = std::numeric_limits<double>::max();
-    for (int i = 0; i < nb_rbgs; ++i) {
-      if ( slice_more.find(rbg_to_slice[i]) != slice_more.end() ) {
-        for (auto it = slice_fewer.begin(); it != slice_fewer.end(); ++it) {
-          assert(flow_spectraleff[i][rbg_to_slice[i]] >= flow_spectraleff[i][it->first]);
-          if (flow_spectraleff[i][rbg_to_slice[i]] - flow_spectraleff[i][it->first] < min_tbs_reduce) {
-            min_tbs_reduce = flow_spectraleff[i][rbg_to_slice[i]] - flow_spectraleff[i][it->first];
-            from_slice = rbg_to_slice[i];
-            to_slice = it->first;
-            rbg_id = i;
-          }
-        }
-      }
-    }
-    assert(from_slice != -1);
-    slice_rbgs[from_slice] -= 1;
-    slice_rbgs[to_slice] += 1;
-    rbg_to_slice[rbg_id] = to_slice;
-    slice_more.at(from_slice) -= 1;
-    slice_fewer.at(to_slice) -= 1;
-    // std::cout << "reallocate: " 
-    // << from_slice << " -> " << to_slice << " "
-    // << slice_rbgs[from_slice] << " & " << slice_rbgs[to_slice] << " "
-    // << slice_more[from_slice] << " & " << slice_fewer[to_slice] << " "
-    // << std::endl;
-    if (slice_more.at(from_slice) <= 0 || slice_rbgs[from_slice] <= 0) {
-      slice_more.erase(from_slice);
-    }
-    if (slice_fewer.at(to_slice) <= 0) {
-      slice_fewer.erase(to_slice);
-    }
-  }
-  double sum_bits = 0;
-  for (int i = 0; i < nb_rbgs; ++i) {
-    sum_bits += flow_spectraleff[i][rbg_to_slice[i]];
-  }
-  fprintf(stderr, "all_bytes: %.0f\n", sum_bits * 180 / 8 * 4); // 4 for rbg_size
-  return rbg_to_slice;
-}
-
-static vector<int> MaximizeCell(double** flow_spectraleff, vector<int>& slice_quota_rbgs, int nb_rbgs, int nb_slices)
-{
-  // it's ok that the quota is negative
-  vector<coord_cqi_t> sorted_cqi;
-  vector<int>         slice_rbgs(nb_slices, 0);
-  vector<int>         rbg_to_slice(nb_rbgs, -1);
-  for (int i = 0; i < nb_rbgs; ++i)
-    for (int j = 0; j < nb_slices; ++j) {
-      sorted_cqi.emplace_back(coord_t(i, j), flow_spectraleff[i][j]);
-    }
-    std::sort(sorted_cqi.begin(), sorted_cqi.end(), [](coord_cqi_t a, coord_cqi_t b){return a.second > b.second; });
-    for (auto it = sorted_cqi.begin(); it != sorted_cqi.end(); ++it) {
-      int rbg_id = it->first.first;
-      int slice_id = it->first.second;
-      if (slice_rbgs[slice_id] < slice_quota_rbgs[slice_id] && rbg_to_slice[rbg_id] == -1) {
-        rbg_to_slice[rbg_id] = slice_id;
-        slice_rbgs[slice_id] += 1;
-    } 
-  }
-  double sum_bits = 0;
-  for (int i = 0; i < nb_rbgs; ++i) {
-    sum_bits += flow_spectraleff[i][rbg_to_slice[i]];
-  }
-  fprintf(stderr, "all_bytes: %.0f\n", sum_bits * 180 / 8 * 4); // 4 for rbg_size
-  return rbg_to_slice;
-}
-
-static vector<int> VogelApproximate(double** flow_spectraleff, vector<int>& slice_quota_rbgs, int nb_rbgs, int nb_slices)
-{
-  vector<int>   slice_rbgs(nb_slices, 0);
-  vector<int>   rbg_to_slice(nb_rbgs, -1);
-  for (int i = 0; i < nb_rbgs; ++i) {
-    int max_diff = -1;
-    coord_t coord_1st;
-    coord_t coord_2nd;
-    // horizonal search
-    for (int j = 0; j < nb_rbgs; ++j) {
-      // the rbg has been allocated
-      if (rbg_to_slice[j] != -1)
-        continue;
-      double eff_1st = -1, eff_2nd = -1;
-      int slice_1st, slice_2nd;
-
-      for (int k = 0; k < nb_slices; ++k) {
-        // the slice has reached quota
-        if (slice_rbgs[k] >= slice_quota_rbgs[k])
-          continue;
-        if (eff_1st == -1 || flow_spectraleff[j][k] > eff_1st) {
-          slice_1st = k;
-          eff_1st = flow_spectraleff[j][k];
-          continue;
-        }
-        if (eff_2nd == -1 || flow_spectraleff[j][k] > eff_2nd) {
-          slice_2nd = k;
-          eff_2nd = flow_spectraleff[j][k];
-          continue;
-        }
-      }
-      if (eff_1st - eff_2nd > max_diff) {
-        max_diff = eff_1st - eff_2nd;
-        coord_1st = coord_t(j, slice_1st);
-        coord_2nd = coord_t(j, slice_2nd);
-      }
-    }
-    // vertical search
-    for (int k = 0; k < nb_slices; ++k) {
-      // the slice has reached quota
-      if (slice_rbgs[k] >= slice_quota_rbgs[k])
-        continue;
-      double eff_1st = -1, eff_2nd = -1;
-      int rbg_1st, rbg_2nd;
-      for (int j = 0; j < nb_rbgs; ++j) {
-        if (rbg_to_slice[j] != -1)
-          continue;
-        if (eff_1st == -1 || flow_spectraleff[j][k] > eff_1st) {
-          rbg_1st = j;
-          eff_1st = flow_spectraleff[j][k];
-          continue;
-        }
-        if (eff_2nd == -1 || flow_spectraleff[j][k] > eff_2nd) {
-          rbg_2nd = j;
-          eff_2nd = flow_spectraleff[j][k];
-          continue;
-        }
-      }
-      if (eff_1st - eff_2nd > max_diff) {
-        max_diff = eff_1st - eff_2nd;
-        coord_1st = coord_t(rbg_1st, k);
-        coord_2nd = coord_t(rbg_2nd, k);
-      }
-    }
-    rbg_to_slice[coord_1st.first] = coord_1st.second;
-    slice_rbgs[coord_1st.second] += 1;
-  }
-  double sum_bits = 0;
-  for (int i = 0; i < nb_rbgs; ++i) {
-    sum_bits += flow_spectraleff[i][rbg_to_slice[i]];
-  }
-  fprintf(stderr, "all_bytes: %.0f\n", sum_bits * 180 / 8 * 4); // 4 for rbg_size
-  return rbg_to_slice;
+  char line[64];
+  snprintf(line, sizeof(line), "all_bytes: %.0f\n", bytes);
+  OutputCapture::Err() << line;
 }
 
 void
@@ -456,189 +227,81 @@ DownlinkTransportScheduler::RBsAllocation()
   UsersToSchedule* users = GetUsersToSchedule();
   int nb_rbs = GetMacEntity ()->GetDevice ()->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
   int rbg_size = get_rbg_size(nb_rbs);
-  // currently nb_rbgs should be divisible
-  nb_rbs = nb_rbs - (nb_rbs % rbg_size);
-  assert(nb_rbs % rbg_size == 0);
-
-  // find out slices without data/flows at all, and assign correct rb target
-  std::vector<bool> slice_with_data(num_slices_, false);
-  std::vector<int> slice_target_rbs(num_slices_, 0);
-  int num_nonempty_slices = 0;
-  int extra_rbs = nb_rbs;
-  for (auto it = users->begin(); it != users->end(); ++it) {
-    int user_id = (*it)->GetUserID();
-    int slice_id = user_to_slice_[user_id];
-    if (slice_with_data[slice_id])
-      continue;
-    num_nonempty_slices += 1;
-    slice_with_data[slice_id] = true;
-    slice_target_rbs[slice_id] = (int)(nb_rbs * slice_weights_[slice_id] + slice_rbs_offset_[slice_id]);
-    extra_rbs -= slice_target_rbs[slice_id];
-  }
-  // std::cout << "slice target RBs:";
-  // for (int i = 0; i < num_slices_; ++i) {
-  //   std::cout << "(" << i << ", " 
-  //     << slice_target_rbs[i] << ", " 
-  //     << slice_rbs_offset_[i] << ","
-  //     << slice_weights_[i] << ") ";
-  // }
-  // std::cout << std::endl;
-  
-  assert(num_nonempty_slices != 0);
-  // we enable reallocation between slices, but not flows
-  bool is_first_slice = true;
-  int rand_begin_idx = rand();
-  for (int i = 0; i < num_slices_; ++i) {
-    int k = (i + rand_begin_idx) % num_slices_;
-    if (slice_with_data[k]) {
-      slice_target_rbs[k] += extra_rbs / num_nonempty_slices;
-      if (is_first_slice) {
-        slice_target_rbs[k] += extra_rbs % num_nonempty_slices;
-        is_first_slice = false;
-      }
-    }
-  }
+  // currently only whole rbgs are scheduled
   int nb_rbgs = nb_rbs / rbg_size;
-  // calculate the rbg quota for slices
-  std::vector<int> slice_quota_rbgs(num_slices_, 0);
-  std::vector<int> slice_final_rbgs(num_slices_, 0);
-  int extra_rbgs = nb_rbgs;
-  for (int i = 0; i < num_slices_; ++i) {
-    slice_quota_rbgs[i] = (int)(slice_target_rbs[i] / rbg_size);
-    extra_rbgs -= slice_quota_rbgs[i];
-  }
-  is_first_slice = true;
-  rand_begin_idx = rand();
-  for (int i = 0; i < num_slices_; ++i) {
-    int k = (rand_begin_idx + i) % num_slices_;
-    if(slice_with_data[k]) {
-      slice_quota_rbgs[k] += extra_rbgs / num_nonempty_slices;
-      if (is_first_slice) {
-        slice_quota_rbgs[k] += extra_rbgs % num_nonempty_slices;
-        is_first_slice = false;
-      }
+
+  // the working set of the allocation lives in the TTI arena
+  TtiArena* arena = GetTtiArena();
+
+  // the users and their spectral efficiency on the first rb of every rbg
+  size_t nb_users = users->size ();
+  rs_slicing_user *slicing_users = arena->NewArray<rs_slicing_user>(nb_users);
+  double *spectral_efficiency = arena->NewArray<double>(nb_users * nb_rbgs);
+  for (size_t j = 0; j < nb_users; j++) {
+    GetSlicingUser(users->at(j), &slicing_users[j]);
+    for (int i = 0; i < nb_rbgs; i++) {
+      spectral_efficiency[j * nb_rbgs + i] = users->at(j)->GetSpectralEfficiency().at(i * rbg_size);
     }
   }
 
-  std::cout << "slice_id, target_rbs, quota_rbgs: ";
+  rs_slicing_input input;
+  input.algo = inter_sched_;
+  input.nb_rbs = nb_rbs;
+  input.rbg_size = rbg_size;
+  input.nb_slices = num_slices_;
+  input.nb_users = nb_users;
+  input.slices = slices_.data();
+  input.users = slicing_users;
+  input.spectral_efficiency = spectral_efficiency;
+  // the slices that get the leftover rbs, then rbgs, first
+  input.rotation[0] = GetRandomStream().NextInt(num_slices_);
+  input.rotation[1] = GetRandomStream().NextInt(num_slices_);
+
+  rs_slicing_output output;
+  output.max_grants = rs_slicing_max_grants(inter_sched_, nb_rbgs, num_slices_);
+  output.grants = arena->NewArray<rs_slicing_grant>(output.max_grants);
+  output.slice_target_rbs = arena->NewArray<int>(num_slices_);
+  output.slice_quota_rbgs = arena->NewArray<int>(num_slices_);
+  size_t workspace_size = rs_slicing_workspace_size(nb_rbgs, num_slices_, nb_users);
+  void *workspace = arena->NewArray<char>(workspace_size);
+
+  int status;
+  {  // the quotas, the users of the slices and the inter-slice solver
+    PROFILE_PHASE (PHASE_SCHED_INTER_SLICE);
+    status = rs_slicing_allocate(&input, slice_rbs_offset_.data(), workspace,
+                                 workspace_size, &output);
+  }
+  assert(status == RS_SLICING_OK);
+
+  OutputCapture::Out() << "slice_id, target_rbs, quota_rbgs: ";
   for (int i = 0; i < num_slices_; ++i) {
-    std::cout << "(" << i << ", " << slice_target_rbs[i] << ", " << slice_quota_rbgs[i] << ") ";
+    OutputCapture::Out() << "(" << i << ", " << output.slice_target_rbs[i] << ", " << output.slice_quota_rbgs[i] << ") ";
   }
-  std::cout << std::endl;
+  OutputCapture::Out() << std::endl;
+  PrintAllBytes(output.sum_efficiency * 180 / 8 * 4); // 4 for rbg_size
 
-  // create a matrix of flow metrics (RBG, flow index)
-  double metrics[nb_rbgs][users->size ()];
-
-  for (int i = 0; i < nb_rbgs; i++) {
-    for (size_t j = 0; j < users->size(); j++) {
-      metrics[i][j] = ComputeSchedulingMetric(
-        users->at(j),
-        users->at(j)->GetSpectralEfficiency().at(i * rbg_size)
-      );
+  for (int g = 0; g < output.nb_grants; ++g) {
+    const rs_slicing_grant &grant = output.grants[g];
+    int l = grant.rbg * rbg_size, r = (grant.rbg + 1) * rbg_size;
+    for (int j = l; j < r; ++j) {
+      users->at(grant.user)->GetListOfAllocatedRBs()->push_back(j);
     }
   }
 
   AMCModule *amc = GetMacEntity ()->GetAmcModule ();
-
-  // 1st index: rbg_id; 2nd index: slice_id
-  // the flow_id when the rbg is assigned to the slice
-  int **user_index = new int*[nb_rbgs];
-  double **flow_spectraleff = new double*[nb_rbgs];
-
-  // Assign the flow_id and cqi to every slice in every rbg
-  for (int i = 0; i < nb_rbgs; i++)
-  {
-    user_index[i] = new int[num_slices_];
-    flow_spectraleff[i] = new double[num_slices_];
-    for (int k = 0; k < num_slices_; k++) {
-      user_index[i][k] = -1;
-      flow_spectraleff[i][k] = 0;
-    }
-    std::vector<double> max_ranks(num_slices_, -1);     // the highest flow metric in every slice
-    for (size_t j = 0; j < users->size(); ++j) {
-      int user_id = users->at(j)->GetUserID();
-      int slice_id = user_to_slice_[user_id];
-      if (metrics[i][j] > max_ranks[slice_id]) {
-        max_ranks[slice_id] = metrics[i][j];
-        user_index[i][slice_id] = j;
-        flow_spectraleff[i][slice_id] = users->at(j)->GetSpectralEfficiency().at(i * rbg_size);
-      }
-    }
-  }
-
-  // calculate the assignment of rbgs to slices
-  vector<int> rbg_to_slice;
-  unordered_map<int, vector<int>> slice_rbgs;
-  if (inter_sched_ == 0) {
-    rbg_to_slice = GreedyByRow(flow_spectraleff, slice_quota_rbgs, nb_rbgs, num_slices_);
-  }
-  else if (inter_sched_ == 1) {
-    rbg_to_slice = SubOpt(flow_spectraleff, slice_quota_rbgs, nb_rbgs, num_slices_);
-  }
-  else if (inter_sched_ == 2) {
-    rbg_to_slice = MaximizeCell(flow_spectraleff, slice_quota_rbgs, nb_rbgs, num_slices_);
-  }
-  else if (inter_sched_ == 3 ) {
-    rbg_to_slice = VogelApproximate(flow_spectraleff, slice_quota_rbgs, nb_rbgs, num_slices_);
-  }
-  else {
-    slice_rbgs = UpperBound(flow_spectraleff, slice_quota_rbgs, nb_rbgs, num_slices_);
-  }
-
-  // ToDo: Generalize the framework
-  if (inter_sched_ < 4 ) {
-    for (size_t i = 0; i < rbg_to_slice.size(); ++i) {
-      int uindex = user_index[i][rbg_to_slice[i]];
-      assert(uindex != -1);
-      int sid = user_to_slice_[users->at(uindex)->GetUserID()];
-      assert(sid == rbg_to_slice[i]);
-      slice_final_rbgs[sid] += 1;
-      int l = i * rbg_size, r = (i+1) * rbg_size;
-      for (int j = l; j < r; ++j) {
-        users->at(uindex)->GetListOfAllocatedRBs()->push_back(j);
-      }
-    }
-  }
-  else {
-    for (auto it = slice_rbgs.begin(); it != slice_rbgs.end(); ++it) {
-      int sid = it->first;
-      auto rbg_list = it->second;
-      slice_final_rbgs[sid] += rbg_list.size();
-      for (size_t i = 0; i < rbg_list.size(); ++i) {
-        int uindex = user_index[rbg_list[i]][sid];
-        assert(uindex != -1);
-        int l = rbg_list[i] * rbg_size, r = (rbg_list[i] + 1) * rbg_size;
-        for (int j = l; j < r; ++j) {
-          users->at(uindex)->GetListOfAllocatedRBs()->push_back(j);
-        }
-      }
-    }
-  }
-
-  for (int i = 0; i < num_slices_; ++i) {
-    slice_rbs_offset_[i] = slice_target_rbs[i] - slice_final_rbgs[i] * rbg_size;
-  }
-
-  // free the flow_id and flow_spectraleff
-  for (int i = 0; i < nb_rbgs; i++) {
-    delete[] user_index[i];
-    delete[] flow_spectraleff[i];
-  }
-  delete[] user_index;
-  delete[] flow_spectraleff;
-
-  PdcchMapIdealControlMessage *pdcchMsg = new PdcchMapIdealControlMessage();
-  std::cout << GetTimeStamp() << std::endl;
+  PdcchMapIdealControlMessage *pdcchMsg = &pdcch_map_;
+  OutputCapture::Out() << GetTimeStamp() << std::endl;
   for (auto it = users->begin(); it != users->end(); it++) {
     UserToSchedule *ue = *it;
     if (ue->GetListOfAllocatedRBs()->size() > 0) {
-      std::vector<double> estimatedSinrValues;
+      TtiVector<double> estimatedSinrValues(arena);
+      estimatedSinrValues.reserve(ue->GetListOfAllocatedRBs()->size());
 
-      std::cout << "User(" << ue->GetUserID() << ") allocated RBGS:";
+      OutputCapture::Out() << "User(" << ue->GetUserID() << ") allocated RBGS:";
       for (size_t i = 0; i < ue->GetListOfAllocatedRBs()->size (); i++ ) {
         int rbid = ue->GetListOfAllocatedRBs()->at(i);
         if (rbid % rbg_size == 0)
-          std::cout << " " << rbid / rbg_size << "(" << ue->GetCqiFeedbacks().at(rbid) << ")";
+          OutputCapture::Out() << " " << rbid / rbg_size << "(" << ue->GetCqiFeedbacks().at(rbid) << ")";
 
         double sinr = amc->GetSinrFromCQI (
           ue->GetCqiFeedbacks ().at (
@@ -646,7 +309,7 @@ DownlinkTransportScheduler::RBsAllocation()
         estimatedSinrValues.push_back (sinr);
       }
       double effectiveSinr = GetEesmEffectiveSinr(estimatedSinrValues);
-      std::cout << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
+      OutputCapture::Out() << " final_cqi: " << amc->GetCQIFromSinr(effectiveSinr) << std::endl;
       int mcs = amc->GetMCSFromCQI(amc->GetCQIFromSinr(effectiveSinr));
       int transportBlockSize = amc->GetTBSizeFromMCS(mcs, ue->GetListOfAllocatedRBs()->size());
 
@@ -668,48 +331,79 @@ DownlinkTransportScheduler::RBsAllocation()
       }
     }
   }
-  if (pdcchMsg->GetMessage()->size() > 0) {
-    GetMacEntity()->GetDevice()->GetPhy()->SendIdealControlMessage(pdcchMsg);
-  }
-  delete pdcchMsg;
 }
 
 double
 DownlinkTransportScheduler::ComputeSchedulingMetric(UserToSchedule* user, double spectralEfficiency)
 {
-  double metric = 0;
-  double averageRate = 1;
+  rs_slicing_user input;
+  GetSlicingUser(user, &input);
+  return rs_slicing_metric(&slices_[input.slice], &input, spectralEfficiency);
+}
+
+void
+DownlinkTransportScheduler::GetSlicingUser(UserToSchedule* user, rs_slicing_user* input)
+{
   int slice_id = user_to_slice_[user->GetUserID()];
-  for (int i = 0; i < MAX_BEARERS; ++i) {
-    if (user->m_bearers[i]) {
-      averageRate += user->m_bearers[i]->GetAverageTransmissionRate();
-    }
-  }
-  spectralEfficiency = spectralEfficiency * 180000 / 1000; // set the unit to kbps
-  averageRate /= 1000.0; // set the unit of both params to kbps
-  SchedulerAlgoParam param = slice_algo_params_[slice_id];
-  if (param.alpha == 0) {
-    metric = pow(spectralEfficiency, param.epsilon) / pow(averageRate, param.psi);
-  }
-  else {
-    // the prioritized flow has no packet, set metric to 0
-    if (user->m_dataToTransmit[slice_priority_[slice_id]] == 0) {
-      metric = 0;
-    }
-    else {
-      RadioBearer* bearer = user->m_bearers[slice_priority_[slice_id]];
-      if (param.beta) {
-        double HoL = bearer->GetHeadOfLinePacketDelay();
-        metric = HoL * pow(spectralEfficiency, param.epsilon)
-          / pow(averageRate, param.psi);
-      }
-      else {
-        metric = pow(spectralEfficiency, param.epsilon)
-          / pow(averageRate, param.psi);
-      }
-    }
-  }
-  return metric;
+  int priority = slice_priority_[slice_id];
+  input->slice = slice_id;
+  input->backlog = 0;
+  for (int i = 0; i < MAX_BEARERS; i++) {
+    input->backlog += user->m_dataToTransmit[i];
+  }
+  input->priority_backlog = user->m_dataToTransmit[priority];
+  input->average_rate = user->GetAverageTransmissionRate();
+  input->hol_delay = user->GetHeadOfLinePacketDelay(priority);
+}
+
+int
+DownlinkTransportScheduler::GetSliceOfUser (int userID)
+{
+  if (userID < 0 || userID >= (int)user_to_slice_.size())
+    return -1;
+  return user_to_slice_[userID];
+}
+
+int
+DownlinkTransportScheduler::GetNbSlices (void)
+{
+  return slices_.size();
+}
+
+bool
+DownlinkTransportScheduler::SetSliceWeight (int slice, double weight)
+{
+  if (slice < 0 || slice >= (int)slices_.size() || weight < 0 || weight > 1)
+    return false;
+  slices_[slice].weight = weight;
+  return true;
+}
+
+bool
+DownlinkTransportScheduler::SetSliceAlgoParam (int slice, const SchedulerAlgoParam& param)
+{
+  if (slice < 0 || slice >= (int)slices_.size())
+    return false;
+  slices_[slice].alpha = param.alpha;
+  slices_[slice].beta = param.beta;
+  slices_[slice].epsilon = param.epsilon;
+  slices_[slice].psi = param.psi;
+  return true;
+}
+
+bool
+DownlinkTransportScheduler::SetInterSliceAlgo (int algo)
+{
+  if (algo < RS_SLICING_GREEDY_BY_ROW || algo > RS_SLICING_UPPER_BOUND)
+    return false;
+  inter_sched_ = algo;
+  return true;
+}
+
+bool
+DownlinkTransportScheduler::HasInterSliceAlgo (void)
+{
+  return true;
 }
 
 void
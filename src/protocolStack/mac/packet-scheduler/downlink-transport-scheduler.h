@@ -26,19 +26,22 @@
 #include <vector>
 
 #include "packet-scheduler.h"
+#include "../../../slicing/slicing.h"
 
 class DownlinkTransportScheduler : public PacketScheduler {
  private:
   // below use customizable scheduler params
   int num_slices_ = 1;
   std::vector<int> user_to_slice_;
-  std::vector<double> slice_weights_;
-  std::vector<SchedulerAlgoParam> slice_algo_params_;
+  std::vector<rs_slicing_slice> slices_;
   std::vector<int> slice_priority_;
   std::vector<double> slice_rbs_offset_;
 
   const double beta_ = 0.1;
-  int inter_sched_ = 0;
+  int inter_sched_ = 0;  // rs_slicing_algo
+
+  // built by RBsAllocation, sent to the UEs by DoStopSchedule
+  PdcchMapIdealControlMessage pdcch_map_;
 
  public:
   DownlinkTransportScheduler(std::string config_fname, int algo);
@@ -49,10 +52,24 @@ class DownlinkTransportScheduler : public PacketScheduler {
   virtual void DoSchedule(void);
   virtual void DoStopSchedule(void);
 
+  virtual bool SupportsPhases(void);
+  virtual void PrepareSchedule(void);
+  virtual void AllocateResources(void);
+
   virtual void RBsAllocation();
   virtual double ComputeSchedulingMetric(UserToSchedule* user,
                                          double spectralEfficiency);
+  virtual int GetSliceOfUser(int userID);
+  virtual int GetNbSlices(void);
+  virtual bool SetSliceWeight(int slice, double weight);
+  virtual bool SetSliceAlgoParam(int slice, const SchedulerAlgoParam& param);
+  virtual bool SetInterSliceAlgo(int algo);
+  virtual bool HasInterSliceAlgo(void);
   void UpdateAverageTransmissionRate(void);
+
+ private:
+  // the user as the slicing library sees it
+  void GetSlicingUser(UserToSchedule* user, rs_slicing_user* input);
 };
 
 #endif /* DOWNLINKPACKETSCHEDULER_H_ */
@@ -36,6 +36,8 @@
 #include "../../../flows/MacQueue.h"
 #include "../../../utility/eesm-effective-sinr.h"
 
+#include <algorithm>
+
 EnhancedUplinkPacketScheduler::EnhancedUplinkPacketScheduler()
 {
   SetMacEntity (0);
@@ -67,6 +69,46 @@ EnhancedUplinkPacketScheduler::ComputeSchedulingMetric (UserToSchedule* user, in
   return metric;
 }
 
+void
+EnhancedUplinkPacketScheduler::ComputeSchedulingMetrics (MetricMatrix *metrics)
+{
+  ComputeThroughputMetrics (metrics);
+}
+
+namespace {
+
+/*
+ * A user that has not been allocated yet, with the RB its expansion would
+ * start from: its best RB not allocated yet, or one that has been since it
+ * was pushed. Ordered by metric, then by RB and by user, which is the order
+ * of the search over the whole matrix it replaces.
+ */
+struct SeedCandidate {
+  double metric;
+  int rb;
+  int user;
+};
+
+bool
+IsWorseSeed (const SeedCandidate& a, const SeedCandidate& b)
+{
+  if (a.metric != b.metric) return a.metric < b.metric;
+  if (a.rb != b.rb) return a.rb > b.rb;
+  return a.user > b.user;
+}
+
+// the RBs of one user, by metric then by RB
+struct IsWorseRB {
+  const double *metrics;
+  bool operator() (int a, int b) const
+  {
+    if (metrics[a] != metrics[b]) return metrics[a] < metrics[b];
+    return a > b;
+  }
+};
+
+}
+
 void
 EnhancedUplinkPacketScheduler::RBsAllocation ()
 {
@@ -76,6 +118,13 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 	 * The main difference is that here we have a given number of RB's to allocate to the UE
 	 * based on its pending queue status whereas the original attempts to allocate till another
 	 * UE has a better channel response
+	 *
+	 * The best user-RB pair among the users and RBs left is taken from a heap
+	 * holding, for every user left, the best RB its expansion can start from;
+	 * each user keeps its RBs in a heap of its own, and drops the ones taken
+	 * by the others when it reaches them. The allocation costs
+	 * O(users x RBs) to build the heaps, plus a logarithm per RB dropped, in
+	 * place of a search of the whole matrix per user.
 	 */
 #ifdef SCHEDULER_DEBUG
 	std::cout << " ---- UL RBs Allocation";
@@ -83,61 +132,44 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 
 	UsersToSchedule *users = GetUsersToSchedule ();
 	UserToSchedule* scheduledUser;
+	int nbOfUsers = users->size ();
 	int nbOfRBs = GetMacEntity ()->GetDevice ()->GetPhy ()->GetBandwidthManager ()->GetUlSubChannels ().size ();
+	TtiArena *arena = GetTtiArena ();
 
 	int availableRBs;     // No of RB's not allocated
 	int unallocatedUsers; // No of users who remain unallocated
 	int selectedUser;     // user to be selected for allocation
 	int selectedPRB;      // PRB to be selected for allocation
-	double bestMetric;    // best metric to identify user/RB combination
 	int left, right;      // index of left and left PRB's to check
-	bool Allocated[nbOfRBs];
+	bool *Allocated = arena->NewArray<bool> (nbOfRBs);
 	bool allocationMade;
-	double metrics[nbOfRBs][users->size ()];
-	int requiredPRBs[users->size ()];
+	int *requiredPRBs = arena->NewArray<int> (nbOfUsers);
 
 
 	//Some initialization
 	availableRBs = nbOfRBs;
-	unallocatedUsers = users->size ();
+	unallocatedUsers = nbOfUsers;
 	for(int i=0; i < nbOfRBs; i++)
 		Allocated[i] = false;
 
 	//create a matrix of flow metrics
-	for (int i = 0; i < nbOfRBs; i++)
-	{
-		for (int j = 0; j < users->size (); j++)
-		{
-			metrics[i][j] = ComputeSchedulingMetric (users->at (j), i);
-		}
-	}
+	MetricMatrix metrics = CreateMetricMatrix (nbOfRBs);
+	ComputeSchedulingMetrics (&metrics);
 
 	//create number of required PRB's per scheduled users
-	for(int j=0; j < users->size(); j++)
+	for(int j=0; j < nbOfUsers; j++)
 	{
 		scheduledUser = users->at(j);
 #ifdef SCHEDULER_DEBUG
 		cout << "\n" << "User "  << j; // << "CQI Vector";
 #endif
 
-		std::vector<double> sinrs;
-		for (std::vector<int>::iterator c = scheduledUser->m_channelContition.begin ();
-				c != scheduledUser->m_channelContition.end (); c++)
-		{
-			//cout << *c <<" ";
-			sinrs.push_back (GetMacEntity ()->GetAmcModule ()->GetSinrFromCQI (*c));
-		}
-
-
-		double effectiveSinr =  GetEesmEffectiveSinr (sinrs);
-
-		int mcs = GetMacEntity ()->GetAmcModule ()->GetMCSFromCQI (
-			  GetMacEntity ()->GetAmcModule ()->GetCQIFromSinr (effectiveSinr));
+		int mcs = GetEffectiveMcs (scheduledUser);
 		scheduledUser->m_selectedMCS = mcs;
 		requiredPRBs[j] = (floor) (scheduledUser->m_dataToTransmit /
 				  (GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, 1) / 8));
 #ifdef SCHEDULER_DEBUG
-		cout << " EffSINR = " << effectiveSinr << "  MCS = " << mcs << "\n";
+		cout << "  MCS = " << mcs << "\n";
 #endif
 	}
 
@@ -150,12 +182,40 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 	  for (int jj = 0; jj < nbOfRBs; jj++)
 	    {
 		  //std::cout  << setw(3) << metrics[jj][ii]/1000 << " ";
-		  printf("%3d  ", (int) (metrics[jj][ii]/1000.0));
+		  printf("%3d  ", (int) (metrics.Get (jj, ii)/1000.0));
 	    }
 	  std::cout << std::endl;
     }
 #endif
 
+  // the RBs of every user requesting some, as a heap, and its best one as
+  // a candidate
+  int **userRBs = arena->NewArray<int*> (nbOfUsers);
+  int *nbUserRBs = arena->NewArray<int> (nbOfUsers);
+  SeedCandidate *candidates = arena->NewArray<SeedCandidate> (nbOfUsers);
+  int nbCandidates = 0;
+  for (int j = 0; j < nbOfUsers; j++)
+    {
+      nbUserRBs[j] = 0;
+      if (requiredPRBs[j] <= 0)
+        continue;
+      const double *row = metrics.GetRow (j);
+      userRBs[j] = arena->NewArray<int> (nbOfRBs);
+      for (int i = 0; i < nbOfRBs; i++)
+        {
+          if (row[i] > (double) (-(1<<30)))
+            userRBs[j][nbUserRBs[j]++] = i;
+        }
+      IsWorseRB worse = { row };
+      std::make_heap (userRBs[j], userRBs[j] + nbUserRBs[j], worse);
+      if (nbUserRBs[j] > 0)
+        {
+          SeedCandidate c = { row[userRBs[j][0]], userRBs[j][0], j };
+          candidates[nbCandidates++] = c;
+        }
+    }
+  std::make_heap (candidates, candidates + nbCandidates, IsWorseSeed);
+
   //RBs allocation
 
   while(availableRBs > 0 && unallocatedUsers > 0) //
@@ -163,28 +223,37 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 	  // First step: find the best user-RB combo
 	  selectedPRB = -1;
 	  selectedUser = -1;
-	  bestMetric = (double) (-(1<<30));
 
-	  for(int i=0; i < nbOfRBs; i++)
+	  while (nbCandidates > 0)
 	  {
-		  if (!Allocated[i]){ // check only unallocated PRB's
-			  for(int j=0; j < users->size (); j++)
-			  {
-				  if ( users->at (j)->m_listOfAllocatedRBs.size() == 0
-						  && requiredPRBs[j] > 0) //only unallocated users requesting some RB's
-					  if (bestMetric < metrics[i][j]){
-						  selectedPRB = i;
-						  selectedUser = j;
-						  bestMetric = metrics[i][j];
-					  }
-			  }
-
+		  std::pop_heap (candidates, candidates + nbCandidates, IsWorseSeed);
+		  SeedCandidate c = candidates[--nbCandidates];
+		  if (!Allocated[c.rb])
+		  {
+			  selectedPRB = c.rb;
+			  selectedUser = c.user;
+			  break;
+		  }
+		  // the RB has been taken since: the next best RB of that user
+		  int *rbs = userRBs[c.user];
+		  IsWorseRB worse = { metrics.GetRow (c.user) };
+		  while (nbUserRBs[c.user] > 0 && Allocated[rbs[0]])
+		  {
+			  std::pop_heap (rbs, rbs + nbUserRBs[c.user], worse);
+			  nbUserRBs[c.user]--;
+		  }
+		  if (nbUserRBs[c.user] > 0)
+		  {
+			  SeedCandidate next = { worse.metrics[rbs[0]], rbs[0], c.user };
+			  candidates[nbCandidates++] = next;
+			  std::push_heap (candidates, candidates + nbCandidates, IsWorseSeed);
 		  }
 	  }
 	  // Now start allocating for the selected user at the selected PRB the required blocks
 	  // using how many PRB's are needed for the user
 	  if (selectedUser != -1)
 	  {
+		  const double *userMetrics = metrics.GetRow (selectedUser);
 		  scheduledUser = users->at(selectedUser);
 		  scheduledUser->m_listOfAllocatedRBs.push_back (selectedPRB);
 		  Allocated[selectedPRB] = true;
@@ -203,7 +272,7 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 			  if (    (right < nbOfRBs) && (! Allocated[right]) &&
 					  (
 							  ((left >=0) &&
-							  (metrics[right][selectedUser] >= metrics[left][selectedUser])) // right is better than left
+							  (userMetrics[right] >= userMetrics[left])) // right is better than left
 							  || (left < 0) || Allocated[left]// OR no more left
 					  )
 				)
@@ -217,7 +286,7 @@ EnhancedUplinkPacketScheduler::RBsAllocation ()
 			  } else if ( (left >=0) && (! Allocated[left]) &&
 						  (
 							  ((right < nbOfRBs) &&
-							  (metrics[left][selectedUser] > metrics[right][selectedUser])) //left better than right
+							  (userMetrics[left] > userMetrics[right])) //left better than right
 							  || (right >= nbOfRBs) || Allocated[right]// OR no more right
 						   )
 						)
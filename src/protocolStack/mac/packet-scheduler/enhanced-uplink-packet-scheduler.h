@@ -33,6 +33,7 @@ class EnhancedUplinkPacketScheduler : public UplinkPacketScheduler {
                                          double spectralEfficiency,
                                          int subChannel);
   virtual double ComputeSchedulingMetric(UserToSchedule* user, int subchannel);
+  virtual void ComputeSchedulingMetrics(MetricMatrix* metrics);
 
   virtual void RBsAllocation();
 };
@@ -34,6 +34,8 @@
 #include "../../../core/idealMessages/ideal-control-messages.h"
 #include "../../../flows/QoS/QoSParameters.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 
 ExpRuleDownlinkPacketScheduler::ExpRuleDownlinkPacketScheduler()
 {
@@ -49,10 +51,11 @@ ExpRuleDownlinkPacketScheduler::~ExpRuleDownlinkPacketScheduler()
 
 
 void
-ExpRuleDownlinkPacketScheduler::DoSchedule ()
+ExpRuleDownlinkPacketScheduler::PrepareSchedule ()
 {
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start EXP RULE packet scheduler for node "
+	OutputCapture::Out () << "Start EXP RULE packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
@@ -60,15 +63,6 @@ ExpRuleDownlinkPacketScheduler::DoSchedule ()
   CheckForDLDropPackets ();
   SelectFlowsToSchedule ();
   ComputeAverageOfHOLDelays ();
-
-  if (GetFlowsToSchedule ()->size() == 0)
-	{}
-  else
-	{
-	  RBsAllocation ();
-	}
-
-  StopSchedule ();
 }
 
 
@@ -106,7 +100,7 @@ double
 ExpRuleDownlinkPacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double spectralEfficiency, int subChannel)
 {
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t ComputeSchedulingMetric for flow "
+	OutputCapture::Out () << "\t ComputeSchedulingMetric for flow "
 			<< bearer->GetApplication ()->GetApplicationID () << std::endl;
 #endif
 
@@ -121,7 +115,7 @@ ExpRuleDownlinkPacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, do
 				bearer->GetAverageTransmissionRate();
 
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t\t non real time flow: metric = " << metric << std::endl;
+	OutputCapture::Out () << "\t\t non real time flow: metric = " << metric << std::endl;
 #endif
 
 	}
@@ -141,7 +135,7 @@ ExpRuleDownlinkPacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, do
 	  metric = (exp (numerator / denominator)) * weight;
 
 #ifdef SCHEDULER_DEBUG
-	  std::cout << "\t\t real time flow: "
+	  OutputCapture::Out () << "\t\t real time flow: "
 			  "\n\t\t\t HOL = " << HOL <<
 			  "\n\t\t\t target delay = " << targetDelay <<
 			  "\n\t\t\t m_avgHOLDelayes = " << m_avgHOLDelayes <<
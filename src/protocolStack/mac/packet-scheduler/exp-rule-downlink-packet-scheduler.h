@@ -29,7 +29,7 @@ class ExpRuleDownlinkPacketScheduler : public DownlinkPacketScheduler {
   ExpRuleDownlinkPacketScheduler();
   virtual ~ExpRuleDownlinkPacketScheduler();
 
-  virtual void DoSchedule(void);
+  virtual void PrepareSchedule(void);
 
   void ComputeAverageOfHOLDelays(void);
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
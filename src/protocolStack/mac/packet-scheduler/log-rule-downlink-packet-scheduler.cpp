@@ -34,6 +34,8 @@
 #include "../../../core/idealMessages/ideal-control-messages.h"
 #include "../../../flows/QoS/QoSParameters.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/phase-profiler.h"
+#include "../../../utility/output-capture.h"
 
 LogRuleDownlinkPacketScheduler::LogRuleDownlinkPacketScheduler()
 {
@@ -47,10 +49,11 @@ LogRuleDownlinkPacketScheduler::~LogRuleDownlinkPacketScheduler()
 }
 
 void
-LogRuleDownlinkPacketScheduler::DoSchedule ()
+LogRuleDownlinkPacketScheduler::PrepareSchedule ()
 {
+  PROFILE_PHASE (PHASE_SCHED_PREPARE);
 #ifdef SCHEDULER_DEBUG
-	std::cout << "Start LOG RULE packet scheduler for node "
+	OutputCapture::Out () << "Start LOG RULE packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
 #endif
 
@@ -59,15 +62,6 @@ LogRuleDownlinkPacketScheduler::DoSchedule ()
   CheckForDLDropPackets ();
 
   SelectFlowsToSchedule ();
-
-  if (GetFlowsToSchedule ()->size() == 0)
-	{}
-  else
-	{
-	  RBsAllocation ();
-	}
-
-  StopSchedule ();
 }
 
 
@@ -29,7 +29,7 @@ class LogRuleDownlinkPacketScheduler : public DownlinkPacketScheduler {
   LogRuleDownlinkPacketScheduler();
   virtual ~LogRuleDownlinkPacketScheduler();
 
-  virtual void DoSchedule(void);
+  virtual void PrepareSchedule(void);
 
   virtual double ComputeSchedulingMetric(RadioBearer *bearer,
                                          double spectralEfficiency,
@@ -65,3 +65,9 @@ MaximumThroughputUplinkPacketScheduler::ComputeSchedulingMetric (UserToSchedule*
 
   return metric;
 }
+
+void
+MaximumThroughputUplinkPacketScheduler::ComputeSchedulingMetrics (MetricMatrix *metrics)
+{
+  ComputeThroughputMetrics (metrics);
+}
@@ -33,6 +33,7 @@ class MaximumThroughputUplinkPacketScheduler : public UplinkPacketScheduler {
                                          double spectralEfficiency,
                                          int subChannel);
   virtual double ComputeSchedulingMetric(UserToSchedule* user, int subchannel);
+  virtual void ComputeSchedulingMetrics(MetricMatrix* metrics);
 };
 
 #endif /* MT_UPLINK_PACKET_SCHEDULER_H_ */
@@ -34,6 +34,7 @@
 #include "../../../core/idealMessages/ideal-control-messages.h"
 #include "../../../flows/QoS/QoSParameters.h"
 #include "../../../flows/MacQueue.h"
+#include "../../../utility/output-capture.h"
 
 MwRulePacketScheduler::MwRulePacketScheduler()
 {
@@ -51,7 +52,7 @@ double
 MwRulePacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double spectralEfficiency, int subChannel)
 {
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t ComputeSchedulingMetric for flow "
+	OutputCapture::Out () << "\t ComputeSchedulingMetric for flow "
 			<< bearer->GetApplication ()->GetApplicationID () << std::endl;
 #endif
 
@@ -66,7 +67,7 @@ MwRulePacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double spec
 				bearer->GetAverageTransmissionRate();
 
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t\t non real time flow: metric = " << metric << std::endl;
+	OutputCapture::Out () << "\t\t non real time flow: metric = " << metric << std::endl;
 #endif
 
 	}
@@ -77,7 +78,7 @@ MwRulePacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double spec
 	  double targetDelay = qos->GetMaxDelay ();
 
 #ifdef SCHEDULER_DEBUG
-	  std::cout << "\t\t real time flow: HOL = " << HOL << ", target delay = " << targetDelay;
+	  OutputCapture::Out () << "\t\t real time flow: HOL = " << HOL << ", target delay = " << targetDelay;
 #endif
 
 	  //compute sum of HOL and average spectral efficiency
@@ -132,7 +133,7 @@ MwRulePacketScheduler::ComputeSchedulingMetric (RadioBearer *bearer, double spec
 	  metric = (exp (numerator / denominator)) * weight;
 
 #ifdef SCHEDULER_DEBUG
-	  std::cout << " --> metric = " << metric << std::endl;
+	  OutputCapture::Out () << " --> metric = " << metric << std::endl;
 #endif
 	}
 
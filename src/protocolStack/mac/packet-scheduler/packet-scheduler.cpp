@@ -25,6 +25,9 @@
 #include "../../packet/Packet.h"
 #include "../../packet/packet-burst.h"
 #include "../../../device/NetworkNode.h"
+#include "../../../device/ENodeB.h"
+#include "../../../phy/lte-phy.h"
+#include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../flows/radio-bearer.h"
 #include "../../../protocolStack/rrc/rrc-entity.h"
 #include "../../../protocolStack/mac/AMCModule.h"
@@ -33,6 +36,9 @@
 #include "../../../flows/QoS/QoSParameters.h"
 #include "../../rlc/am-rlc-entity.h"
 #include "../../../utility/eesm-effective-sinr.h"
+#include "../../../utility/phase-profiler.h"
+#include "scheduler-input-trace.h"
+#include "../../../utility/output-capture.h"
 #include <cassert>
 
 PacketScheduler::PacketScheduler()
@@ -40,6 +46,9 @@ PacketScheduler::PacketScheduler()
   m_mac = NULL;
   m_flowsToSchedule = NULL;
   m_ts = 0;
+  m_replayedInputs = NULL;
+  m_inputsRead = false;
+  m_inputsCounter = 0;
 }
 
 PacketScheduler::~PacketScheduler()
@@ -61,6 +70,11 @@ void
 PacketScheduler::SetMacEntity (MacEntity* mac)
 {
   m_mac = mac;
+  if (mac != NULL && mac->GetDevice () != NULL)
+    {
+      m_rng = CounterRng (mac->GetDevice ()->GetIDNetworkNode (),
+                          RNG_PURPOSE_SCHEDULER);
+    }
 }
 
 MacEntity*
@@ -79,9 +93,34 @@ void
 PacketScheduler::DoSchedule (void)
 {}
 
+bool
+PacketScheduler::SupportsPhases (void)
+{
+  return false;
+}
+
+void
+PacketScheduler::PrepareSchedule (void)
+{}
+
+void
+PacketScheduler::AllocateResources (void)
+{}
+
+CounterRng&
+PacketScheduler::GetRandomStream (void)
+{
+  return m_rng;
+}
+
 void
 PacketScheduler::StopSchedule ()
 {
+  PROFILE_PHASE (PHASE_SCHED_STOP);
+  if (m_inputsRead)
+    {
+      RecordInputs ();
+    }
   DoStopSchedule ();
 }
 
@@ -89,12 +128,17 @@ void
 PacketScheduler::DoStopSchedule ()
 {}
 
-PacketScheduler::FlowToSchedule::FlowToSchedule(RadioBearer* bearer, int dataToTransmit)
+PacketScheduler::FlowToSchedule::FlowToSchedule(RadioBearer* bearer, int dataToTransmit, TtiArena* arena)
+  : m_spectralEfficiency (TtiAllocator<double> (arena)),
+    m_listOfAllocatedRBs (TtiAllocator<int> (arena)),
+    m_listOfSelectedMCS (TtiAllocator<int> (arena)),
+    m_cqiFeedbacks (TtiAllocator<int> (arena))
 {
   m_bearer = bearer;
   m_allocatedBits = 0;
   m_transmittedData = 0;
   m_dataToTransmit = dataToTransmit;
+  m_wideBandCQI = 0;
 }
 
 PacketScheduler::FlowToSchedule::~FlowToSchedule()
@@ -130,10 +174,11 @@ PacketScheduler::ClearFlowsToSchedule ()
 
   for (iter = records->begin(); iter != records->end (); iter++)
   {
-    delete *iter;
+    (*iter)->~FlowToSchedule ();
   }
 
   GetFlowsToSchedule ()->clear ();
+  m_ttiArena.Reset ();
 }
 
 RadioBearer*
@@ -142,13 +187,7 @@ PacketScheduler::FlowToSchedule::GetBearer (void)
   return m_bearer;
 }
 
-void
-PacketScheduler::FlowToSchedule::SetSpectralEfficiency (std::vector<double>& s)
-{
-  m_spectralEfficiency = s;
-}
-
-std::vector<double>
+TtiVector<double>&
 PacketScheduler::FlowToSchedule::GetSpectralEfficiency (void)
 {
   return m_spectralEfficiency;
@@ -207,40 +246,47 @@ PacketScheduler::FlowToSchedule::GetDataToTransmit (void) const
   return m_dataToTransmit;
 }
 
-std::vector<int>*
+TtiVector<int>*
 PacketScheduler::FlowToSchedule::GetListOfAllocatedRBs ()
 {
   return &m_listOfAllocatedRBs;
 }
 
-std::vector<int>*
+TtiVector<int>*
 PacketScheduler::FlowToSchedule::GetListOfSelectedMCS ()
 {
   return &m_listOfSelectedMCS;
 }
 
 void
-PacketScheduler::FlowToSchedule::SetCqiFeedbacks (std::vector<int>& cqiFeedbacks)
+PacketScheduler::FlowToSchedule::SetCqiFeedbacks (const std::vector<int>& cqiFeedbacks, AMCModule* amc)
 {
-  m_cqiFeedbacks = cqiFeedbacks;
+  m_cqiFeedbacks.assign (cqiFeedbacks.begin (), cqiFeedbacks.end ());
+  m_spectralEfficiency.resize (cqiFeedbacks.size ());
+  for (size_t i = 0; i < cqiFeedbacks.size (); i++)
+    {
+      m_spectralEfficiency[i] = amc->GetEfficiencyFromCQI (cqiFeedbacks[i]);
+    }
+  // at most every RB once
+  m_listOfAllocatedRBs.reserve (cqiFeedbacks.size ());
 }
 
-std::vector<int>
+TtiVector<int>&
 PacketScheduler::FlowToSchedule::GetCqiFeedbacks (void)
 {
   return m_cqiFeedbacks;
 }
 
 void
-PacketScheduler::InsertFlowToSchedule (RadioBearer* bearer, int dataToTransmit, std::vector<double> specEff, std::vector<int> cqiFeedbacks)
+PacketScheduler::InsertFlowToSchedule (RadioBearer* bearer, int dataToTransmit, const std::vector<int>& cqiFeedbacks)
 {
-  FlowToSchedule *flowToSchedule = new FlowToSchedule(bearer, dataToTransmit);
-  flowToSchedule->SetSpectralEfficiency (specEff);
-  flowToSchedule->SetCqiFeedbacks (cqiFeedbacks);
+  AMCModule *amc = GetMacEntity()->GetAmcModule();
+  FlowToSchedule *flowToSchedule = m_ttiArena.New<FlowToSchedule>(bearer, dataToTransmit, &m_ttiArena);
+  flowToSchedule->SetCqiFeedbacks (cqiFeedbacks, amc);
 
-  std::vector<double> sinrs;
+  TtiVector<double> sinrs(&m_ttiArena);
 	int numberOfCqi = cqiFeedbacks.size ();
-  AMCModule *amc = GetMacEntity()->GetAmcModule();
+  sinrs.reserve(numberOfCqi);
 	for (int i = 0; i < numberOfCqi; i++)
 	{
     sinrs.push_back(amc->GetSinrFromCQI(cqiFeedbacks.at(i)));
@@ -249,7 +295,7 @@ PacketScheduler::InsertFlowToSchedule (RadioBearer* bearer, int dataToTransmit,
   flowToSchedule->SetWidebandCQI(amc->GetCQIFromSinr(wideSINR));
 
 #ifdef SCHEDULER_DEBUG
-	std::cout << "\t  --> selected flow: "
+	OutputCapture::Out () << "\t  --> selected flow: "
 			<< bearer->GetApplication ()->GetApplicationID ()
 			<< " data:" << dataToTransmit
       << " sinr:" << wideSINR << std::endl;
@@ -300,26 +346,34 @@ PacketScheduler::GetTimeStamp()
   return m_ts;
 }
 
-// dataToTransmit is in unit of bytes
 void
-PacketScheduler::InsertFlowToUser (RadioBearer* bearer, int dataToTransmit, std::vector<double> specEff, std::vector<int> cqiFeedbacks)
+PacketScheduler::SetTimeStamp(unsigned long ts)
 {
-  int userID = bearer->GetUserID();
-  int bearer_priority = bearer->GetPriority();
+  m_ts = ts;
+}
+
+void
+PacketScheduler::InsertFlowToUser (const BearerInput& input)
+{
+  int userID = input.m_userID;
+  int bearer_priority = input.m_priority;
+  int dataToTransmit = input.m_dataToTransmit;
+  const std::vector<int>& cqiFeedbacks = *input.m_cqi;
 
   for (auto it = m_usersToSchedule->begin(); it != m_usersToSchedule->end(); ++it) {
     if ((*it)->GetUserID() == userID) {
-      (*it)->m_bearers[bearer_priority] = bearer;
+      (*it)->m_bearers[bearer_priority] = input.m_bearer;
+      (*it)->m_inputs[bearer_priority] = &input;
       (*it)->m_dataToTransmit[bearer_priority] = dataToTransmit;
       return;
     }
   }
-  UserToSchedule* user = new UserToSchedule(userID, bearer->GetDestination());
-  user->SetSpectralEfficiency(specEff);
-  user->SetCqiFeedbacks(cqiFeedbacks);
-  
-  std::vector<double> sinrs;
   AMCModule *amc = GetMacEntity()->GetAmcModule();
+  UserToSchedule* user = m_ttiArena.New<UserToSchedule>(userID, input.m_userNode, &m_ttiArena);
+  user->SetCqiFeedbacks(cqiFeedbacks, amc);
+
+  TtiVector<double> sinrs(&m_ttiArena);
+  sinrs.reserve(cqiFeedbacks.size());
 	for (int i = 0; i < cqiFeedbacks.size(); i++)
 	{
     sinrs.push_back(amc->GetSinrFromCQI(cqiFeedbacks.at(i)));
@@ -327,8 +381,9 @@ PacketScheduler::InsertFlowToUser (RadioBearer* bearer, int dataToTransmit, std:
   int wideCQI = amc->GetCQIFromSinr(GetEesmEffectiveSinr(sinrs));
   user->SetWidebandCQI(wideCQI);
 
-  assert(user->m_bearers[bearer_priority] == NULL);
-  user->m_bearers[bearer_priority] = bearer;
+  assert(user->m_inputs[bearer_priority] == NULL);
+  user->m_bearers[bearer_priority] = input.m_bearer;
+  user->m_inputs[bearer_priority] = &input;
   user->m_dataToTransmit[bearer_priority] = dataToTransmit;
   m_usersToSchedule->push_back(user);
   user->m_requiredRBs += (dataToTransmit * 8 / amc->GetTBSizeFromMCS(amc->GetMCSFromCQI(wideCQI))); 
@@ -351,9 +406,115 @@ void
 PacketScheduler::ClearUsersToSchedule()
 {
   for (auto it = m_usersToSchedule->begin(); it != m_usersToSchedule->end(); ++it) {
-    delete *it;
+    (*it)->~UserToSchedule();
   }
   m_usersToSchedule->clear();
+  m_ttiArena.Reset();
+}
+
+TtiArena*
+PacketScheduler::GetTtiArena (void)
+{
+  return &m_ttiArena;
+}
+
+const PacketScheduler::BearerInputs&
+PacketScheduler::ReadBearerInputs (void)
+{
+  m_inputsRead = true;
+  m_inputsCounter = m_rng.GetCounter ();
+  if (m_replayedInputs != NULL)
+    {
+      return *m_replayedInputs;
+    }
+
+  m_bearerInputs.clear ();
+  RrcEntity *rrc = GetMacEntity ()->GetDevice ()->GetProtocolStack ()->GetRrcEntity ();
+  RrcEntity::RadioBearersContainer* bearers = rrc->GetRadioBearerContainer ();
+  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
+  for (std::vector<RadioBearer* >::iterator it = bearers->begin (); it != bearers->end (); it++)
+    {
+      RadioBearer *bearer = (*it);
+      if (!bearer->HasPackets () || bearer->GetDestination ()->GetNodeState () != NetworkNode::STATE_ACTIVE)
+        {
+          continue;
+        }
+      BearerInput input;
+      input.m_userID = bearer->GetUserID ();
+      input.m_priority = bearer->GetPriority ();
+      if (bearer->GetApplication ()->GetApplicationType () == Application::APPLICATION_TYPE_INFINITE_BUFFER)
+        {
+          input.m_dataToTransmit = 100000000;
+        }
+      else
+        {
+          input.m_dataToTransmit = bearer->GetQueueSize ();
+        }
+      input.m_averageRate = bearer->GetAverageTransmissionRate ();
+      input.m_headOfLineDelay = bearer->GetHeadOfLinePacketDelay ();
+      input.m_cqi = &enb->GetUserEquipmentRecord (bearer->GetDestination ()->GetIDNetworkNode ())->GetCQI ();
+      input.m_bearer = bearer;
+      input.m_userNode = bearer->GetDestination ();
+      m_bearerInputs.push_back (input);
+    }
+  return m_bearerInputs;
+}
+
+void
+PacketScheduler::SetReplayedInputs (const BearerInputs* inputs)
+{
+  m_replayedInputs = inputs;
+}
+
+int
+PacketScheduler::GetSliceOfUser (int userID)
+{
+  return -1;
+}
+
+int
+PacketScheduler::GetNbSlices (void)
+{
+  return 0;
+}
+
+bool
+PacketScheduler::SetSliceWeight (int slice, double weight)
+{
+  return false;
+}
+
+bool
+PacketScheduler::SetSliceAlgoParam (int slice, const SchedulerAlgoParam& param)
+{
+  return false;
+}
+
+bool
+PacketScheduler::SetInterSliceAlgo (int algo)
+{
+  return false;
+}
+
+bool
+PacketScheduler::HasInterSliceAlgo (void)
+{
+  return false;
+}
+
+void
+PacketScheduler::RecordInputs (void)
+{
+  m_inputsRead = false;
+  SchedulerInputTrace *trace = SchedulerInputTrace::Init ();
+  if (!trace->IsRecording () || m_replayedInputs != NULL)
+    {
+      return;
+    }
+  ENodeB *enb = (ENodeB*) GetMacEntity ()->GetDevice ();
+  int nbRBs = enb->GetPhy ()->GetBandwidthManager ()->GetDlSubChannels ().size ();
+  trace->Write (this, enb->GetIDNetworkNode (), nbRBs, enb->GetDLSchedulerConfig (),
+                m_inputsCounter, m_bearerInputs);
 }
 
 PacketScheduler::UsersToSchedule*
@@ -362,7 +523,10 @@ PacketScheduler::GetUsersToSchedule (void) const
   return m_usersToSchedule;
 }
 
-PacketScheduler::UserToSchedule::UserToSchedule(int id, NetworkNode* node)
+PacketScheduler::UserToSchedule::UserToSchedule(int id, NetworkNode* node, TtiArena* arena)
+  : m_spectralEfficiency (TtiAllocator<double> (arena)),
+    m_listOfAllocatedRBs (TtiAllocator<int> (arena)),
+    m_cqiFeedbacks (TtiAllocator<int> (arena))
 {
   m_userID = id;
   m_userNode = node;
@@ -371,6 +535,7 @@ PacketScheduler::UserToSchedule::UserToSchedule(int id, NetworkNode* node)
   m_requiredRBs = 0;
   for (int i = 0; i < MAX_BEARERS; ++i) {
     m_bearers[i] = NULL;
+    m_inputs[i] = NULL;
     m_dataToTransmit[i] = 0;
   }
 }
@@ -378,25 +543,26 @@ PacketScheduler::UserToSchedule::UserToSchedule(int id, NetworkNode* node)
 PacketScheduler::UserToSchedule::~UserToSchedule()
 {}
 
-void
-PacketScheduler::UserToSchedule::SetSpectralEfficiency (std::vector<double>& s)
-{
-  m_spectralEfficiency = s;
-}
-
-std::vector<double>&
+TtiVector<double>&
 PacketScheduler::UserToSchedule::GetSpectralEfficiency (void)
 {
   return m_spectralEfficiency;
 }
 
 void
-PacketScheduler::UserToSchedule::SetCqiFeedbacks (std::vector<int>& cqiFeedbacks)
+PacketScheduler::UserToSchedule::SetCqiFeedbacks (const std::vector<int>& cqiFeedbacks, AMCModule* amc)
 {
-  m_cqiFeedbacks = cqiFeedbacks;
+  m_cqiFeedbacks.assign (cqiFeedbacks.begin (), cqiFeedbacks.end ());
+  m_spectralEfficiency.resize (cqiFeedbacks.size ());
+  for (size_t i = 0; i < cqiFeedbacks.size (); i++)
+    {
+      m_spectralEfficiency[i] = amc->GetEfficiencyFromCQI (cqiFeedbacks[i]);
+    }
+  // at most every RB once
+  m_listOfAllocatedRBs.reserve (cqiFeedbacks.size ());
 }
 
-std::vector<int>&
+TtiVector<int>&
 PacketScheduler::UserToSchedule::GetCqiFeedbacks (void)
 {
   return m_cqiFeedbacks;
@@ -414,7 +580,7 @@ PacketScheduler::UserToSchedule::GetWidebandCQI()
   return m_wideBandCQI;
 }
 
-std::vector<int>*
+TtiVector<int>*
 PacketScheduler::UserToSchedule::GetListOfAllocatedRBs ()
 {
   return &m_listOfAllocatedRBs;
@@ -425,13 +591,19 @@ PacketScheduler::UserToSchedule::GetAverageTransmissionRate()
 {
   double sum_rate = 1;
   for (int i = 0; i < MAX_BEARERS; i++) {
-    if (m_bearers[i]) {
-      sum_rate += m_bearers[i]->GetAverageTransmissionRate();
+    if (m_inputs[i]) {
+      sum_rate += m_inputs[i]->m_averageRate;
     }
   }
   return sum_rate;
 }
 
+double
+PacketScheduler::UserToSchedule::GetHeadOfLinePacketDelay(int priority)
+{
+  return m_inputs[priority] ? m_inputs[priority]->m_headOfLineDelay : 0;
+}
+
 void
 PacketScheduler::UserToSchedule::UpdateAllocatedBits (int allocatedBits)
 {
@@ -27,13 +27,17 @@
 #include <vector>
 
 #include "../../../core/idealMessages/ideal-control-messages.h"
+#include "../../../utility/counter-rng.h"
+#include "../../../utility/tti-arena.h"
 
 const int MAX_BEARERS = 2;
 
 class MacEntity;
+class NetworkNode;
 class PacketBurst;
 class Packet;
 class RadioBearer;
+class AMCModule;
 
 struct SchedulerAlgoParam {
   int alpha;
@@ -50,18 +54,37 @@ struct SchedulerAlgoParam {
 
 class PacketScheduler {
  public:
+  /*
+   * A bearer of the cell with data for an active user, as the DL schedulers
+   * read it in a TTI. They select and allocate from these only, so the same
+   * TTI can be replayed to a scheduler out of the simulation (see
+   * SchedulerInputTrace), with no bearer nor user node behind the inputs.
+   */
+  struct BearerInput {
+    int m_userID;
+    int m_priority;
+    int m_dataToTransmit;           // bytes
+    double m_averageRate;           // bps
+    double m_headOfLineDelay;       // s
+    const std::vector<int>* m_cqi;  // of the user, one per RB
+    RadioBearer* m_bearer;          // NULL when replayed
+    NetworkNode* m_userNode;        // NULL when replayed
+  };
+  typedef std::vector<BearerInput> BearerInputs;
+
+  // lives in the TTI arena of the scheduler, until ClearFlowsToSchedule
   struct FlowToSchedule {
-    FlowToSchedule(RadioBearer* bearer, int dataToTransmit);
+    FlowToSchedule(RadioBearer* bearer, int dataToTransmit, TtiArena* arena);
     virtual ~FlowToSchedule();
     RadioBearer* m_bearer;
     int m_allocatedBits;    // bits
     int m_transmittedData;  // bytes
     int m_dataToTransmit;   // bytes
 
-    std::vector<double> m_spectralEfficiency;
-    std::vector<int> m_listOfAllocatedRBs;
-    std::vector<int> m_listOfSelectedMCS;
-    std::vector<int> m_cqiFeedbacks;
+    TtiVector<double> m_spectralEfficiency;
+    TtiVector<int> m_listOfAllocatedRBs;
+    TtiVector<int> m_listOfSelectedMCS;
+    TtiVector<int> m_cqiFeedbacks;
     int m_wideBandCQI;
 
     RadioBearer* GetBearer(void);
@@ -72,19 +95,20 @@ class PacketScheduler {
     void SetDataToTransmit(int dataToTransmit);
     int GetDataToTransmit(void) const;
 
-    void SetSpectralEfficiency(std::vector<double>& s);
-    std::vector<double> GetSpectralEfficiency(void);
+    TtiVector<double>& GetSpectralEfficiency(void);
 
     void SetWidebandCQI(int);
     int GetWidebandCQI(void);
 
-    std::vector<int>* GetListOfAllocatedRBs();
-    std::vector<int>* GetListOfSelectedMCS();
+    TtiVector<int>* GetListOfAllocatedRBs();
+    TtiVector<int>* GetListOfSelectedMCS();
 
-    void SetCqiFeedbacks(std::vector<int>& cqiFeedbacks);
-    std::vector<int> GetCqiFeedbacks(void);
+    // also sets the spectral efficiency of every RB
+    void SetCqiFeedbacks(const std::vector<int>& cqiFeedbacks, AMCModule* amc);
+    TtiVector<int>& GetCqiFeedbacks(void);
   };
 
+  // lives in the TTI arena of the scheduler, until ClearUsersToSchedule
   struct UserToSchedule {
    private:
     int m_userID;
@@ -92,16 +116,17 @@ class PacketScheduler {
     int m_allocatedBits;
 
     // spectralEfficiency is transmission rate per HZ(bps/HZ)
-    std::vector<double> m_spectralEfficiency;
-    std::vector<int> m_listOfAllocatedRBs;
+    TtiVector<double> m_spectralEfficiency;
+    TtiVector<int> m_listOfAllocatedRBs;
     int m_wideBandCQI;
-    std::vector<int> m_cqiFeedbacks;
+    TtiVector<int> m_cqiFeedbacks;
 
    public:
     RadioBearer* m_bearers[MAX_BEARERS];
+    const BearerInput* m_inputs[MAX_BEARERS];
     int m_dataToTransmit[MAX_BEARERS];
     int m_requiredRBs;
-    UserToSchedule(int, NetworkNode*);
+    UserToSchedule(int, NetworkNode*, TtiArena* arena);
     virtual ~UserToSchedule();
 
     int GetUserID(void) { return m_userID; }
@@ -110,16 +135,18 @@ class PacketScheduler {
     int GetAllocatedBits(void);
     std::vector<RadioBearer*> GetBearers(void);
 
-    void SetSpectralEfficiency(std::vector<double>& s);
-    std::vector<double>& GetSpectralEfficiency(void);
+    TtiVector<double>& GetSpectralEfficiency(void);
     void SetWidebandCQI(int);
     int GetWidebandCQI(void);
     int GetRequiredRBs(void);
-    void SetCqiFeedbacks(std::vector<int>& cqiFeedbacks);
-    std::vector<int>& GetCqiFeedbacks(void);
+    // also sets the spectral efficiency of every RB
+    void SetCqiFeedbacks(const std::vector<int>& cqiFeedbacks, AMCModule* amc);
+    TtiVector<int>& GetCqiFeedbacks(void);
 
-    std::vector<int>* GetListOfAllocatedRBs();
+    TtiVector<int>* GetListOfAllocatedRBs();
     double GetAverageTransmissionRate();
+    // of the flow with the given priority, 0 without one
+    double GetHeadOfLinePacketDelay(int priority);
   };
 
   PacketScheduler();
@@ -136,9 +163,24 @@ class PacketScheduler {
   void StopSchedule();
   virtual void DoStopSchedule();
 
+  /*
+   * Schedule () split in phases, for the parallel TTI of the FrameManager.
+   * PrepareSchedule and AllocateResources may run concurrently with the
+   * schedulers of other cells: they must only touch the state of this cell,
+   * draw from GetRandomStream (), print through OutputCapture::Out () and
+   * Err () and never schedule events. StopSchedule
+   * then runs in cell order. Schedulers that do not implement the split
+   * keep SupportsPhases () false and run Schedule () whole, in cell order.
+   */
+  virtual bool SupportsPhases(void);
+  virtual void PrepareSchedule(void);
+  virtual void AllocateResources(void);
+
+  // random numbers private to this scheduler, keyed by the node ID
+  CounterRng& GetRandomStream(void);
+
   void InsertFlowToSchedule(RadioBearer* bearer, int dataToTransmit,
-                            std::vector<double> specEff,
-                            std::vector<int> cqiFeedbacks);
+                            const std::vector<int>& cqiFeedbacks);
 
   void UpdateAllocatedBits(FlowToSchedule* scheduledFlow, int allocatedBits,
                            int allocatedRB, int selectedMCS);
@@ -148,29 +190,65 @@ class PacketScheduler {
   void UpdateTimeStamp();
 
   unsigned long GetTimeStamp();
+  // continues the TTI count of a scheduler this one replaces
+  void SetTimeStamp(unsigned long ts);
 
   typedef std::vector<FlowToSchedule*> FlowsToSchedule;
   void CreateFlowsToSchedule(void);
   void DeleteFlowsToSchedule(void);
+  // drops the flows of the last TTI and resets the TTI arena
   void ClearFlowsToSchedule();
   FlowsToSchedule* GetFlowsToSchedule(void) const;
 
   // user-aware scheduling
   // typedef std::unordered_map<int, UserToSchedule*> UsersToSchedule;
   typedef std::vector<UserToSchedule*> UsersToSchedule;
-  void InsertFlowToUser(RadioBearer* bearer, int dataToTransmit,
-                        std::vector<double> specEff,
-                        std::vector<int> TestCqiFeedbacks);
+  void InsertFlowToUser(const BearerInput& input);
   void CreateUsersToSchedule(void);
   void DeleteUsersToSchedule(void);
+  // drops the users of the last TTI and resets the TTI arena
   void ClearUsersToSchedule();
   UsersToSchedule* GetUsersToSchedule(void) const;
 
+  /*
+   * The working set of the current TTI: the users or flows to schedule and
+   * the temporaries of the allocation. Everything in it is dropped at once
+   * when the next TTI starts (ClearUsersToSchedule, ClearFlowsToSchedule).
+   */
+  TtiArena* GetTtiArena(void);
+
+  /*
+   * The inputs of this TTI, read from the bearers of the cell, or the ones
+   * set by SetReplayedInputs. Read once per TTI, when the flows to schedule
+   * are selected: StopSchedule records them when capturing.
+   */
+  const BearerInputs& ReadBearerInputs(void);
+  // NULL goes back to the bearers of the cell
+  void SetReplayedInputs(const BearerInputs* inputs);
+  // -1 for the schedulers that do not slice the cell
+  virtual int GetSliceOfUser(int userID);
+  // 0 for the schedulers that do not slice the cell
+  virtual int GetNbSlices(void);
+  // the inter-slice policy, changed between two TTIs (RealTimeManager);
+  // false when the scheduler has no such slice or setting
+  virtual bool SetSliceWeight(int slice, double weight);
+  virtual bool SetSliceAlgoParam(int slice, const SchedulerAlgoParam& param);
+  virtual bool SetInterSliceAlgo(int algo);  // rs_slicing_algo
+  virtual bool HasInterSliceAlgo(void);
+
  private:
+  void RecordInputs(void);
+
   MacEntity* m_mac;
   FlowsToSchedule* m_flowsToSchedule;
   UsersToSchedule* m_usersToSchedule;
   unsigned long m_ts;
+  CounterRng m_rng;
+  TtiArena m_ttiArena;
+  BearerInputs m_bearerInputs;
+  const BearerInputs* m_replayedInputs;
+  bool m_inputsRead;  // in this TTI, not recorded yet
+  uint64_t m_inputsCounter;  // of the random stream, when they were read
 };
 
 #endif /* PACKETSCHEDULER_H_ */
@@ -0,0 +1,219 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "scheduler-input-trace.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../../../core/eventScheduler/simulator.h"
+
+#define SCHEDULER_INPUT_TRACE_MAGIC 0x4e495352  // "RSIN"
+#define SCHEDULER_INPUT_TRACE_VERSION 1
+
+SchedulerInputTrace* SchedulerInputTrace::ptr = NULL;
+
+SchedulerInputTrace::SchedulerInputTrace() : m_fp(NULL), m_headerWritten(false) {}
+
+SchedulerInputTrace::~SchedulerInputTrace() { Close(); }
+
+bool SchedulerInputTrace::Open(const std::string& fname) {
+  Close();
+  m_fp = fopen(fname.c_str(), "wb");
+  if (m_fp == NULL) return false;
+  m_fname = fname;
+  m_headerWritten = false;
+  // the scenarios return from main without deleting the singletons
+  static bool registered = false;
+  if (!registered) {
+    atexit(CloseAtExit);
+    registered = true;
+  }
+  return true;
+}
+
+void SchedulerInputTrace::Close(void) {
+  for (size_t i = 0; i < m_temporaryFiles.size(); i++) {
+    unlink(m_temporaryFiles[i].c_str());
+  }
+  m_temporaryFiles.clear();
+  if (m_fp == NULL) return;
+  if (fclose(m_fp) != 0) {
+    std::cerr << "ERROR: unable to write the scheduler inputs to " << m_fname
+              << std::endl;
+  }
+  m_fp = NULL;
+}
+
+void SchedulerInputTrace::AddTemporaryFile(const std::string& fname) {
+  m_temporaryFiles.push_back(fname);
+}
+
+void SchedulerInputTrace::CloseAtExit(void) {
+  if (ptr != NULL) ptr->Close();
+}
+
+void SchedulerInputTrace::Write(PacketScheduler* scheduler, int enbID, int nbRBs,
+                                const std::string& config, uint64_t counter,
+                                const PacketScheduler::BearerInputs& inputs) {
+  m_userIndex.clear();
+  m_users.clear();
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (m_userIndex.emplace(inputs[i].m_userID, (int)m_users.size()).second) {
+      m_users.push_back(&inputs[i]);
+    }
+  }
+
+  m_owners.assign(nbRBs, -1);
+  PacketScheduler::UsersToSchedule* users = scheduler->GetUsersToSchedule();
+  for (size_t u = 0; u < users->size(); u++) {
+    TtiVector<int>* rbs = users->at(u)->GetListOfAllocatedRBs();
+    for (size_t i = 0; i < rbs->size(); i++) {
+      int rb = rbs->at(i);
+      if (rb >= 0 && rb < nbRBs) m_owners[rb] = users->at(u)->GetUserID();
+    }
+  }
+
+  bool ok = true;
+  // with the first record, once the scenario has set the seed
+  if (!m_headerWritten) {
+    std::ostringstream text;
+    std::ifstream ifs(config.c_str());
+    if (ifs) text << ifs.rdbuf();
+    std::string configText = text.str();
+    FileHeader fileHeader;
+    fileHeader.m_magic = SCHEDULER_INPUT_TRACE_MAGIC;
+    fileHeader.m_version = SCHEDULER_INPUT_TRACE_VERSION;
+    fileHeader.m_seed = CounterRng::GetGlobalSeed();
+    fileHeader.m_configSize = configText.size();
+    fileHeader.m_reserved = 0;
+    ok = fwrite(&fileHeader, sizeof(fileHeader), 1, m_fp) == 1 &&
+         fwrite(configText.data(), 1, configText.size(), m_fp) == configText.size();
+    m_headerWritten = true;
+  }
+
+  RecordHeader header;
+  header.m_enbID = enbID;
+  header.m_nbRBs = nbRBs;
+  header.m_nbUsers = m_users.size();
+  header.m_nbBearers = inputs.size();
+  header.m_tti = scheduler->GetTimeStamp();
+  header.m_counter = counter;
+  header.m_time = Simulator::Init()->Now();
+  ok = ok && fwrite(&header, sizeof(header), 1, m_fp) == 1;
+
+  for (size_t u = 0; u < m_users.size(); u++) {
+    const std::vector<int>& cqi = *m_users[u]->m_cqi;
+    UserHeader user;
+    user.m_userID = m_users[u]->m_userID;
+    user.m_slice = scheduler->GetSliceOfUser(user.m_userID);
+    user.m_nbCqi = cqi.size();
+    user.m_reserved = 0;
+    m_cqi.assign(cqi.begin(), cqi.end());
+    ok = ok && fwrite(&user, sizeof(user), 1, m_fp) == 1;
+    ok = ok && fwrite(m_cqi.data(), 1, m_cqi.size(), m_fp) == m_cqi.size();
+  }
+
+  for (size_t i = 0; i < inputs.size(); i++) {
+    BearerRecord bearer;
+    bearer.m_averageRate = inputs[i].m_averageRate;
+    bearer.m_headOfLineDelay = inputs[i].m_headOfLineDelay;
+    bearer.m_user = m_userIndex[inputs[i].m_userID];
+    bearer.m_priority = inputs[i].m_priority;
+    bearer.m_dataToTransmit = inputs[i].m_dataToTransmit;
+    bearer.m_reserved = 0;
+    ok = ok && fwrite(&bearer, sizeof(bearer), 1, m_fp) == 1;
+  }
+  ok = ok && fwrite(m_owners.data(), sizeof(int32_t), m_owners.size(), m_fp) ==
+                 m_owners.size();
+  if (!ok) {
+    std::cerr << "ERROR: unable to write the scheduler inputs to " << m_fname
+              << std::endl;
+    exit(1);
+  }
+}
+
+bool SchedulerInputTrace::Load(const std::string& fname, uint64_t* seed,
+                               std::string* config, std::vector<Record>* records) {
+  FILE* fp = fopen(fname.c_str(), "rb");
+  if (fp == NULL) return false;
+
+  FileHeader header;
+  bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+            header.m_magic == SCHEDULER_INPUT_TRACE_MAGIC &&
+            header.m_version == SCHEDULER_INPUT_TRACE_VERSION;
+  *seed = ok ? header.m_seed : 0;
+  config->assign(ok ? header.m_configSize : 0, '\0');
+  ok = ok && fread(&(*config)[0], 1, config->size(), fp) == config->size();
+  records->clear();
+  RecordHeader recordHeader;
+  std::vector<uint8_t> cqi;
+  std::vector<int32_t> users;  // of the bearers
+  while (ok && fread(&recordHeader, sizeof(recordHeader), 1, fp) == 1) {
+    records->push_back(Record());
+    Record& r = records->back();
+    r.m_header = recordHeader;
+
+    for (uint32_t u = 0; ok && u < recordHeader.m_nbUsers; u++) {
+      UserHeader user;
+      ok = fread(&user, sizeof(user), 1, fp) == 1;
+      cqi.resize(ok ? user.m_nbCqi : 0);
+      ok = ok && fread(cqi.data(), 1, cqi.size(), fp) == cqi.size();
+      r.m_userIDs.push_back(user.m_userID);
+      r.m_slices.push_back(user.m_slice);
+      r.m_cqi.push_back(std::vector<int>(cqi.begin(), cqi.end()));
+    }
+
+    users.clear();
+    for (uint32_t i = 0; ok && i < recordHeader.m_nbBearers; i++) {
+      BearerRecord bearer;
+      ok = fread(&bearer, sizeof(bearer), 1, fp) == 1 && bearer.m_user >= 0 &&
+           bearer.m_user < (int32_t)recordHeader.m_nbUsers;
+      if (!ok) break;
+      PacketScheduler::BearerInput input;
+      input.m_userID = r.m_userIDs[bearer.m_user];
+      input.m_priority = bearer.m_priority;
+      input.m_dataToTransmit = bearer.m_dataToTransmit;
+      input.m_averageRate = bearer.m_averageRate;
+      input.m_headOfLineDelay = bearer.m_headOfLineDelay;
+      input.m_cqi = NULL;
+      input.m_bearer = NULL;
+      input.m_userNode = NULL;
+      r.m_inputs.push_back(input);
+      users.push_back(bearer.m_user);
+    }
+    // once all the CQIs of the record are read; they do not move with it
+    for (size_t i = 0; ok && i < r.m_inputs.size(); i++) {
+      r.m_inputs[i].m_cqi = &r.m_cqi[users[i]];
+    }
+
+    r.m_owners.resize(recordHeader.m_nbRBs);
+    ok = ok && fread(r.m_owners.data(), sizeof(int32_t), r.m_owners.size(), fp) ==
+                   r.m_owners.size();
+  }
+  ok = ok && feof(fp);
+  fclose(fp);
+  return ok;
+}
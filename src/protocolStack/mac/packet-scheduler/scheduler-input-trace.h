@@ -0,0 +1,137 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef SCHEDULER_INPUT_TRACE_H_
+#define SCHEDULER_INPUT_TRACE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "packet-scheduler.h"
+
+/*
+ * Capture of what the DL schedulers read, one record per cell and TTI:
+ * the users with their slice and CQIs, the bearer inputs of the TTI (queue,
+ * head of line delay, average rate), where the random stream of the
+ * scheduler was, and the owner of every RB once the scheduler has allocated
+ * them. Records are written by StopSchedule, in the order of the cells,
+ * which is the same with a parallel TTI.
+ *
+ * The file is a fixed header, the scheduler config of the first captured
+ * cell (the scenarios give the same one to all cells, possibly a temporary
+ * file) and the records, each a RecordHeader, its
+ * users (a UserHeader then one byte per CQI), its BearerRecords and one
+ * int32 per RB (the ID of the user, -1 when not allocated).
+ */
+class SchedulerInputTrace {
+ public:
+  struct FileHeader {
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint64_t m_seed;  // global seed of the random streams
+    uint32_t m_configSize;
+    uint32_t m_reserved;
+  };
+
+  struct RecordHeader {
+    uint32_t m_enbID;
+    uint32_t m_nbRBs;
+    uint32_t m_nbUsers;
+    uint32_t m_nbBearers;
+    uint64_t m_tti;      // of the scheduler
+    uint64_t m_counter;  // of its random stream, when the TTI started
+    double m_time;       // simulated seconds
+  };
+
+  struct UserHeader {
+    int32_t m_userID;
+    int32_t m_slice;  // -1 without slices
+    uint32_t m_nbCqi;
+    uint32_t m_reserved;
+  };
+
+  struct BearerRecord {
+    double m_averageRate;
+    double m_headOfLineDelay;
+    int32_t m_user;  // index in the users of the record
+    int32_t m_priority;
+    int32_t m_dataToTransmit;
+    int32_t m_reserved;
+  };
+
+  // a record read back, its inputs pointing to its CQIs
+  struct Record {
+    RecordHeader m_header;
+    std::vector<int> m_userIDs;
+    std::vector<int> m_slices;
+    std::vector<std::vector<int> > m_cqi;
+    PacketScheduler::BearerInputs m_inputs;
+    std::vector<int> m_owners;  // by RB
+  };
+
+ private:
+  SchedulerInputTrace();
+  static SchedulerInputTrace* ptr;
+
+  FILE* m_fp;
+  std::string m_fname;
+  bool m_headerWritten;
+  std::vector<std::string> m_temporaryFiles;
+
+  // the users of the record being written
+  std::unordered_map<int, int> m_userIndex;
+  std::vector<const PacketScheduler::BearerInput*> m_users;
+  std::vector<uint8_t> m_cqi;
+  std::vector<int32_t> m_owners;
+
+  static void CloseAtExit(void);
+
+ public:
+  virtual ~SchedulerInputTrace();
+
+  static SchedulerInputTrace* Init(void) {
+    if (ptr == NULL) {
+      ptr = new SchedulerInputTrace;
+    }
+    return ptr;
+  }
+
+  // starts capturing to fname; false when it cannot be created
+  bool Open(const std::string& fname);
+  void Close(void);
+  bool IsRecording(void) const { return m_fp != NULL; }
+  // a scheduler config the capture reads, removed when it is closed
+  void AddTemporaryFile(const std::string& fname);
+
+  // the TTI the scheduler has just allocated
+  void Write(PacketScheduler* scheduler, int enbID, int nbRBs,
+             const std::string& config, uint64_t counter,
+             const PacketScheduler::BearerInputs& inputs);
+
+  static bool Load(const std::string& fname, uint64_t* seed, std::string* config,
+                   std::vector<Record>* records);
+};
+
+#endif /* SCHEDULER_INPUT_TRACE_H_ */
@@ -0,0 +1,241 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "scheduler-replay.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <streambuf>
+
+#include "../../../componentManagers/SnapshotManager.h"
+#include "../../../core/spectrum/bandwidth-manager.h"
+#include "../../../device/NetworkNode.h"
+#include "../../../networkTopology/Cell.h"
+#include "../../../phy/lte-phy.h"
+#include "packet-scheduler.h"
+
+// drops what the schedulers print
+class ReplayNullBuffer : public std::streambuf {
+ protected:
+  virtual int overflow(int c) { return c; }
+  virtual std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+static uint64_t Fnv1a(uint64_t hash, int32_t value) {
+  const unsigned char* bytes = (const unsigned char*)&value;
+  for (size_t i = 0; i < sizeof(value); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static double Percentile(const std::vector<double>& sorted, double p) {
+  size_t rank = (size_t)(p * sorted.size());
+  if (rank >= sorted.size()) rank = sorted.size() - 1;
+  return sorted[rank];
+}
+
+bool SchedulerReplay::ReadsBearerInputs(ENodeB::DLSchedulerType type) {
+  switch (type) {
+    case ENodeB::DLScheduler_NVS:
+    case ENodeB::DLScheduler_NVS_NONGREEDY:
+    case ENodeB::DLScheduler_SEQUENTIAL:
+    case ENodeB::DLScheduler_SUBOPT:
+    case ENodeB::DLScheduler_MAXCELL:
+    case ENodeB::DLScheduler_VOGEL:
+    case ENodeB::DLScheduler_UpperBound:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int SchedulerReplay::Run(const std::string& traceFile, const std::string& scheduler,
+                         const std::string& configArg, int nbPasses) {
+  ENodeB::DLSchedulerType type;
+  if (!SnapshotManager::ParseDLSchedulerType(scheduler, &type) ||
+      !ReadsBearerInputs(type)) {
+    std::cerr << "ERROR: the scheduler " << scheduler
+              << " cannot replay captured inputs" << std::endl;
+    return 1;
+  }
+  uint64_t seed;
+  std::string capturedConfig;
+  std::vector<SchedulerInputTrace::Record> records;
+  if (!SchedulerInputTrace::Load(traceFile, &seed, &capturedConfig, &records) ||
+      records.empty()) {
+    std::cerr << "ERROR: unable to read the scheduler inputs in " << traceFile
+              << std::endl;
+    return 1;
+  }
+  CounterRng::SetGlobalSeed(seed);
+
+  // "-" is the config of the captured schedulers, which may have been removed
+  std::string config = configArg;
+  char configFname[] = "/tmp/scheduler-replay-XXXXXX";
+  if (configArg == "-") {
+    int fd = mkstemp(configFname);
+    if (fd < 0) {
+      std::cerr << "ERROR: unable to create the scheduler config" << std::endl;
+      return 1;
+    }
+    close(fd);
+    std::ofstream ofs(configFname);
+    ofs << capturedConfig;
+    config = configFname;
+  }
+  int status = Replay(records, type, scheduler, config, nbPasses);
+  if (configArg == "-") unlink(configFname);
+  return status;
+}
+
+int SchedulerReplay::Replay(std::vector<SchedulerInputTrace::Record>& records,
+                            ENodeB::DLSchedulerType type, const std::string& scheduler,
+                            const std::string& config, int nbPasses) {
+  // a bare node per captured user, for what the schedulers send to the UE
+  std::map<int, NetworkNode*> ues;
+  for (size_t i = 0; i < records.size(); i++) {
+    PacketScheduler::BearerInputs& inputs = records[i].m_inputs;
+    for (size_t b = 0; b < inputs.size(); b++) {
+      NetworkNode*& ue = ues[inputs[b].m_userID];
+      if (ue == NULL) {
+        ue = new NetworkNode();
+        ue->SetIDNetworkNode(inputs[b].m_userID);
+        ue->SetNodeType(NetworkNode::TYPE_UE);
+      }
+      inputs[b].m_userNode = ue;
+    }
+  }
+
+  // a bare eNB per captured cell
+  std::map<int, ENodeB*> enbs;
+  std::vector<ENodeB*> byRecord;
+  for (size_t i = 0; i < records.size(); i++) {
+    int enbID = records[i].m_header.m_enbID;
+    int nbRBs = records[i].m_header.m_nbRBs;
+    ENodeB*& enb = enbs[enbID];
+    if (enb == NULL) {
+      enb = new ENodeB(enbID, new Cell(enbs.size(), 1, 0.035, 0, 0), 0, 0);
+      // the schedulers only count the sub-channels
+      BandwidthManager* spectrum = new BandwidthManager(5, 5, 0, 0);
+      spectrum->SetDlSubChannels(std::vector<double>(nbRBs, 0));
+      enb->GetPhy()->SetBandwidthManager(spectrum);
+    }
+    if ((int)enb->GetPhy()->GetBandwidthManager()->GetDlSubChannels().size() != nbRBs) {
+      std::cerr << "ERROR: the RBs of eNB " << enbID << " change in the capture"
+                << std::endl;
+      return 1;
+    }
+    byRecord.push_back(enb);
+  }
+  std::cout << "replay: " << records.size() << " TTIs of " << enbs.size()
+            << " cells, scheduler " << scheduler << std::endl;
+
+  ReplayNullBuffer nullBuffer;
+  std::vector<Pass> passes(nbPasses);
+  for (int p = 0; p < nbPasses; p++) {
+    Pass& pass = passes[p];
+    for (std::map<int, ENodeB*>::iterator it = enbs.begin(); it != enbs.end(); it++) {
+      it->second->SetDLScheduler(type, config);
+    }
+    pass.m_seconds = 0;
+    pass.m_checksum = 14695981039346656037ULL;
+    pass.m_nbCaptured = 0;
+    pass.m_latencies.reserve(records.size());
+
+    std::streambuf* out = std::cout.rdbuf(&nullBuffer);
+    std::streambuf* err = std::cerr.rdbuf(&nullBuffer);
+    for (size_t i = 0; i < records.size(); i++) {
+      const SchedulerInputTrace::Record& r = records[i];
+      PacketScheduler* s = byRecord[i]->GetDLScheduler();
+      for (size_t u = 0; p == 0 && u < r.m_userIDs.size(); u++) {
+        if (r.m_slices[u] >= 0 && s->GetSliceOfUser(r.m_userIDs[u]) != r.m_slices[u]) {
+          std::cout.rdbuf(out);
+          std::cerr.rdbuf(err);
+          std::cerr << "ERROR: " << config << " does not put user " << r.m_userIDs[u]
+                    << " in slice " << r.m_slices[u] << " as the capture"
+                    << std::endl;
+          return 1;
+        }
+      }
+      s->SetReplayedInputs(&r.m_inputs);
+      s->SetTimeStamp(r.m_header.m_tti);
+      s->GetRandomStream().SetCounter(r.m_header.m_counter);
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      s->PrepareSchedule();
+      s->AllocateResources();
+      std::chrono::duration<double> latency = std::chrono::steady_clock::now() - start;
+      pass.m_latencies.push_back(latency.count());
+      pass.m_seconds += latency.count();
+
+      int nbRBs = r.m_header.m_nbRBs;
+      std::vector<int> owners(nbRBs, -1);
+      PacketScheduler::UsersToSchedule* users = s->GetUsersToSchedule();
+      for (size_t u = 0; u < users->size(); u++) {
+        TtiVector<int>* rbs = users->at(u)->GetListOfAllocatedRBs();
+        for (size_t k = 0; k < rbs->size(); k++) {
+          if (rbs->at(k) >= 0 && rbs->at(k) < nbRBs) owners[rbs->at(k)] = users->at(u)->GetUserID();
+        }
+      }
+      pass.m_checksum = Fnv1a(pass.m_checksum, r.m_header.m_enbID);
+      for (int rb = 0; rb < nbRBs; rb++) pass.m_checksum = Fnv1a(pass.m_checksum, owners[rb]);
+      if (owners == r.m_owners) pass.m_nbCaptured++;
+    }
+    std::cout.rdbuf(out);
+    std::cerr.rdbuf(err);
+
+    std::vector<double> sorted(pass.m_latencies);
+    std::sort(sorted.begin(), sorted.end());
+    char line[256];
+    snprintf(line, sizeof(line),
+             "pass %d: %.6f s, %.0f decisions/s, latency p50 %.2f us, p90 %.2f us,"
+             " p99 %.2f us, max %.2f us, checksum %016" PRIx64,
+             p + 1, pass.m_seconds, records.size() / pass.m_seconds,
+             Percentile(sorted, 0.50) * 1e6, Percentile(sorted, 0.90) * 1e6,
+             Percentile(sorted, 0.99) * 1e6, sorted.back() * 1e6, pass.m_checksum);
+    std::cout << line << std::endl;
+  }
+
+  std::cout << "decisions of the capture: " << passes[0].m_nbCaptured << " of "
+            << records.size() << " TTIs" << std::endl;
+  for (int p = 1; p < nbPasses; p++) {
+    if (passes[p].m_checksum != passes[0].m_checksum ||
+        passes[p].m_nbCaptured != passes[0].m_nbCaptured) {
+      std::cerr << "ERROR: the decisions of pass " << p + 1
+                << " differ from the first pass" << std::endl;
+      return 1;
+    }
+  }
+  if (nbPasses > 1) {
+    std::cout << "deterministic: " << nbPasses << " passes" << std::endl;
+  }
+  return 0;
+}
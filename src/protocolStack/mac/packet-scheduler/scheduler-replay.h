@@ -0,0 +1,72 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef SCHEDULER_REPLAY_H_
+#define SCHEDULER_REPLAY_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "../../../device/ENodeB.h"
+#include "scheduler-input-trace.h"
+
+/*
+ * Feeds a capture of scheduler inputs (SchedulerInputTrace) to a DL
+ * scheduler out of the simulation, to benchmark the scheduler alone.
+ *
+ * Every captured cell gets a bare eNB with the ID of the captured one (the
+ * key of the random stream of its scheduler) and as many RBs, and a fresh
+ * scheduler for each pass over the capture; every captured user gets a bare
+ * node with its ID, for the control messages of the scheduler. Each TTI starts from the
+ * captured position of the random stream and is replayed with
+ * PrepareSchedule and AllocateResources only: nothing is transmitted and
+ * what the scheduler prints is dropped, but still formatted.
+ *
+ * A pass reports the decisions (cell TTIs) per second, the percentiles of
+ * the latency of one decision and a checksum of the RBs each user got. The
+ * passes must agree on the checksum; with the scheduler and the config of
+ * the captured run, the decisions must also be the captured ones.
+ */
+class SchedulerReplay {
+ public:
+  struct Pass {
+    double m_seconds;
+    std::vector<double> m_latencies;  // by TTI, in seconds
+    uint64_t m_checksum;
+    int m_nbCaptured;  // TTIs with the captured decisions
+  };
+
+  // the schedulers that select from the bearer inputs
+  static bool ReadsBearerInputs(ENodeB::DLSchedulerType type);
+
+  // the exit status of the program; config "-" is the captured one
+  static int Run(const std::string& traceFile, const std::string& scheduler,
+                 const std::string& config, int nbPasses);
+
+ private:
+  static int Replay(std::vector<SchedulerInputTrace::Record>& records,
+                    ENodeB::DLSchedulerType type, const std::string& scheduler,
+                    const std::string& config, int nbPasses);
+};
+
+#endif /* SCHEDULER_REPLAY_H_ */
@@ -33,9 +33,14 @@
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../flows/MacQueue.h"
 #include "../../../utility/eesm-effective-sinr.h"
+#include "../../../utility/phase-profiler.h"
+
+#include <algorithm>
 
 UplinkPacketScheduler::UplinkPacketScheduler()
-{}
+{
+  m_eesmTermsReady = false;
+}
 
 UplinkPacketScheduler::~UplinkPacketScheduler()
 {
@@ -120,6 +125,9 @@ UplinkPacketScheduler::SelectUsersToSchedule ()
 void
 UplinkPacketScheduler::DoSchedule (void)
 {
+  PROFILE_PHASE (PHASE_SCHED_UPLINK);
+  // the working set of the last TTI
+  GetTtiArena ()->Reset ();
 #ifdef SCHEDULER_DEBUG
 	std::cout << "Start UPLINK packet scheduler for node "
 			<< GetMacEntity ()->GetDevice ()->GetIDNetworkNode()<< std::endl;
@@ -136,6 +144,86 @@ UplinkPacketScheduler::DoSchedule (void)
   DeleteUsersToSchedule ();
 }
 
+UplinkPacketScheduler::MetricMatrix
+UplinkPacketScheduler::CreateMetricMatrix (int nbOfRBs)
+{
+  MetricMatrix metrics;
+  metrics.m_nbUsers = GetUsersToSchedule ()->size ();
+  metrics.m_nbRBs = nbOfRBs;
+  // whole cache lines of 8 doubles
+  metrics.m_stride = (nbOfRBs + 7) & ~7;
+  metrics.m_values = (double*) GetTtiArena ()->Allocate (
+      (size_t) metrics.m_nbUsers * metrics.m_stride * sizeof (double), 64);
+  return metrics;
+}
+
+void
+UplinkPacketScheduler::ComputeSchedulingMetrics (MetricMatrix *metrics)
+{
+  UsersToSchedule *users = GetUsersToSchedule ();
+  for (int j = 0; j < metrics->m_nbUsers; j++)
+    {
+      double *row = metrics->GetRow (j);
+      for (int i = 0; i < metrics->m_nbRBs; i++)
+        {
+          row[i] = ComputeSchedulingMetric (users->at (j), i);
+        }
+    }
+}
+
+void
+UplinkPacketScheduler::ComputeThroughputMetrics (MetricMatrix *metrics)
+{
+  // the metric of every CQI, from 1 to 15, so that a row is a lookup per RB
+  AMCModule *amc = GetMacEntity ()->GetAmcModule ();
+  double metricOfCqi[15];
+  for (int cqi = 1; cqi <= 15; cqi++)
+    {
+      metricOfCqi[cqi - 1] = amc->GetSinrFromCQI (cqi) * 180000;
+    }
+
+  UsersToSchedule *users = GetUsersToSchedule ();
+  for (int j = 0; j < metrics->m_nbUsers; j++)
+    {
+      const std::vector<int>& channel = users->at (j)->m_channelContition;
+      if ((int) channel.size () < metrics->m_nbRBs)
+        {
+          std::cerr << "ERROR: " << channel.size () << " UL CQIs for "
+                    << metrics->m_nbRBs << " RBs" << std::endl;
+          exit (1);
+        }
+      const int *cqi = channel.data ();
+      double *row = metrics->GetRow (j);
+      for (int i = 0; i < metrics->m_nbRBs; i++)
+        {
+          row[i] = metricOfCqi[cqi[i] - 1];
+        }
+    }
+}
+
+int
+UplinkPacketScheduler::GetEffectiveMcs (UserToSchedule *user)
+{
+  AMCModule *amc = GetMacEntity ()->GetAmcModule ();
+  if (!m_eesmTermsReady)
+    {
+      for (int cqi = 1; cqi <= 15; cqi++)
+        {
+          m_eesmTermOfCqi[cqi - 1] = GetEesmTerm (amc->GetSinrFromCQI (cqi));
+        }
+      m_eesmTermsReady = true;
+    }
+
+  double sum = 0;
+  for (std::vector<int>::iterator c = user->m_channelContition.begin ();
+       c != user->m_channelContition.end (); c++)
+    {
+      sum += m_eesmTermOfCqi[*c - 1];
+    }
+  double effectiveSinr = GetEesmEffectiveSinrFromSum (sum, user->m_channelContition.size ());
+  return amc->GetMCSFromCQI (amc->GetCQIFromSinr (effectiveSinr));
+}
+
 void
 UplinkPacketScheduler::RBsAllocation ()
 {
@@ -144,17 +232,13 @@ UplinkPacketScheduler::RBsAllocation ()
 #endif
 
 	UsersToSchedule *users = GetUsersToSchedule ();
+	int nbOfUsers = users->size ();
 	int nbOfRBs = GetMacEntity ()->GetDevice ()->GetPhy ()->GetBandwidthManager ()->GetUlSubChannels ().size ();
+	TtiArena *arena = GetTtiArena ();
 
 	  //create a matrix of flow metrics
-	  double metrics[nbOfRBs][users->size ()];
-	  for (int i = 0; i < nbOfRBs; i++)
-	    {
-		  for (int j = 0; j < users->size (); j++)
-		    {
-			  metrics[i][j] = ComputeSchedulingMetric (users->at (j), i);
-		    }
-	    }
+	  MetricMatrix metrics = CreateMetricMatrix (nbOfRBs);
+	  ComputeSchedulingMetrics (&metrics);
 
 #ifdef SCHEDULER_DEBUG
   std::cout << ", available RBs " << nbOfRBs << ", users " << users->size () << std::endl;
@@ -164,70 +248,94 @@ UplinkPacketScheduler::RBsAllocation ()
 			  << users->at (ii)->m_userToSchedule->GetIDNetworkNode ();
 	  for (int jj = 0; jj < nbOfRBs; jj++)
 	    {
-		  std::cout << " " << metrics[jj][ii];
+		  std::cout << " " << metrics.Get (jj, ii);
 	    }
 	  std::cout << std::endl;
     }
 #endif
 
+  // the user with the highest positive metric on every RB, the first one
+  // on a tie, found row by row in one pass over the matrix
+  double *bestMetric = arena->NewArray<double> (nbOfRBs);
+  int *bestUser = arena->NewArray<int> (nbOfRBs);
+  for (int i = 0; i < nbOfRBs; i++)
+    {
+      bestMetric[i] = 0;
+      bestUser[i] = -1;
+    }
+  for (int k = 0; k < nbOfUsers; k++)
+    {
+      const double *row = metrics.GetRow (k);
+      for (int i = 0; i < nbOfRBs; i++)
+        {
+          bool better = row[i] > bestMetric[i];
+          bestMetric[i] = better ? row[i] : bestMetric[i];
+          bestUser[i] = better ? k : bestUser[i];
+        }
+    }
+
+  // every user gets one grant, of contiguous RBs
+  bool *served = arena->NewArray<bool> (nbOfUsers);
+  for (int k = 0; k < nbOfUsers; k++)
+    {
+      served[k] = false;
+    }
+
   //RBs allocation
   int s = 0;
   while (s < nbOfRBs)
     {
-	  double targetMetric = 0;
-	  bool RBIsAllocated = false;
-	  UserToSchedule* scheduledUser;
-
-	  for (int k = 0; k < users->size (); k++)
-	    {
-		  if (metrics[s][k] > targetMetric)
-			{
-			  targetMetric = metrics[s][k];
-			  RBIsAllocated = true;
-			  scheduledUser = users->at (k);
-			}
-		}
-
-	  if (RBIsAllocated)
+	  int selectedUser = bestUser[s];
+	  if (selectedUser >= 0 && served[selectedUser])
 	    {
-		  int dataToTransmit = scheduledUser->m_dataToTransmit;
-		  int availableRBs = nbOfRBs - s;
-		  std::vector<double> sinrs;
-		  for (std::vector<int>::iterator c = scheduledUser->m_channelContition.begin ();
-				  c != scheduledUser->m_channelContition.end (); c++)
+		  // the best one has its RBs already, the best of the others
+		  double targetMetric = 0;
+		  selectedUser = -1;
+		  for (int k = 0; k < nbOfUsers; k++)
 		    {
-			  sinrs.push_back (GetMacEntity ()->GetAmcModule ()->GetSinrFromCQI (*c));
-		    }
-		  double effectiveSinr =  GetEesmEffectiveSinr (sinrs);
-		  int mcs = GetMacEntity ()->GetAmcModule ()->GetMCSFromCQI (
-				  GetMacEntity ()->GetAmcModule ()->GetCQIFromSinr (effectiveSinr));
-		  int tbs = (GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, availableRBs)) / 8;
-
-		  if (tbs <= dataToTransmit)
-		    {
-			  s = nbOfRBs;
-			  scheduledUser->m_transmittedData = tbs;
-
-			  for (int ss = 0; ss < availableRBs; ss++)
+			  if (!served[k] && metrics.Get (s, k) > targetMetric)
 			    {
-				  scheduledUser->m_listOfAllocatedRBs.push_back (ss); // XXX it doesn't describe correctly assigned PRBs
+				  targetMetric = metrics.Get (s, k);
+				  selectedUser = k;
 			    }
-			  scheduledUser->m_selectedMCS = mcs;
 		    }
-		  else
-		    {
-			  int rbsNeeded = (floor) (scheduledUser->m_dataToTransmit /
-					  (GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, 1) / 8));
-		      scheduledUser->m_transmittedData = GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, rbsNeeded) / 8;
-		      s += rbsNeeded;
+	    }
+	  if (selectedUser < 0)
+	    {
+		  // no user left has a positive metric on this RB
+		  s++;
+		  continue;
+	    }
 
-			  for (int ss = 0; ss < rbsNeeded; ss++)
-			    {
-				  scheduledUser->m_listOfAllocatedRBs.push_back (ss); // XXX it doesn't describe correctly assigned PRBs
-			    }
-			  scheduledUser->m_selectedMCS = mcs;
-		    }
+	  UserToSchedule* scheduledUser = users->at (selectedUser);
+	  served[selectedUser] = true;
+
+	  int dataToTransmit = scheduledUser->m_dataToTransmit;
+	  int availableRBs = nbOfRBs - s;
+	  int mcs = GetEffectiveMcs (scheduledUser);
+	  int tbs = (GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, availableRBs)) / 8;
+
+	  int rbsNeeded;
+	  if (tbs <= dataToTransmit)
+	    {
+		  rbsNeeded = availableRBs;
+		  scheduledUser->m_transmittedData = tbs;
+	    }
+	  else
+	    {
+		  rbsNeeded = (floor) (scheduledUser->m_dataToTransmit /
+				  (GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, 1) / 8));
+		  // less than one RB of data still takes one
+		  rbsNeeded = std::max (1, std::min (rbsNeeded, availableRBs));
+	      scheduledUser->m_transmittedData = GetMacEntity ()->GetAmcModule ()->GetTBSizeFromMCS (mcs, rbsNeeded) / 8;
+	    }
+
+	  for (int ss = s; ss < s + rbsNeeded; ss++)
+	    {
+		  scheduledUser->m_listOfAllocatedRBs.push_back (ss);
 	    }
+	  scheduledUser->m_selectedMCS = mcs;
+	  s += rbsNeeded;
     }
 }
 
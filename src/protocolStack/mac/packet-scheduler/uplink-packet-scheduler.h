@@ -50,15 +50,46 @@ class UplinkPacketScheduler : public PacketScheduler {
   virtual void DoSchedule(void);
   virtual void DoStopSchedule(void);
 
+  /*
+   * Metrics of the users to schedule on the UL RBs of one TTI, user by
+   * user: the row of a user holds its metric on every RB, contiguous and
+   * aligned on a cache line, so that a policy computes a whole row, and a
+   * search runs over a row, in straight loops the compiler vectorizes. It
+   * lives in the TTI arena of the scheduler.
+   */
+  struct MetricMatrix {
+    int m_nbUsers;
+    int m_nbRBs;
+    int m_stride;  // doubles from one row to the next
+    double* m_values;
+
+    double* GetRow(int user) { return m_values + (size_t)user * m_stride; }
+    double Get(int rb, int user) const {
+      return m_values[(size_t)user * m_stride + rb];
+    }
+  };
+  MetricMatrix CreateMetricMatrix(int nbOfRBs);
+
   virtual void RBsAllocation();
+  // fills the matrix, by default one ComputeSchedulingMetric call per cell
+  virtual void ComputeSchedulingMetrics(MetricMatrix* metrics);
   virtual double ComputeSchedulingMetric(RadioBearer* bearer,
                                          double spectralEfficiency,
                                          int subChannel) = 0;
   virtual double ComputeSchedulingMetric(UserToSchedule* user,
                                          int subchannel) = 0;
 
+ protected:
+  // spectral efficiency * 180 kHz, in one pass over the CQIs of each user
+  void ComputeThroughputMetrics(MetricMatrix* metrics);
+  // from the EESM effective SINR of the CQIs of the user on all the RBs
+  int GetEffectiveMcs(UserToSchedule* user);
+
  private:
   UsersToSchedule* m_usersToSchedule;
+  // the EESM term of every CQI, from 1 to 15
+  double m_eesmTermOfCqi[15];
+  bool m_eesmTermsReady;
 };
 
 #endif /* UPLINKPACKETSCHEDULER_H_ */
@@ -31,6 +31,8 @@
 #include "amd-record.h"
 #include "../../core/idealMessages/ideal-control-messages.h"
 #include "../../load-parameters.h"
+#include "../../utility/phase-profiler.h"
+#include <algorithm>
 
 #define MAX_AMD_RETX 5
 
@@ -41,8 +43,9 @@ AmRlcEntity::AmRlcEntity()
   SetRlcMode(RlcEntity::AM_RLC_MODE);
   SetRlcPduSequenceNumber (0);
   m_amStateVariables = new AmStateVariables ();
-  m_sentAMDs = new std::vector<AmdRecord*> ();
-  m_receivedAMDs = new std::vector<AmdRecord*> ();
+  m_sentAMDs = new AmdWindow (m_amStateVariables->m_am_window_size);
+  m_receivedAMDs = new AmdWindow (m_amStateVariables->m_am_window_size);
+  m_unacknowledgedBytes = 0;
 
 }
 
@@ -50,32 +53,25 @@ AmRlcEntity::~AmRlcEntity()
 {
   delete m_amStateVariables;
   ClearPacketList ();
+  delete m_sentAMDs;
+  delete m_receivedAMDs;
   Destroy ();
 }
 
   void
 AmRlcEntity::ClearPacketList (void)
 {
-  std::vector <AmdRecord*>::iterator it;
-  for (it = m_sentAMDs->begin (); it != m_sentAMDs->end (); it++)
-  {
-    delete *it;
-  }
-  m_sentAMDs->clear ();
-
-  for (it = m_receivedAMDs->begin (); it != m_receivedAMDs->end (); it++)
-  {
-    delete *it;
-  }
-  m_receivedAMDs->clear ();
+  m_sentAMDs->Clear ();
+  m_receivedAMDs->Clear ();
+  m_unacknowledgedBytes = 0;
 }
 
   void
 AmRlcEntity::PrintSentAMDs (void)
 {
   std::cout << "\t PrintSentAMDs" << std::endl;
-  std::vector <AmdRecord*>::iterator it;
-  for (it = m_sentAMDs->begin (); it != m_sentAMDs->end (); it++)
+  AmdWindow::iterator it;
+  for (it = m_sentAMDs->begin (); it != m_sentAMDs->end (); ++it)
   {
     Packet* packet = (*it)->m_packet;
     std::cout << "\t\t *** pkt " << packet->GetID() << " frag " << packet->GetRLCHeader ()->GetFragmentNumber () <<
@@ -90,8 +86,8 @@ AmRlcEntity::PrintSentAMDs (void)
 AmRlcEntity::PrintReceivedAMDs (void)
 {
   std::cout << "\t PrintReceivedAMDs" << std::endl;
-  std::vector <AmdRecord*>::iterator it;
-  for (it = m_receivedAMDs->begin (); it != m_receivedAMDs->end (); it++)
+  AmdWindow::iterator it;
+  for (it = m_receivedAMDs->begin (); it != m_receivedAMDs->end (); ++it)
   {
     Packet* packet = (*it)->m_packet;
     std::cout << "\t\t *** pkt " << packet->GetID() << " frag " << packet->GetRLCHeader ()->GetFragmentNumber () <<
@@ -109,13 +105,13 @@ AmRlcEntity::GetAmStateVariables ()
   return m_amStateVariables;
 }
 
-  std::vector<AmdRecord*>*
+  AmdWindow*
 AmRlcEntity::GetSentAMDs (void)
 {
   return m_sentAMDs;
 }
 
-  std::vector<AmdRecord*>*
+  AmdWindow*
 AmRlcEntity::GetReceivedAMDs (void)
 {
   return m_receivedAMDs;
@@ -129,50 +125,7 @@ AmRlcEntity::InsertAMDIntoReceptionList (AmdRecord* amd)
   PrintReceivedAMDs ();
 #endif
 
-  int amds = m_receivedAMDs->size ();
-
-  if (amds == 0)
-  {
-    //std::cout << "no AMD into the list" << std::endl;
-    m_receivedAMDs->insert (m_receivedAMDs->begin (), amd);
-    return;
-  }
-
-  for (int i = 0; i < amds; i++)
-  {
-    Packet* packet = m_receivedAMDs->at (i)->m_packet;
-
-    if (amd->m_packet->GetRLCHeader ()->GetRlcPduSequenceNumber () < packet->GetRLCHeader ()->GetRlcPduSequenceNumber ())
-    {
-      //std::cout << "insert the AMD" << std::endl;
-      m_receivedAMDs->insert (m_receivedAMDs->begin () + i, amd);
-      return;
-    }
-    else if (amd->m_packet->GetRLCHeader ()->GetRlcPduSequenceNumber () > packet->GetRLCHeader ()->GetRlcPduSequenceNumber ()
-        && i == amds - 1)
-    {
-      //std::cout << "insert the AMD at the end of the queue" << std::endl;
-      m_receivedAMDs->insert (m_receivedAMDs->end (), amd);
-      return;
-    }
-    else if (amd->m_packet->GetRLCHeader ()->GetRlcPduSequenceNumber () == packet->GetRLCHeader ()->GetRlcPduSequenceNumber ())
-    {
-      if (amd->m_packet->GetRLCHeader ()->GetEndByte () < packet->GetRLCHeader ()->GetStartByte ())
-      {
-        //std::cout << "insert before an AMD with the same SN" << std::endl;
-        m_receivedAMDs->insert (m_receivedAMDs->begin () + i, amd);
-        return;
-      }
-      else if (i == amds - 1)
-      {
-        //std::cout << "insert the AMD at the end of the queue" << std::endl;
-        m_receivedAMDs->insert (m_receivedAMDs->end (), amd);
-        return;
-      }
-    }
-    else
-    {}
-  }
+  m_receivedAMDs->Insert (amd);
 
 #ifdef RLC_DEBUG
   PrintReceivedAMDs ();
@@ -182,6 +135,7 @@ AmRlcEntity::InsertAMDIntoReceptionList (AmdRecord* amd)
   PacketBurst*
 AmRlcEntity::TransmissionProcedure (int availableBytes)
 {
+  PROFILE_PHASE (PHASE_RLC_TX);
 #ifdef RLC_DEBUG
   std::cout << "AM RLC tx procedure for node " << GetRadioBearerInstance ()->GetSource ()->GetIDNetworkNode ()<< " bearer "<<  GetRlcEntityIndex () << std::endl;
 #endif
@@ -195,13 +149,12 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
   PrintSentAMDs ();
 #endif
 
-  int nbSentAMDs = GetSentAMDs()->size();
-  if (nbSentAMDs != 0)
+  if (!GetSentAMDs ()->empty ())
   {
-    int amdId = 0;
-    while (availableBytes > 0 && amdId < nbSentAMDs)
+    AmdWindow::iterator amdIt = GetSentAMDs ()->begin ();
+    while (availableBytes > 0 && amdIt != GetSentAMDs ()->end ())
     {
-      AmdRecord* amdRecord = GetSentAMDs()->at (amdId);
+      AmdRecord* amdRecord = *amdIt;
 
       if (amdRecord->m_packet->GetSize () + 6 <= availableBytes) //6 = MAC  + CRC overhead
       {
@@ -224,7 +177,7 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
 
         pb->AddPacket (p);
         availableBytes -= p->GetSize ();
-        amdId++;
+        ++amdIt;
       }
       else if (availableBytes > 8) // 8 = RLC + MAC + CRC
       {
@@ -236,6 +189,7 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
 #endif
         Packet* p1 = amdRecord->m_packet->Copy ();
         Packet* p2 = amdRecord->m_packet;
+        m_unacknowledgedBytes -= p2->GetSize ();
 
         int sentBytes = availableBytes - 7;
         p1->GetRLCHeader ()->SetEndByte (p1->GetRLCHeader ()->GetStartByte () + sentBytes - 1);
@@ -263,7 +217,8 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
 
         AmdRecord* newAmdRecord = new AmdRecord (p1, p1->GetRLCHeader ()->GetRlcPduSequenceNumber ());
         newAmdRecord->m_retx_count = amdRecord->m_retx_count;
-        GetSentAMDs ()->insert(GetSentAMDs ()->begin() + amdId, newAmdRecord);
+        GetSentAMDs ()->InsertBefore (amdIt, newAmdRecord);
+        m_unacknowledgedBytes += p2->GetSize () + p1->GetSize () + 5;
 
 #ifdef RLC_DEBUG
         PrintSentAMDs ();
@@ -397,7 +352,8 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
 
 
         AmdRecord *amdRecord = new AmdRecord (packet->Copy (), currentSN);
-        GetSentAMDs ()->push_back (amdRecord);
+        GetSentAMDs ()->Insert (amdRecord);
+        m_unacknowledgedBytes += amdRecord->m_packet->GetSize () + 5;
 #ifdef RLC_DEBUG
         PrintSentAMDs ();
 #endif
@@ -430,6 +386,7 @@ AmRlcEntity::TransmissionProcedure (int availableBytes)
   void
 AmRlcEntity::ReceptionProcedure (Packet* p)
 {
+  PROFILE_PHASE (PHASE_RLC_RX);
 #ifdef RLC_DEBUG
   std::cout << "AM RLC rx procedure for node " << GetRadioBearerInstance ()->GetDestination ()->GetIDNetworkNode () << " bearer "<<  GetRlcEntityIndex () << std::endl;
   std::cout << "_____ pkt " << p->GetID() << " frag " << p->GetRLCHeader ()->GetFragmentNumber () <<
@@ -514,15 +471,15 @@ AmRlcEntity::ReceptionProcedureEnd ()
   PrintReceivedAMDs ();
 #endif
 
-  if (m_receivedAMDs->size () == 0) return;
+  if (m_receivedAMDs->empty ()) return;
 
   int currentPacket = -1;
   int expectedNextByte = 0;
 
-  std::list<int> packetIdToDelete;
+  m_reassembledPackets.clear ();
 
-  std::vector <AmdRecord*>::iterator it;
-  for (it = m_receivedAMDs->begin (); it != m_receivedAMDs->end (); it++)
+  AmdWindow::iterator it;
+  for (it = m_receivedAMDs->begin (); it != m_receivedAMDs->end (); ++it)
   {
     Packet* packet = (*it)->m_packet;
 
@@ -547,7 +504,7 @@ AmRlcEntity::ReceptionProcedureEnd ()
         p->SetSize (packet->GetRLCHeader ()->GetEndByte () + 8);
         bearer->Receive (p);
 
-        packetIdToDelete.push_front(packet->GetID ());
+        m_reassembledPackets.push_back (packet->GetID ());
 
         expectedNextByte = 0;
       }
@@ -560,44 +517,27 @@ AmRlcEntity::ReceptionProcedureEnd ()
   }
 
 
-  //DELETE REASSEBLED PACKETS!
+  //DELETE REASSEBLED PACKETS, and PACKETS or AMDs WHOSE DEADLINE is EXPIRED !
 #ifdef RLC_DEBUG
-  std::cout << "\t\t !! DELETE REASSEBLED PACKETS" << std::endl;
+  std::cout << "\t\t !! DELETE REASSEBLED PACKETS, and PACKETS or AMDs WHOSE DEADLINE is EXPIRED !" << std::endl;
 #endif
 
-  for (std::list<int>::iterator iter = packetIdToDelete.begin (); iter != packetIdToDelete.end (); iter++)
+  // sorted, so that each held AMD is looked up in log time
+  std::sort (m_reassembledPackets.begin (), m_reassembledPackets.end ());
+
+  int currentpacketId = -1;
+  it = m_receivedAMDs->begin ();
+  while (it != m_receivedAMDs->end ())
   {
-    std::vector <AmdRecord*> *newAmdList = new std::vector <AmdRecord*>;
-    int id = (*iter);
-    for (std::vector <AmdRecord*>::iterator  itt = m_receivedAMDs->begin (); itt != m_receivedAMDs->end (); itt++)
+    AmdRecord *amdRecord = (*it);
+    if (std::binary_search (m_reassembledPackets.begin (), m_reassembledPackets.end (),
+                            amdRecord->m_packet->GetID ()))
     {
-      AmdRecord *amdRecord = (*itt);
-      double delay = amdRecord->m_packet->GetTimeStamp () + GetRadioBearerInstance ()->GetQoSParameters ()->GetMaxDelay ();
-      if (amdRecord->m_packet->GetID () == id)
-      {
-        delete amdRecord;
-      }
-      else
-      {
-        newAmdList->push_back (amdRecord);
-      }
+      it = m_receivedAMDs->Erase (it);
+      delete amdRecord;
+      continue;
     }
-    m_receivedAMDs->clear();
-    delete m_receivedAMDs;
-    m_receivedAMDs = newAmdList;
-  }
-
-
-  //DELETE PACKETS or AMDs WHOSE DEADLINE is EXPIRED !
-#ifdef RLC_DEBUG
-  std::cout << "\t\t !! DELETE PACKETS or AMDs WHOSE DEADLINE is EXPIRED !" << std::endl;
-#endif
 
-  int currentpacketId = -1;
-  std::vector <AmdRecord*> *newAmdList = new std::vector <AmdRecord*>;
-  for (std::vector <AmdRecord*>::iterator  itt = m_receivedAMDs->begin (); itt != m_receivedAMDs->end (); itt++)
-  {
-    AmdRecord *amdRecord = (*itt);
     double delay = amdRecord->m_packet->GetTimeStamp () + GetRadioBearerInstance ()->GetQoSParameters ()->GetMaxDelay ();
     if ((delay + 0.01) < Simulator::Init()->Now())
     {
@@ -635,17 +575,14 @@ AmRlcEntity::ReceptionProcedureEnd ()
           std::cout  <<  std::endl;
         }
       }
+      it = m_receivedAMDs->Erase (it);
       delete amdRecord;
     }
     else
     {
-      newAmdList->push_back (amdRecord);
+      ++it;
     }
   }
-  m_receivedAMDs->clear();
-  delete m_receivedAMDs;
-  m_receivedAMDs = newAmdList;
-
 
 
 #ifdef RLC_DEBUG
@@ -680,24 +617,16 @@ AmRlcEntity::ReceiveArqRlcIdealControlMessage (ArqRlcIdealControlMessage msg)
 #endif
 
   //delete AMD PDU from m_sentAMDs
-  std::vector<AmdRecord*>::iterator it;
-  for (it = m_sentAMDs->begin(); it != m_sentAMDs->end(); it++)
+  AmdRecord *amdRecord = m_sentAMDs->Remove (msg.GetAck (), msg.GetStartByte ());
+  if (amdRecord != NULL)
   {
-    AmdRecord *amdRecord = (*it);
-    if (amdRecord->m_packet->GetRLCHeader ()->GetRlcPduSequenceNumber () == msg.GetAck()
-        &&
-        amdRecord->m_packet->GetRLCHeader ()->GetStartByte () == msg.GetStartByte ())
-    {
-      m_sentAMDs->erase (it);
-      delete amdRecord;
+    m_unacknowledgedBytes -= amdRecord->m_packet->GetSize () + 5;
+    delete amdRecord;
 
 #ifdef RLC_DEBUG
-      std::cout << " || deleted AMD ||"<< std::endl;
-      PrintSentAMDs ();
+    std::cout << " || deleted AMD ||"<< std::endl;
+    PrintSentAMDs ();
 #endif
-      return;
-    }
-
   }
 }
 
@@ -711,9 +640,9 @@ AmRlcEntity::CheckForDropPackets (double maxDelay, int bearerID)
 
   int currentpacket = -1;
   double now = Simulator::Init()->Now();
-  std::vector <AmdRecord*> *newAmdlist = new std::vector <AmdRecord*> ();
 
-  for (std::vector <AmdRecord*>::iterator  it = m_sentAMDs->begin (); it != m_sentAMDs->end (); it++)
+  AmdWindow::iterator it = m_sentAMDs->begin ();
+  while (it != m_sentAMDs->end ())
   {
     AmdRecord *amdRecord = (*it);
     double HOL = now - amdRecord->m_packet->GetTimeStamp ();
@@ -754,18 +683,16 @@ AmRlcEntity::CheckForDropPackets (double maxDelay, int bearerID)
           std::cout  <<  std::endl;
         }
       }
+      m_unacknowledgedBytes -= amdRecord->m_packet->GetSize () + 5;
+      it = m_sentAMDs->Erase (it);
       delete amdRecord;
     }
     else
     {
-      newAmdlist->push_back (amdRecord);
+      ++it;
     }
   }
 
-  m_sentAMDs->clear();
-  delete m_sentAMDs;
-  m_sentAMDs = newAmdlist;
-
 #ifdef RLC_DEBUG
   PrintSentAMDs ();
 #endif
@@ -774,10 +701,5 @@ AmRlcEntity::CheckForDropPackets (double maxDelay, int bearerID)
   int
 AmRlcEntity::GetSizeOfUnaknowledgedAmd (void)
 {
-  int size = 0;
-  for (std::vector <AmdRecord*>::iterator  it = m_sentAMDs->begin (); it != m_sentAMDs->end (); it++)
-  {
-    size += (*it)->m_packet->GetSize () + 5; //add also MAC and CRC overhead
-  }
-  return size;
+  return m_unacknowledgedBytes;
 }
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "am-state-variables.h"
+#include "amd-window.h"
 #include "rlc-entity.h"
 
 class PacketBurst;
@@ -43,8 +44,8 @@ class AmRlcEntity : public RlcEntity {
 
   AmStateVariables* GetAmStateVariables();
 
-  std::vector<AmdRecord*>* GetSentAMDs(void);
-  std::vector<AmdRecord*>* GetReceivedAMDs(void);
+  AmdWindow* GetSentAMDs(void);
+  AmdWindow* GetReceivedAMDs(void);
 
   void InsertAMDIntoReceptionList(AmdRecord* amd);
 
@@ -62,8 +63,12 @@ class AmRlcEntity : public RlcEntity {
 
  private:
   AmStateVariables* m_amStateVariables;
-  std::vector<AmdRecord*>* m_sentAMDs;
-  std::vector<AmdRecord*>* m_receivedAMDs;
+  AmdWindow* m_sentAMDs;
+  AmdWindow* m_receivedAMDs;
+  int m_unacknowledgedBytes;  // sizes of the sent AMDs with MAC and CRC overhead
+
+  // IDs of the packets reassembled by ReceptionProcedureEnd, kept to reuse
+  std::vector<int> m_reassembledPackets;
 };
 
 #endif /* AMRLCENTITY_H_ */
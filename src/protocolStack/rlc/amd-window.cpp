@@ -0,0 +1,170 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "amd-window.h"
+
+#include "../packet/Packet.h"
+#include "amd-record.h"
+
+AmdWindow::iterator& AmdWindow::iterator::operator++() {
+  if (m_index + 1 < (int)m_window->m_slots[m_sn & m_window->m_mask].size()) {
+    m_index++;
+  } else {
+    m_sn = m_window->NextPending(m_sn + 1);
+    m_index = 0;
+  }
+  return *this;
+}
+
+AmdWindow::AmdWindow(int capacity)
+    : m_slots(capacity), m_pending(capacity / 64, 0), m_mask(capacity - 1),
+      m_low(0), m_high(0), m_size(0) {}
+
+AmdWindow::~AmdWindow() { Clear(); }
+
+AmdRecord* AmdWindow::front(void) const {
+  return m_size == 0 ? NULL : m_slots[m_low & m_mask].front();
+}
+
+AmdWindow::iterator AmdWindow::begin(void) const {
+  return m_size == 0 ? end() : iterator(this, m_low, 0);
+}
+
+int AmdWindow::NextPending(int sn) const {
+  while (sn < m_high) {
+    int bit = sn & m_mask;
+    uint64_t word = m_pending[bit >> 6] >> (bit & 63);
+    if (word != 0) {
+      int next = sn + __builtin_ctzll(word);
+      return next < m_high ? next : -1;
+    }
+    sn += 64 - (bit & 63);
+  }
+  return -1;
+}
+
+int AmdWindow::PreviousPending(int sn) const {
+  while (sn >= m_low) {
+    int bit = sn & m_mask;
+    uint64_t word = m_pending[bit >> 6] << (63 - (bit & 63));
+    if (word != 0) {
+      int previous = sn - __builtin_clzll(word);
+      return previous >= m_low ? previous : -1;
+    }
+    sn -= (bit & 63) + 1;
+  }
+  return -1;
+}
+
+void AmdWindow::Grow(int span) {
+  int capacity = (int)m_slots.size();
+  while (capacity < span) capacity *= 2;
+
+  std::vector<std::vector<AmdRecord*> > slots(capacity);
+  std::vector<uint64_t> pending(capacity / 64, 0);
+  int mask = capacity - 1;
+  for (int sn = NextPending(m_low); sn != -1; sn = NextPending(sn + 1)) {
+    slots[sn & mask].swap(Slot(sn));
+    pending[(sn & mask) >> 6] |= 1ULL << (sn & 63);
+  }
+  m_slots.swap(slots);
+  m_pending.swap(pending);
+  m_mask = mask;
+}
+
+void AmdWindow::Reserve(int sn) {
+  if (m_size == 0) {
+    m_low = sn;
+    m_high = sn + 1;
+  } else if (sn < m_low) {
+    if (m_high - sn > (int)m_slots.size()) Grow(m_high - sn);
+    m_low = sn;
+  } else if (sn >= m_high) {
+    if (sn + 1 - m_low > (int)m_slots.size()) Grow(sn + 1 - m_low);
+    m_high = sn + 1;
+  }
+  m_pending[(sn & m_mask) >> 6] |= 1ULL << (sn & 63);
+}
+
+void AmdWindow::Insert(AmdRecord* amd) {
+  int sn = amd->m_sn;
+  Reserve(sn);
+  std::vector<AmdRecord*>& slot = Slot(sn);
+  std::vector<AmdRecord*>::iterator it = slot.begin();
+  while (it != slot.end() && amd->m_packet->GetRLCHeader()->GetEndByte() >=
+                                 (*it)->m_packet->GetRLCHeader()->GetStartByte()) {
+    it++;
+  }
+  slot.insert(it, amd);
+  m_size++;
+}
+
+void AmdWindow::InsertBefore(iterator it, AmdRecord* amd) {
+  std::vector<AmdRecord*>& slot = Slot(it.m_sn);
+  slot.insert(slot.begin() + it.m_index, amd);
+  m_size++;
+}
+
+void AmdWindow::SlotEmptied(int sn) {
+  m_pending[(sn & m_mask) >> 6] &= ~(1ULL << (sn & 63));
+  if (m_size == 0) {
+    m_low = m_high = sn;
+    return;
+  }
+  if (sn == m_low) m_low = NextPending(sn + 1);
+  if (sn == m_high - 1) m_high = PreviousPending(sn - 1) + 1;
+}
+
+AmdRecord* AmdWindow::Remove(int sn, int startByte) {
+  if (m_size == 0 || sn < m_low || sn >= m_high) return NULL;
+  std::vector<AmdRecord*>& slot = Slot(sn);
+  for (std::vector<AmdRecord*>::iterator it = slot.begin(); it != slot.end(); it++) {
+    AmdRecord* amd = *it;
+    if (amd->m_sn == sn && amd->m_packet->GetRLCHeader()->GetStartByte() == startByte) {
+      slot.erase(it);
+      m_size--;
+      if (slot.empty()) SlotEmptied(sn);
+      return amd;
+    }
+  }
+  return NULL;
+}
+
+AmdWindow::iterator AmdWindow::Erase(iterator it) {
+  std::vector<AmdRecord*>& slot = Slot(it.m_sn);
+  slot.erase(slot.begin() + it.m_index);
+  m_size--;
+  if (it.m_index < (int)slot.size()) return it;
+  if (slot.empty()) SlotEmptied(it.m_sn);
+  return iterator(this, m_size == 0 ? -1 : NextPending(it.m_sn + 1), 0);
+}
+
+void AmdWindow::Clear(void) {
+  for (int sn = NextPending(m_low); m_size > 0 && sn != -1; sn = NextPending(sn + 1)) {
+    std::vector<AmdRecord*>& slot = Slot(sn);
+    for (std::vector<AmdRecord*>::iterator it = slot.begin(); it != slot.end(); it++) {
+      delete *it;
+    }
+    slot.clear();
+  }
+  m_pending.assign(m_pending.size(), 0);
+  m_low = m_high = m_size = 0;
+}
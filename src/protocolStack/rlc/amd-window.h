@@ -0,0 +1,111 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef AMDWINDOW_H_
+#define AMDWINDOW_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+class AmdRecord;
+
+/*
+ * The AMD PDUs an AM RLC entity holds (sent and not acknowledged yet, or
+ * received and not reassembled yet), in a ring of slots indexed by sequence
+ * number modulo the window. A slot keeps the records of one SN, ordered by
+ * position in the SDU: several only when a PDU was re-segmented.
+ *
+ * One bit per slot is set while the slot holds records, so an ack clears it
+ * and the window start jumps to the next pending SN, a word at a time.
+ * Insert and ack are O(1), iteration skips the empty slots. The slots keep
+ * their storage, nothing is reallocated per TTI. The ring only grows (and
+ * rehashes) when the held SNs span more than the window.
+ *
+ * Records are iterated in SN order, as in the list they replace.
+ */
+class AmdWindow {
+ public:
+  class iterator {
+   public:
+    iterator() : m_window(NULL), m_sn(-1), m_index(0) {}
+
+    AmdRecord* operator*() const { return m_window->m_slots[m_sn & m_window->m_mask][m_index]; }
+    iterator& operator++();
+    bool operator==(const iterator& it) const {
+      return m_sn == it.m_sn && m_index == it.m_index;
+    }
+    bool operator!=(const iterator& it) const { return !(*this == it); }
+
+   private:
+    friend class AmdWindow;
+    iterator(const AmdWindow* window, int sn, int index)
+        : m_window(window), m_sn(sn), m_index(index) {}
+
+    const AmdWindow* m_window;
+    int m_sn;  // -1 past the last record
+    int m_index;
+  };
+
+  // capacity: a power of two, at least 64
+  AmdWindow(int capacity);
+  virtual ~AmdWindow();
+
+  int size(void) const { return m_size; }
+  bool empty(void) const { return m_size == 0; }
+  // the record with the lowest SN
+  AmdRecord* front(void) const;
+  iterator begin(void) const;
+  iterator end(void) const { return iterator(); }
+
+  // after the records of its SN that start after it ends, as
+  // AmRlcEntity::InsertAMDIntoReceptionList always did
+  void Insert(AmdRecord* amd);
+  // before it, with the same SN: the sent part of a re-segmented AMD
+  void InsertBefore(iterator it, AmdRecord* amd);
+  // the record of sn starting at startByte, NULL if none; not deleted
+  AmdRecord* Remove(int sn, int startByte);
+  // removes the record (not deleted) and returns the next one
+  iterator Erase(iterator it);
+  // deletes all the records
+  void Clear(void);
+
+ private:
+  std::vector<AmdRecord*>& Slot(int sn) { return m_slots[sn & m_mask]; }
+  // the first SN >= sn holding records, -1 if none
+  int NextPending(int sn) const;
+  // the last SN <= sn holding records, -1 if none
+  int PreviousPending(int sn) const;
+  // makes room for sn, which the window must hold next
+  void Reserve(int sn);
+  void Grow(int span);
+  void SlotEmptied(int sn);
+
+  std::vector<std::vector<AmdRecord*> > m_slots;
+  std::vector<uint64_t> m_pending;
+  int m_mask;
+  int m_low;   // lowest SN held
+  int m_high;  // highest SN held + 1
+  int m_size;
+};
+
+#endif /* AMDWINDOW_H_ */
@@ -28,6 +28,7 @@
 #include "../../flows/application/Application.h"
 #include "../../device/NetworkNode.h"
 #include "../../load-parameters.h"
+#include "../../utility/phase-profiler.h"
 #include <unordered_map>
 #include <cstdio>
 
@@ -48,6 +49,7 @@ UmRlcEntity::~UmRlcEntity()
   PacketBurst*
 UmRlcEntity::TransmissionProcedure (int availableBytes)
 {
+  PROFILE_PHASE (PHASE_RLC_TX);
 #ifdef RLC_DEBUG
   std::cout << "UM RLC tx procedure for node " << GetRadioBearerInstance ()->GetSource ()->GetIDNetworkNode ()<< std::endl;
 #endif
@@ -197,6 +199,7 @@ UmRlcEntity::TransmissionProcedure (int availableBytes)
   void
 UmRlcEntity::ReceptionProcedure (Packet* p)
 {
+  PROFILE_PHASE (PHASE_RLC_RX);
 #ifdef RLC_DEBUG
   std::cout << "UM RLC rx procedure for node " << GetRadioBearerInstance ()->GetDestination ()->GetIDNetworkNode ()<< std::endl;
   std::cout << "RECEIVE PACKET id " << p->GetID() << " frag n " << p->GetRLCHeader ()->GetFragmentNumber ()<< std::endl;
@@ -29,10 +29,15 @@
 #include "../../../core/spectrum/bandwidth-manager.h"
 #include "../../../phy/lte-phy.h"
 #include "../../../utility/ComputePathLoss.h"
+#include "../../../core/eventScheduler/simulator.h"
+#include <algorithm>
 
 PowerBasedHoManager::PowerBasedHoManager()
 {
   m_target = NULL;
+  m_hysteresis = 0.0;
+  m_timeToTrigger = 0.0;
+  m_refreshDistance = HO_REFRESH_DISTANCE;
 }
 
 PowerBasedHoManager::~PowerBasedHoManager()
@@ -40,85 +45,194 @@ PowerBasedHoManager::~PowerBasedHoManager()
   m_target = NULL;
 }
 
-bool
-PowerBasedHoManager::CheckHandoverNeed (UserEquipment* ue)
+void
+PowerBasedHoManager::SetHysteresis (double hysteresis)
 {
-  NetworkNode *targetNode = ue->GetTargetNode ();
+  m_hysteresis = hysteresis;
+}
 
-  double TXpower = 10 * log10 (
-		  pow (10., (targetNode->GetPhy()->GetTxPower() - 30)/10)
-		  /
-		  targetNode->GetPhy()->GetBandwidthManager()->GetDlSubChannels().size () );
-  double pathLoss = ComputePathLossForInterference(targetNode, ue);
+double
+PowerBasedHoManager::GetHysteresis (void) const
+{
+  return m_hysteresis;
+}
+
+void
+PowerBasedHoManager::SetTimeToTrigger (double timeToTrigger)
+{
+  m_timeToTrigger = timeToTrigger;
+}
 
-  double targetRXpower = TXpower - pathLoss;
-  double RXpower;
+double
+PowerBasedHoManager::GetTimeToTrigger (void) const
+{
+  return m_timeToTrigger;
+}
 
+void
+PowerBasedHoManager::SetRefreshDistance (double distance)
+{
+  m_refreshDistance = distance;
+}
 
-  std::vector<ENodeB*> *listOfNodes = NetworkManager::Init ()->GetENodeBContainer ();
-  std::vector<ENodeB*>::iterator it;
-  for (it = listOfNodes->begin (); it != listOfNodes->end (); it++)
+double
+PowerBasedHoManager::GetRefreshDistance (void) const
+{
+  return m_refreshDistance;
+}
+
+PowerBasedHoManager::UeState::UeState ()
+{
+  m_valid = false;
+  m_scanX = 0;
+  m_scanY = 0;
+  m_scanIndoor = false;
+  m_pendingTarget = NULL;
+  m_pendingSince = 0;
+}
+
+PowerBasedHoManager::UeState&
+PowerBasedHoManager::GetUeState (UserEquipment* ue)
+{
+  int id = ue->GetIDNetworkNode ();
+  if (id < 0)
     {
-	  if ((*it)->GetIDNetworkNode () != targetNode->GetIDNetworkNode () )
-	    {
-
-	      NetworkNode *probableNewTargetNode = (*it);
-
-	      TXpower = 10 * log10 (
-				  pow (10., (probableNewTargetNode->GetPhy()->GetTxPower() - 30)/10)
-				  /
-				  probableNewTargetNode->GetPhy()->GetBandwidthManager()->GetDlSubChannels().size () );
-	      pathLoss = ComputePathLossForInterference(probableNewTargetNode, ue);
-
-	      RXpower = TXpower - pathLoss;
-
-	      if (RXpower > targetRXpower)
-	        {
-	    	  if (NetworkManager::Init()->CheckHandoverPermissions(probableNewTargetNode,ue))
-	    	  {
-		    	  targetRXpower = RXpower;
-			      targetNode = probableNewTargetNode;
-	    	  }
-	        }
-	    }
+      m_unindexedState = UeState ();
+      return m_unindexedState;
     }
-
-  std::vector<HeNodeB*> *listOfNodes2 = NetworkManager::Init ()->GetHomeENodeBContainer();
-  std::vector<HeNodeB*>::iterator it2;
-  for (it2 = listOfNodes2->begin (); it2 != listOfNodes2->end (); it2++)
+  if (id >= (int) m_ueStates.size ())
     {
-	  if ((*it2)->GetIDNetworkNode () != targetNode->GetIDNetworkNode () )
-	    {
+      m_ueStates.resize (id + 1);
+    }
+  return m_ueStates[id];
+}
 
-	      NetworkNode *probableNewTargetNode = (*it2);
+bool
+PowerBasedHoManager::CompareCandidatePower (const Candidate& a, const Candidate& b)
+{
+  if (a.m_rxPower != b.m_rxPower)
+    {
+      return a.m_rxPower > b.m_rxPower;
+    }
+  return a.m_order < b.m_order;
+}
 
-	      TXpower =   10 * log10 (
-				  pow (10., (probableNewTargetNode->GetPhy()->GetTxPower() - 30)/10)
-				  /
-				  probableNewTargetNode->GetPhy()->GetBandwidthManager()->GetDlSubChannels().size () );
+bool
+PowerBasedHoManager::CompareCandidateOrder (const Candidate& a, const Candidate& b)
+{
+  return a.m_order < b.m_order;
+}
 
-	      pathLoss = ComputePathLossForInterference(probableNewTargetNode, ue);
+void
+PowerBasedHoManager::ScanCandidates (UserEquipment* ue, UeState& state)
+{
+  NetworkManager *nm = NetworkManager::Init ();
+  std::vector<Candidate>& candidates = state.m_candidates;
+  candidates.clear ();
 
-	      RXpower = TXpower - pathLoss;
+  int order = 0;
+  std::vector<ENodeB*> *listOfNodes = nm->GetENodeBContainer ();
+  for (size_t i = 0; i < listOfNodes->size (); i++, order++)
+    {
+      NetworkNode *node = listOfNodes->at (i);
+      if (node == ue->GetTargetNode () || nm->CheckHandoverPermissions (node, ue))
+        {
+          Candidate c;
+          c.m_node = node;
+          c.m_order = order;
+          c.m_rxPower = node->GetPhy ()->GetTxPowerPerSubChannel () - ComputePathLossForInterference (node, ue);
+          candidates.push_back (c);
+        }
+    }
+  std::vector<HeNodeB*> *listOfNodes2 = nm->GetHomeENodeBContainer ();
+  for (size_t i = 0; i < listOfNodes2->size (); i++, order++)
+    {
+      NetworkNode *node = listOfNodes2->at (i);
+      if (node == ue->GetTargetNode () || nm->CheckHandoverPermissions (node, ue))
+        {
+          Candidate c;
+          c.m_node = node;
+          c.m_order = order;
+          c.m_rxPower = node->GetPhy ()->GetTxPowerPerSubChannel () - ComputePathLossForInterference (node, ue);
+          candidates.push_back (c);
+        }
+    }
 
-	      if (RXpower > targetRXpower)
-	        {
-	    	  if (NetworkManager::Init()->CheckHandoverPermissions(probableNewTargetNode,ue))
-	    	  {
-		    	  targetRXpower = RXpower;
-			      targetNode = probableNewTargetNode;
-	    	  }
-	        }
-	    }
+  // keep the strongest ones, in container order so that ties resolve as
+  // in a scan of all the nodes
+  if (candidates.size () > HO_NB_CANDIDATES)
+    {
+      std::nth_element (candidates.begin (),
+                        candidates.begin () + HO_NB_CANDIDATES - 1,
+                        candidates.end (),
+                        CompareCandidatePower);
+      candidates.resize (HO_NB_CANDIDATES);
     }
+  std::sort (candidates.begin (), candidates.end (), CompareCandidateOrder);
+
+  CartesianCoordinates *position = ue->GetMobilityModel ()->GetAbsolutePosition ();
+  state.m_scanX = position->GetCoordinateX ();
+  state.m_scanY = position->GetCoordinateY ();
+  state.m_scanIndoor = ue->IsIndoor ();
+  state.m_valid = true;
+}
 
-  if (ue->GetTargetNode ()->GetIDNetworkNode () != targetNode->GetIDNetworkNode ())
+bool
+PowerBasedHoManager::CheckHandoverNeed (UserEquipment* ue)
+{
+  NetworkNode *servingNode = ue->GetTargetNode ();
+  UeState& state = GetUeState (ue);
+  CartesianCoordinates *position = ue->GetMobilityModel ()->GetAbsolutePosition ();
+
+  if (!state.m_valid
+      || state.m_scanIndoor != ue->IsIndoor ()
+      || position->GetDistance (state.m_scanX, state.m_scanY) > m_refreshDistance
+      || m_refreshDistance <= 0)
     {
-	  m_target = targetNode;
-	  return true;
+      ScanCandidates (ue, state);
     }
   else
     {
-	  return false;
+      for (size_t i = 0; i < state.m_candidates.size (); i++)
+        {
+          Candidate& c = state.m_candidates[i];
+          c.m_rxPower = c.m_node->GetPhy ()->GetTxPowerPerSubChannel () - ComputePathLossForInterference (c.m_node, ue);
+        }
+    }
+
+  double targetRXpower = servingNode->GetPhy ()->GetTxPowerPerSubChannel ()
+      - ComputePathLossForInterference (servingNode, ue) + m_hysteresis;
+  NetworkNode *targetNode = NULL;
+  for (size_t i = 0; i < state.m_candidates.size (); i++)
+    {
+      const Candidate& c = state.m_candidates[i];
+      if (c.m_node->GetIDNetworkNode () != servingNode->GetIDNetworkNode ()
+          && c.m_rxPower > targetRXpower)
+        {
+          targetRXpower = c.m_rxPower;
+          targetNode = c.m_node;
+        }
+    }
+
+  if (targetNode == NULL)
+    {
+      state.m_pendingTarget = NULL;
+      return false;
     }
+
+  // time to trigger: the same candidate has to win for long enough
+  double now = Simulator::Init ()->Now ();
+  if (state.m_pendingTarget != targetNode)
+    {
+      state.m_pendingTarget = targetNode;
+      state.m_pendingSince = now;
+    }
+  if (now - state.m_pendingSince < m_timeToTrigger)
+    {
+      return false;
+    }
+
+  state.m_pendingTarget = NULL;
+  m_target = targetNode;
+  return true;
 }
@@ -22,14 +22,70 @@
 #ifndef POWERBASEDHOMANAGER_H_
 #define POWERBASEDHOMANAGER_H_
 
+#include <vector>
+
 #include "ho-manager.h"
 
+#define HO_NB_CANDIDATES 8        // strongest neighbours tracked per UE
+#define HO_REFRESH_DISTANCE 20.0  // m moved before a full neighbour scan
+
+/*
+ * Hands a UE over to the node with the strongest received power.
+ *
+ * Every UE keeps its HO_NB_CANDIDATES strongest permitted neighbours. The
+ * list is rebuilt from all the eNBs and HeNBs only when the UE has moved
+ * more than the refresh distance since the last scan, or went in or out of
+ * a building. In between, a check only evaluates the serving node and the
+ * listed candidates. The lists live in the manager of the serving node: a
+ * UE handed over to this node starts with a full scan.
+ *
+ * A candidate triggers a handover when it beats the serving node by the
+ * hysteresis margin for at least the time to trigger. With the defaults
+ * (0 dB, 0 s) the first check that sees a stronger node triggers.
+ */
 class PowerBasedHoManager : public HoManager {
  public:
   PowerBasedHoManager();
   virtual ~PowerBasedHoManager();
 
   virtual bool CheckHandoverNeed(UserEquipment* ue);
+
+  void SetHysteresis(double hysteresis);  // dB
+  double GetHysteresis(void) const;
+  void SetTimeToTrigger(double timeToTrigger);  // s
+  double GetTimeToTrigger(void) const;
+  void SetRefreshDistance(double distance);  // m, 0 scans at every check
+  double GetRefreshDistance(void) const;
+
+ private:
+  struct Candidate {
+    NetworkNode* m_node;
+    int m_order;  // position in the node containers, breaks ties
+    double m_rxPower;
+  };
+
+  // per UE served by this node, indexed by UE ID
+  struct UeState {
+    UeState();
+    bool m_valid;
+    double m_scanX;
+    double m_scanY;
+    bool m_scanIndoor;
+    std::vector<Candidate> m_candidates;
+    NetworkNode* m_pendingTarget;
+    double m_pendingSince;
+  };
+  UeState& GetUeState(UserEquipment* ue);
+  static bool CompareCandidatePower(const Candidate& a, const Candidate& b);
+  static bool CompareCandidateOrder(const Candidate& a, const Candidate& b);
+
+  void ScanCandidates(UserEquipment* ue, UeState& state);
+
+  double m_hysteresis;
+  double m_timeToTrigger;
+  double m_refreshDistance;
+  std::vector<UeState> m_ueStates;
+  UeState m_unindexedState;
 };
 
 #endif /* POWERBASEDHOMANAGER_H_ */
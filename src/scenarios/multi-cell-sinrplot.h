@@ -49,8 +49,8 @@
 #include "../phy/ue-lte-phy.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
 #include "../utility/UsersDistribution.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 using namespace std;
 
@@ -91,9 +91,9 @@ static void MultiCellSinrPlot(int nbCell, double radius, int nbUE,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cout << "Simulation with SEED = " << seed << std::endl;
 
@@ -153,7 +153,7 @@ static void MultiCellSinrPlot(int nbCell, double radius, int nbUE,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -201,13 +201,13 @@ static void MultiCellSinrPlot(int nbCell, double radius, int nbUE,
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   // nbUE is the number of users of the whole multicell scenario
   // Create UEs
@@ -216,7 +216,9 @@ static void MultiCellSinrPlot(int nbCell, double radius, int nbUE,
     double posX = 0;
     double posY = 0;
     int idUE = i;  // place in first cell
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection =
+        (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+        ((2 * 3.14) / 360);
     ;
 
     UserEquipment *ue =
@@ -236,7 +238,7 @@ static void MultiCellSinrPlot(int nbCell, double radius, int nbUE,
     cqiManager->SetReportingInterval(1);
     cqiManager->SetDevice(ue);
     ue->SetCqiManager(cqiManager);
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     // register ue to the enb
     eNBs->at(0)->RegisterUserEquipment(ue);
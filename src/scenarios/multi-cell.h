@@ -46,8 +46,8 @@
 #include "../phy/ue-lte-phy.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
 #include "../utility/UsersDistribution.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
@@ -69,9 +69,9 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cout << "Simulation with SEED = " << seed << std::endl;
 
@@ -131,7 +131,7 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -179,7 +179,7 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -197,7 +197,7 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   // nbUE is the number of users that are into each cell at the beginning of the
   // simulation
@@ -212,7 +212,9 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
       // ue's random position
       double posX = positions->at(i)->GetCoordinateX();
       double posY = positions->at(i)->GetCoordinateY();
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+          ((2 * 3.14) / 360);
       ;
 
       UserEquipment *ue = new UserEquipment(
@@ -234,7 +236,7 @@ static void MultiCell(int nbCell, double radius, int nbUE, int nbVoIP,
       cqiManager->SetDevice(ue);
       ue->SetCqiManager(cqiManager);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       // register ue to the enb
       eNBs->at(j)->RegisterUserEquipment(ue);
@@ -0,0 +1,469 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef SCALE_TEST_H_
+#define SCALE_TEST_H_
+
+#include <jsoncpp/json/json.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../channel/LteChannel.h"
+#include "../channel/propagation-model/macrocell-urban-area-channel-realization.h"
+#include "../componentManagers/FrameManager.h"
+#include "../componentManagers/SnapshotManager.h"
+#include "../core/eventScheduler/simulator.h"
+#include "../core/spectrum/bandwidth-manager.h"
+#include "../device/CqiManager/trace-cqi-manager.h"
+#include "../device/IPClassifier/ClassifierParameters.h"
+#include "../flows/QoS/QoSParameters.h"
+#include "../flows/application/InfiniteBuffer.h"
+#include "../flows/application/InternetFlow.h"
+#include "../flows/application/TraceBased.h"
+#include "../load-parameters.h"
+#include "../networkTopology/Cell.h"
+#include "../phy/enb-lte-phy.h"
+#include "../phy/ue-lte-phy.h"
+#include "../phy/wideband-cqi-eesm-error-model.h"
+#include "../protocolStack/mac/packet-scheduler/scheduler-input-trace.h"
+#include "../utility/UsersDistribution.h"
+#include "../utility/counter-rng.h"
+#include "../utility/frequency-reuse-helper.h"
+#include "../utility/seed.h"
+
+/*
+ * ScaleTest: a synthetic stress scenario, N cells on the hexagonal layout
+ * with M UEs each, entirely described by a JSON file:
+ *
+ *   {
+ *     "cells": 19, "ues_per_cell": 100, "duration": 2,
+ *     "radius": 0.5, "bandwidth": 10, "cluster": 1,
+ *     "scheduler": 9, "speed": 3, "handover": false, "seed": 1,
+ *     "channel_model": "propagation", "video_random_offset": false,
+ *     "slices": [ ... as in config.json ... ],
+ *     "ues_per_slice": [ ... the slice mix of one cell ... ]
+ *   }
+ *
+ * "slices" gives the weights, the algorithm and the traffic mix of the
+ * slices (video_app, internet_flow and backlog_flow per UE). Every cell
+ * runs the same slices; "ues_per_slice" is rescaled to "ues_per_cell" when
+ * both are given. cells and ues_per_cell can be overridden on the command
+ * line, so that a sweep needs a single file. With "video_random_offset"
+ * every video flow starts at a random frame of its trace, so that flows
+ * playing the same trace are not in lockstep.
+ *
+ * When the simulation ends, a summary for the benchmark harness is printed
+ * on stderr: lines starting with "BENCH " (wall time per simulated second,
+ * events/s, peak RSS) and "BENCH_SUBSYSTEM " (wall time per event handler
+ * class).
+ */
+
+struct ScaleTestSlice {
+  int nb_video;
+  int nb_internetflow;
+  int nb_backlogflow;
+  std::vector<int> video_bitrate;  // kbps, per UE
+  std::vector<double> if_bitrate;  // Mbps, aggregate of the slice in a cell
+};
+
+static std::string ScaleTestVideoTrace(int bitrate) {
+  switch (bitrate) {
+    case 128:
+    case 242:
+    case 440:
+    case 880:
+    case 1280:
+      break;
+    default:
+      bitrate = 128;
+      break;
+  }
+  return path + "src/flows/application/Trace/foreman_H264_" +
+         std::to_string(bitrate) + "k.dat";
+}
+
+// rescales the slice mix to nbUE users, largest remainder first
+static std::vector<int> ScaleTestUesPerSlice(const std::vector<int> &mix,
+                                             int nbUE) {
+  int total = 0;
+  for (size_t s = 0; s < mix.size(); s++) total += mix[s];
+  std::vector<int> ues(mix.size(), 0);
+  if (total == 0) return ues;
+
+  std::vector<std::pair<double, int> > remainders;
+  int assigned = 0;
+  for (size_t s = 0; s < mix.size(); s++) {
+    double share = (double)mix[s] * nbUE / total;
+    ues[s] = (int)share;
+    assigned += ues[s];
+    remainders.push_back(std::make_pair(-(share - ues[s]), (int)s));
+  }
+  std::sort(remainders.begin(), remainders.end());
+  for (int i = 0; assigned < nbUE; i++, assigned++)
+    ues[remainders[i % remainders.size()].second]++;
+  return ues;
+}
+
+static void ScaleTestReport(int nbCells, int nbUEPerCell, double duration,
+                            double setupSeconds, double runSeconds) {
+  Simulator *simulator = Simulator::Init();
+  uint64_t events = simulator->GetNbProcessedEvents();
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  std::cerr << "BENCH cells " << nbCells << " ues_per_cell " << nbUEPerCell
+            << " sim_seconds " << duration << " setup_seconds "
+            << setupSeconds << " wall_seconds " << runSeconds
+            << " wall_per_sim_second " << runSeconds / duration << " events "
+            << events << " events_per_second "
+            << (runSeconds > 0 ? events / runSeconds : 0)
+            << " peak_rss_kb " << usage.ru_maxrss << std::endl;
+  simulator->PrintEventProfile(std::cerr, "BENCH_SUBSYSTEM ");
+}
+
+static void ScaleTest(string config_fname, int nbCellsOverride = -1,
+                      int nbUEOverride = -1) {
+  std::chrono::steady_clock::time_point setupStart =
+      std::chrono::steady_clock::now();
+
+  std::ifstream ifs(config_fname);
+  Json::Reader reader;
+  Json::Value obj;
+  if (!reader.parse(ifs, obj)) {
+    throw std::runtime_error("Error, failed to parse the json config file.");
+  }
+
+  int nbCells = obj.get("cells", 7).asInt();
+  double radius = obj.get("radius", 0.5).asDouble();
+  double duration = obj.get("duration", 1.0).asDouble();
+  double bandwidth = obj.get("bandwidth", 10).asDouble();
+  int cluster = obj.get("cluster", 1).asInt();
+  int sched_type = obj.get("scheduler", 9).asInt();
+  int speed = obj.get("speed", 3).asInt();
+  bool handover = obj.get("handover", false).asBool();
+  int seed = obj.get("seed", 1).asInt();
+  bool trace_driven =
+      obj.get("channel_model", "propagation").asString() == "trace";
+  bool video_random_offset = obj.get("video_random_offset", false).asBool();
+  if (nbCellsOverride > 0) nbCells = nbCellsOverride;
+
+  std::vector<int> mix;
+  const Json::Value &ues_per_slice = obj["ues_per_slice"];
+  for (int s = 0; s < (int)ues_per_slice.size(); s++)
+    mix.push_back(ues_per_slice[s].asInt());
+  int nbUEPerCell = obj.get("ues_per_cell", -1).asInt();
+  if (nbUEOverride >= 0) nbUEPerCell = nbUEOverride;
+  std::vector<int> slice_ues =
+      nbUEPerCell >= 0 ? ScaleTestUesPerSlice(mix, nbUEPerCell) : mix;
+  int num_slices = slice_ues.size();
+  nbUEPerCell = 0;
+  for (int s = 0; s < num_slices; s++) nbUEPerCell += slice_ues[s];
+
+  std::vector<ScaleTestSlice> slices;
+  const Json::Value &slice_schemes = obj["slices"];
+  for (int i = 0; i < (int)slice_schemes.size(); i++) {
+    for (int j = 0; j < slice_schemes[i]["n_slices"].asInt(); j++) {
+      ScaleTestSlice slice;
+      slice.nb_video = slice_schemes[i]["video_app"].asInt();
+      slice.nb_internetflow = slice_schemes[i]["internet_flow"].asInt();
+      slice.nb_backlogflow = slice_schemes[i]["backlog_flow"].asInt();
+      const Json::Value &video_bitrate = slice_schemes[i]["video_bitrate"];
+      for (int k = 0; k < (int)video_bitrate.size(); k++)
+        slice.video_bitrate.push_back(video_bitrate[k].asInt());
+      const Json::Value &if_bitrate = slice_schemes[i]["if_bitrate"];
+      for (int k = 0; k < (int)if_bitrate.size(); k++)
+        slice.if_bitrate.push_back(if_bitrate[k].asDouble());
+      slices.push_back(slice);
+    }
+  }
+  if ((int)slices.size() != num_slices) {
+    std::cerr << "ERROR: " << slices.size() << " slices defined, "
+              << num_slices << " in ues_per_slice" << std::endl;
+    exit(1);
+  }
+
+  /*
+   * The schedulers map a UE ID to its slice through the ues_per_slice of
+   * their config file, counted over the whole network: UE IDs are given
+   * slice by slice, and the schedulers read a copy of the config in which
+   * every slice has the UEs of all the cells.
+   */
+  std::vector<int> slice_first_id(num_slices, 0);
+  Json::Value sched_obj = obj;
+  sched_obj["ues_per_slice"] = Json::Value(Json::arrayValue);
+  for (int s = 0; s < num_slices; s++) {
+    if (s > 0)
+      slice_first_id[s] = slice_first_id[s - 1] + slice_ues[s - 1] * nbCells;
+    sched_obj["ues_per_slice"].append(slice_ues[s] * nbCells);
+  }
+  char sched_fname[] = "/tmp/scale-test-XXXXXX";
+  int fd = mkstemp(sched_fname);
+  if (fd < 0) {
+    std::cerr << "ERROR: unable to create the scheduler config" << std::endl;
+    exit(1);
+  }
+  close(fd);
+  {
+    std::ofstream sched_ofs(sched_fname);
+    Json::FastWriter writer;
+    sched_ofs << writer.write(sched_obj);
+  }
+
+  // CREATE COMPONENT MANAGER
+  Simulator *simulator = Simulator::Init();
+  FrameManager *frameManager = FrameManager::Init();
+  NetworkManager *nm = NetworkManager::Init();
+  simulator->SetEventProfiling(obj.get("profile", true).asBool());
+
+  // CONFIGURE SEED
+  if (seed >= 0) {
+    CounterRng::SetGlobalSeed(GetCommonSeed(seed));
+  } else {
+    CounterRng::SetGlobalSeed(time(NULL));
+  }
+
+  ENodeB::DLSchedulerType downlink_scheduler_type;
+  switch (sched_type) {
+    case 1:
+      downlink_scheduler_type = ENodeB::DLScheduler_TYPE_PROPORTIONAL_FAIR;
+      break;
+    case 7:
+      downlink_scheduler_type = ENodeB::DLScheduler_NVS;
+      break;
+    case 8:
+      downlink_scheduler_type = ENodeB::DLScheduler_SEQUENTIAL;
+      break;
+    case 9:
+      downlink_scheduler_type = ENodeB::DLScheduler_MAXCELL;
+      break;
+    case 10:
+      downlink_scheduler_type = ENodeB::DLScheduler_UpperBound;
+      break;
+    case 11:
+      downlink_scheduler_type = ENodeB::DLScheduler_NVS_NONGREEDY;
+      break;
+    default:
+      throw std::runtime_error("Undefined Scheduler: " +
+                               std::to_string(sched_type));
+  }
+  frameManager->SetFrameStructure(FrameManager::FRAME_STRUCTURE_FDD);
+
+  std::cerr << "ScaleTest: " << nbCells << " cells, " << nbUEPerCell
+            << " UEs per cell, " << num_slices << " slices, " << duration
+            << " s, SEED = " << seed << std::endl;
+
+  // create cells, channels and eNBs
+  std::vector<Cell *> cells;
+  for (int i = 0; i < nbCells; i++) {
+    CartesianCoordinates center =
+        GetCartesianCoordinatesForCell(i, radius * 1000.);
+    Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
+                       center.GetCoordinateY());
+    cells.push_back(c);
+    nm->AddCell(c);
+  }
+
+  std::vector<BandwidthManager *> spectrums =
+      RunFrequencyReuseTechniques(nbCells, cluster, bandwidth);
+
+  std::vector<LteChannel *> dlChannels;
+  std::vector<LteChannel *> ulChannels;
+  std::vector<ENodeB *> eNBs;
+  for (int i = 0; i < nbCells; i++) {
+    LteChannel *dlCh = new LteChannel();
+    dlCh->SetChannelId(i);
+    dlCh->SetTraceDriven(trace_driven);
+    dlChannels.push_back(dlCh);
+    LteChannel *ulCh = new LteChannel();
+    ulCh->SetChannelId(i);
+    ulCh->SetTraceDriven(trace_driven);
+    ulChannels.push_back(ulCh);
+
+    ENodeB *enb = new ENodeB(i, cells.at(i));
+    enb->GetPhy()->SetDlChannel(dlCh);
+    enb->GetPhy()->SetUlChannel(ulCh);
+    enb->SetDLScheduler(downlink_scheduler_type, sched_fname);
+    enb->GetPhy()->SetBandwidthManager(spectrums.at(i));
+    ulCh->AddDevice((NetworkNode *)enb);
+    nm->AddENodeB(enb);
+    eNBs.push_back(enb);
+  }
+  // a snapshot restores the schedulers from the config, after the setup
+  SnapshotManager *snapshot = SnapshotManager::Init();
+  // and a capture of the scheduler inputs copies it with the first TTI
+  if (snapshot->IsEnabled()) {
+    snapshot->AddTemporaryFile(sched_fname);
+  } else if (SchedulerInputTrace::Init()->IsRecording()) {
+    SchedulerInputTrace::Init()->AddTemporaryFile(sched_fname);
+  } else {
+    unlink(sched_fname);
+  }
+
+  Gateway *gw = new Gateway();
+  nm->AddGateway(gw);
+
+  vector<TraceBased *> VideoApplication;
+  vector<InfiniteBuffer *> BEApplication;
+  vector<InternetFlow *> IPApplication;
+  int destinationPort = 101;
+  int applicationID = 0;
+  double start_time = 0.1;
+  double duration_time = start_time + duration;
+
+  for (int c = 0; c < nbCells; c++) {
+    ENodeB *enb = eNBs.at(c);
+    vector<CartesianCoordinates *> *positions =
+        GetUniformUsersDistribution(c, nbUEPerCell);
+    int position = 0;
+
+    for (int s = 0; s < num_slices; s++) {
+      const ScaleTestSlice &slice = slices[s];
+      for (int j = 0; j < slice_ues[s]; j++, position++) {
+        int idUE = slice_first_id[s] + c * slice_ues[s] + j;
+        double posX = positions->at(position)->GetCoordinateX();
+        double posY = positions->at(position)->GetCoordinateY();
+        double speedDirection =
+            CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextUniform(360.) *
+            ((2. * 3.14) / 360.);
+
+        UserEquipment *ue = new UserEquipment(
+            idUE, posX, posY, speed, speedDirection, cells.at(c), enb,
+            handover,
+            speed > 0 ? Mobility::RANDOM_DIRECTION
+                      : Mobility::CONSTANT_POSITION);
+        ue->GetPhy()->SetDlChannel(enb->GetPhy()->GetDlChannel());
+        ue->GetPhy()->SetUlChannel(enb->GetPhy()->GetUlChannel());
+
+        CqiManager *cqiManager;
+        if (trace_driven) {
+          cqiManager = new TraceCqiManager();
+        } else {
+          cqiManager = new FullbandCqiManager();
+        }
+        cqiManager->SetCqiReportingMode(CqiManager::PERIODIC);
+        cqiManager->SetReportingInterval(40);
+        cqiManager->SetDevice(ue);
+        ue->SetCqiManager(cqiManager);
+        ue->GetPhy()->SetErrorModel(new WidebandCqiEesmErrorModel());
+
+        nm->AddUserEquipment(ue);
+        enb->RegisterUserEquipment(ue);
+
+        if (!trace_driven) {
+          enb->GetPhy()->GetDlChannel()->GetPropagationLossModel()
+              ->AddChannelRealization(
+                  new MacroCellUrbanAreaChannelRealization(enb, ue));
+          enb->GetPhy()->GetUlChannel()->GetPropagationLossModel()
+              ->AddChannelRealization(
+                  new MacroCellUrbanAreaChannelRealization(ue, enb));
+        }
+
+        for (int k = 0; k < slice.nb_video; k++) {
+          TraceBased *video_app = new TraceBased();
+          VideoApplication.push_back(video_app);
+          video_app->SetSource(gw);
+          video_app->SetDestination(ue);
+          video_app->SetApplicationID(applicationID);
+          video_app->SetStartTime(start_time);
+          video_app->SetStopTime(duration_time);
+          video_app->SetTraceFile(
+              ScaleTestVideoTrace(k < (int)slice.video_bitrate.size()
+                                      ? slice.video_bitrate[k]
+                                      : 0));
+          video_app->SetRandomStartOffset(video_random_offset);
+          video_app->SetClassifierParameters(new ClassifierParameters(
+              gw->GetIDNetworkNode(), ue->GetIDNetworkNode(), 0,
+              destinationPort, TransportProtocol::TRANSPORT_PROTOCOL_TYPE_UDP));
+          destinationPort++;
+          applicationID++;
+        }
+
+        for (int k = 0; k < slice.nb_backlogflow; k++) {
+          InfiniteBuffer *be_app = new InfiniteBuffer();
+          BEApplication.push_back(be_app);
+          be_app->SetSource(gw);
+          be_app->SetDestination(ue);
+          be_app->SetApplicationID(applicationID);
+          be_app->SetStartTime(start_time);
+          be_app->SetStopTime(duration_time);
+          be_app->SetQoSParameters(new QoSParameters());
+          be_app->SetClassifierParameters(new ClassifierParameters(
+              gw->GetIDNetworkNode(), ue->GetIDNetworkNode(), 0,
+              destinationPort, TransportProtocol::TRANSPORT_PROTOCOL_TYPE_UDP));
+          destinationPort++;
+          applicationID++;
+        }
+
+        for (int k = 0; k < slice.nb_internetflow; k++) {
+          InternetFlow *ip_app = new InternetFlow();
+          IPApplication.push_back(ip_app);
+          ip_app->SetSource(gw);
+          ip_app->SetDestination(ue);
+          ip_app->SetApplicationID(applicationID);
+          ip_app->SetStartTime(start_time);
+          ip_app->SetStopTime(duration_time);
+          ip_app->SetAvgRate(slice.if_bitrate[k] / slice_ues[s]);
+          ip_app->SetPriority(k);
+          ip_app->SetQoSParameters(new QoSParameters());
+          ip_app->SetClassifierParameters(new ClassifierParameters(
+              gw->GetIDNetworkNode(), ue->GetIDNetworkNode(), 0,
+              destinationPort, TransportProtocol::TRANSPORT_PROTOCOL_TYPE_UDP));
+          destinationPort++;
+          applicationID++;
+        }
+      }
+    }
+
+    for (size_t i = 0; i < positions->size(); i++) delete positions->at(i);
+    delete positions;
+  }
+
+  simulator->SetStop(duration_time);
+
+  std::chrono::steady_clock::time_point runStart =
+      std::chrono::steady_clock::now();
+  simulator->Run();
+  std::chrono::steady_clock::time_point runEnd =
+      std::chrono::steady_clock::now();
+  snapshot->RemoveTemporaryFiles();
+
+  ScaleTestReport(
+      nbCells, nbUEPerCell, duration_time,
+      std::chrono::duration<double>(runStart - setupStart).count(),
+      std::chrono::duration<double>(runEnd - runStart).count());
+
+  delete frameManager;
+  delete simulator;
+  for (size_t i = 0; i < VideoApplication.size(); i++)
+    delete VideoApplication[i];
+  for (size_t i = 0; i < BEApplication.size(); i++) delete BEApplication[i];
+  for (size_t i = 0; i < IPApplication.size(); i++) delete IPApplication[i];
+}
+
+#endif /* SCALE_TEST_H_ */
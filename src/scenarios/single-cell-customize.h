@@ -51,7 +51,7 @@
 #include "../phy/wideband-cqi-eesm-error-model.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 using std::pair;
 using std::vector;
@@ -80,9 +80,9 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cerr << "Simulation with SEED = " << seed << std::endl;
 
@@ -163,7 +163,7 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -209,7 +209,7 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
 
     spectrums.at(i)->Print();
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -262,7 +262,7 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   for (int idUE = 0; idUE < total_ues; idUE++) {
     // we hardcoded the configuration for the customization experiment
@@ -280,11 +280,12 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
       nbVideo = nb_videoflow_sliceD;
     }
 
-    double posX = (double)rand() / RAND_MAX * radius * 1000 * 0.4 + 100;
-    double posY = (double)rand() / RAND_MAX * radius * 1000 * 0.4 + 100;
-    posX = rand() % 2 == 0 ? posX : -posX;
-    posY = rand() % 2 == 0 ? posY : -posY;
-    double speedDirection = GetRandomVariable(360.) * ((2. * 3.14) / 360.);
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform() * radius * 1000 * 0.4 + 100;
+    double posY = rng.NextUniform() * radius * 1000 * 0.4 + 100;
+    posX = rng.NextInt(2) == 0 ? posX : -posX;
+    posY = rng.NextInt(2) == 0 ? posY : -posY;
+    double speedDirection = rng.NextUniform(360.) * ((2. * 3.14) / 360.);
 
     UserEquipment *ue = new UserEquipment(
         idUE, posX, posY, speed, speedDirection, cells->at(0), eNBs->at(0),
@@ -308,7 +309,7 @@ static void SingleCellCustomize(double radius, int sched_type, int frame_struct,
     WidebandCqiEesmErrorModel *errorModel = new WidebandCqiEesmErrorModel();
     ue->GetPhy()->SetErrorModel(errorModel);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     // register ue to the enb
     eNBs->at(0)->RegisterUserEquipment(ue);
@@ -49,8 +49,8 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
 #include "../utility/UsersDistribution.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 static void SingleCellWithFemto(double radius, int nbBuildings,
@@ -77,9 +77,9 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cout << "Simulation with SEED = " << seed << std::endl;
 
@@ -139,7 +139,7 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -230,14 +230,15 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
   // create Home eNBs
   std::vector<Femtocell *> *femtocells = nm->GetFemtoCellContainer();
   for (int i = nbCell; i < nbCell + nbFemtoCells; i++) {
-    double HeNBdrop = (double)rand() / (double)RAND_MAX;
+    double HeNBdrop =
+        CounterRng::Stream(i, RNG_PURPOSE_PLACEMENT_HENB).NextUniform();
 
     if (HeNBdrop <= activityRatio) {
       HeNodeB *enb = new HeNodeB(i, femtocells->at(i - nbCell));
@@ -289,7 +290,7 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   // Users in MACRO CELL
   // nbUE is the number of users that are into each cell at the beginning of the
@@ -305,7 +306,9 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
       // ue's random position
       double posX = positions->at(idUE - totalNbCell)->GetCoordinateX();
       double posY = positions->at(idUE - totalNbCell)->GetCoordinateY();
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+          ((2 * 3.14) / 360);
       ;
 
       UserEquipment *ue = new UserEquipment(
@@ -329,7 +332,7 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
       cqiManager->SetDevice(ue);
       ue->SetCqiManager(cqiManager);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       // register ue to the enb
       eNBs->at(j)->RegisterUserEquipment(ue);
@@ -367,7 +370,9 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
       // ue's random position
       double posX = positions->at(i)->GetCoordinateX();
       double posY = positions->at(i)->GetCoordinateY();
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+          ((2 * 3.14) / 360);
       ;
 
       UserEquipment *ue =
@@ -401,7 +406,7 @@ static void SingleCellWithFemto(double radius, int nbBuildings,
       cqiManager->SetDevice(ue);
       ue->SetCqiManager(cqiManager);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       // register ue to the enb
       HeNBs->at(j)->RegisterUserEquipment(ue);
@@ -35,6 +35,7 @@
 #include "../componentManagers/FrameManager.h"
 #include "../core/eventScheduler/simulator.h"
 #include "../core/spectrum/bandwidth-manager.h"
+#include "../device/CqiManager/trace-cqi-manager.h"
 #include "../device/IPClassifier/ClassifierParameters.h"
 #include "../flows/QoS/QoSForEXP.h"
 #include "../flows/QoS/QoSForFLS.h"
@@ -52,7 +53,7 @@
 #include "../phy/wideband-cqi-eesm-error-model.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 struct SliceConfig {
@@ -83,9 +84,9 @@ static void SingleCellWithInterference(double radius, int sched_type,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cerr << "Simulation with SEED = " << seed << std::endl;
 
@@ -146,7 +147,7 @@ static void SingleCellWithInterference(double radius, int sched_type,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -192,7 +193,7 @@ static void SingleCellWithInterference(double radius, int sched_type,
 
     spectrums.at(i)->Print();
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -228,6 +229,16 @@ static void SingleCellWithInterference(double radius, int sched_type,
     slice_users.push_back(num_ue);
     total_ues += num_ue;
   }
+  // "channel_model": "trace" replaces the propagation/SINR pipeline with
+  // the SDR CQI traces
+  bool trace_driven = obj.get("channel_model", "propagation").asString() == "trace";
+  if (trace_driven) {
+    for (int i = 0; i < nbCells; i++) {
+      dlChannels->at(i)->SetTraceDriven(true);
+      ulChannels->at(i)->SetTraceDriven(true);
+    }
+    std::cout << "Trace-driven channel model" << std::endl;
+  }
   const Json::Value &slice_schemes = obj["slices"];
   for (int i = 0; i < slice_schemes.size(); i++) {
     int n_slices = slice_schemes[i]["n_slices"].asInt();
@@ -249,17 +260,18 @@ static void SingleCellWithInterference(double radius, int sched_type,
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   double start_time = 0.1;
   double duration_time = start_time + duration;
 
   for (int idUE = 0; idUE < total_ues; idUE++) {
-    double posX = (double)rand() / RAND_MAX * radius * 1000 * 0.4 + 100;
-    double posY = (double)rand() / RAND_MAX * radius * 1000 * 0.4 + 100;
-    posX = rand() % 2 == 0 ? posX : -posX;
-    posY = rand() % 2 == 0 ? posY : -posY;
-    double speedDirection = GetRandomVariable(360.) * ((2. * 3.14) / 360.);
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform() * radius * 1000 * 0.4 + 100;
+    double posY = rng.NextUniform() * radius * 1000 * 0.4 + 100;
+    posX = rng.NextInt(2) == 0 ? posX : -posX;
+    posY = rng.NextInt(2) == 0 ? posY : -posY;
+    double speedDirection = rng.NextUniform(360.) * ((2. * 3.14) / 360.);
 
     UserEquipment *ue = new UserEquipment(
         idUE, posX, posY, speed, speedDirection, cells->at(0), eNBs->at(0),
@@ -273,7 +285,12 @@ static void SingleCellWithInterference(double radius, int sched_type,
     ue->GetPhy()->SetDlChannel(eNBs->at(0)->GetPhy()->GetDlChannel());
     ue->GetPhy()->SetUlChannel(eNBs->at(0)->GetPhy()->GetUlChannel());
 
-    FullbandCqiManager *cqiManager = new FullbandCqiManager();
+    CqiManager *cqiManager;
+    if (trace_driven) {
+      cqiManager = new TraceCqiManager();
+    } else {
+      cqiManager = new FullbandCqiManager();
+    }
     cqiManager->SetCqiReportingMode(CqiManager::PERIODIC);
     cqiManager->SetReportingInterval(40);
     // cqiManager->SetReportingInterval (1);
@@ -283,26 +300,28 @@ static void SingleCellWithInterference(double radius, int sched_type,
     WidebandCqiEesmErrorModel *errorModel = new WidebandCqiEesmErrorModel();
     ue->GetPhy()->SetErrorModel(errorModel);
 
-    nm->GetUserEquipmentContainer()->push_back(ue);
+    nm->AddUserEquipment(ue);
 
     // register ue to the enb
     eNBs->at(0)->RegisterUserEquipment(ue);
 
     // define the channel realization
-    MacroCellUrbanAreaChannelRealization *c_dl =
-        new MacroCellUrbanAreaChannelRealization(eNBs->at(0), ue);
-    eNBs->at(0)
-        ->GetPhy()
-        ->GetDlChannel()
-        ->GetPropagationLossModel()
-        ->AddChannelRealization(c_dl);
-    MacroCellUrbanAreaChannelRealization *c_ul =
-        new MacroCellUrbanAreaChannelRealization(ue, eNBs->at(0));
-    eNBs->at(0)
-        ->GetPhy()
-        ->GetUlChannel()
-        ->GetPropagationLossModel()
-        ->AddChannelRealization(c_ul);
+    if (!trace_driven) {
+      MacroCellUrbanAreaChannelRealization *c_dl =
+          new MacroCellUrbanAreaChannelRealization(eNBs->at(0), ue);
+      eNBs->at(0)
+          ->GetPhy()
+          ->GetDlChannel()
+          ->GetPropagationLossModel()
+          ->AddChannelRealization(c_dl);
+      MacroCellUrbanAreaChannelRealization *c_ul =
+          new MacroCellUrbanAreaChannelRealization(ue, eNBs->at(0));
+      eNBs->at(0)
+          ->GetPhy()
+          ->GetUlChannel()
+          ->GetPropagationLossModel()
+          ->AddChannelRealization(c_ul);
+    }
 
     // CREATE DOWNLINK APPLICATION FOR THIS UE
     SliceConfig config = slice_configs[user_to_slice[idUE]];
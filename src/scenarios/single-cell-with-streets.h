@@ -49,8 +49,8 @@
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
 #include "../utility/IndoorScenarios.h"
-#include "../utility/RandomVariable.h"
 #include "../utility/UsersDistribution.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
@@ -75,9 +75,9 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cout << "Simulation with SEED = " << seed << std::endl;
 
@@ -137,7 +137,7 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
     Cell *c = new Cell(i, radius, 0.035, center.GetCoordinateX(),
                        center.GetCoordinateY());
     cells->push_back(c);
-    nm->GetCellContainer()->push_back(c);
+    nm->AddCell(c);
 
     std::cout << "Created Cell, id " << c->GetIdCell()
               << ", position: " << c->GetCellCenterPosition()->GetCoordinateX()
@@ -216,7 +216,7 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
 
     ulChannels->at(i)->AddDevice((NetworkNode *)enb);
 
-    nm->GetENodeBContainer()->push_back(enb);
+    nm->AddENodeB(enb);
     eNBs->push_back(enb);
   }
 
@@ -264,7 +264,7 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
 
   // Create GW
   Gateway *gw = new Gateway();
-  nm->GetGatewayContainer()->push_back(gw);
+  nm->AddGateway(gw);
 
   // Users in MACRO CELL
   // nbUE is the number of users that are into each cell at the beginning of the
@@ -280,7 +280,9 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
       // ue's random position
       double posX = positions->at(idUE - totalNbCell)->GetCoordinateX();
       double posY = positions->at(idUE - totalNbCell)->GetCoordinateY();
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+          ((2 * 3.14) / 360);
       ;
 
       UserEquipment *ue = new UserEquipment(
@@ -304,7 +306,7 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
       cqiManager->SetDevice(ue);
       ue->SetCqiManager(cqiManager);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       // register ue to the enb
       eNBs->at(j)->RegisterUserEquipment(ue);
@@ -343,7 +345,9 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
       // ue's random position
       double posX = positions->at(i)->GetCoordinateX();
       double posY = positions->at(i)->GetCoordinateY();
-      double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+      double speedDirection =
+          (double)CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE).NextInt(360) *
+          ((2 * 3.14) / 360);
       ;
 
       UserEquipment *ue =
@@ -368,7 +372,7 @@ static void SingleCellWithStreets(double radius, int nbStreets, int nbUE,
       cqiManager->SetDevice(ue);
       ue->SetCqiManager(cqiManager);
 
-      nm->GetUserEquipmentContainer()->push_back(ue);
+      nm->AddUserEquipment(ue);
 
       // register ue to the enb
       HeNBs->at(j)->RegisterUserEquipment(ue);
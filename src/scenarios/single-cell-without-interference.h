@@ -48,7 +48,7 @@
 #include "../phy/wideband-cqi-eesm-error-model.h"
 #include "../protocolStack/packet/Packet.h"
 #include "../protocolStack/packet/packet-burst.h"
-#include "../utility/RandomVariable.h"
+#include "../utility/counter-rng.h"
 #include "../utility/seed.h"
 
 static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
@@ -70,9 +70,9 @@ static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
   // CONFIGURE SEED
   if (seed >= 0) {
     int commonSeed = GetCommonSeed(seed);
-    srand(commonSeed);
+    CounterRng::SetGlobalSeed(commonSeed);
   } else {
-    srand(time(NULL));
+    CounterRng::SetGlobalSeed(time(NULL));
   }
   std::cout << "Simulation with SEED = " << seed << std::endl;
 
@@ -138,7 +138,7 @@ static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
 
   // CREATE CELL
   Cell *cell = new Cell(0, radius, 0.035, 0, 0);
-  networkManager->GetCellContainer()->push_back(cell);
+  networkManager->AddCell(cell);
 
   // CREATE CHANNELS and propagation loss model
   LteChannel *dlCh = new LteChannel();
@@ -154,22 +154,23 @@ static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
   enb->GetPhy()->SetBandwidthManager(spectrum);
   ulCh->AddDevice(enb);
   enb->SetDLScheduler(downlink_scheduler_type);
-  networkManager->GetENodeBContainer()->push_back(enb);
+  networkManager->AddENodeB(enb);
 
   // Create GW
   Gateway *gw = new Gateway();
-  networkManager->GetGatewayContainer()->push_back(gw);
+  networkManager->AddGateway(gw);
 
   // Create UEs
   int idUE = 2;
   for (int i = 0; i < nbUE; i++) {
     // ue's random position
     int maxXY = radius * 1000;  // in metres
-    double posX = (double)rand() / RAND_MAX;
+    CounterRng &rng = CounterRng::Stream(idUE, RNG_PURPOSE_PLACEMENT_UE);
+    double posX = rng.NextUniform();
     posX = 0.95 * (((2 * radius * 1000) * posX) - (radius * 1000));
-    double posY = (double)rand() / RAND_MAX;
+    double posY = rng.NextUniform();
     posY = 0.95 * (((2 * radius * 1000) * posY) - (radius * 1000));
-    double speedDirection = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    double speedDirection = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     UserEquipment *ue =
         new UserEquipment(idUE, posX, posY, speed, speedDirection, cell, enb,
@@ -191,7 +192,7 @@ static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
     WidebandCqiEesmErrorModel *errorModel = new WidebandCqiEesmErrorModel();
     ue->GetPhy()->SetErrorModel(errorModel);
 
-    networkManager->GetUserEquipmentContainer()->push_back(ue);
+    networkManager->AddUserEquipment(ue);
 
     // register ue to the enb
     enb->RegisterUserEquipment(ue);
@@ -210,7 +211,7 @@ static void SingleCellWithoutInterference(double radius, int nbUE, int nbVoIP,
         ->AddChannelRealization(c_ul);
 
     // CREATE DOWNLINK APPLICATION FOR THIS UE
-    double start_time = 0.5 + (double)(rand() % 5);
+    double start_time = 0.5 + (double)(rng.NextInt(5));
     double duration_time = start_time + flow_duration;
 
     // *** voip application
@@ -0,0 +1,498 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#include "slicing.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+
+using coord_t = std::pair<int, int>;
+using coord_cqi_t = std::pair<coord_t, double>;
+using rbg_cqi_t = std::pair<int, double>;
+
+// carves the arrays of a call from the workspace, in a fixed order
+class Workspace {
+ public:
+  Workspace(void* base, size_t size) : m_base((char*)base), m_size(size), m_used(0) {}
+
+  template <typename T>
+  T* Take(size_t n) {
+    size_t offset = (m_used + alignof(T) - 1) & ~(alignof(T) - 1);
+    m_used = offset + n * sizeof(T);
+    if (m_base == NULL || m_used > m_size) return NULL;
+    return (T*)(m_base + offset);
+  }
+
+  size_t Used(void) const { return m_used; }
+
+ private:
+  char* m_base;
+  size_t m_size;
+  size_t m_used;
+};
+
+struct Arrays {
+  bool* slice_with_data;
+  int* slice_rbgs;     // RBGs given by the solver
+  int* slice_final_rbgs;
+  int* slice_quota;    // the solver's copy of the quotas
+  int* slice_more;     // SubOpt: RBGs over the quota
+  int* slice_fewer;    // SubOpt: RBGs under the quota
+  double* max_ranks;
+  int* rbg_to_slice;
+  int* user_index;     // by RBG then slice: the user representing the slice
+  double* flow_se;     // by RBG then slice: the spectral efficiency of that user
+  rbg_cqi_t* sorted_rbgs;
+  coord_cqi_t* sorted_pairs;
+};
+
+// with a workspace of NULL, only counts the bytes of the same layout
+bool TakeArrays(Workspace* ws, int nb_rbgs, int nb_slices, Arrays* a) {
+  size_t cells = (size_t)nb_rbgs * nb_slices;
+  a->slice_with_data = ws->Take<bool>(nb_slices);
+  a->slice_rbgs = ws->Take<int>(nb_slices);
+  a->slice_final_rbgs = ws->Take<int>(nb_slices);
+  a->slice_quota = ws->Take<int>(nb_slices);
+  a->slice_more = ws->Take<int>(nb_slices);
+  a->slice_fewer = ws->Take<int>(nb_slices);
+  a->max_ranks = ws->Take<double>(nb_slices);
+  a->rbg_to_slice = ws->Take<int>(nb_rbgs);
+  a->user_index = ws->Take<int>(cells);
+  a->flow_se = ws->Take<double>(cells);
+  a->sorted_rbgs = ws->Take<rbg_cqi_t>(nb_rbgs);
+  a->sorted_pairs = ws->Take<coord_cqi_t>(cells);
+  return a->sorted_pairs != NULL;
+}
+
+double SumEfficiency(const double* flow_se, const int* rbg_to_slice, int nb_rbgs,
+                     int nb_slices) {
+  double sum_bits = 0;
+  for (int i = 0; i < nb_rbgs; ++i) {
+    if (rbg_to_slice[i] < 0) continue;
+    sum_bits += flow_se[i * nb_slices + rbg_to_slice[i]];
+  }
+  return sum_bits;
+}
+
+// every RBG in turn to the best slice still under its quota
+void GreedyByRow(const double* flow_se, const int* quota, int nb_rbgs, int nb_slices,
+                 int* slice_rbgs, int* rbg_to_slice) {
+  for (int i = 0; i < nb_rbgs; ++i) {
+    const double* row = flow_se + i * nb_slices;
+    double max_eff = -1;
+    int assigned_slice = -1;
+    for (int j = 0; j < nb_slices; ++j) {
+      if (row[j] > max_eff && slice_rbgs[j] < quota[j]) {
+        max_eff = row[j];
+        assigned_slice = j;
+      }
+    }
+    rbg_to_slice[i] = assigned_slice;
+    if (assigned_slice != -1) slice_rbgs[assigned_slice] += 1;
+  }
+}
+
+/*
+ * Every RBG to its best slice, then the RBG that loses the least moves from
+ * a slice over its quota to one under it, until no move is left. The slices
+ * under their quota are tried from the highest index, which is the order
+ * the simulator used to iterate them in (an unordered_map of up to 13).
+ */
+void SubOpt(const double* flow_se, int* quota, int nb_rbgs, int nb_slices,
+            int* slice_rbgs, int* slice_more, int* slice_fewer, int* rbg_to_slice) {
+  for (int i = 0; i < nb_slices; ++i) {
+    if (quota[i] < 0) quota[i] = 0;
+  }
+  for (int i = 0; i < nb_rbgs; ++i) {
+    const double* row = flow_se + i * nb_slices;
+    double max_eff = -1;
+    int assigned_slice = -1;
+    for (int j = 0; j < nb_slices; ++j) {
+      if (row[j] > max_eff) {
+        max_eff = row[j];
+        assigned_slice = j;
+      }
+    }
+    rbg_to_slice[i] = assigned_slice;
+    if (assigned_slice != -1) slice_rbgs[assigned_slice] += 1;
+  }
+  // 0 when the slice is not in the set
+  int nb_more = 0, nb_fewer = 0;
+  for (int i = 0; i < nb_slices; ++i) {
+    slice_more[i] = slice_fewer[i] = 0;
+    if (slice_rbgs[i] > quota[i]) {
+      slice_more[i] = slice_rbgs[i] - quota[i];
+      nb_more++;
+    } else if (slice_rbgs[i] < quota[i]) {
+      slice_fewer[i] = quota[i] - slice_rbgs[i];
+      nb_fewer++;
+    }
+  }
+  while (nb_more > 0 && nb_fewer > 0) {
+    int from_slice = -1, to_slice = -1, rbg_id = -1;
+    double min_tbs_reduce = std::numeric_limits<double>::max();
+    for (int i = 0; i < nb_rbgs; ++i) {
+      int from = rbg_to_slice[i];
+      if (from < 0 || slice_more[from] <= 0) continue;
+      const double* row = flow_se + i * nb_slices;
+      for (int to = nb_slices - 1; to >= 0; --to) {
+        if (slice_fewer[to] <= 0) continue;
+        if (row[from] - row[to] < min_tbs_reduce) {
+          min_tbs_reduce = row[from] - row[to];
+          from_slice = from;
+          to_slice = to;
+          rbg_id = i;
+        }
+      }
+    }
+    if (from_slice == -1) break;
+    slice_rbgs[from_slice] -= 1;
+    slice_rbgs[to_slice] += 1;
+    rbg_to_slice[rbg_id] = to_slice;
+    slice_more[from_slice] -= 1;
+    slice_fewer[to_slice] -= 1;
+    if (slice_more[from_slice] <= 0 || slice_rbgs[from_slice] <= 0) {
+      slice_more[from_slice] = 0;
+      nb_more--;
+    }
+    if (slice_fewer[to_slice] <= 0) {
+      slice_fewer[to_slice] = 0;
+      nb_fewer--;
+    }
+  }
+}
+
+// the (RBG, slice) pairs from the most efficient one; negative quotas are ok
+void MaximizeCell(const double* flow_se, const int* quota, int nb_rbgs, int nb_slices,
+                  coord_cqi_t* sorted_cqi, int* slice_rbgs, int* rbg_to_slice) {
+  int n = 0;
+  for (int i = 0; i < nb_rbgs; ++i)
+    for (int j = 0; j < nb_slices; ++j) {
+      sorted_cqi[n++] = coord_cqi_t(coord_t(i, j), flow_se[i * nb_slices + j]);
+    }
+  std::sort(sorted_cqi, sorted_cqi + n,
+            [](coord_cqi_t a, coord_cqi_t b) { return a.second > b.second; });
+  for (int k = 0; k < n; ++k) {
+    int rbg_id = sorted_cqi[k].first.first;
+    int slice_id = sorted_cqi[k].first.second;
+    if (slice_rbgs[slice_id] < quota[slice_id] && rbg_to_slice[rbg_id] == -1) {
+      rbg_to_slice[rbg_id] = slice_id;
+      slice_rbgs[slice_id] += 1;
+    }
+  }
+}
+
+/*
+ * Vogel's approximation: the RBG or slice with the largest gap between its
+ * best and second best choice is served first. The gap is kept in an int,
+ * as the simulator always did.
+ */
+void VogelApproximate(const double* flow_se, const int* quota, int nb_rbgs,
+                      int nb_slices, int* slice_rbgs, int* rbg_to_slice) {
+  for (int i = 0; i < nb_rbgs; ++i) {
+    int max_diff = -1;
+    coord_t coord_1st(-1, -1);
+    // horizontal search
+    for (int j = 0; j < nb_rbgs; ++j) {
+      if (rbg_to_slice[j] != -1) continue;
+      const double* row = flow_se + j * nb_slices;
+      double eff_1st = -1, eff_2nd = -1;
+      int slice_1st = -1;
+      for (int k = 0; k < nb_slices; ++k) {
+        if (slice_rbgs[k] >= quota[k]) continue;
+        if (eff_1st == -1 || row[k] > eff_1st) {
+          slice_1st = k;
+          eff_1st = row[k];
+          continue;
+        }
+        if (eff_2nd == -1 || row[k] > eff_2nd) {
+          eff_2nd = row[k];
+          continue;
+        }
+      }
+      if (eff_1st - eff_2nd > max_diff) {
+        max_diff = eff_1st - eff_2nd;
+        coord_1st = coord_t(j, slice_1st);
+      }
+    }
+    // vertical search
+    for (int k = 0; k < nb_slices; ++k) {
+      if (slice_rbgs[k] >= quota[k]) continue;
+      double eff_1st = -1, eff_2nd = -1;
+      int rbg_1st = -1;
+      for (int j = 0; j < nb_rbgs; ++j) {
+        if (rbg_to_slice[j] != -1) continue;
+        double eff = flow_se[j * nb_slices + k];
+        if (eff_1st == -1 || eff > eff_1st) {
+          rbg_1st = j;
+          eff_1st = eff;
+          continue;
+        }
+        if (eff_2nd == -1 || eff > eff_2nd) {
+          eff_2nd = eff;
+          continue;
+        }
+      }
+      if (eff_1st - eff_2nd > max_diff) {
+        max_diff = eff_1st - eff_2nd;
+        coord_1st = coord_t(rbg_1st, k);
+      }
+    }
+    if (coord_1st.first < 0 || coord_1st.second < 0) break;
+    rbg_to_slice[coord_1st.first] = coord_1st.second;
+    slice_rbgs[coord_1st.second] += 1;
+  }
+}
+
+bool Grant(rs_slicing_output* out, int rbg, int slice, int user) {
+  if (out->nb_grants >= out->max_grants) return false;
+  rs_slicing_grant& g = out->grants[out->nb_grants++];
+  g.rbg = rbg;
+  g.slice = slice;
+  g.user = user;
+  return true;
+}
+
+// every slice its best RBGs, whoever else gets them: the grants by slice
+int UpperBound(const double* flow_se, const int* user_index, const int* quota,
+               int nb_rbgs, int nb_slices, rbg_cqi_t* sorted_cqi,
+               int* slice_final_rbgs, rs_slicing_output* out) {
+  double sum_bits = 0;
+  for (int j = 0; j < nb_slices; ++j) {
+    if (quota[j] <= 0) continue;
+    for (int i = 0; i < nb_rbgs; ++i) {
+      sorted_cqi[i] = rbg_cqi_t(i, flow_se[i * nb_slices + j]);
+    }
+    std::sort(sorted_cqi, sorted_cqi + nb_rbgs,
+              [](rbg_cqi_t a, rbg_cqi_t b) { return a.second > b.second; });
+    int nb = std::min(quota[j], nb_rbgs);
+    for (int k = 0; k < nb; ++k) {
+      int rbg = sorted_cqi[k].first;
+      sum_bits += sorted_cqi[k].second;
+      int user = user_index[rbg * nb_slices + j];
+      if (user == -1) continue;
+      if (!Grant(out, rbg, j, user)) return RS_SLICING_ENOSPC;
+      slice_final_rbgs[j] += 1;
+    }
+  }
+  out->sum_efficiency = sum_bits;
+  return RS_SLICING_OK;
+}
+
+}  // namespace
+
+size_t rs_slicing_workspace_size(int nb_rbgs, int nb_slices, int nb_users) {
+  (void)nb_users;
+  if (nb_rbgs < 0 || nb_slices < 0) return 0;
+  Workspace ws(NULL, 0);
+  Arrays a;
+  TakeArrays(&ws, nb_rbgs, nb_slices, &a);
+  // room to align the base
+  return ws.Used() + alignof(std::max_align_t);
+}
+
+int rs_slicing_max_grants(int algo, int nb_rbgs, int nb_slices) {
+  return algo == RS_SLICING_UPPER_BOUND ? nb_rbgs * nb_slices : nb_rbgs;
+}
+
+double rs_slicing_metric(const rs_slicing_slice* slice, const rs_slicing_user* user,
+                         double spectral_efficiency) {
+  double metric = 0;
+  double se = spectral_efficiency * 180000 / 1000;  // kbps
+  double average_rate = user->average_rate / 1000.0;  // kbps
+  if (slice->alpha == 0) {
+    metric = pow(se, slice->epsilon) / pow(average_rate, slice->psi);
+  } else if (user->priority_backlog == 0) {
+    // the prioritized flow has no packet
+    metric = 0;
+  } else if (slice->beta) {
+    metric = user->hol_delay * pow(se, slice->epsilon) / pow(average_rate, slice->psi);
+  } else {
+    metric = pow(se, slice->epsilon) / pow(average_rate, slice->psi);
+  }
+  return metric;
+}
+
+int rs_slicing_allocate(const rs_slicing_input* in, double* slice_rbs_offset,
+                        void* workspace, size_t workspace_size,
+                        rs_slicing_output* out) {
+  if (in == NULL || out == NULL || slice_rbs_offset == NULL) return RS_SLICING_EINVAL;
+  int nb_slices = in->nb_slices;
+  int nb_users = in->nb_users;
+  if (in->algo < RS_SLICING_GREEDY_BY_ROW || in->algo > RS_SLICING_UPPER_BOUND ||
+      in->rbg_size <= 0 || in->nb_rbs < 0 || nb_slices <= 0 || nb_users < 0 ||
+      in->slices == NULL || (nb_users > 0 && in->users == NULL) ||
+      out->slice_target_rbs == NULL || out->slice_quota_rbgs == NULL) {
+    return RS_SLICING_EINVAL;
+  }
+  int rbg_size = in->rbg_size;
+  int nb_rbs = in->nb_rbs - in->nb_rbs % rbg_size;
+  int nb_rbgs = nb_rbs / rbg_size;
+  if (nb_rbgs > 0 && nb_users > 0 && in->spectral_efficiency == NULL) {
+    return RS_SLICING_EINVAL;
+  }
+  for (int u = 0; u < nb_users; u++) {
+    if (in->users[u].slice < 0 || in->users[u].slice >= nb_slices) return RS_SLICING_EINVAL;
+  }
+  if (out->max_grants < 0 || (out->max_grants > 0 && out->grants == NULL)) {
+    return RS_SLICING_EINVAL;
+  }
+
+  // the workspace as given may not be aligned
+  uintptr_t base = ((uintptr_t)workspace + alignof(std::max_align_t) - 1) &
+                   ~(uintptr_t)(alignof(std::max_align_t) - 1);
+  size_t skipped = base - (uintptr_t)workspace;
+  if (workspace == NULL || workspace_size < skipped) return RS_SLICING_ENOSPC;
+  Workspace ws((void*)base, workspace_size - skipped);
+  Arrays a;
+  if (!TakeArrays(&ws, nb_rbgs, nb_slices, &a)) return RS_SLICING_ENOSPC;
+
+  out->nb_grants = 0;
+  out->sum_efficiency = 0;
+  int* slice_target_rbs = out->slice_target_rbs;
+  int* slice_quota_rbgs = out->slice_quota_rbgs;
+
+  // the slices with a backlogged user, and their target of RBs
+  int num_nonempty_slices = 0;
+  int extra_rbs = nb_rbs;
+  for (int k = 0; k < nb_slices; k++) {
+    a.slice_with_data[k] = false;
+    slice_target_rbs[k] = 0;
+    a.slice_rbgs[k] = 0;
+    a.slice_final_rbgs[k] = 0;
+  }
+  for (int u = 0; u < nb_users; u++) {
+    int slice_id = in->users[u].slice;
+    if (in->users[u].backlog <= 0 || a.slice_with_data[slice_id]) continue;
+    num_nonempty_slices += 1;
+    a.slice_with_data[slice_id] = true;
+    slice_target_rbs[slice_id] =
+        (int)(nb_rbs * in->slices[slice_id].weight + slice_rbs_offset[slice_id]);
+    extra_rbs -= slice_target_rbs[slice_id];
+  }
+  if (num_nonempty_slices == 0) {
+    for (int k = 0; k < nb_slices; k++) slice_quota_rbgs[k] = 0;
+    return RS_SLICING_ENODATA;
+  }
+  bool is_first_slice = true;
+  int rand_begin_idx = in->rotation[0] % nb_slices;
+  for (int i = 0; i < nb_slices; ++i) {
+    int k = (i + rand_begin_idx) % nb_slices;
+    if (a.slice_with_data[k]) {
+      slice_target_rbs[k] += extra_rbs / num_nonempty_slices;
+      if (is_first_slice) {
+        slice_target_rbs[k] += extra_rbs % num_nonempty_slices;
+        is_first_slice = false;
+      }
+    }
+  }
+
+  // the quota of RBGs
+  int extra_rbgs = nb_rbgs;
+  for (int i = 0; i < nb_slices; ++i) {
+    slice_quota_rbgs[i] = (int)(slice_target_rbs[i] / rbg_size);
+    extra_rbgs -= slice_quota_rbgs[i];
+  }
+  is_first_slice = true;
+  rand_begin_idx = in->rotation[1] % nb_slices;
+  for (int i = 0; i < nb_slices; ++i) {
+    int k = (rand_begin_idx + i) % nb_slices;
+    if (a.slice_with_data[k]) {
+      slice_quota_rbgs[k] += extra_rbgs / num_nonempty_slices;
+      if (is_first_slice) {
+        slice_quota_rbgs[k] += extra_rbgs % num_nonempty_slices;
+        is_first_slice = false;
+      }
+    }
+  }
+  for (int k = 0; k < nb_slices; k++) a.slice_quota[k] = slice_quota_rbgs[k];
+
+  // the user with the highest metric of every slice, in every RBG
+  for (int i = 0; i < nb_rbgs; i++) {
+    int* index_row = a.user_index + i * nb_slices;
+    double* se_row = a.flow_se + i * nb_slices;
+    for (int k = 0; k < nb_slices; k++) {
+      index_row[k] = -1;
+      se_row[k] = 0;
+      a.max_ranks[k] = -1;
+    }
+    for (int u = 0; u < nb_users; ++u) {
+      const rs_slicing_user* user = &in->users[u];
+      if (user->backlog <= 0) continue;
+      double se = in->spectral_efficiency[(size_t)u * nb_rbgs + i];
+      double metric = rs_slicing_metric(&in->slices[user->slice], user, se);
+      if (metric > a.max_ranks[user->slice]) {
+        a.max_ranks[user->slice] = metric;
+        index_row[user->slice] = u;
+        se_row[user->slice] = se;
+      }
+    }
+  }
+
+  // the RBGs of the slices
+  if (in->algo == RS_SLICING_UPPER_BOUND) {
+    int status = UpperBound(a.flow_se, a.user_index, a.slice_quota, nb_rbgs, nb_slices,
+                            a.sorted_rbgs, a.slice_final_rbgs, out);
+    if (status != RS_SLICING_OK) return status;
+  } else {
+    for (int i = 0; i < nb_rbgs; i++) a.rbg_to_slice[i] = -1;
+    switch (in->algo) {
+      case RS_SLICING_GREEDY_BY_ROW:
+        GreedyByRow(a.flow_se, a.slice_quota, nb_rbgs, nb_slices, a.slice_rbgs,
+                    a.rbg_to_slice);
+        break;
+      case RS_SLICING_SUBOPT:
+        SubOpt(a.flow_se, a.slice_quota, nb_rbgs, nb_slices, a.slice_rbgs, a.slice_more,
+               a.slice_fewer, a.rbg_to_slice);
+        break;
+      case RS_SLICING_MAXIMIZE_CELL:
+        MaximizeCell(a.flow_se, a.slice_quota, nb_rbgs, nb_slices, a.sorted_pairs,
+                     a.slice_rbgs, a.rbg_to_slice);
+        break;
+      default:
+        VogelApproximate(a.flow_se, a.slice_quota, nb_rbgs, nb_slices, a.slice_rbgs,
+                         a.rbg_to_slice);
+        break;
+    }
+    out->sum_efficiency = SumEfficiency(a.flow_se, a.rbg_to_slice, nb_rbgs, nb_slices);
+    for (int i = 0; i < nb_rbgs; ++i) {
+      int slice_id = a.rbg_to_slice[i];
+      if (slice_id < 0) continue;
+      int user = a.user_index[i * nb_slices + slice_id];
+      if (user == -1) continue;
+      if (!Grant(out, i, slice_id, user)) return RS_SLICING_ENOSPC;
+      a.slice_final_rbgs[slice_id] += 1;
+    }
+  }
+
+  // what the slices did not get, or got over their target, carries over
+  for (int i = 0; i < nb_slices; ++i) {
+    slice_rbs_offset[i] = slice_target_rbs[i] - a.slice_final_rbgs[i] * rbg_size;
+  }
+  return RS_SLICING_OK;
+}
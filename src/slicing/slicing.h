@@ -0,0 +1,139 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef RADIOSABER_SLICING_H_
+#define RADIOSABER_SLICING_H_
+
+#include <stddef.h>
+
+/*
+ * The inter-slice scheduling of RadioSaber as a library with a C API, free
+ * of the simulator: DownlinkTransportScheduler is one of its callers, a RAN
+ * scheduler or a benchmark can be another. It only needs the C++ standard
+ * library and builds on its own:
+ *
+ *   g++ -O2 -c slicing.cpp && ar rcs libradiosaber-slicing.a slicing.o
+ *
+ * One call schedules one TTI of one cell:
+ *  1. every slice with a backlogged user gets a target of RBs, its weight
+ *     plus the offset it carries from the previous TTIs, and a quota of RBGs;
+ *     what the rounding leaves goes to the slices from a rotating one;
+ *  2. in every RBG, each slice is represented by its user with the highest
+ *     metric (proportional fair, or by head of line delay, see
+ *     rs_slicing_metric);
+ *  3. an inter-slice algorithm gives the RBGs to the slices, within their
+ *     quotas, from the spectral efficiency of these users;
+ *  4. the offsets are updated with what each slice got.
+ *
+ * All the buffers belong to the caller and the call does not allocate: the
+ * temporaries come from a workspace of rs_slicing_workspace_size bytes,
+ * which can be reused from call to call. Nothing is printed and there is no
+ * global state, so cells can be scheduled from several threads with one
+ * workspace each.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum rs_slicing_algo {
+  RS_SLICING_GREEDY_BY_ROW = 0,  /* every RBG to its best slice under quota */
+  RS_SLICING_SUBOPT = 1,         /* best slices, then the cheapest moves */
+  RS_SLICING_MAXIMIZE_CELL = 2,  /* the best (RBG, slice) pairs first */
+  RS_SLICING_VOGEL = 3,          /* Vogel's approximation of the transport */
+  RS_SLICING_UPPER_BOUND = 4     /* every slice its best RBGs, shared */
+};
+
+enum rs_slicing_status {
+  RS_SLICING_OK = 0,
+  RS_SLICING_EINVAL = -1,     /* a size or an index out of range */
+  RS_SLICING_ENOSPC = -2,     /* the workspace or the grants are too small */
+  RS_SLICING_ENODATA = -3     /* no user has a backlog */
+};
+
+typedef struct {
+  double weight;   /* share of the RBs of the cell */
+  int alpha;       /* 0: every flow; otherwise the prioritized flow only */
+  int beta;        /* with alpha, the metric is weighted by the HOL delay */
+  int epsilon;     /* exponent of the spectral efficiency */
+  int psi;         /* exponent of the average rate */
+} rs_slicing_slice;
+
+typedef struct {
+  int slice;                 /* index in the slices */
+  long long backlog;         /* bytes queued; users without any are skipped */
+  long long priority_backlog; /* bytes of the flow the slice prioritizes */
+  double average_rate;       /* bit/s */
+  double hol_delay;          /* s, of the prioritized flow */
+} rs_slicing_user;
+
+typedef struct {
+  int algo;                /* rs_slicing_algo */
+  int nb_rbs;              /* only whole RBGs are scheduled */
+  int rbg_size;            /* RBs per RBG */
+  int nb_slices;
+  int nb_users;
+  const rs_slicing_slice *slices;     /* nb_slices */
+  const rs_slicing_user *users;       /* nb_users */
+  /* by user, one row of nb_rbs / rbg_size RBGs: bit/s/Hz */
+  const double *spectral_efficiency;
+  /* the slices the leftover RBs, then RBGs, start from (modulo nb_slices) */
+  unsigned rotation[2];
+} rs_slicing_input;
+
+typedef struct {
+  int rbg;
+  int slice;
+  int user;  /* index in the users */
+} rs_slicing_grant;
+
+typedef struct {
+  rs_slicing_grant *grants;  /* by RBG; by slice with RS_SLICING_UPPER_BOUND */
+  int max_grants;            /* rs_slicing_max_grants */
+  int nb_grants;
+  int *slice_target_rbs;     /* nb_slices */
+  int *slice_quota_rbgs;     /* nb_slices */
+  double sum_efficiency;     /* of the granted RBGs, bit/s/Hz */
+} rs_slicing_output;
+
+/* bytes of workspace for a cell of that size */
+size_t rs_slicing_workspace_size(int nb_rbgs, int nb_slices, int nb_users);
+
+/* grants one call can return */
+int rs_slicing_max_grants(int algo, int nb_rbgs, int nb_slices);
+
+/* the metric of a user on an RB of that spectral efficiency */
+double rs_slicing_metric(const rs_slicing_slice *slice, const rs_slicing_user *user,
+                         double spectral_efficiency);
+
+/*
+ * Schedules one TTI: fills out, and updates slice_rbs_offset (nb_slices
+ * RBs, zero at the start) for the next call. Returns a rs_slicing_status.
+ */
+int rs_slicing_allocate(const rs_slicing_input *in, double *slice_rbs_offset,
+                        void *workspace, size_t workspace_size,
+                        rs_slicing_output *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADIOSABER_SLICING_H_ */
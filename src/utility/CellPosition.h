@@ -176,6 +176,27 @@ static CartesianCoordinates GetCartesianCoordinatesForCell(int idCell,
       x = radius + (radius / 2);
       y = 3 * (radius * (sqrt(3) / 2));
       break;
+
+    default: {
+      // ring k holds the cells 3k(k-1)+1 .. 3k(k+1); walk it in axial
+      // coordinates from its top cell, in the order of the rings above
+      static const int directions[6][2] = {{-1, 0}, {0, -1}, {1, -1},
+                                           {1, 0},  {0, 1},  {-1, 1}};
+      int ring = 1;
+      while (3 * ring * (ring + 1) < idCell) ring++;
+      int index = idCell - (3 * ring * (ring - 1) + 1);
+      int q = 0;
+      int r = ring;
+      for (int side = 0; side < index / ring; side++) {
+        q += directions[side][0] * ring;
+        r += directions[side][1] * ring;
+      }
+      q += directions[index / ring][0] * (index % ring);
+      r += directions[index / ring][1] * (index % ring);
+      x = q * (radius + (radius / 2));
+      y = (r + q / 2.) * (radius * sqrt(3));
+      break;
+    }
   }
 
   CartesianCoordinates coordinates;
@@ -30,6 +30,7 @@
 
 #include "../componentManagers/NetworkManager.h"
 #include "../networkTopology/Building.h"
+#include "counter-rng.h"
 
 static vector<CartesianCoordinates*>* GetUniformBuildingDistribution(
     int idCell, int nbBuilding) {
@@ -44,10 +45,11 @@ static vector<CartesianCoordinates*>* GetUniformBuildingDistribution(
   CartesianCoordinates* cellCoordinates = cell->GetCellCenterPosition();
   double r;
   double angle;
+  CounterRng& rng = CounterRng::Stream(idCell, RNG_PURPOSE_PLACEMENT_BUILDING);
 
   for (int i = 0; i < nbBuilding; i++) {
-    r = (double)(rand() % (int)radius);
-    angle = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    r = (double)(rng.NextInt((int)radius));
+    angle = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     double x = r * cos(angle);
     double y = r * sin(angle);
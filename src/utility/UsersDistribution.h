@@ -28,6 +28,7 @@
 #include "../componentManagers/NetworkManager.h"
 #include "../core/cartesianCoodrdinates/CartesianCoordinates.h"
 #include "CellPosition.h"
+#include "counter-rng.h"
 
 static CartesianCoordinates *GetCartesianCoordinatesFromPolar(double r,
                                                               double angle) {
@@ -52,10 +53,11 @@ static vector<CartesianCoordinates *> *GetUniformUsersDistribution(int idCell,
   CartesianCoordinates *cellCoordinates = cell->GetCellCenterPosition();
   double r;
   double angle;
+  CounterRng &rng = CounterRng::Stream(idCell, RNG_PURPOSE_PLACEMENT_CELL);
 
   for (int i = 0; i < nbUE; i++) {
-    r = (double)(rand() % (int)radius);
-    angle = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    r = (double)(rng.NextInt((int)radius));
+    angle = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     CartesianCoordinates *newCoordinates =
         GetCartesianCoordinatesFromPolar(r, angle);
@@ -85,10 +87,11 @@ static vector<CartesianCoordinates *> *GetUniformUsersDistributionInFemtoCell(
   CartesianCoordinates *cellCoordinates = cell->GetCellCenterPosition();
   double r;
   double angle;
+  CounterRng &rng = CounterRng::Stream(idCell, RNG_PURPOSE_PLACEMENT_CELL);
 
   for (int i = 0; i < nbUE; i++) {
-    r = (double)(rand() % (int)side);
-    angle = (double)(rand() % 360) * ((2 * 3.14) / 360);
+    r = (double)(rng.NextInt((int)side));
+    angle = (double)(rng.NextInt(360)) * ((2 * 3.14) / 360);
 
     CartesianCoordinates *newCoordinates =
         GetCartesianCoordinatesFromPolar(r, angle);
@@ -0,0 +1,138 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef COUNTER_RNG_H_
+#define COUNTER_RNG_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+
+/*
+ * What a stream is drawn for. Together with the ID of the entity that owns
+ * it, this is the key of the stream.
+ */
+enum RngPurpose {
+  RNG_PURPOSE_ERROR_MODEL = 1,  // BLER decisions, one stream per error model
+  RNG_PURPOSE_SCHEDULER,        // per eNB
+  RNG_PURPOSE_MOBILITY,         // per UE
+  RNG_PURPOSE_TRAFFIC,          // per application
+  RNG_PURPOSE_CHANNEL,          // per channel realization
+  // scenario setup
+  RNG_PURPOSE_PLACEMENT_UE,        // position and direction, per UE
+  RNG_PURPOSE_PLACEMENT_CELL,      // UEs dropped in a cell, per cell or femtocell
+  RNG_PURPOSE_PLACEMENT_BUILDING,  // buildings dropped in a cell, per cell
+  RNG_PURPOSE_PLACEMENT_HENB,      // HeNB deployment, per femtocell or building
+};
+
+/*
+ * Counter-based random stream. The n-th value of a stream is a pure hash of
+ * (global seed, stream key, n), so a stream never depends on how many numbers
+ * other modules have drawn, unlike the global rand().
+ *
+ * Streams are keyed by (entity ID, purpose): every object that draws keeps
+ * its own stream, so results do not depend on the order in which entities
+ * are processed, and a module drawing one more number changes nothing else.
+ */
+class CounterRng {
+ public:
+  CounterRng(uint64_t stream = 0)
+      : m_stream(Mix(stream)), m_generation(Generation()),
+        m_key(Mix(GlobalSeed() ^ m_stream)), m_counter(0) {}
+
+  CounterRng(uint64_t entity, RngPurpose purpose)
+      : CounterRng(Mix(entity) ^ ((uint64_t)purpose << 56)) {}
+
+  /*
+   * Set by the scenario before the streams are created. Setting it again
+   * later rekeys the existing streams too, at their next draw: the runs
+   * forked by the SnapshotManager draw with a seed of their own.
+   */
+  static void SetGlobalSeed(uint64_t seed) {
+    GlobalSeed() = seed;
+    Generation()++;
+  }
+  static uint64_t GetGlobalSeed(void) { return GlobalSeed(); }
+
+  /*
+   * The stream of (entity, purpose) shared by all its users, for the code
+   * that has no object to keep a stream in (scenario setup, helpers). Not
+   * thread-safe.
+   */
+  static CounterRng& Stream(uint64_t entity, RngPurpose purpose) {
+    static std::map<std::pair<uint64_t, int>, CounterRng> streams;
+    std::pair<uint64_t, int> key(entity, purpose);
+    std::map<std::pair<uint64_t, int>, CounterRng>::iterator it = streams.find(key);
+    if (it == streams.end())
+      it = streams.insert(std::make_pair(key, CounterRng(entity, purpose))).first;
+    return it->second;
+  }
+
+  // SplitMix64 finalizer
+  static inline uint64_t Mix(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  inline uint64_t Next(void) {
+    if (m_generation != Generation()) {
+      m_generation = Generation();
+      m_key = Mix(GlobalSeed() ^ m_stream);
+    }
+    return Mix(m_key + (m_counter++) * 0x9E3779B97F4A7C15ULL);
+  }
+
+  // uniform in [0, 1) with 53 bits of precision
+  inline double NextUniform(void) {
+    return (Next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // uniform in [0, max)
+  inline double NextUniform(double max) { return NextUniform() * max; }
+
+  // uniform integer in [0, n), for n > 0; the bias is below n / 2^64
+  inline int NextInt(int n) { return (int)(Next() % (uint64_t)n); }
+
+  uint64_t GetCounter(void) const { return m_counter; }
+  void SetCounter(uint64_t counter) { m_counter = counter; }
+
+ private:
+  static uint64_t& GlobalSeed(void) {
+    static uint64_t seed = 0;
+    return seed;
+  }
+
+  // bumped by each SetGlobalSeed
+  static uint64_t& Generation(void) {
+    static uint64_t generation = 0;
+    return generation;
+  }
+
+  uint64_t m_stream;
+  uint64_t m_generation;
+  uint64_t m_key;
+  uint64_t m_counter;
+};
+
+#endif /* COUNTER_RNG_H_ */
@@ -30,19 +30,31 @@ static double beta_value[20] = {1.49,  1.53,  1.57,  1.61,  1.69,  1.69, 1.65,
                                 3.36,  4.56,  6.42,  7.33,  7.68,  9.21, 10.81,
                                 13.76, 17.52, 20.57, 22.75, 25.16, 28.38};
 
-static double GetEesmEffectiveSinr(std::vector<double> &sinr) {
-  double eff_sinr;
-  double sum_I_sinr = 0;
+// the term of one RB, of that SINR in dB, in the sum of GetEesmEffectiveSinr
+static double GetEesmTerm(double sinr) {
   double beta = 1;
-  for (auto it = sinr.begin(); it != sinr.end(); it++) {
-    // since sinr[] is expressed in dB we should convert it in natural unit!
-    double s = pow(10, ((*it) / 10));
-    sum_I_sinr += exp(-s / beta);
-  }
+  // since sinr[] is expressed in dB we should convert it in natural unit!
+  double s = pow(10, (sinr / 10));
+  return exp(-s / beta);
+}
 
-  eff_sinr = -beta * log(sum_I_sinr / sinr.size());
+// the effective SINR in dB, from the sum of the terms of nbRBs RBs
+static double GetEesmEffectiveSinrFromSum(double sum_I_sinr, size_t nbRBs) {
+  double eff_sinr;
+  double beta = 1;
+  eff_sinr = -beta * log(sum_I_sinr / nbRBs);
   eff_sinr = 10 * log10(eff_sinr);  // convert in dB
   return eff_sinr;
+}
+
+// sinr: a container of double, the SINR of every RB in dB
+template <class Container>
+static double GetEesmEffectiveSinr(const Container &sinr) {
+  double sum_I_sinr = 0;
+  for (auto it = sinr.begin(); it != sinr.end(); it++) {
+    sum_I_sinr += GetEesmTerm(*it);
+  }
+  return GetEesmEffectiveSinrFromSum(sum_I_sinr, sinr.size());
 
   // double eff_sinr;
   // double sum_I_sinr = 0;
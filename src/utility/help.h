@@ -37,6 +37,12 @@ static void Help(void) {
          "run test suites:"
          "\n"
          "\t ./LTE-Sim test"
+         "\n"
+         "\t ./LTE-Sim test-amc-tables"
+         "\n"
+         "\t ./LTE-Sim test-lookup-scaling"
+         "\n"
+         "\t ./LTE-Sim test-timing-wheel"
          "\n\n"
          "run examples:"
          "\n"
@@ -58,12 +64,56 @@ static void Help(void) {
          "sched_type frame_struct speed maxDelay videoBitRate seed(optional)"
          "\n\t\t --> ./LTE-Sim MultiCell 7 1 1 0 0 1 0 1 1 3 0.1 128"
          "\n"
+         "\t ./LTE-Sim ScaleTest config.json nbCells(optional) "
+         "nbUEPerCell(optional)"
+         "\n\t\t --> ./LTE-Sim ScaleTest benchmarks/scale/scale-test.json 19 "
+         "100"
+         "\n"
          "\t ./LTE-Sim SingleCellWithFemto radius nbBuildings BuildingType "
          "activityRatio nbMacroUE nbFemtoUE nbVoip nbVideo nbBE nbCBR "
          "sched_type frame_struct speed accessPolicy maxDelay videoBitRate "
          "seed(optional)"
          "\n\t\t --> ./LTE-Sim SingleCellWithFemto 1 1 0 1 0 1 0 0 1 0 1 1 3 0 "
          "0.1 128"
+         "\n"
+         "\t ./LTE-Sim CompileCqiTrace traceDir(optional)"
+         "\n\t\t --> ./LTE-Sim CompileCqiTrace cqi-traces-noise0/"
+         "\n"
+         "\t ./LTE-Sim ReplaySchedulerInputs capture scheduler config "
+         "passes(optional, default 2); config - is the captured one"
+         "\n\t\t --> ./LTE-Sim ReplaySchedulerInputs inputs.bin subopt "
+         "config.json 5"
+         "\n\n"
+         "options, before the scenario name:"
+         "\n"
+         "\t --tti-threads n: schedules the cells of each TTI on n threads, "
+         "with the same results as the sequential run"
+         "\n\t\t --> ./LTE-Sim --tti-threads 4 MultiCell 7 1 1 0 0 1 0 2 1 3 "
+         "0.1 128"
+         "\n\t --snapshot-at t, --snapshot-schedulers s1,s2,...: runs the "
+         "warm-up up to t once, then restores it once per DL scheduler "
+         "(pf, mlwdf, exp, fls, log-rule, exp-rule, nvs, nvs-nongreedy, "
+         "sequential, subopt, maxcell, vogel, upperbound)"
+         "\n\t --snapshot-seeds 1,2,5-8: restores it once per seed too, "
+         "the seeds change the streams drawn after t"
+         "\n\t --snapshot-output prefix: the restored runs print to "
+         "prefix-scheduler-seedN.out/.err (default: snapshot, - for none); "
+         "the parent prints one RUN summary line per run"
+         "\n\t --snapshot-jobs n: restored runs executed at once "
+         "(default: number of processors)"
+         "\n\t --capture-scheduler-inputs file: writes what the DL "
+         "schedulers read in every TTI and cell, and what they allocate, "
+         "for ReplaySchedulerInputs"
+         "\n\t --real-time slot_us: starts one TTI every slot_us microseconds "
+         "of wall clock, and reports the TTIs over past their slot"
+         "\n\t --real-time-socket path: (real time, 1000 us by default) "
+         "streams the CQIs of every TTI on a Unix socket, and applies the "
+         "slice weights, parameters and inter-slice algorithm it receives"
+         "\n\t\t --> ./LTE-Sim --snapshot-at 2 --snapshot-schedulers "
+         "nvs,sequential,maxcell SingleCellWithI 1 9 1 3 1 10 config.json"
+         "\n\t\t --> ./LTE-Sim --snapshot-at 0 --snapshot-schedulers "
+         "nvs,maxcell --snapshot-seeds 0-7 --snapshot-output - ScaleTest "
+         "scale-test.json (one setup, 16 runs)"
          "\n\n\n"
          "\n\t legend:"
          "\n\t\t schd_type: 1-> PF, 2-> M-LWDF, 3-> EXP, 4-> FLS, 5 -> "
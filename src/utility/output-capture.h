@@ -0,0 +1,84 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef OUTPUT_CAPTURE_H_
+#define OUTPUT_CAPTURE_H_
+
+#include <iostream>
+#include <sstream>
+
+/*
+ * Per-thread capture of the simulator output.
+ *
+ * Code that may run on a worker of the parallel TTI writes to Out () and
+ * Err () rather than to std::cout and std::cerr. While the calling thread
+ * has an active capture, these are string streams owned by the caller;
+ * otherwise they are std::cout and std::cerr. The parallel TTI replays the
+ * output of each cell in cell order, so a run prints exactly what the
+ * sequential run prints.
+ *
+ * The workers never touch std::cout or std::cerr: the formatting state of a
+ * stream is not safe to share between threads. Reset () gives a capture the
+ * formatting of the stream it stands for, and is called before the workers
+ * start.
+ */
+class OutputCapture {
+ public:
+  enum Stream { STDOUT = 0, STDERR = 1 };
+
+  static std::ostream& Out(void) {
+    std::ostream* target = Target(STDOUT);
+    return target != NULL ? *target : std::cout;
+  }
+
+  static std::ostream& Err(void) {
+    std::ostream* target = Target(STDERR);
+    return target != NULL ? *target : std::cerr;
+  }
+
+  // empties a capture and copies the formatting of std::cout / std::cerr
+  static void Reset(std::ostringstream* capture, Stream stream) {
+    capture->str(std::string());
+    capture->clear();
+    capture->copyfmt(stream == STDOUT ? std::cout : std::cerr);
+    // std::cerr is tied to std::cout, a capture flushes nothing
+    capture->tie(NULL);
+  }
+
+  // redirects Out () and Err () of the calling thread until Stop ()
+  static void Start(std::ostringstream* out, std::ostringstream* err) {
+    Target(STDOUT) = out;
+    Target(STDERR) = err;
+  }
+
+  static void Stop(void) {
+    Target(STDOUT) = NULL;
+    Target(STDERR) = NULL;
+  }
+
+ private:
+  static std::ostream*& Target(int stream) {
+    static thread_local std::ostream* target[2] = {NULL, NULL};
+    return target[stream];
+  }
+};
+
+#endif /* OUTPUT_CAPTURE_H_ */
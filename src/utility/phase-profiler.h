@@ -0,0 +1,321 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef PHASE_PROFILER_H_
+#define PHASE_PROFILER_H_
+
+/*
+ * Hot-path phase profiler.
+ *
+ * PROFILE_PHASE (PHASE_X) times the rest of the enclosing scope. The costs a
+ * phase accumulates during one TTI are summed, and the sum goes into an HDR
+ * histogram of that phase when the next TTI starts (PROFILE_TTI_BOUNDARY,
+ * called by the FrameManager). At exit, a table of the per-TTI cost of every
+ * phase is printed to stderr, and every timed scope is written as a Chrome
+ * trace (chrome://tracing, Perfetto) to $PHASE_PROFILE_TRACE, by default
+ * phase-trace.json.
+ *
+ * Phases nest (the channel delivers to the PHY, which computes the SINR), so
+ * their costs are inclusive. Scopes may run on the TTI worker threads; each
+ * thread accumulates on its own, the boundary is crossed when they are idle.
+ *
+ * Everything compiles out unless PHASE_PROFILER is defined.
+ */
+
+#ifdef PHASE_PROFILER
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+enum PhaseId {
+  PHASE_TTI = 0,                  // wall time from one TTI to the next
+  PHASE_FRAME_ALLOCATION,         // FrameManager: resource allocation
+  PHASE_CHANNEL_RX,               // LteChannel: loss model and delivery
+  PHASE_UE_PHY_RX,                // UeLtePhy: reception of a burst
+  PHASE_UE_PHY_SINR,              // UeLtePhy: SINR and interference
+  PHASE_UE_PHY_CQI,               // UeLtePhy: CQI feedbacks
+  PHASE_SCHED_PREPARE,            // DL scheduler: flow selection
+  PHASE_SCHED_ALLOCATE,           // DL scheduler: RB allocation
+  PHASE_SCHED_INTER_SLICE,        // DL scheduler: inter-slice solver
+  PHASE_SCHED_STOP,               // DL scheduler: logging and transmission
+  PHASE_SCHED_UPLINK,             // UL scheduler
+  PHASE_RLC_TX,                   // RLC entities: transmission procedure
+  PHASE_RLC_RX,                   // RLC entities: reception procedure
+  NB_PHASES
+};
+
+static const char* const phaseNames[NB_PHASES] = {
+    "tti",
+    "frame.allocation",
+    "channel.rx",
+    "ue_phy.rx",
+    "ue_phy.sinr",
+    "ue_phy.cqi",
+    "scheduler.prepare",
+    "scheduler.allocate",
+    "scheduler.inter_slice",
+    "scheduler.stop",
+    "scheduler.uplink",
+    "rlc.tx",
+    "rlc.rx",
+};
+
+/*
+ * HDR histogram of non-negative integers (nanoseconds here): exact below
+ * 256, then 128 linear sub-buckets per power of two, i.e. a relative error
+ * below 1/128 over the whole range.
+ */
+class PhaseHistogram {
+ public:
+  static const int SUB_BUCKETS = 128;
+  static const int MAX_SHIFT = 40;
+  static const int NB_BUCKETS = 2 * SUB_BUCKETS + MAX_SHIFT * SUB_BUCKETS;
+
+  PhaseHistogram() : m_counts(NB_BUCKETS, 0), m_total(0), m_sum(0), m_min(UINT64_MAX), m_max(0) {}
+
+  void Record(uint64_t v) {
+    m_counts[Index(v)]++;
+    m_total++;
+    m_sum += v;
+    m_min = std::min(m_min, v);
+    m_max = std::max(m_max, v);
+  }
+
+  uint64_t GetCount(void) const { return m_total; }
+  uint64_t GetMin(void) const { return m_total > 0 ? m_min : 0; }
+  uint64_t GetMax(void) const { return m_max; }
+  double GetMean(void) const { return m_total > 0 ? (double)m_sum / m_total : 0; }
+
+  // the smallest recorded value v such that q of the values are <= v
+  uint64_t GetPercentile(double q) const {
+    if (m_total == 0) return 0;
+    uint64_t rank = (uint64_t)(q * m_total + 0.5);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < NB_BUCKETS; i++) {
+      seen += m_counts[i];
+      if (seen >= rank) return std::min(std::max(HighestEquivalent(i), m_min), m_max);
+    }
+    return m_max;
+  }
+
+ private:
+  static int Index(uint64_t v) {
+    if (v < 2 * SUB_BUCKETS) return (int)v;
+    int shift = 63 - __builtin_clzll(v) - 7;
+    if (shift > MAX_SHIFT) return NB_BUCKETS - 1;
+    return 2 * SUB_BUCKETS + (shift - 1) * SUB_BUCKETS + (int)((v >> shift) - SUB_BUCKETS);
+  }
+
+  static uint64_t HighestEquivalent(int i) {
+    if (i < 2 * SUB_BUCKETS) return i;
+    int shift = (i - 2 * SUB_BUCKETS) / SUB_BUCKETS + 1;
+    uint64_t sub = (i - 2 * SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> m_counts;
+  uint64_t m_total;
+  uint64_t m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+class PhaseProfiler {
+ public:
+  // the Chrome trace stops growing past this many scopes
+  static const uint64_t MAX_TRACE_EVENTS = 1000000;
+
+  struct TraceEvent {
+    uint64_t m_start;  // ns since the profiler started
+    uint64_t m_duration;
+    int m_phase;
+  };
+
+  struct ThreadState {
+    int m_tid;
+    uint64_t m_ttiCost[NB_PHASES];
+    bool m_ttiSeen[NB_PHASES];
+    std::vector<TraceEvent> m_events;
+  };
+
+  static PhaseProfiler* Init(void) {
+    static PhaseProfiler* ptr = NULL;
+    if (ptr == NULL) {
+      ptr = new PhaseProfiler;
+      atexit(&PhaseProfiler::AtExit);
+    }
+    return ptr;
+  }
+
+  inline uint64_t Now(void) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - m_origin)
+        .count();
+  }
+
+  inline void Record(PhaseId phase, uint64_t start, uint64_t end) {
+    ThreadState* s = GetThreadState();
+    s->m_ttiCost[phase] += end - start;
+    s->m_ttiSeen[phase] = true;
+    if (m_nbTraceEvents.fetch_add(1, std::memory_order_relaxed) < MAX_TRACE_EVENTS) {
+      TraceEvent e = {start, end - start, phase};
+      s->m_events.push_back(e);
+    }
+  }
+
+  /*
+   * Closes the current TTI: moves the per-TTI sums of all threads into the
+   * histograms. Called on the main thread while the workers are idle.
+   */
+  void TtiBoundary(void) {
+    uint64_t now = Now();
+    if (m_lastTti > 0) Record(PHASE_TTI, m_lastTti, now);
+    m_lastTti = now;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t cost[NB_PHASES] = {0};
+    bool seen[NB_PHASES] = {false};
+    for (size_t t = 0; t < m_threads.size(); t++) {
+      ThreadState* s = m_threads[t];
+      for (int p = 0; p < NB_PHASES; p++) {
+        cost[p] += s->m_ttiCost[p];
+        seen[p] = seen[p] || s->m_ttiSeen[p];
+        s->m_ttiCost[p] = 0;
+        s->m_ttiSeen[p] = false;
+      }
+    }
+    for (int p = 0; p < NB_PHASES; p++)
+      if (seen[p]) m_histograms[p].Record(cost[p]);
+  }
+
+  void PrintSummary(std::ostream& os) {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "PHASE_PROFILE per-TTI cost in microseconds (inclusive)" << std::endl;
+    os << std::left << std::setw(24) << "phase" << std::right << std::setw(10) << "ttis"
+       << std::setw(11) << "mean" << std::setw(11) << "p50" << std::setw(11) << "p90"
+       << std::setw(11) << "p99" << std::setw(11) << "max" << std::setw(12) << "total_ms"
+       << std::endl;
+    os << std::fixed << std::setprecision(2);
+    for (int p = 0; p < NB_PHASES; p++) {
+      const PhaseHistogram& h = m_histograms[p];
+      if (h.GetCount() == 0) continue;
+      os << std::left << std::setw(24) << phaseNames[p] << std::right << std::setw(10)
+         << h.GetCount() << std::setw(11) << h.GetMean() / 1e3 << std::setw(11)
+         << h.GetPercentile(0.5) / 1e3 << std::setw(11) << h.GetPercentile(0.9) / 1e3
+         << std::setw(11) << h.GetPercentile(0.99) / 1e3 << std::setw(11)
+         << h.GetMax() / 1e3 << std::setw(12) << h.GetMean() * h.GetCount() / 1e6
+         << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  bool WriteChromeTrace(const char* fname) {
+    FILE* fp = fopen(fname, "w");
+    if (fp == NULL) return false;
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t t = 0; t < m_threads.size(); t++) {
+      ThreadState* s = m_threads[t];
+      for (size_t i = 0; i < s->m_events.size(); i++) {
+        const TraceEvent& e = s->m_events[i];
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",", phaseNames[e.m_phase], s->m_tid, e.m_start / 1e3,
+                e.m_duration / 1e3);
+        first = false;
+      }
+    }
+    fprintf(fp, "\n]}\n");
+    return fclose(fp) == 0;
+  }
+
+ private:
+  PhaseProfiler() : m_origin(std::chrono::steady_clock::now()), m_lastTti(0), m_nbTraceEvents(0) {}
+
+  ThreadState* GetThreadState(void) {
+    static thread_local ThreadState* state = NULL;
+    if (state == NULL) {
+      state = new ThreadState;
+      for (int p = 0; p < NB_PHASES; p++) {
+        state->m_ttiCost[p] = 0;
+        state->m_ttiSeen[p] = false;
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      state->m_tid = m_threads.size();
+      m_threads.push_back(state);
+    }
+    return state;
+  }
+
+  static void AtExit(void) {
+    PhaseProfiler* profiler = Init();
+    profiler->TtiBoundary();
+    profiler->PrintSummary(std::cerr);
+    const char* fname = getenv("PHASE_PROFILE_TRACE");
+    if (fname == NULL) fname = "phase-trace.json";
+    if (!profiler->WriteChromeTrace(fname))
+      std::cerr << "ERROR: unable to write the phase trace to " << fname << std::endl;
+  }
+
+  std::chrono::steady_clock::time_point m_origin;
+  uint64_t m_lastTti;
+  std::atomic<uint64_t> m_nbTraceEvents;
+  PhaseHistogram m_histograms[NB_PHASES];
+  std::mutex m_mutex;  // guards m_threads and the events at exit
+  std::vector<ThreadState*> m_threads;
+};
+
+class PhaseTimer {
+ public:
+  explicit PhaseTimer(PhaseId phase)
+      : m_profiler(PhaseProfiler::Init()), m_phase(phase), m_start(m_profiler->Now()) {}
+  ~PhaseTimer() { m_profiler->Record(m_phase, m_start, m_profiler->Now()); }
+
+ private:
+  PhaseProfiler* m_profiler;
+  PhaseId m_phase;
+  uint64_t m_start;
+};
+
+#define PHASE_TIMER_NAME2(line) phaseTimer##line
+#define PHASE_TIMER_NAME(line) PHASE_TIMER_NAME2(line)
+#define PROFILE_PHASE(phase) PhaseTimer PHASE_TIMER_NAME(__LINE__)(phase)
+#define PROFILE_TTI_BOUNDARY() PhaseProfiler::Init()->TtiBoundary()
+
+#else
+
+#define PROFILE_PHASE(phase)
+#define PROFILE_TTI_BOUNDARY()
+
+#endif /* PHASE_PROFILER */
+
+#endif /* PHASE_PROFILER_H_ */
@@ -0,0 +1,133 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef SPATIAL_GRID_H_
+#define SPATIAL_GRID_H_
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#define SPATIAL_GRID_MAX_SIDE 1024  // buckets per dimension
+
+/*
+ * Uniform grid over axis-aligned boxes, identified by their index in the
+ * container the grid was built from.
+ *
+ * Every box is listed in all the buckets it overlaps, in insertion order, so
+ * the candidates of a query come out sorted by container index and callers
+ * can keep the first-match semantics of a linear scan. The grid only narrows
+ * the candidates: callers still apply their exact predicate.
+ */
+class SpatialGrid {
+ public:
+  SpatialGrid() { Reset(0, 0, 0, 0, 1); }
+
+  /*
+   * Covers [minX, maxX] x [minY, maxY] with buckets of the given side,
+   * enlarged when needed to stay within SPATIAL_GRID_MAX_SIDE per dimension.
+   */
+  void Reset(double minX, double minY, double maxX, double maxY,
+             double bucketSide) {
+    if (!(bucketSide > 0)) bucketSide = 1;
+    double side = std::max(maxX - minX, maxY - minY);
+    if (side / bucketSide > SPATIAL_GRID_MAX_SIDE - 1)
+      bucketSide = side / (SPATIAL_GRID_MAX_SIDE - 1);
+    m_minX = minX;
+    m_minY = minY;
+    m_bucketSide = bucketSide;
+    m_columns = (int)((maxX - minX) / bucketSide) + 1;
+    m_rows = (int)((maxY - minY) / bucketSide) + 1;
+    m_buckets.assign((size_t)m_columns * m_rows, std::vector<int>());
+  }
+
+  void Insert(int item, double minX, double minY, double maxX, double maxY) {
+    int c0, r0, c1, r1;
+    if (!Clip(minX, minY, maxX, maxY, c0, r0, c1, r1)) return;
+    for (int r = r0; r <= r1; r++)
+      for (int c = c0; c <= c1; c++)
+        m_buckets[(size_t)r * m_columns + c].push_back(item);
+  }
+
+  // items whose box may contain (x, y)
+  const std::vector<int>& Query(double x, double y) const {
+    static const std::vector<int> none;
+    int c = Column(x);
+    int r = Row(y);
+    if (c < 0 || c >= m_columns || r < 0 || r >= m_rows) return none;
+    return m_buckets[(size_t)r * m_columns + c];
+  }
+
+  // items whose box may intersect the query box, sorted and unique
+  void Query(double minX, double minY, double maxX, double maxY,
+             std::vector<int>& items) const {
+    items.clear();
+    int c0, r0, c1, r1;
+    if (!Clip(minX, minY, maxX, maxY, c0, r0, c1, r1)) return;
+    for (int r = r0; r <= r1; r++)
+      for (int c = c0; c <= c1; c++) {
+        const std::vector<int>& bucket = m_buckets[(size_t)r * m_columns + c];
+        items.insert(items.end(), bucket.begin(), bucket.end());
+      }
+    if (r0 != r1 || c0 != c1) {
+      std::sort(items.begin(), items.end());
+      items.erase(std::unique(items.begin(), items.end()), items.end());
+    }
+  }
+
+  // true when the query box covers every bucket
+  bool Covers(double minX, double minY, double maxX, double maxY) const {
+    return Column(minX) <= 0 && Row(minY) <= 0 &&
+           Column(maxX) >= m_columns - 1 && Row(maxY) >= m_rows - 1;
+  }
+
+  double GetBucketSide(void) const { return m_bucketSide; }
+
+ private:
+  int Column(double x) const {
+    double c = floor((x - m_minX) / m_bucketSide);
+    if (!(c >= 0)) return -1;  // also NaN
+    return c >= m_columns ? m_columns : (int)c;
+  }
+  int Row(double y) const {
+    double r = floor((y - m_minY) / m_bucketSide);
+    if (!(r >= 0)) return -1;
+    return r >= m_rows ? m_rows : (int)r;
+  }
+  bool Clip(double minX, double minY, double maxX, double maxY, int& c0,
+            int& r0, int& c1, int& r1) const {
+    c0 = std::max(Column(minX), 0);
+    r0 = std::max(Row(minY), 0);
+    c1 = std::min(Column(maxX), m_columns - 1);
+    r1 = std::min(Row(maxY), m_rows - 1);
+    return c0 <= c1 && r0 <= r1;
+  }
+
+  double m_minX;
+  double m_minY;
+  double m_bucketSide;
+  int m_columns;
+  int m_rows;
+  std::vector<std::vector<int> > m_buckets;
+};
+
+#endif /* SPATIAL_GRID_H_ */
@@ -0,0 +1,155 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+#ifndef TTI_ARENA_H_
+#define TTI_ARENA_H_
+
+#include <stddef.h>
+
+#include <new>
+#include <vector>
+
+/*
+ * Monotonic arena for the working set a scheduler builds during one TTI.
+ * Allocation bumps a pointer, nothing is freed until Reset (), which takes
+ * the whole TTI back at once. The destructors are not run: objects with a
+ * destructor that matters must be destroyed by their owner before the reset.
+ *
+ * A TTI that does not fit in the block takes extra blocks from the heap; the
+ * next Reset () frees them and grows the block to the largest TTI seen, so
+ * once the scheduler has seen its busiest TTI it no longer calls the heap.
+ *
+ * Not thread-safe: one arena per scheduler.
+ */
+class TtiArena {
+ public:
+  // with no initial capacity, the block is sized by the first TTI
+  TtiArena(size_t capacity = 0)
+      : m_block(NULL), m_capacity(0), m_used(0), m_peak(0) {
+    if (capacity > 0) Grow(capacity);
+  }
+
+  ~TtiArena() {
+    FreeOverflow();
+    ::operator delete(m_block);
+  }
+
+  // align is a power of two, up to a cache line
+  void* Allocate(size_t bytes, size_t align) {
+    size_t base = (size_t)m_block;
+    size_t offset = ((base + m_used + align - 1) & ~(align - 1)) - base;
+    if (offset + bytes <= m_capacity) {
+      m_used = offset + bytes;
+      return m_block + offset;
+    }
+    // the block is full for this TTI
+    m_peak += bytes + align;
+    void* p = ::operator new(bytes + align);
+    m_overflow.push_back(p);
+    return (void*)(((size_t)p + align - 1) & ~(align - 1));
+  }
+
+  // n uninitialized T
+  template <class T>
+  T* NewArray(size_t n) {
+    return (T*)Allocate(n * sizeof(T), alignof(T));
+  }
+
+  template <class T, class... Args>
+  T* New(Args&&... args) {
+    return new (Allocate(sizeof(T), alignof(T))) T(static_cast<Args&&>(args)...);
+  }
+
+  // forgets everything allocated since the last reset
+  void Reset(void) {
+    if (!m_overflow.empty()) {
+      FreeOverflow();
+      Grow(m_capacity + m_peak);
+    }
+    m_used = 0;
+    m_peak = 0;
+  }
+
+  size_t GetCapacity(void) const { return m_capacity; }
+  size_t GetUsed(void) const { return m_used; }
+
+ private:
+  TtiArena(const TtiArena&);
+  TtiArena& operator=(const TtiArena&);
+
+  void Grow(size_t capacity) {
+    ::operator delete(m_block);
+    m_block = NULL;
+    m_capacity = 0;
+    m_block = (char*)::operator new(capacity);
+    m_capacity = capacity;
+  }
+
+  void FreeOverflow(void) {
+    for (size_t i = 0; i < m_overflow.size(); i++) ::operator delete(m_overflow[i]);
+    m_overflow.clear();
+  }
+
+  char* m_block;
+  size_t m_capacity;
+  size_t m_used;
+  size_t m_peak;  // bytes taken from the heap this TTI
+  std::vector<void*> m_overflow;
+};
+
+/*
+ * Standard allocator drawing from a TtiArena, for the containers of the
+ * per-TTI working set. deallocate () is a no-op: a container that grows
+ * leaves its old storage in the arena until the reset, so reserve what is
+ * known up front.
+ */
+template <class T>
+class TtiAllocator {
+ public:
+  typedef T value_type;
+
+  TtiAllocator(TtiArena* arena) : m_arena(arena) {}
+  template <class U>
+  TtiAllocator(const TtiAllocator<U>& other) : m_arena(other.GetArena()) {}
+
+  T* allocate(size_t n) { return m_arena->NewArray<T>(n); }
+  void deallocate(T*, size_t) {}
+
+  TtiArena* GetArena(void) const { return m_arena; }
+
+ private:
+  TtiArena* m_arena;
+};
+
+template <class T, class U>
+bool operator==(const TtiAllocator<T>& a, const TtiAllocator<U>& b) {
+  return a.GetArena() == b.GetArena();
+}
+
+template <class T, class U>
+bool operator!=(const TtiAllocator<T>& a, const TtiAllocator<U>& b) {
+  return a.GetArena() != b.GetArena();
+}
+
+template <class T>
+using TtiVector = std::vector<T, TtiAllocator<T> >;
+
+#endif /* TTI_ARENA_H_ */
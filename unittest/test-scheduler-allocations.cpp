@@ -0,0 +1,56 @@
+/* project: RadioSaber; Mode: C++
+ * Copyright (c) 2021, 2022, 2023, 2024 University of Illinois Urbana Champaign
+ *
+ * This file is part of RadioSaber, which is a project built upon LTE-Sim in 2022
+ *
+ * RadioSaber is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RadioSaber is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Author: Yongzhou Chen <yongzhouc@outlook.com>
+ */
+
+/*
+ * Test binary of the scheduler allocation test: linked with the objects of
+ * the simulator but LTE-Sim.o, in place of its main program. It replaces the
+ * global operator new to count the heap calls, which is why it is not part
+ * of LTE-Sim.
+ */
+
+#include <stdlib.h>
+
+#include <new>
+
+#include "../src/TEST/test-scheduler-allocations.h"
+
+bool schedAllocCounting = false;
+long schedAllocCount = 0;
+
+void* operator new(size_t size) {
+  if (schedAllocCounting) schedAllocCount++;
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == NULL) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+// not inlined: GCC would see free () called on what it knows as a new
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept { free(p); }
+
+int main(int, char*[]) {
+  TestSchedulerAllocations();
+  return 0;
+}